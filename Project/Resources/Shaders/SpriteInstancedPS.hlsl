@@ -0,0 +1,22 @@
+// SPRITE_TEXTURED / SPRITE_ALPHA_TEST は SpriteCommon が ShaderPermutation で 0/1 を定義する（SpriteFeature）
+struct PSIn {
+    float4 posH : SV_POSITION;
+    float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+#if SPRITE_TEXTURED
+Texture2D<float4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+#endif
+
+float4 main(PSIn i) : SV_TARGET {
+    float4 color = i.color;
+#if SPRITE_TEXTURED
+    color *= gTexture.Sample(gSampler, i.uv);
+#endif
+#if SPRITE_ALPHA_TEST
+    clip(color.a - 0.5);
+#endif
+    return color;
+}
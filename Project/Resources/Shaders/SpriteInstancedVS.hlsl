@@ -0,0 +1,25 @@
+struct VSIn {
+    float2 pos : POSITION;
+    float2 uv : TEXCOORD0;
+    float4 wvp0 : WVP0;
+    float4 wvp1 : WVP1;
+    float4 wvp2 : WVP2;
+    float4 wvp3 : WVP3;
+    float4 color : COLOR0;
+    float4 uvRect : UVRECT0;
+};
+
+struct VSOut {
+    float4 posH : SV_POSITION;
+    float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+VSOut main(VSIn i) {
+    VSOut o;
+    float4x4 wvp = float4x4(i.wvp0, i.wvp1, i.wvp2, i.wvp3);
+    o.posH = mul(float4(i.pos, 0, 1), wvp);
+    o.uv = lerp(i.uvRect.xy, i.uvRect.zw, i.uv);
+    o.color = i.color;
+    return o;
+}
@@ -1,3 +1,4 @@
+// SPRITE_TEXTURED / SPRITE_ALPHA_TEST は SpriteCommon が ShaderPermutation で 0/1 を定義する（SpriteFeature）
 cbuffer Material : register(b0) {
     float4 gColor;
     uint gEnableLighting;
@@ -5,6 +6,23 @@ cbuffer Material : register(b0) {
     row_major float4x4 gUVTransform;
 };
 
-float4 main() : SV_TARGET {
-    return gColor;
+#if SPRITE_TEXTURED
+Texture2D<float4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+#endif
+
+struct PSIn {
+    float4 posH : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+float4 main(PSIn i) : SV_TARGET {
+    float4 color = gColor;
+#if SPRITE_TEXTURED
+    color *= gTexture.Sample(gSampler, i.uv);
+#endif
+#if SPRITE_ALPHA_TEST
+    clip(color.a - 0.5);
+#endif
+    return color;
 }
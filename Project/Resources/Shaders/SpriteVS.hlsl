@@ -3,9 +3,10 @@ struct VSIn {
     float2 uv : TEXCOORD0;
 };
 
+// Sprite は転置して送るので、既定の column_major のまま読む（SpriteInstancedVS と同じ向きになる）
 cbuffer Transform : register(b1) {
-    row_major float4x4 gWVP;
-    row_major float4x4 gWorld;
+    float4x4 gWVP;   // World * View * Proj（World は畳み込み済み）
+    float4x4 gWorld;
 };
 
 struct VSOut {
@@ -15,8 +16,7 @@ struct VSOut {
 
 VSOut main(VSIn i) {
     VSOut o;
-    float4 wpos = mul(float4(i.pos, 1), gWorld);
-    o.posH = mul(wpos, gWVP);
+    o.posH = mul(float4(i.pos, 1), gWVP);
     o.uv = i.uv;
     return o;
 }
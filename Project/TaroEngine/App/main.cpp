@@ -1,16 +1,28 @@
 #include "DirectXCommon.h"
 #include "WinApp.h"
 #include "SpriteCommon.h"
+#include "SpriteBatch.h"
 #include "ShaderCompiler.h"
+#include "ShaderCache.h"
+#include "PipelineCache.h"
 #include "EngineContext.h"
 #include "GameScene.h"
 #include "SceneManager.h"
 #include "OutputLogger.h"
 #include "MultiLogger.h"
-#include "FileLogger.h"
+#include "RotatingFileLogger.h"
+#include "AsyncLogger.h"
+#include "BinaryLogger.h"
 #include "PathUtil.h"   
+#include "Profiler.h"
+#include "ProfilerView.h"
+#include "FixedTimestep.h"
+#include "SimulationThread.h"
+#include "SnapshotExchange.h"
+#include "JobSystem.h"
 #include <memory>
 #include <chrono>
+#include <cstdlib>
 
 /// <summary>
 /// アプリのエントリポイント。
@@ -37,8 +49,18 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	ShaderCompiler compiler;
 	compiler.Initialize();
 
+	// コンパイル結果は Generated/ShaderCache に保存し、次回起動時に再利用する
+	ShaderCache shaderCache;
+	if (shaderCache.Initialize(PathUtil::FindOrCreateGenerated() / "ShaderCache")) {
+		compiler.SetCache(&shaderCache);
+	}
+
+	// PSO は Generated/PipelineCache.bin に保存し、次回起動時のドライバコンパイルを省く
+	PipelineCache pipelineCache;
+	pipelineCache.Initialize(dx->GetDevice(), PathUtil::FindOrCreateGenerated() / "PipelineCache.bin");
+
 	std::unique_ptr<SpriteCommon> spriteCommon = std::make_unique<SpriteCommon>();
-	spriteCommon->Initialize(dx->GetDevice());
+	spriteCommon->Initialize(dx->GetDevice(), &pipelineCache);
 
 	SpriteCommon::PipelineFormats formats{};
 	formats.rtvFormat = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
@@ -53,6 +75,26 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 		formats,
 		L"main", L"main");
 
+	spriteCommon->CreateInstancedPipeline(
+		compiler,
+		dx->GetDevice(),
+		L"Resources/Shaders/SpriteInstancedVS.hlsl",
+		L"Resources/Shaders/SpriteInstancedPS.hlsl",
+		formats,
+		L"main", L"main");
+
+	pipelineCache.Save();
+
+	// ===============================
+	// ジョブシステム（このスレッドがメインスレッドとして登録される）
+	// ===============================
+	JobSystem jobSystem;
+	jobSystem.Initialize(JobSystem::DefaultWorkerCount());
+
+	std::unique_ptr<SpriteBatch> spriteBatch = std::make_unique<SpriteBatch>();
+	spriteBatch->Initialize(dx->GetDevice(), dx->GetUploadRing());
+	spriteBatch->SetJobSystem(&jobSystem);
+
 	// ===============================
 	// DI: EngineContext を用意
 	// ===============================
@@ -60,16 +102,52 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	engine.directXCommon = dx.get();
 	engine.device = dx->GetDevice();
 	engine.spriteCommon = spriteCommon.get();
+	engine.spriteBatch = spriteBatch.get();
+	engine.jobSystem = &jobSystem;
 	engine.multiLogger = std::make_unique<MultiLogger>();
 	engine.multiLogger->AddLogger(std::make_shared<OutputLogger>());
 
 	const auto logPath = PathUtil::DefaultLogFilePath();
-	auto fileLogger = std::make_shared<FileLogger>(logPath.string());
+	// ファイルはサイズで切り替えて古いものを数世代だけ残す（書き込みはワーカースレッドでまとめて行う）
+	auto fileLogger = std::make_shared<RotatingFileLogger>(logPath);
 	if (fileLogger->IsOpen()) {
-		engine.multiLogger->AddLogger(fileLogger);
-		engine.multiLogger->Log(LogLevel::INFO, ("FileLogger attached: " + logPath.string()).c_str());
+		engine.multiLogger->AddLogger(std::make_shared<AsyncLogger>(fileLogger));
+		TARO_LOG_INFO(*engine.multiLogger, "FileLogger attached: {}", logPath.string());
 	} else {
-		engine.multiLogger->Log(LogLevel::WARN, ("FileLogger open failed: " + logPath.string()).c_str());
+		TARO_LOG_WARN(*engine.multiLogger, "FileLogger open failed: {}", logPath.string());
+	}
+
+	// 環境変数 TARO_BINARY_LOG=1 があれば、整形せずに記録するバイナリログ（Generated/Logs/app.tlog）も残す。
+	// テキストへの復元は TaroLogDecode（Project/Tools/LogDecode）で行う
+	char binaryLog[8] = {};
+	if (GetEnvironmentVariableA("TARO_BINARY_LOG", binaryLog, sizeof(binaryLog)) > 0 && std::atoi(binaryLog) != 0) {
+		const auto binaryLogPath = PathUtil::DefaultLogFilePath("app.tlog");
+		auto binaryLogger = std::make_shared<BinaryLogger>(binaryLogPath.string());
+		if (binaryLogger->IsOpen()) {
+			engine.multiLogger->AddLogger(binaryLogger);
+			TARO_LOG_INFO(*engine.multiLogger, "BinaryLogger attached: {}", binaryLogPath.string());
+		} else {
+			TARO_LOG_WARN(*engine.multiLogger, "BinaryLogger open failed: {}", binaryLogPath.string());
+		}
+	}
+
+	// ===============================
+	// プロファイラ
+	// ===============================
+	Profiler::Get().SetThreadName("Main");
+	const auto profileDir = PathUtil::FindOrCreateGenerated() / "Profile";
+	ProfilerView profilerView;
+	profilerView.Initialize(profileDir);
+	profilerView.SetGpuProfiler(dx->GetGpuProfiler());
+	profilerView.SetFramePacer(dx->GetFramePacer());
+
+	// 環境変数 TARO_PROFILE_TRACE=<フレーム数> があれば起動直後から Chrome trace を記録する（ImGui なしで解析する用）
+	char traceFrames[16] = {};
+	if (GetEnvironmentVariableA("TARO_PROFILE_TRACE", traceFrames, sizeof(traceFrames)) > 0) {
+		const int frames = std::atoi(traceFrames);
+		if (frames > 0 && Profiler::Get().BeginTraceCapture(profileDir / "trace.json", static_cast<uint32_t>(frames))) {
+			TARO_LOG_INFO(*engine.multiLogger, "Profiler trace capture: {} frames -> {}", frames, (profileDir / "trace.json").string());
+		}
 	}
 
 	// ===============================
@@ -88,6 +166,55 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	const float kDtClampMin = 1.0f / 240.0f; // 低すぎるdtの下限
 	const float kDtClampMax = 1.0f / 15.0f;  // スパイク抑制の上限
 
+	// シミュレーションは描画レートと切り離して固定刻みで進める
+	const double kFixedStepHz = 60.0;     // 1 秒あたりの固定ステップ数
+	const uint32_t kMaxSubsteps = 8;      // 1 フレームで進める最大ステップ数
+	const double kMaxFrameSeconds = 0.25; // これを超える停止（ブレークポイントなど）は切り捨てる
+	FixedTimestep timestep;
+	timestep.Initialize(kFixedStepHz, kMaxSubsteps, kMaxFrameSeconds);
+
+	// 1 フレーム分のシミュレーション（固定ステップ → 可変更新）
+	auto simulate = [&](double frameSeconds) {
+		float dt = static_cast<float>(frameSeconds);
+		if (dt < kDtClampMin) dt = kDtClampMin;
+		if (dt > kDtClampMax) dt = kDtClampMax;
+
+		// --- 固定ステップ更新（0 回以上） ---
+		const uint32_t steps = timestep.Advance(frameSeconds);
+		const float fixedDt = static_cast<float>(timestep.GetStepSeconds());
+		for (uint32_t i = 0; i < steps; ++i) {
+			sceneMgr.FixedUpdate(fixedDt);
+		}
+
+		// --- 更新 ---
+		sceneMgr.Update(dt);
+	};
+
+	// シミュレーションを別スレッドで 1 フレーム先行させる（false なら同じスレッドで順に実行する）。
+	// 描画スレッドはフレーム N をスナップショットから積み、その間にシミュレーションが N+1 を進める
+	const bool kPipelinedSimulation = true;
+	// スナップショットの描画を積むコマンドリストの提出順（フレーム先頭のクリアの後、UI の前）
+	const uint32_t kSceneCommandOrder = CommandContextPool::kOrderFrameBegin + 1;
+
+	SnapshotExchange<RenderSnapshot> snapshots;
+	SimulationThread simThread;
+	uint64_t simFrameIndex = 0;
+	if (kPipelinedSimulation) {
+		simThread.Start([&](const SimulationThread::FrameInput &input) {
+			TARO_PROFILE_SCOPE("Simulation");
+			simulate(input.frameSeconds);
+
+			RenderSnapshot *snapshot = snapshots.BeginWrite();
+			if (!snapshot) return; // 終了中
+			snapshot->Clear();
+			snapshot->frameIndex = input.frameIndex;
+			snapshot->interpolationAlpha = timestep.GetAlpha();
+			snapshot->extracted = sceneMgr.ExtractRenderData(*snapshot);
+			snapshots.EndWrite();
+		});
+		simThread.Kick({simFrameIndex, 0.0}); // 最初のフレームを用意しておく
+	}
+
 	bool running = true;
 	while (running) {
 		// Windows メッセージ処理（true が返ったら終了）
@@ -95,32 +222,77 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 			break;
 		}
 
+		Profiler::Get().BeginFrame();
+
 		// --- dt 計測（秒） ---
 		auto now = clock::now();
-		float dt = std::chrono::duration<float>(now - prev).count();
+		const double frameSeconds = std::chrono::duration<double>(now - prev).count();
 		prev = now;
-		if (dt < kDtClampMin) dt = kDtClampMin;
-		if (dt > kDtClampMax) dt = kDtClampMax;
-
-		// --- 更新 ---
-		sceneMgr.Update(dt);
 
 		// --- 描画 ---
 		const float clearColor[] = {0.1f, 0.25f, 0.5f, 1.0f};
-		dx->PreDraw(clearColor);
-
 		RenderContext rc{};
-		rc.commandList = dx->GetCommandList();
+		JobCounter sceneRecorded;
+
+		if (!kPipelinedSimulation) {
+			simulate(frameSeconds);
 
-		sceneMgr.Draw(rc);
+			dx->PreDraw(clearColor);
+			rc.commandList = dx->GetCommandList();
+			rc.interpolationAlpha = timestep.GetAlpha();
+			{
+				TARO_GPU_PROFILE_SCOPE(*dx->GetGpuProfiler(), "Scene");
+				sceneMgr.Draw(rc);
+			}
+		} else {
+			// フレーム N のスナップショットを受け取る（公開後のシミュレーションは次の依頼待ちで止まる）
+			const RenderSnapshot *snapshot = snapshots.BeginRead();
+			simThread.WaitIdle();
+
+			dx->PreDraw(clearColor);
+			rc.commandList = dx->GetCommandList();
+			rc.interpolationAlpha = snapshot->interpolationAlpha;
+
+			// シーン本体に触れる処理（UI、スナップショット非対応シーンの描画）は再開前に済ませる
+			if (snapshot->extracted) {
+				sceneMgr.DrawUI();
+			} else {
+				TARO_GPU_PROFILE_SCOPE(*dx->GetGpuProfiler(), "Scene");
+				sceneMgr.Draw(rc);
+			}
+
+			// N+1 の更新を始め、並行してスナップショットからコマンドを積む。
+			// 積むのはワーカーが専用のコマンドリストで行い、その間メインスレッドは UI を組み立てる
+			// （ワーカーのリストには GPU 計測を積めないので、Scene の GPU 時間は Frame に含まれる）
+			simThread.Kick({++simFrameIndex, frameSeconds});
+			if (snapshot->extracted) {
+				jobSystem.Run(sceneRecorded, [&, snapshot] {
+					TARO_PROFILE_SCOPE("RecordSnapshot");
+					RenderContext workerRc = rc;
+					workerRc.commandList = dx->AcquireCommandList(kSceneCommandOrder);
+					sceneMgr.DrawSnapshot(workerRc, *snapshot);
+				});
+			}
+		}
+		profilerView.Draw();
+		jobSystem.Wait(sceneRecorded); // PostDraw でまとめて提出する前に記録を終える
 
 		dx->PostDraw();
+		if (kPipelinedSimulation) {
+			snapshots.EndRead();
+		}
+
+		Profiler::Get().EndFrame();
 	}
 
 	// ===============================
 	// 終了処理
 	// ===============================
+	snapshots.Stop();          // シミュレーションスレッドの待ちを解く
+	simThread.Stop();          // 依頼済みのフレームを終えて停止
 	sceneMgr.Finalize();       // 現在シーンのFinalize
+	jobSystem.Finalize();      // 積まれたジョブを終えてワーカー停止
+	Profiler::Get().EndTraceCapture(); // 記録途中のトレースがあれば書き出す
 	dx->Finalize();            // D3D12 後片付け
 	winApp->Finalize();        // ウィンドウ破棄
 
@@ -5,7 +5,9 @@
 
 class DirectXCommon;
 class SpriteCommon;
+class SpriteBatch;
 class MultiLogger;
+class JobSystem;
 
 /// <summary>
 /// エンジン全体で共有する長寿命オブジェクトを束ねる。
@@ -14,6 +16,8 @@ struct EngineContext {
 	DirectXCommon *directXCommon = nullptr; // DirectX12基盤管理
 	ID3D12Device *device = nullptr; // D3D12デバイス
 	SpriteCommon *spriteCommon = nullptr; // スプライト共通描画設定
+	SpriteBatch *spriteBatch = nullptr; // スプライトのインスタンス描画バッチ
+	JobSystem *jobSystem = nullptr; // 並列処理用のジョブスケジューラ（どのスレッドからでも使える）
 	std::unique_ptr<MultiLogger> multiLogger;
 };
 
@@ -22,4 +26,5 @@ struct EngineContext {
 /// </summary>
 struct RenderContext {
 	ID3D12GraphicsCommandList *commandList = nullptr; // コマンドリスト
+	float interpolationAlpha = 1.0f; // 固定ステップ間の補間係数（0: 前回ステップ, 1: 最新ステップ）
 };
@@ -0,0 +1,51 @@
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void FixedTimestep::Initialize(double stepHz, uint32_t maxSubsteps, double maxFrameSeconds) {
+    assert(maxFrameSeconds > 0.0);
+    SetStepHz(stepHz);
+    SetMaxSubsteps(maxSubsteps);
+    maxFrameSeconds_ = maxFrameSeconds;
+    accumulator_ = 0.0;
+    totalSteps_ = 0;
+    droppedSeconds_ = 0.0;
+}
+
+void FixedTimestep::SetStepHz(double stepHz) {
+    assert(stepHz > 0.0);
+    stepSeconds_ = 1.0 / stepHz;
+}
+
+void FixedTimestep::SetMaxSubsteps(uint32_t maxSubsteps) {
+    assert(maxSubsteps > 0);
+    maxSubsteps_ = maxSubsteps;
+}
+
+uint32_t FixedTimestep::Advance(double frameSeconds) {
+    // 負の値（時計の巻き戻り）や長い停止（ブレークポイントなど）は丸める
+    frameSeconds = std::max(frameSeconds, 0.0);
+    if (frameSeconds > maxFrameSeconds_) {
+        droppedSeconds_ += frameSeconds - maxFrameSeconds_;
+        frameSeconds = maxFrameSeconds_;
+    }
+    accumulator_ += frameSeconds;
+
+    uint32_t steps = 0;
+    while (accumulator_ >= stepSeconds_ && steps < maxSubsteps_) {
+        accumulator_ -= stepSeconds_;
+        ++steps;
+    }
+
+    // 上限に達しても残っている分は追いつけないので捨て、補間係数を 1 未満に保つ
+    // （fmod は丸め誤差なく [0, stepSeconds_) に収まる）
+    if (accumulator_ >= stepSeconds_) {
+        const double keep = std::fmod(accumulator_, stepSeconds_);
+        droppedSeconds_ += accumulator_ - keep;
+        accumulator_ = keep;
+    }
+
+    totalSteps_ += steps;
+    return steps;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// 固定ステップ更新のためのアキュムレータ。<br/>
+/// フレームの経過時間をためて、固定刻みで何回シミュレーションを進めるかと、
+/// 描画用の補間係数（前回ステップから次ステップまでの割合）を求める。
+/// </summary>
+/// <remarks>
+/// 1 フレームの処理が重くなって追いつけない状態（spiral of death）を避けるため、
+/// 1 フレームのステップ数は maxSubsteps まで、1 フレームの経過時間は maxFrameSeconds までに制限し、
+/// 超えた分は捨てる（シミュレーションが実時間より遅れる）。
+/// </remarks>
+class FixedTimestep {
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="stepHz">1 秒あたりのステップ数。</param>
+    /// <param name="maxSubsteps">1 フレームで進める最大ステップ数。</param>
+    /// <param name="maxFrameSeconds">1 フレームとして受け付ける最大経過時間（秒）。</param>
+    void Initialize(double stepHz = 60.0, uint32_t maxSubsteps = 8, double maxFrameSeconds = 0.25);
+
+    /// <summary>
+    /// フレームの経過時間を加え、このフレームで進めるステップ数を返す。
+    /// </summary>
+    /// <param name="frameSeconds">前フレームからの経過時間（秒）。</param>
+    /// <returns>FixedUpdate を呼ぶ回数。</returns>
+    uint32_t Advance(double frameSeconds);
+
+    /// <summary>
+    /// 描画用の補間係数 [0, 1]。前回のステップの状態から次のステップの状態までの割合。
+    /// </summary>
+    float GetAlpha() const { return static_cast<float>(accumulator_ / stepSeconds_); }
+
+    /// <summary>1 ステップの秒数。</summary>
+    double GetStepSeconds() const { return stepSeconds_; }
+
+    /// <summary>1 秒あたりのステップ数を変更する（ためていた時間はそのまま）。</summary>
+    void SetStepHz(double stepHz);
+
+    /// <summary>1 フレームで進める最大ステップ数を変更する。</summary>
+    void SetMaxSubsteps(uint32_t maxSubsteps);
+
+    /// <summary>これまでに進めたステップ数。</summary>
+    uint64_t GetTotalSteps() const { return totalSteps_; }
+
+    /// <summary>追いつけずに捨てた時間の累計（秒）。</summary>
+    double GetDroppedSeconds() const { return droppedSeconds_; }
+
+    /// <summary>ためている時間を捨てる（シーン切替の直後など）。</summary>
+    void Reset() { accumulator_ = 0.0; }
+
+private:
+    double stepSeconds_ = 1.0 / 60.0;
+    uint32_t maxSubsteps_ = 8;
+    double maxFrameSeconds_ = 0.25;
+    double accumulator_ = 0.0;
+    uint64_t totalSteps_ = 0;
+    double droppedSeconds_ = 0.0;
+};
@@ -0,0 +1,176 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace {
+    // スピンに回す時間の下限と上限
+    constexpr uint64_t kMinSpinMarginNs = 200000;   // 0.2ms
+    constexpr uint64_t kMaxSpinMarginNs = 4000000;  // 4ms
+    // 最初はスリープの精度が分からないので大きめに取る
+    constexpr uint64_t kInitialSpinMarginNs = 2000000;
+}
+
+// ===============================
+// SystemFrameClock
+// ===============================
+
+SystemFrameClock::SystemFrameClock() {
+#if defined(_WIN32)
+    // 高分解能タイマー（Windows 10 1803 以降）。使えなければ通常のタイマーにする
+    timer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer_) {
+        timer_ = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+#endif
+}
+
+SystemFrameClock::~SystemFrameClock() {
+#if defined(_WIN32)
+    if (timer_) {
+        CloseHandle(timer_);
+    }
+#endif
+}
+
+uint64_t SystemFrameClock::NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void SystemFrameClock::SleepNs(uint64_t ns) {
+#if defined(_WIN32)
+    if (timer_) {
+        LARGE_INTEGER due{};
+        due.QuadPart = -static_cast<LONGLONG>(ns / 100); // 負値は相対時間（100ns 単位）
+        if (SetWaitableTimer(timer_, &due, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(timer_, INFINITE);
+            return;
+        }
+    }
+#endif
+    std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+}
+
+// ===============================
+// FramePacer
+// ===============================
+
+void FramePacer::Initialize(IFrameClock *clock) {
+    if (clock) {
+        clock_ = clock;
+    } else {
+        ownedClock_ = std::make_unique<SystemFrameClock>();
+        clock_ = ownedClock_.get();
+    }
+    spinMarginNs_ = kInitialSpinMarginNs;
+    deadlineNs_ = 0;
+    lastFrameNs_ = clock_->NowNs();
+    frameHead_ = 0;
+    frameCount_ = 0;
+}
+
+void FramePacer::SetMode(Mode mode) {
+    mode_ = mode;
+    deadlineNs_ = 0; // 次の Wait で締め切りを取り直す
+}
+
+void FramePacer::SetTargetFps(double fps) {
+    assert(fps > 0.0);
+    targetFps_ = fps;
+    periodNs_ = static_cast<uint64_t>(1000000000.0 / fps);
+    deadlineNs_ = 0;
+}
+
+void FramePacer::Wait() {
+    assert(clock_);
+    if (mode_ == Mode::FixedRate) {
+        if (deadlineNs_ == 0) {
+            deadlineNs_ = lastFrameNs_ + periodNs_;
+        }
+        WaitUntil(deadlineNs_);
+
+        // 締め切りは前回の締め切りから積み上げる（起床の遅れを次フレームに持ち越さない）。
+        // 1 フレーム以上遅れていたら、取り返そうと連続で走らないよう今から数え直す
+        const uint64_t now = clock_->NowNs();
+        deadlineNs_ += periodNs_;
+        if (now >= deadlineNs_) {
+            deadlineNs_ = now + periodNs_;
+        }
+        RecordFrame(now);
+        return;
+    }
+
+    RecordFrame(clock_->NowNs());
+}
+
+void FramePacer::WaitUntil(uint64_t deadlineNs) {
+    uint64_t now = clock_->NowNs();
+
+    // 寝過ごし量を見込んで手前で起き、
+    while (now < deadlineNs && deadlineNs - now > spinMarginNs_) {
+        const uint64_t request = deadlineNs - now - spinMarginNs_;
+        clock_->SleepNs(request);
+        const uint64_t after = clock_->NowNs();
+        const uint64_t overslept = after - now > request ? after - now - request : 0;
+
+        // 寝過ごしが見込みを超えたらすぐ広げ、下回ったらゆっくり縮める
+        if (overslept > spinMarginNs_) {
+            spinMarginNs_ = overslept;
+        } else {
+            spinMarginNs_ -= (spinMarginNs_ - overslept) / 16;
+        }
+        spinMarginNs_ = std::clamp(spinMarginNs_, kMinSpinMarginNs, kMaxSpinMarginNs);
+        now = after;
+    }
+
+    // 残りはスピンで正確に合わせる
+    while (now < deadlineNs) {
+        now = clock_->NowNs();
+    }
+}
+
+void FramePacer::RecordFrame(uint64_t nowNs) {
+    frameTimes_[frameHead_] = nowNs - lastFrameNs_;
+    frameHead_ = (frameHead_ + 1) % kStatsWindow;
+    frameCount_ = (std::min)(frameCount_ + 1, kStatsWindow);
+    lastFrameNs_ = nowNs;
+}
+
+FramePacer::Stats FramePacer::GetStats() const {
+    Stats stats;
+    if (frameCount_ == 0) return stats;
+
+    std::vector<uint64_t> sorted(frameTimes_.begin(), frameTimes_.begin() + frameCount_);
+    std::sort(sorted.begin(), sorted.end());
+
+    constexpr double kNsToMs = 1.0 / 1000000.0;
+    auto percentile = [&](double p) {
+        const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted[(std::max)(rank, size_t{1}) - 1] * kNsToMs;
+    };
+
+    double sum = 0.0;
+    for (uint64_t t : sorted) sum += static_cast<double>(t);
+    const double mean = sum / sorted.size();
+    double variance = 0.0;
+    for (uint64_t t : sorted) {
+        const double d = static_cast<double>(t) - mean;
+        variance += d * d;
+    }
+    variance /= sorted.size();
+
+    stats.p50Ms = percentile(0.50);
+    stats.p99Ms = percentile(0.99);
+    stats.minMs = sorted.front() * kNsToMs;
+    stats.maxMs = sorted.back() * kNsToMs;
+    stats.meanMs = mean * kNsToMs;
+    stats.stdDevMs = std::sqrt(variance) * kNsToMs;
+    stats.samples = frameCount_;
+    return stats;
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// FramePacer が使う時計。テストや検証では差し替えて時間を進められる。
+/// </summary>
+class IFrameClock {
+public:
+    virtual ~IFrameClock() = default;
+
+    /// <summary>単調増加する現在時刻（ナノ秒）。</summary>
+    virtual uint64_t NowNs() = 0;
+
+    /// <summary>おおよそ指定時間だけスレッドを眠らせる（多少寝過ごしてよい）。</summary>
+    virtual void SleepNs(uint64_t ns) = 0;
+};
+
+/// <summary>
+/// steady_clock と OS のスリープを使う既定の時計。<br/>
+/// Windows では高分解能の待機可能タイマーを使い、1ms 未満の精度で眠る。
+/// </summary>
+class SystemFrameClock : public IFrameClock {
+public:
+    SystemFrameClock();
+    ~SystemFrameClock() override;
+
+    SystemFrameClock(const SystemFrameClock &) = delete;
+    SystemFrameClock &operator=(const SystemFrameClock &) = delete;
+
+    uint64_t NowNs() override;
+    void SleepNs(uint64_t ns) override;
+
+private:
+    void *timer_ = nullptr; // HANDLE（Windows のみ）
+};
+
+/// <summary>
+/// フレームの間隔を整えるペーサー。<br/>
+/// 固定レートでは「次の締め切りの少し手前までスリープ → 残りはスピン」で待ち、
+/// スリープの寝過ごし量を学習してスピンに回す時間を調整する。
+/// </summary>
+/// <remarks>
+/// - Uncapped: 待たない（Present も垂直同期なし）。<br/>
+/// - FixedRate: 目標 FPS の締め切りまで待つ（Present は垂直同期なし）。<br/>
+/// - VSync: 待たない（Present の垂直同期に任せる）。<br/>
+/// どのモードでもフレーム時間を記録し、p50 / p99 などの統計を出せる。
+/// 時計は IFrameClock で注入できるので、ペーシングのロジックは D3D12 なしで動く。
+/// </remarks>
+class FramePacer {
+public:
+    /// <summary>ペーシングの方式。</summary>
+    enum class Mode {
+        Uncapped,
+        FixedRate,
+        VSync,
+    };
+
+    /// <summary>直近のフレーム時間の統計（ミリ秒）。</summary>
+    struct Stats {
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        double meanMs = 0.0;
+        double stdDevMs = 0.0;  ///< ジッタ（標準偏差）
+        uint32_t samples = 0;
+    };
+
+    /// <summary>統計に使うフレーム数。</summary>
+    static constexpr uint32_t kStatsWindow = 240;
+
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="clock">使う時計（nullptr なら SystemFrameClock）。FramePacer より長く生存すること。</param>
+    void Initialize(IFrameClock *clock = nullptr);
+
+    /// <summary>ペーシングの方式を設定する。</summary>
+    void SetMode(Mode mode);
+
+    /// <summary>ペーシングの方式を取得する。</summary>
+    Mode GetMode() const { return mode_; }
+
+    /// <summary>FixedRate の目標 FPS を設定する。</summary>
+    void SetTargetFps(double fps);
+
+    /// <summary>FixedRate の目標 FPS を取得する。</summary>
+    double GetTargetFps() const { return targetFps_; }
+
+    /// <summary>
+    /// Present に渡す同期間隔（VSync なら 1、それ以外は 0）。
+    /// </summary>
+    uint32_t GetSyncInterval() const { return mode_ == Mode::VSync ? 1u : 0u; }
+
+    /// <summary>
+    /// フレームの終わり（Present の後）に呼ぶ。必要なら次の締め切りまで待ち、フレーム時間を記録する。
+    /// </summary>
+    void Wait();
+
+    /// <summary>直近 kStatsWindow フレームの統計を計算する。</summary>
+    Stats GetStats() const;
+
+    /// <summary>スリープの寝過ごし量の推定（ナノ秒）。この分はスピンで待つ。</summary>
+    uint64_t GetSpinMarginNs() const { return spinMarginNs_; }
+
+private:
+    /// <summary>締め切りまで sleep + spin で待つ。</summary>
+    void WaitUntil(uint64_t deadlineNs);
+
+    /// <summary>フレーム時間を記録する。</summary>
+    void RecordFrame(uint64_t nowNs);
+
+private:
+    IFrameClock *clock_ = nullptr;
+    std::unique_ptr<SystemFrameClock> ownedClock_;
+
+    Mode mode_ = Mode::VSync;
+    double targetFps_ = 60.0;
+    uint64_t periodNs_ = 1000000000ull / 60;
+
+    uint64_t deadlineNs_ = 0;     // 次フレームの締め切り（FixedRate）
+    uint64_t lastFrameNs_ = 0;    // 前回 Wait を抜けた時刻
+    uint64_t spinMarginNs_ = 0;   // スリープを切り上げる余裕
+
+    std::vector<uint64_t> frameTimes_ = std::vector<uint64_t>(kStatsWindow); // リング
+    uint32_t frameHead_ = 0;
+    uint32_t frameCount_ = 0;
+};
@@ -0,0 +1,257 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <cassert>
+#include <string>
+
+namespace {
+
+    thread_local const void *tlsOwner = nullptr; // このスレッドを登録した JobSystem
+    thread_local void *tlsState = nullptr;       // JobSystem::ThreadState*
+    thread_local uint32_t tlsStealSeed = 0x9E3779B9u; // キューを持たないスレッドの乱数
+
+    // ジョブの記憶域を一度に確保する数
+    constexpr size_t kJobBlockSize = 256;
+
+    // 眠る前に仕事を探し直す回数
+    constexpr uint32_t kSpinBeforeSleep = 64;
+
+    inline uint32_t NextRandom(uint32_t &state) {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+} // namespace
+
+JobSystem::~JobSystem() {
+    Finalize();
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+    assert(threads_.empty() && "already initialized");
+    stopping_.store(false);
+
+    threads_.reserve(workerCount + 1);
+    for (uint32_t i = 0; i <= workerCount; ++i) {
+        auto state = std::make_unique<ThreadState>();
+        state->index = i;
+        state->stealSeed = 0x9E3779B9u * (i + 1);
+        threads_.push_back(std::move(state));
+    }
+
+    // 呼び出し元をメインスレッド（キュー 0）として登録する
+    tlsOwner = this;
+    tlsState = threads_[0].get();
+
+    workers_.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerMain, this, i);
+    }
+}
+
+void JobSystem::Finalize() {
+    if (threads_.empty()) return;
+    assert(GetThreadState() == threads_[0].get() && "Finalize must be called from the initializing thread");
+
+    // 残っている仕事は手伝って片付ける
+    while (Job *job = FindJob(threads_[0].get())) {
+        Execute(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_.store(true);
+    }
+    sleepCv_.notify_all();
+    for (auto &t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+
+    tlsOwner = nullptr;
+    tlsState = nullptr;
+    threads_.clear();
+    sharedJobs_.clear();
+    sharedCount_.store(0);
+    sharedFreeJobs_ = nullptr;
+    jobBlocks_.clear();
+}
+
+void JobSystem::Wait(JobCounter &counter) {
+    ThreadState *self = GetThreadState();
+    while (!counter.IsDone()) {
+        if (Job *job = FindJob(self)) {
+            Execute(job);
+        } else {
+            // 残りは他のスレッドが実行中
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t JobSystem::DefaultWorkerCount() {
+    const uint32_t hw = std::thread::hardware_concurrency();
+    // メインスレッドの分を 1 つ空ける
+    return (std::max)(1u, hw > 1 ? hw - 1 : 1u);
+}
+
+JobSystem::ThreadState *JobSystem::GetThreadState() const {
+    return tlsOwner == this ? static_cast<ThreadState *>(tlsState) : nullptr;
+}
+
+JobSystem::Job *JobSystem::AllocateJob() {
+    ThreadState *self = GetThreadState();
+    if (self) {
+        if (!self->freeJobs) {
+            self->freeJobs = self->returnedJobs.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (Job *job = self->freeJobs) {
+            self->freeJobs = job->nextFree;
+            return job;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    if (!self && sharedFreeJobs_) {
+        Job *job = sharedFreeJobs_;
+        sharedFreeJobs_ = job->nextFree;
+        return job;
+    }
+
+    // 足りなければブロックごと確保し、先頭以外を確保したスレッドの空きリストへ
+    auto block = std::make_unique<Job[]>(kJobBlockSize);
+    Job *&freeList = self ? self->freeJobs : sharedFreeJobs_;
+    for (size_t i = 0; i < kJobBlockSize; ++i) {
+        block[i].owner = self;
+    }
+    for (size_t i = kJobBlockSize - 1; i > 0; --i) {
+        block[i].nextFree = freeList;
+        freeList = &block[i];
+    }
+    Job *job = &block[0];
+    jobBlocks_.push_back(std::move(block));
+    return job;
+}
+
+void JobSystem::FreeJob(Job *job) {
+    ThreadState *owner = job->owner;
+    if (!owner) {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        job->nextFree = sharedFreeJobs_;
+        sharedFreeJobs_ = job;
+        return;
+    }
+    if (owner == GetThreadState()) {
+        job->nextFree = owner->freeJobs;
+        owner->freeJobs = job;
+        return;
+    }
+
+    // 確保したスレッドへ返す（取り出しは exchange で一括なので ABA は起きない）
+    Job *head = owner->returnedJobs.load(std::memory_order_relaxed);
+    do {
+        job->nextFree = head;
+    } while (!owner->returnedJobs.compare_exchange_weak(head, job, std::memory_order_release,
+        std::memory_order_relaxed));
+}
+
+void JobSystem::Enqueue(Job *job) {
+    ThreadState *self = GetThreadState();
+    if (self) {
+        if (!self->deque.Push(job)) {
+            Execute(job); // 溢れた分はその場で処理する
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(sharedMutex_);
+        sharedJobs_.push_back(job);
+        sharedCount_.fetch_add(1, std::memory_order_release);
+    }
+    WakeWorker();
+}
+
+JobSystem::Job *JobSystem::FindJob(ThreadState *self) {
+    Job *job = nullptr;
+    if (self && self->deque.Pop(job)) {
+        return job;
+    }
+
+    if (sharedCount_.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(sharedMutex_);
+        if (!sharedJobs_.empty()) {
+            job = sharedJobs_.front();
+            sharedJobs_.pop_front();
+            sharedCount_.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // 他のキューから盗む（偏らないよう開始位置を乱数で決める）
+    const size_t count = threads_.size();
+    const size_t start = NextRandom(self ? self->stealSeed : tlsStealSeed) % count;
+    for (size_t i = 0; i < count; ++i) {
+        ThreadState *victim = threads_[(start + i) % count].get();
+        if (victim != self && victim->deque.Steal(job)) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::Execute(Job *job) {
+    JobCounter *counter = job->counter;
+    job->invoke(*job);
+    FreeJob(job);
+    // 0 になった時点で待っている側がカウンタを破棄しうるので、これ以降は触れない
+    counter->pending_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::WakeWorker() {
+    workEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepingCount_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        sleepCv_.notify_one();
+    }
+}
+
+void JobSystem::WorkerMain(uint32_t index) {
+    ThreadState *self = threads_[index].get();
+    tlsOwner = this;
+    tlsState = self;
+    const std::string name = "Worker " + std::to_string(index);
+    Profiler::Get().SetThreadName(name.c_str());
+
+    for (;;) {
+        Job *job = nullptr;
+        for (uint32_t spin = 0; spin < kSpinBeforeSleep && !job; ++spin) {
+            job = FindJob(self);
+            if (!job) std::this_thread::yield();
+        }
+        if (job) {
+            Execute(job);
+            continue;
+        }
+
+        // 眠る前の世代を読んでから探し直す。以降に積まれた仕事は世代の変化で必ず気付ける
+        const uint64_t epoch = workEpoch_.load(std::memory_order_seq_cst);
+        if ((job = FindJob(self)) != nullptr) {
+            Execute(job);
+            continue;
+        }
+        if (stopping_.load()) {
+            break; // 積まれた仕事はすべて片付いている
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepingCount_.fetch_add(1, std::memory_order_seq_cst);
+        sleepCv_.wait(lock, [&] {
+            return workEpoch_.load(std::memory_order_seq_cst) != epoch || stopping_.load();
+        });
+        sleepingCount_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    tlsOwner = nullptr;
+    tlsState = nullptr;
+}
@@ -0,0 +1,240 @@
+#pragma once
+#include "WorkStealingDeque.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// ジョブの完了を待つためのカウンタ。<br/>
+/// Run に渡すと未完了のジョブ数が増え、ジョブが終わると減る。
+/// ジョブの中から同じカウンタで子ジョブを積めば、親は子がすべて終わるまで完了しない。
+/// </summary>
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+    /// <summary>結び付いたジョブがすべて終わったか。</summary>
+    bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> pending_{0};
+};
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // alignas によるパディング（ThreadState が持つ WorkStealingDeque）
+#endif
+
+/// <summary>
+/// ワークスティーリング方式のジョブスケジューラ。<br/>
+/// ワーカーごとに Chase-Lev の両端キューを持ち、自分のキューは LIFO で処理し、
+/// 空になったら他のワーカーのキューから FIFO で盗む。
+/// </summary>
+/// <remarks>
+/// - Initialize を呼んだスレッド（メインスレッド）もキューを 1 つ持ち、Wait の間はジョブを手伝う。<br/>
+/// - それ以外のスレッド（SimulationThread など）から積んだジョブは共有キューに入り、
+///   そのスレッドの Wait も同じくジョブを手伝う。<br/>
+/// - ジョブの呼び出し可能オブジェクトは kJobStorageSize バイトまでを確保なしで保持する。
+///   大きな状態は参照でキャプチャすること。
+/// </remarks>
+class JobSystem {
+public:
+    /// <summary>ジョブ 1 つに埋め込める呼び出し可能オブジェクトの最大サイズ。</summary>
+    static constexpr size_t kJobStorageSize = 64;
+
+    /// <summary>1 スレッドの両端キューの容量（溢れた分はその場で実行する）。</summary>
+    static constexpr size_t kDequeCapacity = 4096;
+
+public:
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /// <summary>
+    /// ワーカーを起動する。呼んだスレッドはメインスレッドとして登録される。
+    /// </summary>
+    /// <param name="workerCount">ワーカースレッド数（0 ならすべて呼び出し元で実行する）。</param>
+    void Initialize(uint32_t workerCount);
+
+    /// <summary>
+    /// ワーカーを停止する（積まれたジョブはすべて終えてから止まる）。
+    /// </summary>
+    void Finalize();
+
+    /// <summary>
+    /// ジョブを積む。
+    /// </summary>
+    /// <param name="counter">完了を待つカウンタ（ジョブが終わるまで生存すること）。</param>
+    /// <param name="function">引数なしで呼べるオブジェクト（他のスレッドで実行される）。</param>
+    template <typename F>
+    void Run(JobCounter &counter, F &&function);
+
+    /// <summary>
+    /// カウンタが 0 になるまで、積まれたジョブを手伝いながら待つ。
+    /// </summary>
+    void Wait(JobCounter &counter);
+
+    /// <summary>
+    /// [0, count) を grainSize 以下の区間に分けて並列に処理し、すべて終わるまで待つ。
+    /// </summary>
+    /// <param name="count">要素数。</param>
+    /// <param name="grainSize">1 ジョブで処理する最大の要素数（小さすぎると分割のコストが勝る）。</param>
+    /// <param name="body">body(begin, end)。複数のスレッドから同時に呼ばれる。</param>
+    /// <remarks>区間は二分割を繰り返して積むので、暇なワーカーが大きな塊から盗める。</remarks>
+    template <typename F>
+    void ParallelFor(size_t count, size_t grainSize, F &&body);
+
+    /// <summary>ワーカースレッド数（メインスレッドを含まない）。</summary>
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    /// <summary>
+    /// 既定のワーカー数（論理コア数 - 1、最低 1）を返す。
+    /// </summary>
+    static uint32_t DefaultWorkerCount();
+
+private:
+    struct ThreadState;
+
+    /// <summary>
+    /// 積まれた仕事 1 つ。呼び出し可能オブジェクトを storage に埋め込む。
+    /// </summary>
+    struct Job {
+        void (*invoke)(Job &) = nullptr; // 実行して storage のオブジェクトを破棄する
+        JobCounter *counter = nullptr;
+        ThreadState *owner = nullptr;    // 確保したスレッド（nullptr は共有の記憶域）
+        Job *nextFree = nullptr;
+        alignas(std::max_align_t) unsigned char storage[kJobStorageSize];
+    };
+
+    /// <summary>
+    /// キューを持つスレッド（メインスレッドとワーカー）の状態。
+    /// </summary>
+    struct ThreadState {
+        ThreadState() : deque(kDequeCapacity) {}
+        WorkStealingDeque<Job *> deque;
+        Job *freeJobs = nullptr;                  // 所有スレッドだけが触る
+        std::atomic<Job *> returnedJobs{nullptr}; // 他のスレッドが実行し終えて返したもの
+        uint32_t index = 0;
+        uint32_t stealSeed = 0;
+    };
+
+    /// <summary>呼び出しスレッドの状態（キューを持たないスレッドなら nullptr）。</summary>
+    ThreadState *GetThreadState() const;
+
+    /// <summary>ジョブを 1 つ確保する。</summary>
+    Job *AllocateJob();
+
+    /// <summary>実行し終えたジョブを戻す。</summary>
+    void FreeJob(Job *job);
+
+    /// <summary>確保したジョブを積む（積めなければその場で実行する）。</summary>
+    void Enqueue(Job *job);
+
+    /// <summary>実行できるジョブを探す（自分のキュー → 共有キュー → 他のキュー）。</summary>
+    Job *FindJob(ThreadState *self);
+
+    /// <summary>ジョブを実行してカウンタを減らす。</summary>
+    void Execute(Job *job);
+
+    /// <summary>ワーカースレッドの本体。</summary>
+    void WorkerMain(uint32_t index);
+
+    /// <summary>眠っているワーカーを 1 つ起こす。</summary>
+    void WakeWorker();
+
+    /// <summary>ParallelFor の区間を二分割しながら積む。</summary>
+    template <typename F>
+    void SpawnRange(JobCounter &counter, size_t begin, size_t end, size_t grainSize, F *body);
+
+private:
+    std::vector<std::unique_ptr<ThreadState>> threads_; // [0] はメインスレッド
+    std::vector<std::thread> workers_;
+
+    // キューを持たないスレッドから積まれたジョブ
+    std::mutex sharedMutex_;
+    std::deque<Job *> sharedJobs_;
+    std::atomic<size_t> sharedCount_{0};
+
+    // ジョブの記憶域（ブロック単位で確保し、終了まで解放しない）
+    std::mutex poolMutex_;
+    std::vector<std::unique_ptr<Job[]>> jobBlocks_;
+    Job *sharedFreeJobs_ = nullptr; // キューを持たないスレッド用（poolMutex_ で保護）
+
+    // 眠っているワーカーの起床
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<uint64_t> workEpoch_{0}; // 仕事が積まれるたびに進む
+    std::atomic<uint32_t> sleepingCount_{0};
+    std::atomic<bool> stopping_{false};
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+// ===============================
+// テンプレート実装
+// ===============================
+
+template <typename F>
+void JobSystem::Run(JobCounter &counter, F &&function) {
+    using Fn = std::decay_t<F>;
+    static_assert(sizeof(Fn) <= kJobStorageSize, "job capture is too large; capture by reference");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "job capture is over-aligned");
+
+    Job *job = AllocateJob();
+    ::new (static_cast<void *>(job->storage)) Fn(std::forward<F>(function));
+    job->invoke = [](Job &j) {
+        Fn &fn = *std::launder(reinterpret_cast<Fn *>(j.storage));
+        fn();
+        fn.~Fn();
+    };
+    job->counter = &counter;
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+    Enqueue(job);
+}
+
+template <typename F>
+void JobSystem::ParallelFor(size_t count, size_t grainSize, F &&body) {
+    if (count == 0) return;
+    grainSize = (std::max)(grainSize, static_cast<size_t>(1));
+
+    // 分割するほどの量がなければ呼び出し元でそのまま処理する
+    if (count <= grainSize || workers_.empty()) {
+        body(static_cast<size_t>(0), count);
+        return;
+    }
+
+    JobCounter counter;
+    SpawnRange(counter, 0, count, grainSize, &body);
+    Wait(counter);
+}
+
+template <typename F>
+void JobSystem::SpawnRange(JobCounter &counter, size_t begin, size_t end, size_t grainSize, F *body) {
+    Run(counter, [this, &counter, begin, end, grainSize, body] {
+        // 後半を積んで前半を自分で続ける（積んだ後半は他のワーカーが盗める）
+        size_t last = end;
+        while (last - begin > grainSize) {
+            const size_t mid = begin + (last - begin) / 2;
+            SpawnRange(counter, mid, last, grainSize, body);
+            last = mid;
+        }
+        (*body)(begin, last);
+    });
+}
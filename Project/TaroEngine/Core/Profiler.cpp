@@ -0,0 +1,299 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+    const std::chrono::steady_clock::time_point kEpoch = std::chrono::steady_clock::now();
+
+    thread_local void *tlsBuffer = nullptr; // Profiler::ThreadBuffer*
+
+    // JSON 文字列として書けるようにエスケープする
+    void AppendJsonString(std::string &out, const char *s) {
+        out += '"';
+        for (; s && *s; ++s) {
+            const char c = *s;
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out += ' ';
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    // ナノ秒を Chrome trace のマイクロ秒（小数 3 桁）で書く
+    void AppendMicros(std::string &out, uint64_t ns) {
+        out += std::to_string(ns / 1000);
+        out += '.';
+        const uint64_t frac = ns % 1000;
+        out += static_cast<char>('0' + frac / 100);
+        out += static_cast<char>('0' + frac / 10 % 10);
+        out += static_cast<char>('0' + frac % 10);
+    }
+
+    // スロットは所有スレッドが書き、EndFrame が同時に読みうるので、フィールドごとに atomic_ref で触る
+    // （x86 / ARM ともに relaxed は通常のロード・ストアになる）
+    void StoreEvent(Profiler::Event &dst, const Profiler::Event &src) {
+        std::atomic_ref(dst.name).store(src.name, std::memory_order_relaxed);
+        std::atomic_ref(dst.startNs).store(src.startNs, std::memory_order_relaxed);
+        std::atomic_ref(dst.endNs).store(src.endNs, std::memory_order_relaxed);
+        std::atomic_ref(dst.depth).store(src.depth, std::memory_order_relaxed);
+    }
+
+    Profiler::Event LoadEvent(Profiler::Event &src) {
+        Profiler::Event e;
+        e.name = std::atomic_ref(src.name).load(std::memory_order_relaxed);
+        e.startNs = std::atomic_ref(src.startNs).load(std::memory_order_relaxed);
+        e.endNs = std::atomic_ref(src.endNs).load(std::memory_order_relaxed);
+        e.depth = std::atomic_ref(src.depth).load(std::memory_order_relaxed);
+        return e;
+    }
+
+} // namespace
+
+Profiler &Profiler::Get() {
+    static Profiler instance;
+    return instance;
+}
+
+uint64_t Profiler::NowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - kEpoch).count());
+}
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer() {
+    if (tlsBuffer) {
+        return *static_cast<ThreadBuffer *>(tlsBuffer);
+    }
+
+    // 初回だけ登録する。バッファはスレッド終了後も Profiler が持ち続ける（回収途中で消えないように）
+    Profiler &self = Get();
+    auto buffer = std::make_unique<ThreadBuffer>();
+    ThreadBuffer *raw = buffer.get();
+    {
+        std::lock_guard<std::mutex> lock(self.registryMutex_);
+        raw->threadId = static_cast<uint32_t>(self.buffers_.size());
+        raw->name = "Thread " + std::to_string(raw->threadId);
+        self.buffers_.push_back(std::move(buffer));
+    }
+    tlsBuffer = raw;
+    return *raw;
+}
+
+void Profiler::SetThreadName(const char *name) {
+    ThreadBuffer &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer.name = name ? name : "";
+}
+
+uint32_t Profiler::EnterZone() {
+    return GetThreadBuffer().depth++;
+}
+
+void Profiler::LeaveZone(const char *name, uint64_t startNs, uint32_t depth) {
+    ThreadBuffer &buffer = GetThreadBuffer();
+    buffer.depth = depth;
+
+    // 所有スレッドだけが書くので、位置を進めるのは store で足りる。
+    // 書き込みの前の release フェンスで、このスロットの値を読んだ EndFrame には
+    // 書き込み位置が index まで進んでいることが見える（読み直しで破れたゾーンと判定できる）
+    const uint64_t index = buffer.writeIndex.load(std::memory_order_relaxed);
+    Event e;
+    e.name = name;
+    e.startNs = startNs;
+    e.endNs = NowNs();
+    e.depth = depth;
+    std::atomic_thread_fence(std::memory_order_release);
+    StoreEvent(buffer.events[index % kThreadBufferCapacity], e);
+    buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::BeginFrame() {
+    frameStartNs_ = NowNs();
+}
+
+void Profiler::EndFrame() {
+    // 一時停止中は履歴を残さず読み捨てる（トレース記録中は止めない）
+    if (paused_ && !capturing_) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (auto &buffer : buffers_) {
+            buffer->readIndex = buffer->writeIndex.load(std::memory_order_acquire);
+        }
+        ++frameIndex_;
+        return;
+    }
+
+    Frame &frame = history_[historyHead_];
+    frame.index = frameIndex_++;
+    frame.startNs = frameStartNs_;
+    frame.endNs = NowNs();
+    frame.droppedEvents = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        frame.threads.resize(buffers_.size());
+
+        for (size_t t = 0; t < buffers_.size(); ++t) {
+            ThreadBuffer &buffer = *buffers_[t];
+            ThreadFrame &out = frame.threads[t];
+            out.threadId = buffer.threadId;
+            out.threadName = buffer.name;
+            out.events.clear();
+
+            // 書き手は end 番目をいま書いているかもしれず、そのスロットは end - capacity 番目と同じ。
+            // 確実に残っているのは end の手前 capacity - 1 個まで
+            uint64_t begin = buffer.readIndex;
+            const uint64_t end = buffer.writeIndex.load(std::memory_order_acquire);
+            if (end - begin >= kThreadBufferCapacity) {
+                const uint64_t oldest = end - kThreadBufferCapacity + 1;
+                frame.droppedEvents += oldest - begin;
+                begin = oldest;
+            }
+            for (uint64_t i = begin; i < end; ++i) {
+                out.events.push_back(LoadEvent(buffer.events[i % kThreadBufferCapacity]));
+            }
+
+            // 先にコピーしてから書き込み位置を読み直す（seqlock と同じ手順）。
+            // コピー中に書き手が after 番目まで進んでいれば、after - capacity 番目以前のスロットは
+            // 上書き中か上書き済みで、途中まで書き換わったゾーンを読んだかもしれない。それらは捨てる
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t after = buffer.writeIndex.load(std::memory_order_relaxed);
+            if (after - begin >= kThreadBufferCapacity) {
+                const uint64_t overwritten = (std::min)(after - begin - kThreadBufferCapacity + 1, end - begin);
+                out.events.erase(out.events.begin(), out.events.begin() + static_cast<ptrdiff_t>(overwritten));
+                frame.droppedEvents += overwritten;
+            }
+            buffer.readIndex = end;
+
+            // 記録は終了順なので、表示・集計用に開始順（同時刻なら浅い順）に並べ替える
+            std::sort(out.events.begin(), out.events.end(), [](const Event &a, const Event &b) {
+                return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+            });
+        }
+    }
+
+    historyHead_ = (historyHead_ + 1) % kHistoryFrames;
+    historyCount_ = (std::min)(historyCount_ + 1, static_cast<size_t>(kHistoryFrames));
+
+    if (capturing_) {
+        AppendTrace(frame);
+        if (--traceFramesLeft_ == 0) {
+            EndTraceCapture();
+        }
+    }
+}
+
+const Profiler::Frame &Profiler::GetFrame(size_t ageFromNewest) const {
+    assert(ageFromNewest < historyCount_);
+    return history_[(historyHead_ + kHistoryFrames - 1 - ageFromNewest) % kHistoryFrames];
+}
+
+std::vector<Profiler::ZoneNode> Profiler::BuildHierarchy(const ThreadFrame &thread) {
+    std::vector<ZoneNode> nodes;
+    std::vector<int32_t> stack; // 深さごとの現在のノード
+
+    for (const Event &e : thread.events) {
+        if (stack.size() > e.depth) stack.resize(e.depth);
+        const int32_t parent = stack.empty() ? -1 : stack.back();
+
+        // 同じ親の下の同名ノードにまとめる（名前はリテラルだが翻訳単位ごとに別アドレスになりうる）
+        int32_t found = -1;
+        for (int32_t i = parent + 1; i < static_cast<int32_t>(nodes.size()); ++i) {
+            if (nodes[i].parent == parent && std::strcmp(nodes[i].name, e.name) == 0) {
+                found = i;
+                break;
+            }
+        }
+        if (found < 0) {
+            ZoneNode node;
+            node.name = e.name;
+            node.parent = parent;
+            node.depth = static_cast<uint32_t>(stack.size());
+            nodes.push_back(node);
+            found = static_cast<int32_t>(nodes.size()) - 1;
+        }
+
+        const uint64_t duration = e.endNs - e.startNs;
+        nodes[found].calls += 1;
+        nodes[found].totalNs += duration;
+        nodes[found].selfNs += duration;
+        if (parent >= 0) {
+            nodes[parent].selfNs -= (std::min)(nodes[parent].selfNs, duration);
+        }
+        stack.push_back(found);
+    }
+    return nodes;
+}
+
+bool Profiler::BeginTraceCapture(const std::filesystem::path &path, uint32_t maxFrames) {
+    if (capturing_ || maxFrames == 0) return false;
+    capturing_ = true;
+    tracePath_ = path;
+    traceFramesLeft_ = maxFrames;
+    traceJson_ = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    traceNamedThreads_.clear();
+    return true;
+}
+
+void Profiler::AppendTrace(const Frame &frame) {
+    auto appendEvent = [&](const char *name, uint64_t startNs, uint64_t endNs, uint32_t tid) {
+        traceJson_ += "{\"ph\":\"X\",\"pid\":1,\"tid\":";
+        traceJson_ += std::to_string(tid);
+        traceJson_ += ",\"name\":";
+        AppendJsonString(traceJson_, name);
+        traceJson_ += ",\"ts\":";
+        AppendMicros(traceJson_, startNs);
+        traceJson_ += ",\"dur\":";
+        AppendMicros(traceJson_, endNs - startNs);
+        traceJson_ += "},\n";
+    };
+
+    // フレーム全体をメインスレッド（ID 0 とは限らないので専用の行）に置く
+    constexpr uint32_t kFrameTrackId = 0xFFFF;
+    const std::string frameName = "Frame " + std::to_string(frame.index);
+    appendEvent(frameName.c_str(), frame.startNs, frame.endNs, kFrameTrackId);
+
+    for (const ThreadFrame &thread : frame.threads) {
+        if (std::find(traceNamedThreads_.begin(), traceNamedThreads_.end(), thread.threadId) == traceNamedThreads_.end()) {
+            traceJson_ += "{\"ph\":\"M\",\"pid\":1,\"tid\":";
+            traceJson_ += std::to_string(thread.threadId);
+            traceJson_ += ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            AppendJsonString(traceJson_, thread.threadName.c_str());
+            traceJson_ += "}},\n";
+            traceNamedThreads_.push_back(thread.threadId);
+        }
+        for (const Event &e : thread.events) {
+            appendEvent(e.name, e.startNs, e.endNs, thread.threadId);
+        }
+    }
+}
+
+bool Profiler::EndTraceCapture() {
+    if (!capturing_) return false;
+    capturing_ = false;
+
+    // 末尾の ",\n" を閉じ括弧に置き換える
+    if (traceJson_.size() >= 2 && traceJson_.compare(traceJson_.size() - 2, 2, ",\n") == 0) {
+        traceJson_.resize(traceJson_.size() - 2);
+    }
+    traceJson_ += "\n]}\n";
+
+    std::error_code ec;
+    if (tracePath_.has_parent_path()) {
+        std::filesystem::create_directories(tracePath_.parent_path(), ec);
+    }
+    std::ofstream ofs(tracePath_, std::ios::binary | std::ios::trunc);
+    if (ofs) {
+        ofs.write(traceJson_.data(), static_cast<std::streamsize>(traceJson_.size()));
+    }
+    traceJson_.clear();
+    traceJson_.shrink_to_fit();
+    return static_cast<bool>(ofs);
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ===============================
+// 計測マクロ
+// ===============================
+// TARO_PROFILE_ENABLED を 0 にすると計測コードごと消える。
+#if !defined(TARO_PROFILE_ENABLED)
+#define TARO_PROFILE_ENABLED 1
+#endif
+
+#define TARO_PROFILE_CONCAT_INNER(a, b) a##b
+#define TARO_PROFILE_CONCAT(a, b) TARO_PROFILE_CONCAT_INNER(a, b)
+
+#if TARO_PROFILE_ENABLED
+/// スコープの開始から終了までを 1 つのゾーンとして記録する（name は文字列リテラル）。
+#define TARO_PROFILE_SCOPE(name) ProfileScope TARO_PROFILE_CONCAT(taroProfileScope_, __LINE__)(name)
+/// 関数名をゾーン名にして記録する。
+#define TARO_PROFILE_FUNCTION() TARO_PROFILE_SCOPE(__FUNCTION__)
+#else
+#define TARO_PROFILE_SCOPE(name) ((void)0)
+#define TARO_PROFILE_FUNCTION() ((void)0)
+#endif
+
+/// <summary>
+/// フレーム単位の CPU プロファイラ。<br/>
+/// 各スレッドは自分専用のリングバッファにゾーン（名前・開始/終了ナノ秒・深さ）をロックなしで書き込み、
+/// EndFrame でメインスレッドがまとめて回収してフレームごとの履歴にする。
+/// </summary>
+/// <remarks>
+/// - 履歴は ProfilerView（ImGui）で表示する。<br/>
+/// - BeginTraceCapture で指定フレーム数を Chrome trace 形式の JSON に書き出せる
+///   （ImGui なしでも動くので、chrome://tracing や Perfetto で他の環境から解析できる）。<br/>
+/// - BeginFrame / EndFrame / 履歴の参照はメインスレッドから呼ぶこと。
+/// </remarks>
+class Profiler {
+public:
+    /// <summary>記録した 1 ゾーン。</summary>
+    struct Event {
+        const char *name = nullptr; ///< ゾーン名（文字列リテラル）
+        uint64_t startNs = 0;       ///< 開始時刻（プロファイラ起動からのナノ秒）
+        uint64_t endNs = 0;         ///< 終了時刻
+        uint32_t depth = 0;         ///< 入れ子の深さ（0 が最上位）
+    };
+
+    /// <summary>1 フレーム内の 1 スレッド分のゾーン（開始時刻順）。</summary>
+    struct ThreadFrame {
+        uint32_t threadId = 0;
+        std::string threadName;
+        std::vector<Event> events;
+    };
+
+    /// <summary>1 フレーム分の記録。</summary>
+    struct Frame {
+        uint64_t index = 0;
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+        uint64_t droppedEvents = 0; ///< バッファが溢れて失ったゾーン数（回収中に上書きされて捨てたものを含む）
+        std::vector<ThreadFrame> threads;
+    };
+
+    /// <summary>
+    /// 同じ呼び出し経路のゾーンを集計した階層の 1 ノード。
+    /// </summary>
+    struct ZoneNode {
+        const char *name = nullptr;
+        int32_t parent = -1;   ///< 親ノードのインデックス（-1 は最上位）
+        uint32_t depth = 0;
+        uint32_t calls = 0;
+        uint64_t totalNs = 0;  ///< 子を含む時間
+        uint64_t selfNs = 0;   ///< 子を除いた時間
+    };
+
+    /// <summary>1 スレッドのリングバッファのスロット数（1 フレームで回収できるのはこれより 1 つ少ない）。</summary>
+    static constexpr uint32_t kThreadBufferCapacity = 16384;
+
+    /// <summary>保持するフレーム履歴の数。</summary>
+    static constexpr uint32_t kHistoryFrames = 240;
+
+public:
+    /// <summary>プロセス全体で 1 つのインスタンスを取得する。</summary>
+    static Profiler &Get();
+
+    /// <summary>計測の有効/無効を切り替える（無効時のゾーンはほぼコストなし）。</summary>
+    void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    /// <summary>計測が有効か。</summary>
+    bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// 履歴の更新を一時停止する（ゾーンの回収は続けるので、再開時に古いゾーンが混ざらない）。
+    /// </summary>
+    void SetPaused(bool paused) { paused_ = paused; }
+
+    /// <summary>履歴の更新を一時停止しているか。</summary>
+    bool IsPaused() const { return paused_; }
+
+    /// <summary>呼び出したスレッドの表示名を設定する。</summary>
+    void SetThreadName(const char *name);
+
+    /// <summary>フレームの開始を記録する。</summary>
+    void BeginFrame();
+
+    /// <summary>
+    /// フレームの終了を記録し、全スレッドのゾーンを回収して履歴に追加する。
+    /// </summary>
+    void EndFrame();
+
+    /// <summary>履歴のフレーム数。</summary>
+    size_t GetFrameCount() const { return historyCount_; }
+
+    /// <summary>
+    /// 履歴のフレームを取得する。
+    /// </summary>
+    /// <param name="ageFromNewest">0 が最新。GetFrameCount() 未満。</param>
+    const Frame &GetFrame(size_t ageFromNewest) const;
+
+    /// <summary>
+    /// 1 スレッド分のゾーンを呼び出し経路ごとに集計する（子は親より後ろに並ぶ）。
+    /// </summary>
+    static std::vector<ZoneNode> BuildHierarchy(const ThreadFrame &thread);
+
+    /// <summary>
+    /// 次のフレームから maxFrames フレーム分を Chrome trace JSON に記録し始める。
+    /// </summary>
+    /// <param name="path">出力先。</param>
+    /// <param name="maxFrames">記録するフレーム数（到達したら自動で書き出す）。</param>
+    /// <returns>開始できたら true（記録中なら false）。</returns>
+    bool BeginTraceCapture(const std::filesystem::path &path, uint32_t maxFrames);
+
+    /// <summary>記録中のトレースを書き出して終了する。</summary>
+    /// <returns>書き出せたら true。</returns>
+    bool EndTraceCapture();
+
+    /// <summary>トレースを記録中か。</summary>
+    bool IsCapturing() const { return capturing_; }
+
+    /// <summary>プロファイラ起動からの経過ナノ秒。</summary>
+    static uint64_t NowNs();
+
+    // ===============================
+    // ProfileScope 用
+    // ===============================
+
+    /// <summary>ゾーンの開始（呼び出しスレッドの深さを 1 つ進める）。</summary>
+    /// <returns>ゾーンの深さ。</returns>
+    static uint32_t EnterZone();
+
+    /// <summary>ゾーンの終了を記録する。</summary>
+    static void LeaveZone(const char *name, uint64_t startNs, uint32_t depth);
+
+private:
+    /// <summary>
+    /// スレッド専用のリングバッファ。書き込みは所有スレッドだけ、読み出しは EndFrame だけ。
+    /// </summary>
+    struct ThreadBuffer {
+        Event events[kThreadBufferCapacity];
+        std::atomic<uint64_t> writeIndex{0};
+        uint64_t readIndex = 0;  // EndFrame だけが触る
+        uint32_t depth = 0;      // 所有スレッドだけが触る
+        uint32_t threadId = 0;
+        std::string name;        // registryMutex_ で保護
+    };
+
+    Profiler() = default;
+
+    /// <summary>呼び出しスレッドのバッファを取得する（初回は登録する）。</summary>
+    static ThreadBuffer &GetThreadBuffer();
+
+    /// <summary>フレームをトレースに追記する。</summary>
+    void AppendTrace(const Frame &frame);
+
+private:
+    std::atomic<bool> enabled_{true};
+    bool paused_ = false;
+
+    std::mutex registryMutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    // 履歴（メインスレッドだけが触る）
+    std::vector<Frame> history_ = std::vector<Frame>(kHistoryFrames);
+    size_t historyHead_ = 0;  // 次に書き込む位置
+    size_t historyCount_ = 0;
+    uint64_t frameIndex_ = 0;
+    uint64_t frameStartNs_ = 0;
+
+    // トレース記録
+    bool capturing_ = false;
+    std::filesystem::path tracePath_;
+    uint32_t traceFramesLeft_ = 0;
+    std::string traceJson_;
+    std::vector<uint32_t> traceNamedThreads_;
+};
+
+/// <summary>
+/// スコープの間を 1 ゾーンとして記録する RAII マーカー（TARO_PROFILE_SCOPE から使う）。
+/// </summary>
+class ProfileScope {
+public:
+    explicit ProfileScope(const char *name) : name_(name) {
+        if (Profiler::Get().IsEnabled()) {
+            depth_ = Profiler::EnterZone();
+            startNs_ = Profiler::NowNs();
+            active_ = true;
+        }
+    }
+
+    ~ProfileScope() {
+        if (active_) {
+            Profiler::LeaveZone(name_, startNs_, depth_);
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *name_;
+    uint64_t startNs_ = 0;
+    uint32_t depth_ = 0;
+    bool active_ = false;
+};
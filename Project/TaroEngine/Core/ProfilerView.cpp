@@ -0,0 +1,302 @@
+#include "ProfilerView.h"
+#include "FramePacer.h"
+#include "GpuProfiler.h"
+#include "imgui/imgui.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr float kNsToMs = 1.0f / 1000000.0f;
+
+    // ゾーン名から色を決める（同じ名前は毎フレーム同じ色になる）
+    ImU32 ZoneColor(const char *name) {
+        uint32_t h = 2166136261u;
+        for (const char *p = name; p && *p; ++p) {
+            h = (h ^ static_cast<uint8_t>(*p)) * 16777619u;
+        }
+        const float hue = static_cast<float>(h % 360) / 360.0f;
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, r, g, b);
+        return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+    }
+
+    // 階層ノードを木として表に並べる（子は親より後ろにある）
+    void DrawZoneRow(const std::vector<Profiler::ZoneNode> &nodes,
+        const std::vector<std::vector<int32_t>> &children, int32_t index) {
+        const Profiler::ZoneNode &node = nodes[index];
+        const bool leaf = children[index].empty();
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_DefaultOpen;
+        if (leaf) flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+        const bool open = ImGui::TreeNodeEx(reinterpret_cast<void *>(static_cast<intptr_t>(index)), flags, "%s", node.name);
+
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", node.totalNs * kNsToMs);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", node.selfNs * kNsToMs);
+        ImGui::TableNextColumn();
+        ImGui::Text("%u", node.calls);
+
+        if (open && !leaf) {
+            for (int32_t child : children[index]) {
+                DrawZoneRow(nodes, children, child);
+            }
+            ImGui::TreePop();
+        }
+    }
+
+} // namespace
+
+void ProfilerView::Initialize(const std::filesystem::path &captureDirectory) {
+    captureDirectory_ = captureDirectory;
+}
+
+void ProfilerView::Draw() {
+    Profiler &profiler = Profiler::Get();
+
+    if (!ImGui::Begin("Profiler")) {
+        ImGui::End();
+        return;
+    }
+
+    // --- 操作 ---
+    bool enabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) profiler.SetEnabled(enabled);
+    ImGui::SameLine();
+    bool paused = profiler.IsPaused();
+    if (ImGui::Checkbox("Pause", &paused)) profiler.SetPaused(paused);
+
+    ImGui::SameLine();
+    if (profiler.IsCapturing()) {
+        ImGui::TextUnformatted("Capturing...");
+    } else {
+        if (ImGui::Button("Capture trace")) {
+            const auto path = captureDirectory_ / ("trace_" + std::to_string(Profiler::NowNs() / 1000000) + ".json");
+            profiler.BeginTraceCapture(path, static_cast<uint32_t>(captureFrames_));
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(80.0f);
+        ImGui::DragInt("frames", &captureFrames_, 1.0f, 1, 3600);
+    }
+
+    if (framePacer_) {
+        DrawPacing();
+    }
+
+    if (profiler.GetFrameCount() == 0) {
+        ImGui::TextUnformatted("No frames recorded.");
+        ImGui::End();
+        return;
+    }
+
+    DrawFrameGraph(profiler);
+
+    const Profiler::Frame &frame = profiler.GetFrame(static_cast<size_t>(selectedAge_));
+    ImGui::Text("Frame %llu  %.3f ms", static_cast<unsigned long long>(frame.index),
+        (frame.endNs - frame.startNs) * kNsToMs);
+    if (frame.droppedEvents > 0) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "(%llu zones dropped)",
+            static_cast<unsigned long long>(frame.droppedEvents));
+    }
+
+    if (ImGui::BeginTabBar("ProfilerTabs")) {
+        if (ImGui::BeginTabItem("Hierarchy")) {
+            DrawHierarchy(frame);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Timeline")) {
+            DrawTimeline(frame);
+            ImGui::EndTabItem();
+        }
+        if (gpuProfiler_ && ImGui::BeginTabItem("GPU")) {
+            DrawGpu();
+            ImGui::EndTabItem();
+        }
+        ImGui::EndTabBar();
+    }
+
+    ImGui::End();
+}
+
+void ProfilerView::DrawFrameGraph(Profiler &profiler) {
+    const int count = static_cast<int>(profiler.GetFrameCount());
+
+    // 古い順に並べる
+    float times[Profiler::kHistoryFrames];
+    float maxMs = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        const Profiler::Frame &f = profiler.GetFrame(static_cast<size_t>(count - 1 - i));
+        times[i] = (f.endNs - f.startNs) * kNsToMs;
+        maxMs = (std::max)(maxMs, times[i]);
+    }
+
+    ImGui::PlotHistogram("##FrameTimes", times, count, 0, "Frame time (ms)", 0.0f,
+        (std::max)(maxMs, 16.7f), ImVec2(-1.0f, 60.0f));
+
+    // グラフ上のクリックでフレームを選ぶ
+    if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+        const ImVec2 min = ImGui::GetItemRectMin();
+        const ImVec2 size = ImGui::GetItemRectSize();
+        const float t = (ImGui::GetIO().MousePos.x - min.x) / (std::max)(size.x, 1.0f);
+        const int clicked = std::clamp(static_cast<int>(t * count), 0, count - 1);
+        selectedAge_ = count - 1 - clicked;
+        profiler.SetPaused(true);
+    }
+
+    selectedAge_ = std::clamp(selectedAge_, 0, count - 1);
+    ImGui::SliderInt("Frame age", &selectedAge_, 0, count - 1);
+}
+
+void ProfilerView::DrawHierarchy(const Profiler::Frame &frame) {
+    if (frame.threads.empty()) {
+        ImGui::TextUnformatted("No zones.");
+        return;
+    }
+
+    hierarchyThread_ = std::clamp(hierarchyThread_, 0, static_cast<int>(frame.threads.size()) - 1);
+    if (ImGui::BeginCombo("Thread", frame.threads[hierarchyThread_].threadName.c_str())) {
+        for (int i = 0; i < static_cast<int>(frame.threads.size()); ++i) {
+            if (ImGui::Selectable(frame.threads[i].threadName.c_str(), i == hierarchyThread_)) {
+                hierarchyThread_ = i;
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    const std::vector<Profiler::ZoneNode> nodes = Profiler::BuildHierarchy(frame.threads[hierarchyThread_]);
+    std::vector<std::vector<int32_t>> children(nodes.size());
+    std::vector<int32_t> roots;
+    for (int32_t i = 0; i < static_cast<int32_t>(nodes.size()); ++i) {
+        if (nodes[i].parent < 0) {
+            roots.push_back(i);
+        } else {
+            children[nodes[i].parent].push_back(i);
+        }
+    }
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersOuterH |
+        ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("Zones", 4, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Total ms", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Self ms", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableHeadersRow();
+        for (int32_t root : roots) {
+            DrawZoneRow(nodes, children, root);
+        }
+        ImGui::EndTable();
+    }
+}
+
+void ProfilerView::DrawTimeline(const Profiler::Frame &frame) {
+    constexpr float kRowHeight = 18.0f;
+    constexpr float kLabelWidth = 90.0f;
+
+    ImGui::BeginChild("Timeline", ImVec2(0.0f, 0.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = (std::max)(ImGui::GetContentRegionAvail().x - kLabelWidth, 1.0f);
+    const double frameNs = (std::max)(static_cast<double>(frame.endNs - frame.startNs), 1.0);
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    const ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+
+    float y = origin.y;
+    for (const Profiler::ThreadFrame &thread : frame.threads) {
+        uint32_t maxDepth = 0;
+        for (const Profiler::Event &e : thread.events) {
+            maxDepth = (std::max)(maxDepth, e.depth);
+        }
+        drawList->AddText(ImVec2(origin.x, y), textColor, thread.threadName.c_str());
+
+        for (const Profiler::Event &e : thread.events) {
+            // フレーム外にはみ出した部分（別スレッドの長いゾーンなど）は端で切る
+            const double startNs = static_cast<double>(e.startNs) - static_cast<double>(frame.startNs);
+            const double endNs = static_cast<double>(e.endNs) - static_cast<double>(frame.startNs);
+            const float x0 = origin.x + kLabelWidth + static_cast<float>(std::clamp(startNs / frameNs, 0.0, 1.0)) * width;
+            const float x1 = origin.x + kLabelWidth + static_cast<float>(std::clamp(endNs / frameNs, 0.0, 1.0)) * width;
+            const float y0 = y + e.depth * kRowHeight;
+            const ImVec2 min(x0, y0);
+            const ImVec2 max((std::max)(x1, x0 + 1.0f), y0 + kRowHeight - 1.0f);
+
+            drawList->AddRectFilled(min, max, ZoneColor(e.name));
+            if (max.x - min.x > 30.0f) {
+                drawList->PushClipRect(min, max, true);
+                drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(0, 0, 0, 255), e.name);
+                drawList->PopClipRect();
+            }
+            if (ImGui::IsWindowHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+                ImGui::SetTooltip("%s\n%.3f ms", e.name, (e.endNs - e.startNs) * kNsToMs);
+            }
+        }
+        y += (maxDepth + 1) * kRowHeight + 4.0f;
+    }
+
+    ImGui::Dummy(ImVec2(kLabelWidth + width, y - origin.y));
+    ImGui::EndChild();
+}
+
+void ProfilerView::DrawPacing() {
+    if (!ImGui::CollapsingHeader("Frame pacing")) return;
+
+    const char *modes[] = {"Uncapped", "Fixed rate", "VSync"};
+    int mode = static_cast<int>(framePacer_->GetMode());
+    if (ImGui::Combo("Mode", &mode, modes, IM_ARRAYSIZE(modes))) {
+        framePacer_->SetMode(static_cast<FramePacer::Mode>(mode));
+    }
+    if (framePacer_->GetMode() == FramePacer::Mode::FixedRate) {
+        float fps = static_cast<float>(framePacer_->GetTargetFps());
+        if (ImGui::DragFloat("Target FPS", &fps, 1.0f, 10.0f, 1000.0f, "%.0f")) {
+            framePacer_->SetTargetFps(fps);
+        }
+    }
+
+    const FramePacer::Stats stats = framePacer_->GetStats();
+    ImGui::Text("p50 %.3f ms  p99 %.3f ms  (min %.3f / max %.3f)", stats.p50Ms, stats.p99Ms, stats.minMs, stats.maxMs);
+    ImGui::Text("mean %.3f ms  jitter %.3f ms  spin margin %.3f ms", stats.meanMs, stats.stdDevMs,
+        framePacer_->GetSpinMarginNs() / 1000000.0);
+}
+
+void ProfilerView::DrawGpu() {
+    // GPU の結果はバックバッファ数ぶん遅れて届くので、CPU 側の選択フレームとは対応しない
+    ImGui::Text("GPU frame %.3f ms", gpuProfiler_->GetLastFrameMs());
+    if (gpuProfiler_->GetDroppedScopeCount() > 0) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "(%llu scopes dropped)",
+            static_cast<unsigned long long>(gpuProfiler_->GetDroppedScopeCount()));
+    }
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersOuterH |
+        ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("GpuScopes", 4, flags)) {
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Last ms", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Avg ms", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Max ms", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableHeadersRow();
+        for (const GpuProfiler::ZoneStats &z : gpuProfiler_->GetStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(z.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", z.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", z.avgMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", z.maxMs);
+        }
+        ImGui::EndTable();
+    }
+
+    // 直近フレームの入れ子
+    for (const GpuProfiler::ScopeResult &r : gpuProfiler_->GetLastResults()) {
+        ImGui::Text("%*s%s  %.3f ms", static_cast<int>(r.depth * 2), "", r.name, r.ms);
+    }
+}
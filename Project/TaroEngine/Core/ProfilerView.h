@@ -0,0 +1,59 @@
+#pragma once
+#include "Profiler.h"
+#include <filesystem>
+
+class FramePacer;
+class GpuProfiler;
+
+/// <summary>
+/// Profiler の履歴を ImGui で表示するウィンドウ。<br/>
+/// フレーム時間のグラフ、選択フレームの呼び出し階層（合計/自己時間・回数）、
+/// スレッドごとのタイムライン（フレームグラフ）を表示し、Chrome trace の記録も開始できる。
+/// </summary>
+class ProfilerView {
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="captureDirectory">Chrome trace JSON の保存先ディレクトリ。</param>
+    void Initialize(const std::filesystem::path &captureDirectory);
+
+    /// <summary>
+    /// GPU 時間のタブに表示する GpuProfiler を設定する（nullptr ならタブを出さない）。
+    /// </summary>
+    void SetGpuProfiler(const GpuProfiler *gpuProfiler) { gpuProfiler_ = gpuProfiler; }
+
+    /// <summary>
+    /// フレーム間隔の統計と設定を表示する FramePacer を設定する（nullptr なら表示しない）。
+    /// </summary>
+    void SetFramePacer(FramePacer *framePacer) { framePacer_ = framePacer; }
+
+    /// <summary>
+    /// ウィンドウを描画する（ImGui::NewFrame と ImGui::Render の間で呼ぶ）。
+    /// </summary>
+    void Draw();
+
+private:
+    /// <summary>フレーム時間のグラフと選択。</summary>
+    void DrawFrameGraph(Profiler &profiler);
+
+    /// <summary>呼び出し階層の表。</summary>
+    void DrawHierarchy(const Profiler::Frame &frame);
+
+    /// <summary>スレッドごとのタイムライン。</summary>
+    void DrawTimeline(const Profiler::Frame &frame);
+
+    /// <summary>フレームペーシングの設定と統計。</summary>
+    void DrawPacing();
+
+    /// <summary>GPU スコープの集計表。</summary>
+    void DrawGpu();
+
+private:
+    std::filesystem::path captureDirectory_;
+    const GpuProfiler *gpuProfiler_ = nullptr;
+    FramePacer *framePacer_ = nullptr;
+    int selectedAge_ = 0;      // 0 が最新フレーム
+    int captureFrames_ = 300;  // トレースに記録するフレーム数
+    int hierarchyThread_ = 0;  // 階層を表示するスレッド
+};
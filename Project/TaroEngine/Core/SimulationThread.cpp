@@ -0,0 +1,68 @@
+#include "SimulationThread.h"
+#include "Profiler.h"
+#include <cassert>
+#include <utility>
+
+SimulationThread::~SimulationThread() {
+    Stop();
+}
+
+void SimulationThread::Start(FrameFunction function) {
+    assert(!thread_.joinable());
+    assert(function);
+    function_ = std::move(function);
+    stopRequested_ = false;
+    thread_ = std::thread([this] { Run(); });
+}
+
+void SimulationThread::Kick(const FrameInput &input) {
+    assert(thread_.joinable());
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return !hasPending_; });
+        pending_ = input;
+        hasPending_ = true;
+    }
+    cv_.notify_all();
+}
+
+void SimulationThread::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return !hasPending_ && !busy_; });
+}
+
+void SimulationThread::Stop() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void SimulationThread::Run() {
+    Profiler::Get().SetThreadName("Simulation");
+
+    for (;;) {
+        FrameInput input;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return hasPending_ || stopRequested_; });
+            // 依頼済みの分は止める前に処理する
+            if (!hasPending_) break;
+            input = pending_;
+            hasPending_ = false;
+            busy_ = true;
+        }
+        cv_.notify_all();
+
+        function_(input);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_ = false;
+        }
+        cv_.notify_all();
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// シミュレーション（シーンの更新）を専用スレッドで 1 フレームずつ実行する。<br/>
+/// 描画スレッドが Kick でフレームの入力を渡すと、ワーカーが登録された処理を 1 回実行する。
+/// </summary>
+/// <remarks>
+/// 更新結果は SnapshotExchange で描画スレッドへ渡す想定。
+/// Kick は前のフレームの処理が終わっていなくても呼べる（終わるまで待ってから渡す）。
+/// </remarks>
+class SimulationThread {
+public:
+    /// <summary>1 フレーム分の入力。</summary>
+    struct FrameInput {
+        uint64_t frameIndex = 0;    ///< フレーム番号
+        double frameSeconds = 0.0;  ///< 前フレームからの経過時間（秒）
+    };
+
+    /// <summary>1 フレーム分の処理。</summary>
+    using FrameFunction = std::function<void(const FrameInput &)>;
+
+public:
+    SimulationThread() = default;
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    /// <summary>
+    /// ワーカースレッドを開始する。
+    /// </summary>
+    /// <param name="function">フレームごとに実行する処理（ワーカースレッドで呼ばれる）。</param>
+    void Start(FrameFunction function);
+
+    /// <summary>
+    /// 1 フレーム分の処理を依頼する（前の依頼が未着手なら着手されるまで待つ）。
+    /// </summary>
+    void Kick(const FrameInput &input);
+
+    /// <summary>依頼した処理がすべて終わるまで待つ。</summary>
+    void WaitIdle();
+
+    /// <summary>依頼済みの処理を終えてからスレッドを止める。</summary>
+    void Stop();
+
+    /// <summary>スレッドが動いているか。</summary>
+    bool IsRunning() const { return thread_.joinable(); }
+
+private:
+    /// <summary>ワーカーの本体。</summary>
+    void Run();
+
+private:
+    std::thread thread_;
+    FrameFunction function_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    FrameInput pending_{};
+    bool hasPending_ = false;
+    bool busy_ = false;
+    bool stopRequested_ = false;
+};
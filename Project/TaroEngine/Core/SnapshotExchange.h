@@ -0,0 +1,99 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/// <summary>
+/// 2 枚のスナップショットを、書き手（シミュレーションスレッド）と読み手（描画スレッド）で受け渡す。<br/>
+/// 書き手が 1 枚に書いている間、読み手はもう 1 枚の公開済みスナップショットを読む。
+/// </summary>
+/// <remarks>
+/// - 書き手は読み手より 1 枚までしか先行できない（公開済みが読まれるまで次の BeginWrite は待つ）。
+///   フレームを飛ばさないので、描画される内容はシミュレーションの全フレームと 1 対 1 に対応する。<br/>
+/// - 読み手が読んでいる間、そのスナップショットは書き換えられない（不変）。<br/>
+/// - 受け渡しは mutex で同期するので、T はスレッドセーフである必要はない。
+/// </remarks>
+template <class T>
+class SnapshotExchange {
+public:
+    /// <summary>
+    /// 書き込みを開始する。前回の公開分が読まれるまで待つ。
+    /// </summary>
+    /// <returns>書き込み先（前々回の内容が残っているので、必要なら書き手が消す）。Stop 後は nullptr。</returns>
+    T *BeginWrite() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return stopped_ || (ready_ < 0 && nextWrite_ != reading_); });
+        if (stopped_) return nullptr;
+        writing_ = nextWrite_;
+        return &slots_[writing_];
+    }
+
+    /// <summary>
+    /// 書き込んだスナップショットを公開する。
+    /// </summary>
+    void EndWrite() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (writing_ < 0) return;
+            ready_ = writing_;
+            nextWrite_ = writing_ ^ 1;
+            writing_ = -1;
+            ++publishedCount_;
+        }
+        cv_.notify_all();
+    }
+
+    /// <summary>
+    /// 公開済みのスナップショットの読み取りを開始する。公開されるまで待つ。
+    /// </summary>
+    /// <returns>読み取り対象（EndRead まで不変）。Stop 後で公開分がなければ nullptr。</returns>
+    const T *BeginRead() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return stopped_ || ready_ >= 0; });
+        if (ready_ < 0) return nullptr;
+        reading_ = ready_;
+        ready_ = -1;
+        lock.unlock();
+        cv_.notify_all(); // 書き手は次の 1 枚に進める
+        return &slots_[reading_];
+    }
+
+    /// <summary>
+    /// 読み取りを終える（このスナップショットは次の書き込み先に戻る）。
+    /// </summary>
+    void EndRead() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reading_ = -1;
+        }
+        cv_.notify_all();
+    }
+
+    /// <summary>
+    /// 待機中の BeginWrite / BeginRead をすべて起こし、以後は待たずに nullptr を返させる。
+    /// </summary>
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    /// <summary>これまでに公開したスナップショット数。</summary>
+    uint64_t GetPublishedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return publishedCount_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    T slots_[2]{};
+    int writing_ = -1;   // 書き込み中のスロット
+    int reading_ = -1;   // 読み取り中のスロット
+    int ready_ = -1;     // 公開済みで未読のスロット
+    int nextWrite_ = 0;  // 次に書き込むスロット
+    bool stopped_ = false;
+    uint64_t publishedCount_ = 0;
+};
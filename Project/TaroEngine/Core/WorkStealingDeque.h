@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // alignas によるパディング（キャッシュライン分離のため意図的）
+#endif
+
+/// <summary>
+/// Chase-Lev 方式のワークスティーリング両端キュー（容量固定）。<br/>
+/// 所有スレッドだけが底側で Push / Pop（LIFO）し、他のスレッドは天側から Steal（FIFO）する。
+/// </summary>
+/// <remarks>
+/// - T はポインタなど atomic で扱える小さな型。<br/>
+/// - 容量を超えた Push は失敗を返す（呼び出し側がその場で処理する想定）。バッファを差し替えないので、
+///   盗む側が読んでいる最中の要素が解放されることはない。<br/>
+/// - 順序付けは単独の fence を使わず seq_cst の操作で表す（ThreadSanitizer が正しく追えるように）。
+/// </remarks>
+template <typename T>
+class WorkStealingDeque {
+public:
+    /// <summary>
+    /// コンストラクタ。
+    /// </summary>
+    /// <param name="capacity">容量（2 のべき乗）。</param>
+    explicit WorkStealingDeque(size_t capacity)
+        : buffer_(std::make_unique<std::atomic<T>[]>(capacity)), mask_(static_cast<int64_t>(capacity) - 1) {
+        assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    /// <summary>
+    /// 底に積む（所有スレッドのみ）。
+    /// </summary>
+    /// <returns>満杯なら false。</returns>
+    bool Push(T item) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t > mask_) return false;
+
+        buffer_[b & mask_].store(item, std::memory_order_relaxed);
+        // 要素の書き込みを Steal 側の bottom_ の acquire に公開する
+        bottom_.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>
+    /// 底から取り出す（所有スレッドのみ）。
+    /// </summary>
+    /// <param name="out">取り出した要素。</param>
+    /// <returns>空だったか、最後の 1 つを盗まれたら false。</returns>
+    bool Pop(T &out) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        // bottom_ の書き込みと top_ の読み込みの順序を保証する（Steal と同時に最後の 1 つを狙う場合）
+        bottom_.store(b, std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_seq_cst);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed); // 空
+            return false;
+        }
+
+        out = buffer_[b & mask_].load(std::memory_order_relaxed);
+        if (t == b) {
+            // 最後の 1 つは Steal と top_ の CAS で取り合う
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// 天から盗む（どのスレッドからでも呼べる）。
+    /// </summary>
+    /// <param name="out">盗んだ要素。</param>
+    /// <returns>空だったか、他のスレッドとの取り合いに負けたら false。</returns>
+    bool Steal(T &out) {
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b) return false;
+
+        const T item = buffer_[t & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = item;
+        return true;
+    }
+
+    /// <summary>おおよその要素数（他スレッドの操作と並行していると厳密ではない）。</summary>
+    size_t GetApproximateSize() const {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+private:
+    std::unique_ptr<std::atomic<T>[]> buffer_;
+    const int64_t mask_;
+
+    // 天（盗む側）と底（所有スレッド）は別々のキャッシュラインに置く
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
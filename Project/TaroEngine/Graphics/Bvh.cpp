@@ -0,0 +1,509 @@
+#include "Bvh.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+    using Aabb = Bvh::Aabb;
+
+    // これより深くなったら SAH をやめて個数で半分に分ける（検索のスタックが溢れないように）
+    constexpr uint32_t kMaxSahDepth = 48;
+
+    // 検索用スタックの深さ（kMaxSahDepth + 個数での二分割の深さ 32 より大きく）
+    constexpr uint32_t kStackSize = 96;
+
+    // ビン集計・境界計算を区切って並列にするときの 1 区切りのプリミティブ数
+    constexpr uint32_t kChunkSize = 16384;
+
+    inline Aabb EmptyAabb() {
+        return Aabb{{INFINITY, INFINITY, INFINITY}, {-INFINITY, -INFINITY, -INFINITY}};
+    }
+
+    inline void Grow(Aabb &a, const Aabb &b) {
+        a.min.x = (std::min)(a.min.x, b.min.x);
+        a.min.y = (std::min)(a.min.y, b.min.y);
+        a.min.z = (std::min)(a.min.z, b.min.z);
+        a.max.x = (std::max)(a.max.x, b.max.x);
+        a.max.y = (std::max)(a.max.y, b.max.y);
+        a.max.z = (std::max)(a.max.z, b.max.z);
+    }
+
+    inline void Grow(Aabb &a, const Vector3 &p) {
+        Grow(a, Aabb{p, p});
+    }
+
+    // 表面積の半分（SAH は比しか使わない）。空なら 0
+    inline float HalfArea(const Aabb &a) {
+        const float dx = a.max.x - a.min.x;
+        const float dy = a.max.y - a.min.y;
+        const float dz = a.max.z - a.min.z;
+        if (dx < 0.0f || dy < 0.0f || dz < 0.0f) return 0.0f;
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    inline float Axis(const Vector3 &v, int axis) {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    inline bool Overlaps(const Aabb &a, const Aabb &b) {
+        return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+            a.min.y <= b.max.y && b.min.y <= a.max.y &&
+            a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+    // 視錐台との関係（外 / 交差 / 内）
+    enum class Containment { Outside, Intersects, Inside };
+
+    inline Containment Classify(const Frustum &f, const Aabb &a) {
+        const float cx = (a.min.x + a.max.x) * 0.5f, ex = (a.max.x - a.min.x) * 0.5f;
+        const float cy = (a.min.y + a.max.y) * 0.5f, ey = (a.max.y - a.min.y) * 0.5f;
+        const float cz = (a.min.z + a.max.z) * 0.5f, ez = (a.max.z - a.min.z) * 0.5f;
+        Containment result = Containment::Inside;
+        for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+            const float dist = ((f.normalX[p] * cx + f.normalY[p] * cy) + f.normalZ[p] * cz) + f.distance[p];
+            const float r = (std::fabs(f.normalX[p]) * ex + std::fabs(f.normalY[p]) * ey) + std::fabs(f.normalZ[p]) * ez;
+            if (dist < -r) return Containment::Outside;
+            if (dist < r) result = Containment::Intersects;
+        }
+        return result;
+    }
+
+    // レイと箱の入る距離（当たらなければ INFINITY）
+    inline float RayEntry(const Aabb &a, const Vector3 &origin, const Vector3 &invDir, float maxT) {
+        const float tx0 = (a.min.x - origin.x) * invDir.x, tx1 = (a.max.x - origin.x) * invDir.x;
+        const float ty0 = (a.min.y - origin.y) * invDir.y, ty1 = (a.max.y - origin.y) * invDir.y;
+        const float tz0 = (a.min.z - origin.z) * invDir.z, tz1 = (a.max.z - origin.z) * invDir.z;
+        // 向きが 0 の軸では inf になる。原点がちょうど面上だと NaN になり、fmin / fmax で外れ扱いになる（かすめるだけ）
+        const float tNear = std::fmax(std::fmax(std::fmin(tx0, tx1), std::fmin(ty0, ty1)), std::fmax(std::fmin(tz0, tz1), 0.0f));
+        const float tFar = std::fmin(std::fmin(std::fmax(tx0, tx1), std::fmax(ty0, ty1)), std::fmin(std::fmax(tz0, tz1), maxT));
+        return tNear <= tFar ? tNear : INFINITY;
+    }
+
+    // ビン集計（3 軸まとめて）。使うのは先頭の binCount 個だけ
+    struct BinSet {
+        Aabb bounds[3][Bvh::kBinCount];
+        uint32_t counts[3][Bvh::kBinCount];
+        uint32_t binCount = 0;
+
+        explicit BinSet(uint32_t n = Bvh::kBinCount) : binCount(n) {
+            for (int a = 0; a < 3; ++a) {
+                for (uint32_t b = 0; b < binCount; ++b) {
+                    bounds[a][b] = EmptyAabb();
+                    counts[a][b] = 0;
+                }
+            }
+        }
+
+        void Merge(const BinSet &other) {
+            for (int a = 0; a < 3; ++a) {
+                for (uint32_t b = 0; b < binCount; ++b) {
+                    Grow(bounds[a][b], other.bounds[a][b]);
+                    counts[a][b] += other.counts[a][b];
+                }
+            }
+        }
+    };
+
+    // 重心を軸ごとのビン番号にする
+    struct Binner {
+        float origin[3];
+        float scale[3]; // 0 ならその軸は重心が揃っていて分けられない
+        uint32_t lastBin;
+
+        uint32_t operator()(const Vector3 &c, int axis) const {
+            const float t = (Axis(c, axis) - origin[axis]) * scale[axis];
+            return (std::min)(lastBin, static_cast<uint32_t>(t));
+        }
+    };
+
+    // [begin, end) を kChunkSize ごとに区切って処理する（大きければ JobSystem で並列に）
+    template <typename F>
+    void ForEachChunk(JobSystem *jobs, uint32_t begin, uint32_t end, F &&fn) {
+        const uint32_t chunks = (end - begin + kChunkSize - 1) / kChunkSize;
+        if (!jobs || chunks <= 1) {
+            for (uint32_t c = 0; c < chunks; ++c) {
+                fn(c, begin + c * kChunkSize, (std::min)(end, begin + (c + 1) * kChunkSize));
+            }
+            return;
+        }
+        JobCounter counter;
+        for (uint32_t c = 0; c < chunks; ++c) {
+            const uint32_t b = begin + c * kChunkSize;
+            const uint32_t e = (std::min)(end, b + kChunkSize);
+            jobs->Run(counter, [&fn, c, b, e] { fn(c, b, e); });
+        }
+        jobs->Wait(counter);
+    }
+
+    inline Vector3 Centroid(const Aabb &a) {
+        return Vector3{(a.min.x + a.max.x) * 0.5f, (a.min.y + a.max.y) * 0.5f, (a.min.z + a.max.z) * 0.5f};
+    }
+
+} // namespace
+
+void Bvh::Build(const Aabb *bounds, uint32_t count, JobSystem *jobs) {
+    nodes_.clear();
+    primIndices_.clear();
+    primBounds_.clear();
+    buildCost_ = currentCost_ = 0.0f;
+    if (count == 0) return;
+    assert(bounds);
+
+    BuildContext ctx;
+    ctx.jobs = jobs;
+    ctx.refs.resize(count);
+    ForEachChunk(jobs, 0, count, [&](uint32_t, uint32_t b, uint32_t e) {
+        for (uint32_t i = b; i < e; ++i) {
+            ctx.refs[i].bounds = bounds[i];
+            ctx.refs[i].index = i;
+        }
+    });
+
+    // ノード数は最大 2N-1。先に確保しておき、並列に作る部分木は番号の払い出しだけを共有する
+    nodes_.resize(static_cast<size_t>(count) * 2 - 1);
+    ctx.nodeCount.store(1);
+    Aabb rootBounds;
+    Aabb rootCentroids;
+    ComputeRange(ctx, 0, count, rootBounds, rootCentroids);
+    BuildNode(ctx, 0, 0, count, 0, rootBounds, rootCentroids);
+    nodes_.resize(ctx.nodeCount.load());
+
+    // 葉の並びのまま番号と境界箱を残す
+    primIndices_.resize(count);
+    primBounds_.resize(count);
+    ForEachChunk(jobs, 0, count, [&](uint32_t, uint32_t b, uint32_t e) {
+        for (uint32_t i = b; i < e; ++i) {
+            primIndices_[i] = ctx.refs[i].index;
+            primBounds_[i] = ctx.refs[i].bounds;
+        }
+    });
+
+    buildCost_ = currentCost_ = ComputeSahCost();
+}
+
+void Bvh::ComputeRange(const BuildContext &ctx, uint32_t begin, uint32_t end, Aabb &outBounds, Aabb &outCentroids) {
+    JobSystem *jobs = end - begin > kParallelThreshold ? ctx.jobs : nullptr;
+    const uint32_t chunks = (end - begin + kChunkSize - 1) / kChunkSize;
+    std::vector<Aabb> partial(static_cast<size_t>(chunks) * 2, EmptyAabb());
+    ForEachChunk(jobs, begin, end, [&](uint32_t c, uint32_t b, uint32_t e) {
+        Aabb box = EmptyAabb();
+        Aabb cen = EmptyAabb();
+        for (uint32_t i = b; i < e; ++i) {
+            Grow(box, ctx.refs[i].bounds);
+            Grow(cen, Centroid(ctx.refs[i].bounds));
+        }
+        partial[c * 2] = box;
+        partial[c * 2 + 1] = cen;
+    });
+    outBounds = EmptyAabb();
+    outCentroids = EmptyAabb();
+    for (uint32_t c = 0; c < chunks; ++c) {
+        Grow(outBounds, partial[c * 2]);
+        Grow(outCentroids, partial[c * 2 + 1]);
+    }
+}
+
+void Bvh::BuildNode(BuildContext &ctx, uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth,
+    const Aabb &bounds, const Aabb &centroidBounds) {
+    const uint32_t count = end - begin;
+    JobSystem *jobs = count > kParallelThreshold ? ctx.jobs : nullptr;
+
+    Node &node = nodes_[nodeIndex];
+    node.bounds = bounds;
+    node.first = begin;
+    node.count = count;
+    if (count <= 1) return;
+
+    // 小さいノードはビンを減らす（ノードの大半は小さく、ビンの掃引がプリミティブの集計より重くなるため）
+    const uint32_t binCount = (std::min)(kBinCount, (std::max)(count, 4u));
+    Binner binner;
+    binner.lastBin = binCount - 1;
+    bool canBin = false;
+    for (int a = 0; a < 3; ++a) {
+        const float extent = Axis(centroidBounds.max, a) - Axis(centroidBounds.min, a);
+        binner.origin[a] = Axis(centroidBounds.min, a);
+        const float scale = extent > 0.0f ? static_cast<float>(binCount) * 0.9999f / extent : 0.0f;
+        binner.scale[a] = std::isfinite(scale) ? scale : 0.0f;
+        canBin = canBin || binner.scale[a] > 0.0f;
+    }
+
+    // --- ビン分割の SAH で分割軸と位置を決める ---
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    float bestCost = INFINITY;
+    BinSet bins(binCount);
+    if (canBin && depth < kMaxSahDepth) {
+        auto binChunk = [&](BinSet &out, uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; ++i) {
+                const Aabb &box = ctx.refs[i].bounds;
+                const Vector3 c = Centroid(box);
+                // 分けられない軸（scale == 0）はすべてビン 0 に入り、後で読み飛ばされる
+                for (int a = 0; a < 3; ++a) {
+                    const uint32_t bin = binner(c, a);
+                    Grow(out.bounds[a][bin], box);
+                    ++out.counts[a][bin];
+                }
+            }
+        };
+        if (jobs) {
+            std::vector<BinSet> partial((count + kChunkSize - 1) / kChunkSize, BinSet(binCount));
+            ForEachChunk(jobs, begin, end, [&](uint32_t c, uint32_t b, uint32_t e) { binChunk(partial[c], b, e); });
+            for (const BinSet &p : partial) {
+                bins.Merge(p);
+            }
+        } else {
+            binChunk(bins, begin, end);
+        }
+
+        const float nodeArea = HalfArea(bounds);
+        const float invNodeArea = nodeArea > 0.0f ? 1.0f / nodeArea : 0.0f;
+        for (int a = 0; a < 3; ++a) {
+            if (binner.scale[a] == 0.0f) continue;
+
+            // 左から累積した面積・個数と、右から累積したものを突き合わせる（split より前のビンが左）
+            float leftArea[kBinCount];
+            uint32_t leftCount[kBinCount];
+            Aabb acc = EmptyAabb();
+            uint32_t n = 0;
+            for (uint32_t b = 0; b + 1 < binCount; ++b) {
+                Grow(acc, bins.bounds[a][b]);
+                n += bins.counts[a][b];
+                leftArea[b + 1] = HalfArea(acc);
+                leftCount[b + 1] = n;
+            }
+            acc = EmptyAabb();
+            n = 0;
+            for (uint32_t split = binCount - 1; split > 0; --split) {
+                Grow(acc, bins.bounds[a][split]);
+                n += bins.counts[a][split];
+                if (leftCount[split] == 0 || n == 0) continue;
+                const float cost = 1.0f + (leftArea[split] * leftCount[split] + HalfArea(acc) * n) * invNodeArea;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = a;
+                    bestSplit = split;
+                }
+            }
+        }
+
+        // 分けても得をしないなら葉にする（大きすぎる葉は作らない）
+        if (count <= kMaxLeafSize && (bestAxis < 0 || bestCost >= static_cast<float>(count))) return;
+    } else if (count <= kMaxLeafSize) {
+        return;
+    }
+
+    // --- 分割 ---
+    uint32_t mid = begin;
+    Aabb leftBounds = EmptyAabb(), rightBounds = EmptyAabb();
+    Aabb leftCentroids = EmptyAabb(), rightCentroids = EmptyAabb();
+    if (bestAxis >= 0) {
+        // 子の境界箱はビンから求まる。重心の範囲は振り分けながら集める
+        for (uint32_t b = 0; b < binCount; ++b) {
+            Grow(b < bestSplit ? leftBounds : rightBounds, bins.bounds[bestAxis][b]);
+        }
+        uint32_t i = begin;
+        uint32_t j = end;
+        while (i < j) {
+            const Vector3 c = Centroid(ctx.refs[i].bounds);
+            if (binner(c, bestAxis) < bestSplit) {
+                Grow(leftCentroids, c);
+                ++i;
+            } else {
+                Grow(rightCentroids, c);
+                std::swap(ctx.refs[i], ctx.refs[--j]);
+            }
+        }
+        mid = i;
+    } else {
+        // 深すぎる・重心が揃っているとき。最も広い軸の中央値で個数を半分に分ける
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (Axis(centroidBounds.max, a) - Axis(centroidBounds.min, a) >
+                Axis(centroidBounds.max, axis) - Axis(centroidBounds.min, axis)) {
+                axis = a;
+            }
+        }
+        mid = begin + count / 2;
+        std::nth_element(ctx.refs.begin() + begin, ctx.refs.begin() + mid, ctx.refs.begin() + end,
+            [axis](const PrimRef &l, const PrimRef &r) {
+                return Axis(l.bounds.min, axis) + Axis(l.bounds.max, axis) < Axis(r.bounds.min, axis) + Axis(r.bounds.max, axis);
+            });
+        ComputeRange(ctx, begin, mid, leftBounds, leftCentroids);
+        ComputeRange(ctx, mid, end, rightBounds, rightCentroids);
+    }
+    assert(mid > begin && mid < end);
+
+    const uint32_t left = ctx.nodeCount.fetch_add(2, std::memory_order_relaxed);
+    node.first = left;
+    node.count = 0;
+
+    if (jobs) {
+        // 左の部分木は他のワーカーに任せ、右を自分で作る
+        JobCounter counter;
+        jobs->Run(counter, [this, &ctx, left, begin, mid, depth, &leftBounds, &leftCentroids] {
+            BuildNode(ctx, left, begin, mid, depth + 1, leftBounds, leftCentroids);
+        });
+        BuildNode(ctx, left + 1, mid, end, depth + 1, rightBounds, rightCentroids);
+        jobs->Wait(counter);
+    } else {
+        BuildNode(ctx, left, begin, mid, depth + 1, leftBounds, leftCentroids);
+        BuildNode(ctx, left + 1, mid, end, depth + 1, rightBounds, rightCentroids);
+    }
+}
+
+void Bvh::Refit(const Aabb *bounds) {
+    if (nodes_.empty()) return;
+    assert(bounds);
+
+    // 子は必ず親より後ろの番号なので、後ろから順に付け直せば葉から根へ伝わる
+    for (size_t i = nodes_.size(); i-- > 0;) {
+        Node &node = nodes_[i];
+        Aabb box = EmptyAabb();
+        if (node.count > 0) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                primBounds_[k] = bounds[primIndices_[k]];
+                Grow(box, primBounds_[k]);
+            }
+        } else {
+            Grow(box, nodes_[node.first].bounds);
+            Grow(box, nodes_[node.first + 1].bounds);
+        }
+        node.bounds = box;
+    }
+    currentCost_ = ComputeSahCost();
+}
+
+bool Bvh::Update(const Aabb *bounds, JobSystem *jobs) {
+    Refit(bounds);
+    if (GetQualityRatio() <= kRebuildCostRatio) return false;
+    Build(bounds, GetPrimitiveCount(), jobs);
+    return true;
+}
+
+size_t Bvh::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &out) const {
+    if (nodes_.empty()) return 0;
+    const size_t before = out.size();
+
+    // insideStack: 祖先が視錐台に完全に入っていれば、子孫の平面判定を省く
+    uint32_t stack[kStackSize];
+    bool insideStack[kStackSize];
+    uint32_t top = 0;
+    stack[top] = 0;
+    insideStack[top++] = false;
+    while (top > 0) {
+        --top;
+        const Node &node = nodes_[stack[top]];
+        bool inside = insideStack[top];
+        if (!inside) {
+            const Containment c = Classify(frustum, node.bounds);
+            if (c == Containment::Outside) continue;
+            inside = (c == Containment::Inside);
+        }
+
+        if (node.count > 0) {
+            // 葉の中は個別の箱で判定する（葉全体が内側なら不要）
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                if (inside || Classify(frustum, primBounds_[k]) != Containment::Outside) {
+                    out.push_back(primIndices_[k]);
+                }
+            }
+            continue;
+        }
+        assert(top + 2 <= kStackSize);
+        stack[top] = node.first;
+        insideStack[top++] = inside;
+        stack[top] = node.first + 1;
+        insideStack[top++] = inside;
+    }
+    return out.size() - before;
+}
+
+size_t Bvh::QueryAabb(const Aabb &box, std::vector<uint32_t> &out) const {
+    if (nodes_.empty()) return 0;
+    const size_t before = out.size();
+
+    uint32_t stack[kStackSize];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = nodes_[stack[--top]];
+        if (!Overlaps(node.bounds, box)) continue;
+
+        if (node.count > 0) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                if (Overlaps(primBounds_[k], box)) {
+                    out.push_back(primIndices_[k]);
+                }
+            }
+            continue;
+        }
+        assert(top + 2 <= kStackSize);
+        stack[top++] = node.first;
+        stack[top++] = node.first + 1;
+    }
+    return out.size() - before;
+}
+
+bool Bvh::Raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, RayHit &hit) const {
+    if (nodes_.empty()) return false;
+
+    const Vector3 invDir{1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z};
+    float best = maxDistance;
+    uint32_t bestPrim = UINT32_MAX;
+
+    if (RayEntry(nodes_[0].bounds, origin, invDir, best) == INFINITY) return false;
+
+    uint32_t stack[kStackSize];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = nodes_[stack[--top]];
+        // 積んだ後に近い当たりが見つかっていれば、ここで捨てられる
+        if (RayEntry(node.bounds, origin, invDir, best) == INFINITY) continue;
+
+        if (node.count > 0) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                const float t = RayEntry(primBounds_[k], origin, invDir, best);
+                if (t != INFINITY && (t < best || bestPrim == UINT32_MAX)) {
+                    best = t;
+                    bestPrim = primIndices_[k];
+                }
+            }
+            continue;
+        }
+
+        // 近い子を先に調べる（後に積んだ方が先に取り出される）
+        const uint32_t a = node.first;
+        const uint32_t b = node.first + 1;
+        const float ta = RayEntry(nodes_[a].bounds, origin, invDir, best);
+        const float tb = RayEntry(nodes_[b].bounds, origin, invDir, best);
+        assert(top + 2 <= kStackSize);
+        if (ta <= tb) {
+            if (tb != INFINITY) stack[top++] = b;
+            if (ta != INFINITY) stack[top++] = a;
+        } else {
+            if (ta != INFINITY) stack[top++] = a;
+            stack[top++] = b;
+        }
+    }
+
+    if (bestPrim == UINT32_MAX) return false;
+    hit.primitive = bestPrim;
+    hit.distance = best;
+    return true;
+}
+
+float Bvh::ComputeSahCost() const {
+    if (nodes_.empty()) return 0.0f;
+    const float rootArea = HalfArea(nodes_[0].bounds);
+    if (rootArea <= 0.0f) return 0.0f;
+
+    double cost = 0.0;
+    for (const Node &node : nodes_) {
+        const float area = HalfArea(node.bounds);
+        cost += node.count > 0 ? static_cast<double>(area) * node.count : static_cast<double>(area);
+    }
+    return static_cast<float>(cost / rootArea);
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include "Frustum.h"
+#include "Vector3.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// <summary>
+/// オブジェクトの境界箱（AABB）に対する BVH（Bounding Volume Hierarchy）。<br/>
+/// ビン分割の SAH で構築し、視錐台・AABB での検索とレイによるピッキングに使う。
+/// </summary>
+/// <remarks>
+/// 動くオブジェクトには 2 通りで追従する。<br/>
+/// - Refit: 木の形はそのままに、葉から根へ境界箱を付け直す（O(ノード数)、安い）。<br/>
+/// - Build: 作り直す。Refit を続けると木の質（SAH コスト）が落ちるので、
+///   Update はコストが構築時の kRebuildCostRatio 倍を超えたら作り直す。<br/>
+/// JobSystem を渡すと、大きな部分木の構築と大きなノードのビン集計を並列に行う。
+/// 検索はスレッドセーフ（const）だが、Build / Refit 中に呼んではいけない。
+/// </remarks>
+class Bvh {
+public:
+    /// <summary>軸平行の境界箱。</summary>
+    struct Aabb {
+        Vector3 min{0.0f, 0.0f, 0.0f};
+        Vector3 max{0.0f, 0.0f, 0.0f};
+    };
+
+    /// <summary>
+    /// 木のノード。count > 0 なら葉で、GetPrimitiveIndices() の [first, first + count) を持つ。
+    /// count == 0 なら内部ノードで、子は first と first + 1。
+    /// </summary>
+    struct Node {
+        Aabb bounds;
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    /// <summary>レイの当たり。</summary>
+    struct RayHit {
+        uint32_t primitive = UINT32_MAX; ///< 当たったプリミティブの番号
+        float distance = 0.0f;           ///< 原点からの距離（direction の長さを 1 とした単位）
+    };
+
+    /// <summary>葉に置く最大のプリミティブ数（SAH が分けないと判断したときの上限）。</summary>
+    static constexpr uint32_t kMaxLeafSize = 8;
+
+    /// <summary>SAH で評価する 1 軸あたりのビン数（小さいノードではプリミティブ数まで減らす）。</summary>
+    static constexpr uint32_t kBinCount = 16;
+
+    /// <summary>これより多いプリミティブを持つ部分木は JobSystem で並列に作る。</summary>
+    static constexpr uint32_t kParallelThreshold = 8192;
+
+    /// <summary>Update が作り直す、構築時に対する SAH コストの比。</summary>
+    static constexpr float kRebuildCostRatio = 1.5f;
+
+public:
+    /// <summary>
+    /// 木を作る。
+    /// </summary>
+    /// <param name="bounds">プリミティブの境界箱（count 要素）。番号がそのままプリミティブの番号になる。</param>
+    /// <param name="count">プリミティブ数。</param>
+    /// <param name="jobs">並列化に使う JobSystem（nullptr なら呼び出し元だけで作る）。</param>
+    void Build(const Aabb *bounds, uint32_t count, JobSystem *jobs = nullptr);
+
+    /// <summary>
+    /// 木の形を変えずに境界箱を付け直す。
+    /// </summary>
+    /// <param name="bounds">Build と同じ数・並びの、新しい境界箱。</param>
+    void Refit(const Aabb *bounds);
+
+    /// <summary>
+    /// Refit し、木の質が落ちていれば作り直す（毎フレーム呼ぶ想定）。
+    /// </summary>
+    /// <param name="bounds">Build と同じ数・並びの、新しい境界箱。</param>
+    /// <param name="jobs">作り直すときに使う JobSystem。</param>
+    /// <returns>作り直したら true。</returns>
+    bool Update(const Aabb *bounds, JobSystem *jobs = nullptr);
+
+    /// <summary>
+    /// 視錐台と交差するプリミティブの番号を out の末尾に追加する（順序は不定）。
+    /// </summary>
+    /// <returns>追加した数。</returns>
+    size_t QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &out) const;
+
+    /// <summary>
+    /// AABB と重なるプリミティブの番号を out の末尾に追加する（順序は不定）。
+    /// </summary>
+    /// <returns>追加した数。</returns>
+    size_t QueryAabb(const Aabb &box, std::vector<uint32_t> &out) const;
+
+    /// <summary>
+    /// レイが最初に当たるプリミティブ（の境界箱）を求める。
+    /// </summary>
+    /// <param name="origin">レイの原点。</param>
+    /// <param name="direction">レイの向き（正規化しなくてよい）。</param>
+    /// <param name="maxDistance">これより遠い当たりは無視する。</param>
+    /// <param name="hit">当たり。</param>
+    /// <returns>当たったら true。</returns>
+    bool Raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, RayHit &hit) const;
+
+    /// <summary>
+    /// SAH コスト（根の表面積で正規化、内部ノードの走査と葉のプリミティブ判定をともに 1 とする）。
+    /// </summary>
+    float ComputeSahCost() const;
+
+    /// <summary>直近の Refit 後の SAH コスト ÷ 構築時の SAH コスト。</summary>
+    float GetQualityRatio() const { return buildCost_ > 0.0f ? currentCost_ / buildCost_ : 1.0f; }
+
+    /// <summary>ノード列（[0] が根）。</summary>
+    const std::vector<Node> &GetNodes() const { return nodes_; }
+
+    /// <summary>葉の範囲が指すプリミティブ番号の並び。</summary>
+    const std::vector<uint32_t> &GetPrimitiveIndices() const { return primIndices_; }
+
+    /// <summary>プリミティブ数。</summary>
+    uint32_t GetPrimitiveCount() const { return static_cast<uint32_t>(primIndices_.size()); }
+
+private:
+    /// <summary>構築中のプリミティブ（番号越しに参照せず、これ自体を並べ替えて連続アクセスにする）。</summary>
+    struct PrimRef {
+        Aabb bounds;
+        uint32_t index = 0;
+    };
+
+    /// <summary>構築中だけ使う共有データ。</summary>
+    struct BuildContext {
+        std::vector<PrimRef> refs;
+        std::atomic<uint32_t> nodeCount{0};
+        JobSystem *jobs = nullptr;
+    };
+
+    /// <summary>
+    /// ノードを作り、必要なら分割して子を作る。bounds / centroidBounds は [begin, end) の
+    /// 境界箱と重心の範囲（親の分割時に求めたものを受け取り、ノードごとの集計を省く）。
+    /// </summary>
+    void BuildNode(BuildContext &ctx, uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth,
+        const Aabb &bounds, const Aabb &centroidBounds);
+
+    /// <summary>refs の [begin, end) の境界箱と重心の範囲を求める。</summary>
+    static void ComputeRange(const BuildContext &ctx, uint32_t begin, uint32_t end, Aabb &outBounds, Aabb &outCentroids);
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> primIndices_;
+    std::vector<Aabb> primBounds_; // primIndices_ と同じ並びの境界箱（葉の中の判定を連続アクセスにする）
+    float buildCost_ = 0.0f;
+    float currentCost_ = 0.0f;
+};
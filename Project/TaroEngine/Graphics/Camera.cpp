@@ -1,4 +1,5 @@
 #include "Camera.h"
+#include "Bvh.h"
 #include <cmath>
 
 namespace {
@@ -7,6 +8,16 @@ namespace {
         if (len <= 0.0f) return Vector3(0, 0, 0);
         return Vector3(v.x / len, v.y / len, v.z / len);
     }
+
+    // 行ベクトル (x, y, z, 1) * m を w で割る
+    inline Vector3 TransformCoord(const Vector3 &v, const Matrix4x4 &m) {
+        const float x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0];
+        const float y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1];
+        const float z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2];
+        const float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3];
+        const float invW = (w != 0.0f) ? 1.0f / w : 0.0f;
+        return Vector3(x * invW, y * invW, z * invW);
+    }
 }
 
 void Camera::Initialize(float viewportWidth, float viewportHeight, float fovYRadians, float nearZ, float farZ) {
@@ -105,9 +116,28 @@ void Camera::Recalculate_() {
 
     // ViewProjection
     viewProj_ = MatrixUtil::Multiply(view_, proj_);
+
+    // 視錐台（カリング用）
+    frustum_ = Frustum::FromViewProjection(viewProj_);
     dirty_ = false;
 }
 
+size_t Camera::QueryVisible(const Bvh &bvh, std::vector<uint32_t> &out) const {
+    return bvh.QueryFrustum(frustum_, out);
+}
+
+bool Camera::ScreenPointToRay(float ndcX, float ndcY, Vector3 &origin, Vector3 &direction) const {
+    Matrix4x4 invViewProj;
+    if (!MatrixUtil::Inverse(viewProj_, invViewProj)) return false;
+
+    // D3D の深度は 0（ニア）〜 1（ファー）
+    const Vector3 nearPoint = TransformCoord(Vector3(ndcX, ndcY, 0.0f), invViewProj);
+    const Vector3 farPoint = TransformCoord(Vector3(ndcX, ndcY, 1.0f), invViewProj);
+    origin = nearPoint;
+    direction = Normalize(Vector3(farPoint.x - nearPoint.x, farPoint.y - nearPoint.y, farPoint.z - nearPoint.z));
+    return true;
+}
+
 void Camera::ApplyYawPitch_(float yaw, float pitch) {
     // forward（左手）: +Z 前、Yaw+ で左回り、Pitch+ で上向き
     float cy = std::cos(yaw), sy = std::sin(yaw);
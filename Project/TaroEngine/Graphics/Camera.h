@@ -1,7 +1,12 @@
 #pragma once
+#include "Frustum.h"
 #include "Matrix4x4.h"
 #include "Vector3.h"
 #include "MatrixUtil.h"
+#include <cstdint>
+#include <vector>
+
+class Bvh;
 
 /// <summary>
 /// 3D カメラ。位置 / 注視点 / 上方向 とレンズパラメータ（FOV / アスペクト / 近遠）から
@@ -89,6 +94,45 @@ public:
     /// <summary>ViewProjection 行列を取得。</summary>
     const Matrix4x4 &GetViewProjection() const { return viewProj_; }
 
+    /// <summary>視錐台（ワールド空間）を取得。</summary>
+    const Frustum &GetFrustum() const { return frustum_; }
+
+    /// <summary>
+    /// 境界球（SoA）を視錐台で判定し、見えるものの番号を詰めて書き出す。
+    /// </summary>
+    /// <param name="in">ワールド空間の境界球。</param>
+    /// <param name="outVisible">書き出し先（in.count 要素分の容量が必要）。</param>
+    /// <returns>見えた数。</returns>
+    size_t CullSpheres(const FrustumCulling::SphereStreams &in, uint32_t *outVisible) const {
+        return FrustumCulling::CullSpheres(frustum_, in, outVisible);
+    }
+
+    /// <summary>
+    /// AABB（SoA）を視錐台で判定し、見えるものの番号を詰めて書き出す。
+    /// </summary>
+    /// <param name="in">ワールド空間の AABB。</param>
+    /// <param name="outVisible">書き出し先（in.count 要素分の容量が必要）。</param>
+    /// <returns>見えた数。</returns>
+    size_t CullAabbs(const FrustumCulling::AabbStreams &in, uint32_t *outVisible) const {
+        return FrustumCulling::CullAabbs(frustum_, in, outVisible);
+    }
+
+    /// <summary>
+    /// BVH から視錐台に入るプリミティブの番号を out の末尾に追加する。
+    /// </summary>
+    /// <returns>追加した数。</returns>
+    size_t QueryVisible(const Bvh &bvh, std::vector<uint32_t> &out) const;
+
+    /// <summary>
+    /// 画面上の点を通るワールド空間のレイを求める（Bvh::Raycast でのピッキング用）。
+    /// </summary>
+    /// <param name="ndcX">正規化デバイス座標の X（左 -1 〜 右 +1）。</param>
+    /// <param name="ndcY">正規化デバイス座標の Y（下 -1 〜 上 +1）。</param>
+    /// <param name="origin">ニア平面上の点。</param>
+    /// <param name="direction">ファー平面へ向かう単位ベクトル。</param>
+    /// <returns>ViewProjection が逆行列を持たなければ false。</returns>
+    bool ScreenPointToRay(float ndcX, float ndcY, Vector3 &origin, Vector3 &direction) const;
+
     /// <summary>FOV（ラジアン）を取得。</summary>
     float GetFovY() const { return fovY_; }
 
@@ -116,11 +160,12 @@ private:
     Matrix4x4 view_ = MatrixUtil::MakeIdentityMatrix();
     Matrix4x4 proj_ = MatrixUtil::MakeIdentityMatrix();
     Matrix4x4 viewProj_ = MatrixUtil::MakeIdentityMatrix();
+    Frustum frustum_ = Frustum::FromViewProjection(viewProj_);
 
     bool dirty_ = true;
 
     /// <summary>
-    /// 内部計算：View/Proj/ViewProj を再生成。
+    /// 内部計算：View/Proj/ViewProj と視錐台を再生成。
     /// </summary>
     void Recalculate_();
 
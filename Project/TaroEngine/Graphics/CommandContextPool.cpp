@@ -0,0 +1,93 @@
+#include "CommandContextPool.h"
+#include <algorithm>
+#include <cassert>
+
+void CommandContextPool::Initialize(ICommandContextBackend *backend) {
+    assert(backend);
+    backend_ = backend;
+}
+
+void CommandContextPool::Finalize() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(recording_.empty() && submitted_.empty());
+    inFlight_.clear();
+    free_.clear();
+    contexts_.clear();
+}
+
+CommandContext *CommandContextPool::Acquire(uint32_t order) {
+    assert(backend_);
+    CommandContext *context = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            context = free_.back();
+            free_.pop_back();
+        } else {
+            contexts_.push_back(backend_->CreateContext());
+            context = contexts_.back().get();
+        }
+        context->order_ = order;
+        context->sequence_ = nextSequence_++;
+        context->fenceValue_ = 0;
+        recording_.push_back(context);
+    }
+
+    // リセットは借りたスレッドで行う（他のスレッドの記録を止めない）
+    backend_->BeginRecording(*context);
+    return context;
+}
+
+uint32_t CommandContextPool::Submit() {
+    std::vector<CommandContext *> contexts;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        contexts.swap(recording_);
+    }
+    if (contexts.empty()) return 0;
+
+    std::sort(contexts.begin(), contexts.end(), [](const CommandContext *a, const CommandContext *b) {
+        return a->order_ != b->order_ ? a->order_ < b->order_ : a->sequence_ < b->sequence_;
+    });
+    for (CommandContext *context : contexts) {
+        backend_->EndRecording(*context);
+    }
+    backend_->Execute(contexts.data(), static_cast<uint32_t>(contexts.size()));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    submitted_.insert(submitted_.end(), contexts.begin(), contexts.end());
+    return static_cast<uint32_t>(contexts.size());
+}
+
+void CommandContextPool::FinishFrame(uint64_t fenceValue) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(inFlight_.empty() || inFlight_.back()->fenceValue_ <= fenceValue);
+    for (CommandContext *context : submitted_) {
+        context->fenceValue_ = fenceValue;
+        inFlight_.push_back(context);
+    }
+    submitted_.clear();
+}
+
+void CommandContextPool::Reclaim(uint64_t completedFenceValue) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!inFlight_.empty() && inFlight_.front()->fenceValue_ <= completedFenceValue) {
+        free_.push_back(inFlight_.front());
+        inFlight_.pop_front();
+    }
+}
+
+size_t CommandContextPool::GetCreatedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return contexts_.size();
+}
+
+size_t CommandContextPool::GetFreeCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+}
+
+size_t CommandContextPool::GetInFlightCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return submitted_.size() + inFlight_.size();
+}
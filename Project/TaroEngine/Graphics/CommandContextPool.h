@@ -0,0 +1,86 @@
+#pragma once
+#include "ICommandContextBackend.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// コマンドの記録先（アロケータ＋リスト）をスレッドごとに貸し出し、フェンスで回収して使い回すプール。<br/>
+/// 各スレッドは Acquire で自分専用のコンテキストを受け取って並行に記録し、
+/// フレーム末尾の Submit で order 順に並べて 1 回の実行にまとめる。
+/// </summary>
+/// <remarks>
+/// 使い方は FencedRingAllocator と同じく
+/// Acquire（任意スレッド）→ Submit → FinishFrame(シグナルしたフェンス値)
+/// → 次フレーム開始時に Reclaim(GPU 完了済みのフェンス値)。<br/>
+/// - Submit は Acquire したスレッドの記録がすべて終わってから呼ぶこと。<br/>
+/// - 提出順は order の昇順。同じ order どうしは取得順になり、スレッド間では決まらないので、
+///   順序が意味を持つパスには別々の order を与えること。
+/// </remarks>
+class CommandContextPool {
+public:
+    /// <summary>フレームの先頭（バックバッファの遷移・クリア）に使う order。</summary>
+    static constexpr uint32_t kOrderFrameBegin = 0;
+
+    /// <summary>フレームの末尾（UI・Present への遷移）に使う order。</summary>
+    static constexpr uint32_t kOrderFrameEnd = UINT32_MAX;
+
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="backend">バックエンド（プールより長く生存すること）。</param>
+    void Initialize(ICommandContextBackend *backend);
+
+    /// <summary>
+    /// すべてのコンテキストを破棄する（GPU の完了を待ってから呼ぶこと）。
+    /// </summary>
+    void Finalize();
+
+    /// <summary>
+    /// 記録を始めたコンテキストを借りる（どのスレッドからでも呼べる）。
+    /// </summary>
+    /// <param name="order">提出順のキー。</param>
+    /// <returns>呼び出したスレッド専用のコンテキスト（Submit で閉じられる）。</returns>
+    CommandContext *Acquire(uint32_t order);
+
+    /// <summary>
+    /// 借りているコンテキストをすべて閉じ、order 順に 1 回で実行する。
+    /// </summary>
+    /// <returns>実行したコンテキスト数。</returns>
+    uint32_t Submit();
+
+    /// <summary>
+    /// 直前の Submit 分に、完了を示すフェンス値を結び付ける。
+    /// </summary>
+    /// <param name="fenceValue">Submit の後にシグナルしたフェンス値。</param>
+    void FinishFrame(uint64_t fenceValue);
+
+    /// <summary>
+    /// GPU が完了したコンテキストを再利用できるよう戻す。
+    /// </summary>
+    /// <param name="completedFenceValue">GPU が完了したフェンス値。</param>
+    void Reclaim(uint64_t completedFenceValue);
+
+    /// <summary>これまでに作ったコンテキスト数。</summary>
+    size_t GetCreatedCount() const;
+
+    /// <summary>すぐに貸し出せるコンテキスト数。</summary>
+    size_t GetFreeCount() const;
+
+    /// <summary>GPU の完了待ちのコンテキスト数（提出済み・フェンス未設定を含む）。</summary>
+    size_t GetInFlightCount() const;
+
+private:
+    ICommandContextBackend *backend_ = nullptr;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<CommandContext>> contexts_; // 所有する全コンテキスト
+    std::vector<CommandContext *> free_;                   // 貸し出せるもの
+    std::vector<CommandContext *> recording_;              // 貸し出し中
+    std::vector<CommandContext *> submitted_;              // 提出済みでフェンス未設定
+    std::deque<CommandContext *> inFlight_;                // フェンス値の昇順
+    uint64_t nextSequence_ = 0;
+};
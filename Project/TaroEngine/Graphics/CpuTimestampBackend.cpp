@@ -0,0 +1,45 @@
+#include "CpuTimestampBackend.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <utility>
+
+CpuTimestampBackend::CpuTimestampBackend(uint32_t frameSlotCount, uint32_t maxQueriesPerFrame)
+    : CpuTimestampBackend(frameSlotCount, maxQueriesPerFrame, [] {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }, 1000000000ull) {
+}
+
+CpuTimestampBackend::CpuTimestampBackend(uint32_t frameSlotCount, uint32_t maxQueriesPerFrame, Clock clock,
+    uint64_t frequency)
+    : frameSlotCount_(frameSlotCount),
+      maxQueriesPerFrame_(maxQueriesPerFrame),
+      clock_(std::move(clock)),
+      frequency_(frequency),
+      written_(static_cast<size_t>(frameSlotCount) * maxQueriesPerFrame),
+      resolved_(static_cast<size_t>(frameSlotCount) * maxQueriesPerFrame),
+      resolvedCount_(frameSlotCount) {
+    assert(frameSlotCount > 0 && maxQueriesPerFrame > 0);
+    assert(clock_ && frequency_ > 0);
+}
+
+void CpuTimestampBackend::WriteTimestamp(uint32_t frameSlot, uint32_t queryIndex) {
+    assert(frameSlot < frameSlotCount_ && queryIndex < maxQueriesPerFrame_);
+    written_[static_cast<size_t>(frameSlot) * maxQueriesPerFrame_ + queryIndex] = clock_();
+}
+
+void CpuTimestampBackend::ResolveFrame(uint32_t frameSlot, uint32_t queryCount) {
+    assert(frameSlot < frameSlotCount_ && queryCount <= maxQueriesPerFrame_);
+    const size_t base = static_cast<size_t>(frameSlot) * maxQueriesPerFrame_;
+    std::copy_n(written_.begin() + base, queryCount, resolved_.begin() + base);
+    resolvedCount_[frameSlot] = queryCount;
+}
+
+bool CpuTimestampBackend::ReadFrame(uint32_t frameSlot, uint32_t queryCount, uint64_t *out) {
+    assert(frameSlot < frameSlotCount_ && out);
+    if (queryCount > resolvedCount_[frameSlot]) return false;
+    const size_t base = static_cast<size_t>(frameSlot) * maxQueriesPerFrame_;
+    std::copy_n(resolved_.begin() + base, queryCount, out);
+    return true;
+}
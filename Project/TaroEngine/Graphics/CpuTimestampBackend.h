@@ -0,0 +1,51 @@
+#pragma once
+#include "IGpuTimestampBackend.h"
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// CPU の時計でタイムスタンプを取る IGpuTimestampBackend の代替実装。<br/>
+/// GPU のない環境や、時計を差し替えて GpuProfiler の集計を確かめるときに使う。
+/// </summary>
+/// <remarks>
+/// GPU と同じく ResolveFrame した値だけが ReadFrame で見えるので、
+/// 解決前のスロットを読むといった使い方の誤りもそのまま再現される。
+/// </remarks>
+class CpuTimestampBackend : public IGpuTimestampBackend {
+public:
+    /// <summary>時刻（tick）を返す関数。</summary>
+    using Clock = std::function<uint64_t()>;
+
+    /// <summary>
+    /// コンストラクタ（steady_clock のナノ秒を使う）。
+    /// </summary>
+    /// <param name="frameSlotCount">フレームスロット数。</param>
+    /// <param name="maxQueriesPerFrame">1 フレームのタイムスタンプ数。</param>
+    CpuTimestampBackend(uint32_t frameSlotCount, uint32_t maxQueriesPerFrame);
+
+    /// <summary>
+    /// コンストラクタ（時計を指定する）。
+    /// </summary>
+    /// <param name="frameSlotCount">フレームスロット数。</param>
+    /// <param name="maxQueriesPerFrame">1 フレームのタイムスタンプ数。</param>
+    /// <param name="clock">時刻を返す関数。</param>
+    /// <param name="frequency">clock の 1 秒あたりの tick 数。</param>
+    CpuTimestampBackend(uint32_t frameSlotCount, uint32_t maxQueriesPerFrame, Clock clock, uint64_t frequency);
+
+    uint32_t GetFrameSlotCount() const override { return frameSlotCount_; }
+    uint32_t GetMaxQueriesPerFrame() const override { return maxQueriesPerFrame_; }
+    uint64_t GetFrequency() const override { return frequency_; }
+
+    void WriteTimestamp(uint32_t frameSlot, uint32_t queryIndex) override;
+    void ResolveFrame(uint32_t frameSlot, uint32_t queryCount) override;
+    bool ReadFrame(uint32_t frameSlot, uint32_t queryCount, uint64_t *out) override;
+
+private:
+    uint32_t frameSlotCount_ = 0;
+    uint32_t maxQueriesPerFrame_ = 0;
+    Clock clock_;
+    uint64_t frequency_ = 0;
+    std::vector<uint64_t> written_;  // 書き込まれた値（クエリヒープ相当）
+    std::vector<uint64_t> resolved_; // 解決済みの値（読み出しバッファ相当）
+    std::vector<uint32_t> resolvedCount_;
+};
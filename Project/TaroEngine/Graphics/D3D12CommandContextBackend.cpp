@@ -0,0 +1,48 @@
+#include "D3D12CommandContextBackend.h"
+#include <cassert>
+#include <vector>
+
+void D3D12CommandContextBackend::Initialize(ID3D12Device *device, ID3D12CommandQueue *queue) {
+    assert(device && queue);
+    device_ = device;
+    queue_ = queue;
+}
+
+std::unique_ptr<CommandContext> D3D12CommandContextBackend::CreateContext() {
+    assert(device_);
+    auto context = std::make_unique<D3D12CommandContext>();
+
+    HRESULT hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+        IID_PPV_ARGS(&context->allocator_));
+    assert(SUCCEEDED(hr));
+    hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, context->allocator_.Get(), nullptr,
+        IID_PPV_ARGS(&context->commandList_));
+    assert(SUCCEEDED(hr));
+
+    // 作成直後は記録中なので閉じておく（BeginRecording でリセットする）
+    context->commandList_->Close();
+    return context;
+}
+
+void D3D12CommandContextBackend::BeginRecording(CommandContext &context) {
+    auto &d3d = static_cast<D3D12CommandContext &>(context);
+    HRESULT hr = d3d.allocator_->Reset();
+    assert(SUCCEEDED(hr));
+    hr = d3d.commandList_->Reset(d3d.allocator_.Get(), nullptr);
+    assert(SUCCEEDED(hr));
+}
+
+void D3D12CommandContextBackend::EndRecording(CommandContext &context) {
+    auto &d3d = static_cast<D3D12CommandContext &>(context);
+    HRESULT hr = d3d.commandList_->Close();
+    assert(SUCCEEDED(hr));
+}
+
+void D3D12CommandContextBackend::Execute(CommandContext *const *contexts, uint32_t count) {
+    assert(queue_);
+    std::vector<ID3D12CommandList *> lists(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        lists[i] = static_cast<D3D12CommandContext *>(contexts[i])->GetCommandList();
+    }
+    queue_->ExecuteCommandLists(count, lists.data());
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "ICommandContextBackend.h"
+#include <d3d12.h>
+#include <wrl.h>
+
+/// <summary>
+/// D3D12 のコマンドアロケータとコマンドリストの組。
+/// </summary>
+class D3D12CommandContext : public CommandContext {
+public:
+    /// <summary>記録先のコマンドリストを取得する。</summary>
+    ID3D12GraphicsCommandList *GetCommandList() const { return commandList_.Get(); }
+
+private:
+    friend class D3D12CommandContextBackend;
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator_;
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList_;
+};
+
+/// <summary>
+/// DIRECT キューにコマンドリストを提出する ICommandContextBackend。
+/// </summary>
+class D3D12CommandContextBackend : public ICommandContextBackend {
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="device">D3D12 デバイス。</param>
+    /// <param name="queue">提出先の DIRECT キュー。</param>
+    void Initialize(ID3D12Device *device, ID3D12CommandQueue *queue);
+
+    std::unique_ptr<CommandContext> CreateContext() override;
+    void BeginRecording(CommandContext &context) override;
+    void EndRecording(CommandContext &context) override;
+    void Execute(CommandContext *const *contexts, uint32_t count) override;
+
+private:
+    ID3D12Device *device_ = nullptr;
+    ID3D12CommandQueue *queue_ = nullptr;
+};
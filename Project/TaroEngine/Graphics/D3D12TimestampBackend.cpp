@@ -0,0 +1,55 @@
+#include "D3D12TimestampBackend.h"
+#include "BufferUtil.h"
+#include <cassert>
+#include <cstring>
+
+void D3D12TimestampBackend::Initialize(ID3D12Device *device, ID3D12CommandQueue *queue, uint32_t frameSlotCount,
+    uint32_t maxQueriesPerFrame) {
+    assert(device && queue);
+    assert(frameSlotCount > 0 && maxQueriesPerFrame > 0);
+    frameSlotCount_ = frameSlotCount;
+    maxQueriesPerFrame_ = maxQueriesPerFrame;
+
+    D3D12_QUERY_HEAP_DESC desc{};
+    desc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    desc.Count = frameSlotCount * maxQueriesPerFrame;
+    HRESULT hr = device->CreateQueryHeap(&desc, IID_PPV_ARGS(&queryHeap_));
+    assert(SUCCEEDED(hr));
+
+    readback_ = BufferUtil::CreateReadbackBuffer(device, sizeof(uint64_t) * desc.Count);
+
+    // 取れない環境では 1 のまま（時間は 0 扱いになる）
+    uint64_t frequency = 0;
+    if (SUCCEEDED(queue->GetTimestampFrequency(&frequency)) && frequency > 0) {
+        frequency_ = frequency;
+    }
+}
+
+void D3D12TimestampBackend::WriteTimestamp(uint32_t frameSlot, uint32_t queryIndex) {
+    assert(commandList_);
+    assert(frameSlot < frameSlotCount_ && queryIndex < maxQueriesPerFrame_);
+    commandList_->EndQuery(queryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, frameSlot * maxQueriesPerFrame_ + queryIndex);
+}
+
+void D3D12TimestampBackend::ResolveFrame(uint32_t frameSlot, uint32_t queryCount) {
+    assert(commandList_);
+    assert(frameSlot < frameSlotCount_ && queryCount <= maxQueriesPerFrame_);
+    const uint32_t first = frameSlot * maxQueriesPerFrame_;
+    commandList_->ResolveQueryData(queryHeap_.Get(), D3D12_QUERY_TYPE_TIMESTAMP, first, queryCount,
+        readback_.Get(), sizeof(uint64_t) * first);
+}
+
+bool D3D12TimestampBackend::ReadFrame(uint32_t frameSlot, uint32_t queryCount, uint64_t *out) {
+    assert(frameSlot < frameSlotCount_ && queryCount <= maxQueriesPerFrame_ && out);
+    const SIZE_T begin = sizeof(uint64_t) * frameSlot * maxQueriesPerFrame_;
+    D3D12_RANGE readRange{begin, begin + sizeof(uint64_t) * queryCount};
+
+    void *mapped = nullptr;
+    if (FAILED(readback_->Map(0, &readRange, &mapped))) return false;
+    std::memcpy(out, static_cast<const uint8_t *>(mapped) + begin, sizeof(uint64_t) * queryCount);
+
+    // CPU からは書いていない
+    D3D12_RANGE writtenRange{0, 0};
+    readback_->Unmap(0, &writtenRange);
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "IGpuTimestampBackend.h"
+#include <d3d12.h>
+#include <wrl.h>
+
+/// <summary>
+/// D3D12 のタイムスタンプクエリを使う IGpuTimestampBackend。<br/>
+/// クエリヒープとリードバックバッファをフレームスロット数ぶんに区切って使う。
+/// </summary>
+class D3D12TimestampBackend : public IGpuTimestampBackend {
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="device">D3D12 デバイス。</param>
+    /// <param name="queue">計測するコマンドを実行するキュー（周波数の取得に使う）。</param>
+    /// <param name="frameSlotCount">フレームスロット数（バックバッファ数）。</param>
+    /// <param name="maxQueriesPerFrame">1 フレームのタイムスタンプ数。</param>
+    void Initialize(ID3D12Device *device, ID3D12CommandQueue *queue, uint32_t frameSlotCount,
+        uint32_t maxQueriesPerFrame);
+
+    /// <summary>
+    /// タイムスタンプを積むコマンドリストを設定する（フレーム開始時に呼ぶ）。
+    /// </summary>
+    void SetCommandList(ID3D12GraphicsCommandList *commandList) { commandList_ = commandList; }
+
+    uint32_t GetFrameSlotCount() const override { return frameSlotCount_; }
+    uint32_t GetMaxQueriesPerFrame() const override { return maxQueriesPerFrame_; }
+    uint64_t GetFrequency() const override { return frequency_; }
+
+    void WriteTimestamp(uint32_t frameSlot, uint32_t queryIndex) override;
+    void ResolveFrame(uint32_t frameSlot, uint32_t queryCount) override;
+    bool ReadFrame(uint32_t frameSlot, uint32_t queryCount, uint64_t *out) override;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12QueryHeap> queryHeap_;
+    Microsoft::WRL::ComPtr<ID3D12Resource> readback_;
+    ID3D12GraphicsCommandList *commandList_ = nullptr;
+    uint32_t frameSlotCount_ = 0;
+    uint32_t maxQueriesPerFrame_ = 0;
+    uint64_t frequency_ = 1;
+};
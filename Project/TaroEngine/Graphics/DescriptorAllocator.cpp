@@ -0,0 +1,54 @@
+#include "DescriptorAllocator.h"
+#include <cassert>
+
+void DescriptorAllocator::Initialize(ID3D12Device *device, D3D12_DESCRIPTOR_HEAP_TYPE type,
+    uint32_t persistentCount, uint32_t transientCount, bool shaderVisible) {
+    assert(device);
+
+    indices_.Initialize(persistentCount, transientCount);
+
+    D3D12_DESCRIPTOR_HEAP_DESC desc{};
+    desc.Type = type;
+    desc.NumDescriptors = indices_.GetTotalCount();
+    desc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE
+                               : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+    heap_.Reset();
+    HRESULT hr = device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap_));
+    assert(SUCCEEDED(hr));
+    (void)hr;
+
+    shaderVisible_ = shaderVisible;
+    incrementSize_ = device->GetDescriptorHandleIncrementSize(type);
+    cpuStart_ = heap_->GetCPUDescriptorHandleForHeapStart();
+    gpuStart_ = shaderVisible ? heap_->GetGPUDescriptorHandleForHeapStart() : D3D12_GPU_DESCRIPTOR_HANDLE{};
+}
+
+DescriptorAllocator::Handle DescriptorAllocator::AllocatePersistent() {
+    const uint32_t index = indices_.AllocatePersistent();
+    assert(index != DescriptorIndexAllocator::kInvalidIndex && "DescriptorAllocator: persistent slots exhausted");
+    return MakeHandle(index);
+}
+
+void DescriptorAllocator::Free(const Handle &handle) {
+    if (!handle.IsValid()) return;
+    indices_.FreePersistent(handle.index);
+}
+
+DescriptorAllocator::Handle DescriptorAllocator::AllocateTransient(uint32_t count) {
+    const uint32_t index = indices_.AllocateTransient(count);
+    assert(index != DescriptorIndexAllocator::kInvalidIndex && "DescriptorAllocator: transient slots exhausted");
+    return MakeHandle(index);
+}
+
+DescriptorAllocator::Handle DescriptorAllocator::MakeHandle(uint32_t index) const {
+    Handle h;
+    if (index == DescriptorIndexAllocator::kInvalidIndex) return h;
+
+    h.index = index;
+    h.cpu = GetCPUHandle(index);
+    if (shaderVisible_) {
+        h.gpu = GetGPUHandle(index);
+    }
+    return h;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "DescriptorIndexAllocator.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <wrl.h>
+
+/// <summary>
+/// 1 つのディスクリプタヒープを永続スロット／フレーム一時スロットに分けて払い出すアロケータ。<br/>
+/// スロット番号の管理は DescriptorIndexAllocator に任せ、本クラスはヒープとハンドル計算を受け持つ。
+/// </summary>
+class DescriptorAllocator {
+public:
+    /// <summary>
+    /// 払い出したスロット。
+    /// </summary>
+    struct Handle {
+        uint32_t index = DescriptorIndexAllocator::kInvalidIndex; // ヒープ先頭からのインデックス
+        D3D12_CPU_DESCRIPTOR_HANDLE cpu{};                         // CPU ハンドル
+        D3D12_GPU_DESCRIPTOR_HANDLE gpu{};                         // GPU ハンドル（シェーダ可視のときのみ）
+
+        /// <summary>有効なスロットか。</summary>
+        bool IsValid() const { return index != DescriptorIndexAllocator::kInvalidIndex; }
+    };
+
+public:
+    /// <summary>
+    /// 初期化処理。ヒープを生成し、インクリメントサイズを取得しておく。
+    /// </summary>
+    /// <param name="device">D3D12 デバイス。</param>
+    /// <param name="type">ヒープ種別。</param>
+    /// <param name="persistentCount">永続スロット数。</param>
+    /// <param name="transientCount">一時スロット数。</param>
+    /// <param name="shaderVisible">シェーダ可視にするか。</param>
+    void Initialize(ID3D12Device *device, D3D12_DESCRIPTOR_HEAP_TYPE type,
+        uint32_t persistentCount, uint32_t transientCount, bool shaderVisible);
+
+    /// <summary>
+    /// 永続スロットを 1 つ確保する（テクスチャ SRV など）。<br/>
+    /// ヒープは拡張しないので、満杯は Debug では assert で止める。
+    /// </summary>
+    /// <returns>確保したスロット。満杯なら無効なハンドル（Release 時）。</returns>
+    Handle AllocatePersistent();
+
+    /// <summary>
+    /// 永続スロットを解放する。<br/>
+    /// GPU が参照中でないことは呼び出し側で保証すること。
+    /// </summary>
+    /// <param name="handle">AllocatePersistent で得たスロット。</param>
+    void Free(const Handle &handle);
+
+    /// <summary>
+    /// このフレームだけ使う連続スロットを確保する。<br/>
+    /// FinishFrame で渡したフェンスの完了後に自動で再利用される。
+    /// </summary>
+    /// <param name="count">スロット数。</param>
+    /// <returns>先頭スロット。空きが足りなければ無効なハンドル（Debug では assert で止める）。</returns>
+    Handle AllocateTransient(uint32_t count);
+
+    /// <summary>現在のフレームを締める（フェンス Signal の直後に呼ぶ）。</summary>
+    /// <param name="fenceValue">シグナルしたフェンス値。</param>
+    void FinishFrame(uint64_t fenceValue) { indices_.FinishFrame(fenceValue); }
+
+    /// <summary>GPU 完了済みフレームの一時スロットを回収する。</summary>
+    /// <param name="completedFenceValue">完了済みのフェンス値。</param>
+    void Reclaim(uint64_t completedFenceValue) { indices_.Reclaim(completedFenceValue); }
+
+    /// <summary>インデックスから CPU ハンドルを求める。</summary>
+    D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(uint32_t index) const {
+        return {cpuStart_.ptr + static_cast<SIZE_T>(index) * incrementSize_};
+    }
+
+    /// <summary>インデックスから GPU ハンドルを求める。</summary>
+    D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(uint32_t index) const {
+        return {gpuStart_.ptr + static_cast<UINT64>(index) * incrementSize_};
+    }
+
+    /// <summary>ヒープを取得する。</summary>
+    ID3D12DescriptorHeap *GetHeap() const { return heap_.Get(); }
+
+    /// <summary>ディスクリプタ 1 つぶんのバイト数を取得する。</summary>
+    UINT GetIncrementSize() const { return incrementSize_; }
+
+    /// <summary>使用状況を取得する。</summary>
+    DescriptorIndexAllocator::Stats GetStats() const { return indices_.GetStats(); }
+
+private:
+    /// <summary>インデックスからハンドルを組み立てる。</summary>
+    Handle MakeHandle(uint32_t index) const;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap_;
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuStart_{};
+    D3D12_GPU_DESCRIPTOR_HANDLE gpuStart_{};
+    UINT incrementSize_ = 0; // GetDescriptorHandleIncrementSize は毎回呼ばずキャッシュする
+    bool shaderVisible_ = false;
+
+    DescriptorIndexAllocator indices_;
+};
@@ -0,0 +1,80 @@
+#include "DescriptorIndexAllocator.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+void DescriptorIndexAllocator::Initialize(uint32_t persistentCount, uint32_t transientCount) {
+    assert(transientCount > 0);
+    // インデックスが kInvalidIndex と重ならないこと
+    assert(uint64_t{persistentCount} + transientCount < kInvalidIndex);
+    persistentCount_ = persistentCount;
+    transientCount_ = transientCount;
+
+    usedBits_.assign((persistentCount + 63) / 64, 0);
+    // 末尾語の範囲外ビットは使用中にしておき、探索で拾わないようにする
+    if (const uint32_t rem = persistentCount % 64; rem != 0) {
+        usedBits_.back() = ~((uint64_t{1} << rem) - 1);
+    }
+    searchWord_ = 0;
+    persistentUsed_ = 0;
+    persistentPeak_ = 0;
+
+    transient_.Initialize(transientCount);
+    transientPeak_ = 0;
+    failedAllocations_ = 0;
+}
+
+uint32_t DescriptorIndexAllocator::AllocatePersistent() {
+    const uint32_t wordCount = static_cast<uint32_t>(usedBits_.size());
+    for (uint32_t w = searchWord_; w < wordCount; ++w) {
+        const uint64_t bits = usedBits_[w];
+        if (bits == ~uint64_t{0}) continue;
+
+        const uint32_t bit = static_cast<uint32_t>(std::countr_one(bits));
+        usedBits_[w] = bits | (uint64_t{1} << bit);
+        searchWord_ = w;
+
+        ++persistentUsed_;
+        persistentPeak_ = std::max(persistentPeak_, persistentUsed_);
+        return w * 64 + bit;
+    }
+
+    searchWord_ = wordCount;
+    ++failedAllocations_;
+    return kInvalidIndex;
+}
+
+void DescriptorIndexAllocator::FreePersistent(uint32_t index) {
+    assert(index < persistentCount_);
+    const uint32_t w = index / 64;
+    const uint64_t mask = uint64_t{1} << (index % 64);
+    assert((usedBits_[w] & mask) != 0 && "double free");
+
+    usedBits_[w] &= ~mask;
+    searchWord_ = std::min(searchWord_, w);
+    --persistentUsed_;
+}
+
+uint32_t DescriptorIndexAllocator::AllocateTransient(uint32_t count) {
+    assert(count > 0);
+    const uint64_t offset = transient_.Allocate(count, 1);
+    if (offset == FencedRingAllocator::kInvalidOffset) {
+        ++failedAllocations_;
+        return kInvalidIndex;
+    }
+
+    transientPeak_ = std::max(transientPeak_, static_cast<uint32_t>(transient_.GetUsedSize()));
+    return persistentCount_ + static_cast<uint32_t>(offset);
+}
+
+DescriptorIndexAllocator::Stats DescriptorIndexAllocator::GetStats() const {
+    Stats s;
+    s.persistentCapacity = persistentCount_;
+    s.persistentUsed = persistentUsed_;
+    s.persistentPeak = persistentPeak_;
+    s.transientCapacity = transientCount_;
+    s.transientUsed = static_cast<uint32_t>(transient_.GetUsedSize());
+    s.transientPeak = transientPeak_;
+    s.failedAllocations = failedAllocations_;
+    return s;
+}
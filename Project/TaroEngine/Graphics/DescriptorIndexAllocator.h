@@ -0,0 +1,94 @@
+#pragma once
+#include "FencedRingAllocator.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ディスクリプタヒープのスロット番号を管理する（D3D12 非依存）。<br/>
+/// ヒープを前半の「永続領域」と後半の「一時領域」に分けて扱う。
+/// <list type="bullet">
+/// <item>永続領域：テクスチャ SRV など寿命の長いもの。ビットセットで空きを管理し、個別に解放できる。</item>
+/// <item>一時領域：そのフレームだけ使うもの。リング上を線形に確保し、フェンス完了でフレーム単位に解放する。</item>
+/// </list>
+/// </summary>
+class DescriptorIndexAllocator {
+public:
+    /// <summary>
+    /// 確保失敗を表すインデックス。
+    /// </summary>
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    /// <summary>
+    /// 使用状況（容量見直し用の診断情報）。
+    /// </summary>
+    struct Stats {
+        uint32_t persistentCapacity = 0; // 永続領域のスロット数
+        uint32_t persistentUsed = 0;     // 永続領域の使用数
+        uint32_t persistentPeak = 0;     // 永続領域の最大使用数
+        uint32_t transientCapacity = 0;  // 一時領域のスロット数
+        uint32_t transientUsed = 0;      // 一時領域の使用数（完了待ちフレーム分を含む）
+        uint32_t transientPeak = 0;      // 一時領域の最大使用数
+        uint32_t failedAllocations = 0;  // 容量不足で失敗した回数
+    };
+
+public:
+    /// <summary>
+    /// 初期化処理。容量は固定で、後から増やすことはできない（溢れた確保は kInvalidIndex を返す）。
+    /// </summary>
+    /// <param name="persistentCount">永続領域のスロット数（先頭から）。</param>
+    /// <param name="transientCount">一時領域のスロット数（永続領域の直後から）。</param>
+    void Initialize(uint32_t persistentCount, uint32_t transientCount);
+
+    /// <summary>
+    /// 永続スロットを 1 つ確保する。
+    /// </summary>
+    /// <returns>ヒープ先頭からのインデックス。空きがなければ kInvalidIndex。</returns>
+    uint32_t AllocatePersistent();
+
+    /// <summary>
+    /// 永続スロットを解放する。
+    /// </summary>
+    /// <param name="index">AllocatePersistent で得たインデックス。</param>
+    void FreePersistent(uint32_t index);
+
+    /// <summary>
+    /// 連続した一時スロットを確保する（ディスクリプタテーブル用）。
+    /// </summary>
+    /// <param name="count">スロット数。</param>
+    /// <returns>先頭のインデックス。空きがなければ kInvalidIndex。</returns>
+    uint32_t AllocateTransient(uint32_t count);
+
+    /// <summary>
+    /// 現在のフレームを締める。以降の一時確保は次のフレームとして扱う。
+    /// </summary>
+    /// <param name="fenceValue">このフレームでシグナルしたフェンス値。</param>
+    void FinishFrame(uint64_t fenceValue) { transient_.FinishFrame(fenceValue); }
+
+    /// <summary>
+    /// GPU 完了済みフレームの一時スロットを解放する。
+    /// </summary>
+    /// <param name="completedFenceValue">完了済みのフェンス値。</param>
+    void Reclaim(uint64_t completedFenceValue) { transient_.Reclaim(completedFenceValue); }
+
+    /// <summary>ヒープ全体のスロット数を取得する。</summary>
+    uint32_t GetTotalCount() const { return persistentCount_ + transientCount_; }
+
+    /// <summary>使用状況を取得する。</summary>
+    Stats GetStats() const;
+
+private:
+    uint32_t persistentCount_ = 0;
+    uint32_t transientCount_ = 0;
+
+    // 永続領域：1 ビット = 1 スロット（1 で使用中）
+    std::vector<uint64_t> usedBits_;
+    uint32_t searchWord_ = 0; // 空きを探し始める語（これより前は満杯）
+    uint32_t persistentUsed_ = 0;
+    uint32_t persistentPeak_ = 0;
+
+    // 一時領域：スロット単位のリング
+    FencedRingAllocator transient_;
+    uint32_t transientPeak_ = 0;
+
+    uint32_t failedAllocations_ = 0;
+};
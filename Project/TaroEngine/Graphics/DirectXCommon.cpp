@@ -1,6 +1,7 @@
 #define NOMINMAX
 #include "DirectXCommon.h"
 #include "WinApp.h"
+#include "Profiler.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_dx12.h"
 #include "imgui/imgui_impl_win32.h"
@@ -32,24 +33,36 @@ DirectXCommon::CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type,
 D3D12_CPU_DESCRIPTOR_HANDLE
 DirectXCommon::GetCPUHandle(ID3D12DescriptorHeap *heap, UINT index) const {
   D3D12_CPU_DESCRIPTOR_HANDLE h = heap->GetCPUDescriptorHandleForHeapStart();
-  h.ptr += static_cast<SIZE_T>(index) *
-           device_->GetDescriptorHandleIncrementSize(heap->GetDesc().Type);
+  h.ptr += static_cast<SIZE_T>(index) * GetDescriptorSize(heap->GetDesc().Type);
   return h;
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE
 DirectXCommon::GetGPUHandle(ID3D12DescriptorHeap *heap, UINT index) const {
   D3D12_GPU_DESCRIPTOR_HANDLE h = heap->GetGPUDescriptorHandleForHeapStart();
-  h.ptr += static_cast<UINT64>(index) *
-           device_->GetDescriptorHandleIncrementSize(heap->GetDesc().Type);
+  h.ptr += static_cast<UINT64>(index) * GetDescriptorSize(heap->GetDesc().Type);
   return h;
 }
 
+UINT DirectXCommon::GetDescriptorSize(D3D12_DESCRIPTOR_HEAP_TYPE type) const {
+  switch (type) {
+  case D3D12_DESCRIPTOR_HEAP_TYPE_RTV:
+    return descriptorSizeRTV_;
+  case D3D12_DESCRIPTOR_HEAP_TYPE_DSV:
+    return descriptorSizeDSV_;
+  case D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV:
+    return descriptorSizeSRV_;
+  default:
+    return device_->GetDescriptorHandleIncrementSize(type);
+  }
+}
+
 // =====================================
 // 同期
 // =====================================
 
 void DirectXCommon::WaitForFrame(UINT frameIndex) {
+  TARO_PROFILE_SCOPE("DirectXCommon::WaitForFrame");
   const uint64_t fenceValue = fenceValues_[frameIndex];
   if (fenceValue == 0)
     return; // まだ Signal していない
@@ -98,7 +111,7 @@ void DirectXCommon::Initialize(WinApp *winApp) {
 #endif
 
   // 初期化シーケンス
-  InitializeFixFPS();
+  InitializeFramePacer();
   InitializeDevice();
   InitializeCommand();
   InitializeSwapChain();
@@ -108,6 +121,8 @@ void DirectXCommon::Initialize(WinApp *winApp) {
   InitializeRenderTargetViews();
   InitializeDepthStencilView();
   InitializeFence();
+  InitializeUploadRing();
+  InitializeGpuProfiler();
   InitializeViewport();
   InitializeScissorRect();
   InitializeDXCCompiler();
@@ -117,29 +132,64 @@ void DirectXCommon::Initialize(WinApp *winApp) {
 void DirectXCommon::Finalize() {
   // 終了前にフラッシュ（未完了の仕事を待つ）
   WaitForGpu();
+  commandContexts_.Reclaim(fence_->GetCompletedValue());
+  commandContexts_.Finalize();
 
   // ImGui 終了
   ImGui_ImplDX12_Shutdown();
   ImGui_ImplWin32_Shutdown();
   ImGui::DestroyContext();
+  srvAllocator_.Free(imguiFontSrv_);
+  imguiFontSrv_ = {};
 
   if (fenceEvent_) {
     CloseHandle(fenceEvent_);
     fenceEvent_ = nullptr;
   }
+  if (frameLatencyWaitable_) {
+    CloseHandle(frameLatencyWaitable_);
+    frameLatencyWaitable_ = nullptr;
+  }
+}
+
+ID3D12GraphicsCommandList *DirectXCommon::AcquireCommandList(uint32_t order) {
+  auto *context =
+      static_cast<D3D12CommandContext *>(commandContexts_.Acquire(order));
+  ID3D12GraphicsCommandList *list = context->GetCommandList();
+
+  // 描画先・ヒープ・VP/Scissor はフレーム中に変わらないので、どのスレッドから読んでもよい
+  D3D12_CPU_DESCRIPTOR_HANDLE dsv =
+      dsvHeap_->GetCPUDescriptorHandleForHeapStart();
+  list->OMSetRenderTargets(1, &rtvHandles_[currentBackBufferIndex_], FALSE,
+                           &dsv);
+  ID3D12DescriptorHeap *heaps[] = {srvAllocator_.GetHeap()};
+  list->SetDescriptorHeaps(1, heaps);
+  list->RSSetViewports(1, &viewport_);
+  list->RSSetScissorRects(1, &scissorRect_);
+  return list;
 }
 
 void DirectXCommon::PreDraw(const float clearColor[4]) {
+  TARO_PROFILE_SCOPE("DirectXCommon::PreDraw");
   // 最小化中は何もしない
   if (width_ == 0 || height_ == 0)
     return;
 
+  // スワップチェーンが次のフレームを受け付けるまで待つ（先行しすぎて遅延が溜まらないように）
+  WaitForFrameLatency();
+
   // 今回使うバックバッファ
   currentBackBufferIndex_ = swapChain_->GetCurrentBackBufferIndex();
 
   // このフレームに対応するアロケータが空くまで（必要なら）待機
   WaitForFrame(currentBackBufferIndex_);
 
+  // GPU が使い終えたフレームの Upload 領域を回収
+  const uint64_t completedFence = fence_->GetCompletedValue();
+  uploadRing_.Reclaim(completedFence);
+  srvAllocator_.Reclaim(completedFence);
+  commandContexts_.Reclaim(completedFence);
+
   // Present -> RenderTarget 遷移
   D3D12_RESOURCE_BARRIER barrier{};
   barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
@@ -147,32 +197,23 @@ void DirectXCommon::PreDraw(const float clearColor[4]) {
   barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
   barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
 
-  // 今回のアロケータでリセット
-  auto *allocator = commandAllocators_[currentBackBufferIndex_].Get();
-  allocator->Reset();
-  commandList_->Reset(allocator, nullptr);
+  // フレーム先頭のリストを借りる（メインスレッドの描画もここに積む）
+  commandList_ = AcquireCommandList(CommandContextPool::kOrderFrameBegin);
+
+  // GPU 計測の開始（このスロットの前回分はフェンス待ち済みなのでここで回収される）
+  gpuTimestamps_.SetCommandList(commandList_);
+  gpuProfiler_.BeginFrame(currentBackBufferIndex_);
+
   commandList_->ResourceBarrier(1, &barrier);
 
-  // RTV/DSV 設定
+  // クリア
   D3D12_CPU_DESCRIPTOR_HANDLE dsv =
       dsvHeap_->GetCPUDescriptorHandleForHeapStart();
-  commandList_->OMSetRenderTargets(1, &rtvHandles_[currentBackBufferIndex_],
-                                   FALSE, &dsv);
-
-  // クリア
   commandList_->ClearRenderTargetView(rtvHandles_[currentBackBufferIndex_],
                                       clearColor, 0, nullptr);
   commandList_->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0,
                                       nullptr);
 
-  // 描画用ディスクリプタヒープ設定（SRV など）
-  ID3D12DescriptorHeap *heaps[] = {srvHeap_.Get()};
-  commandList_->SetDescriptorHeaps(1, heaps);
-
-  // VP/Scissor
-  commandList_->RSSetViewports(1, &viewport_);
-  commandList_->RSSetScissorRects(1, &scissorRect_);
-
   // ImGui フレーム開始
   ImGui_ImplDX12_NewFrame();
   ImGui_ImplWin32_NewFrame();
@@ -180,12 +221,21 @@ void DirectXCommon::PreDraw(const float clearColor[4]) {
 }
 
 void DirectXCommon::PostDraw() {
+  TARO_PROFILE_SCOPE("DirectXCommon::PostDraw");
   if (width_ == 0 || height_ == 0)
     return;
 
+  // UI と Present への遷移は、ワーカーが記録したリストより後ろに並べる
+  ID3D12GraphicsCommandList *endList =
+      AcquireCommandList(CommandContextPool::kOrderFrameEnd);
+  gpuTimestamps_.SetCommandList(endList);
+
   // ImGui を描画コマンドへ発行
   ImGui::Render();
-  ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList_.Get());
+  {
+    TARO_GPU_PROFILE_SCOPE(gpuProfiler_, "ImGui");
+    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), endList);
+  }
 
   // RenderTarget -> Present 遷移
   D3D12_RESOURCE_BARRIER barrier{};
@@ -193,12 +243,14 @@ void DirectXCommon::PostDraw() {
   barrier.Transition.pResource = backBuffers_[currentBackBufferIndex_].Get();
   barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
   barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-  commandList_->ResourceBarrier(1, &barrier);
+  endList->ResourceBarrier(1, &barrier);
 
-  // コマンドリストを閉じて実行
-  commandList_->Close();
-  ID3D12CommandList *lists[] = {commandList_.Get()};
-  commandQueue_->ExecuteCommandLists(1, lists);
+  // タイムスタンプを解決してから閉じる
+  gpuProfiler_.EndFrame();
+
+  // 借りたリストをすべて閉じ、order 順に 1 回で実行
+  commandContexts_.Submit();
+  commandList_ = nullptr;
 
   // 今フレーム用のフェンス値を発行して記録
   const uint64_t fenceToSignal = ++nextFenceValue_;
@@ -206,11 +258,19 @@ void DirectXCommon::PostDraw() {
   assert(SUCCEEDED(hr));
   fenceValues_[currentBackBufferIndex_] = fenceToSignal;
 
-  // Present（必要に応じて 0 / tearing に切り替え可）
-  swapChain_->Present(1, 0);
+  // このフレームで切り出した Upload 領域は fenceToSignal の完了で解放
+  uploadRing_.FinishFrame(fenceToSignal);
+  srvAllocator_.FinishFrame(fenceToSignal);
+  commandContexts_.FinishFrame(fenceToSignal);
+
+  // Present（垂直同期なしでティアリングが使えるなら許可する）
+  const UINT syncInterval = framePacer_.GetSyncInterval();
+  const UINT presentFlags =
+      (syncInterval == 0 && tearingSupported_) ? DXGI_PRESENT_ALLOW_TEARING : 0;
+  swapChain_->Present(syncInterval, presentFlags);
 
-  // 60FPS 固定のためのスリープ調整
-  UpdateFixFPS();
+  // FixedRate なら次の締め切りまで待つ（統計は全モードで記録）
+  framePacer_.Wait();
 }
 
 void DirectXCommon::Resize(uint32_t width, uint32_t height) {
@@ -232,7 +292,7 @@ void DirectXCommon::Resize(uint32_t width, uint32_t height) {
   HRESULT hr = swapChain_->ResizeBuffers(
       kBufferCount, width, height,
       DXGI_FORMAT_R8G8B8A8_UNORM, // 既存設定に合わせる
-      0 /* 将来 tearing を使うなら DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING */);
+      GetSwapChainFlags());        // 作成時と同じフラグが必要
   assert(SUCCEEDED(hr));
 
   // 新しいインデックス＆サイズを反映
@@ -253,8 +313,10 @@ void DirectXCommon::Resize(uint32_t width, uint32_t height) {
 // Private 初期化群
 // =====================================
 
-void DirectXCommon::InitializeFixFPS() {
-  fpsReference_ = std::chrono::steady_clock::now();
+void DirectXCommon::InitializeFramePacer() {
+  framePacer_.Initialize();
+  framePacer_.SetTargetFps(kDefaultTargetFps);
+  framePacer_.SetMode(FramePacer::Mode::VSync);
 }
 
 void DirectXCommon::InitializeDevice() {
@@ -306,19 +368,9 @@ void DirectXCommon::InitializeCommand() {
   hr = device_->CreateCommandQueue(&qdesc, IID_PPV_ARGS(&commandQueue_));
   assert(SUCCEEDED(hr));
 
-  // フレーム数分のアロケータ
-  for (UINT i = 0; i < kBufferCount; ++i) {
-    hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                         IID_PPV_ARGS(&commandAllocators_[i]));
-    assert(SUCCEEDED(hr));
-  }
-
-  // コマンドリストは 1 本（毎フレーム Reset）
-  hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                  commandAllocators_[0].Get(), nullptr,
-                                  IID_PPV_ARGS(&commandList_));
-  assert(SUCCEEDED(hr));
-  commandList_->Close();
+  // アロケータとリストはプールが必要な数だけ作り、フェンスで回収して使い回す
+  commandContextBackend_.Initialize(device_.Get(), commandQueue_.Get());
+  commandContexts_.Initialize(&commandContextBackend_);
 }
 
 void DirectXCommon::InitializeSwapChain() {
@@ -331,7 +383,18 @@ void DirectXCommon::InitializeSwapChain() {
   desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
   desc.BufferCount = kBufferCount;
   desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
-  // desc.Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING; // 必要に応じて
+
+  // 垂直同期なしの Present でティアリングを使えるか
+  ComPtr<IDXGIFactory5> factory5;
+  if (SUCCEEDED(dxgiFactory_.As(&factory5))) {
+    BOOL allowTearing = FALSE;
+    if (SUCCEEDED(factory5->CheckFeatureSupport(
+            DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing,
+            sizeof(allowTearing)))) {
+      tearingSupported_ = allowTearing == TRUE;
+    }
+  }
+  desc.Flags = GetSwapChainFlags();
 
   ComPtr<IDXGISwapChain1> sc1;
   HRESULT hr = dxgiFactory_->CreateSwapChainForHwnd(
@@ -343,6 +406,11 @@ void DirectXCommon::InitializeSwapChain() {
   hr = sc1.As(&swapChain_);
   assert(SUCCEEDED(hr));
 
+  // CPU の先行を kMaxFrameLatency フレームに抑え、待機用のオブジェクトを取得
+  hr = swapChain_->SetMaximumFrameLatency(kMaxFrameLatency);
+  assert(SUCCEEDED(hr));
+  frameLatencyWaitable_ = swapChain_->GetFrameLatencyWaitableObject();
+
   // Alt+Enter のフルスクリーン切替を無効化（アプリ側で制御するため）
   dxgiFactory_->MakeWindowAssociation(winApp_->GetHwnd(),
                                       DXGI_MWA_NO_ALT_ENTER);
@@ -362,8 +430,10 @@ void DirectXCommon::InitializeDescriptorHeaps() {
                                        kBufferCount, false));
   dsvHeap_.Attach(
       CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1, false));
-  srvHeap_.Attach(
-      CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 128, true));
+
+  // SRV は永続スロット（前半）とフレーム一時スロット（後半）に分けて払い出す
+  srvAllocator_.Initialize(device_.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+                           kSrvPersistentCount, kSrvTransientCount, true);
 }
 
 void DirectXCommon::InitializeBackBuffers() {
@@ -437,6 +507,16 @@ void DirectXCommon::InitializeFence() {
     fenceValues_[i] = 0;
 }
 
+void DirectXCommon::InitializeUploadRing() {
+  uploadRing_.Initialize(device_.Get(), kUploadRingSize);
+}
+
+void DirectXCommon::InitializeGpuProfiler() {
+  gpuTimestamps_.Initialize(device_.Get(), commandQueue_.Get(), kBufferCount,
+                            kGpuTimestampsPerFrame);
+  gpuProfiler_.Initialize(&gpuTimestamps_);
+}
+
 void DirectXCommon::InitializeViewport() {
   viewport_.Width = static_cast<float>(width_);
   viewport_.Height = static_cast<float>(height_);
@@ -469,30 +549,30 @@ void DirectXCommon::InitializeImGui() {
   ImGui::StyleColorsDark();
 
   // Win32/DX12 バックエンド初期化
+  // フォントテクスチャ用に永続スロットを 1 つ確保
+  imguiFontSrv_ = srvAllocator_.AllocatePersistent();
+
   ImGui_ImplWin32_Init(winApp_->GetHwnd());
   ImGui_ImplDX12_Init(device_.Get(), kBufferCount,
-                      DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, srvHeap_.Get(),
-                      srvHeap_->GetCPUDescriptorHandleForHeapStart(),
-                      srvHeap_->GetGPUDescriptorHandleForHeapStart());
+                      DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, srvAllocator_.GetHeap(),
+                      imguiFontSrv_.cpu, imguiFontSrv_.gpu);
 }
 
 // ===============================
-// FPS固定
+// フレームペーシング
 // ===============================
-void DirectXCommon::UpdateFixFPS() {
-  using clock = std::chrono::steady_clock;
-  using micro = std::chrono::microseconds;
-
-  const micro kMinTime(kTargetFrameMicroSec);
-
-  const clock::time_point now = clock::now();
-  const micro elapsed = std::chrono::duration_cast<micro>(now - fpsReference_);
+void DirectXCommon::WaitForFrameLatency() {
+  TARO_PROFILE_SCOPE("DirectXCommon::WaitForFrameLatency");
+  if (!frameLatencyWaitable_)
+    return;
 
-  if (elapsed < kMinTime) {
-    while (clock::now() - fpsReference_ < kMinTime) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
-    }
-  }
+  // 表示側が止まっていても固まらないよう 1 秒で諦める
+  WaitForSingleObjectEx(frameLatencyWaitable_, 1000, TRUE);
+}
 
-  fpsReference_ += kMinTime;
+UINT DirectXCommon::GetSwapChainFlags() const {
+  UINT flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+  if (tearingSupported_)
+    flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+  return flags;
 }
\ No newline at end of file
@@ -1,11 +1,16 @@
 #pragma once
+#include "CommandContextPool.h"
+#include "D3D12CommandContextBackend.h"
+#include "D3D12TimestampBackend.h"
+#include "DescriptorAllocator.h"
+#include "FramePacer.h"
+#include "GpuProfiler.h"
+#include "UploadRingBuffer.h"
 #include <cassert>
-#include <chrono>
 #include <cstdint>
 #include <d3d12.h>
 #include <dxcapi.h>
 #include <dxgi1_6.h>
-#include <thread>
 #include <windows.h>
 #include <wrl.h>
 
@@ -27,9 +32,41 @@ public:
     static constexpr uint32_t kBufferCount = 3;
 
     /// <summary>
-    /// 目標フレーム時間（60FPSなら約16.666ms）
+    /// FixedRate のときの既定の目標 FPS
     /// </summary>
-    static constexpr int64_t kTargetFrameMicroSec = 1000000 / 60;
+    static constexpr double kDefaultTargetFps = 60.0;
+
+    /// <summary>
+    /// CPU が GPU より先行してよい最大フレーム数（待機可能スワップチェーンで制御）
+    /// </summary>
+    static constexpr UINT kMaxFrameLatency = 1;
+
+    /// <summary>
+    /// フレーム内で使い捨てる Upload データ用リングの容量（全フレーム分の合計）
+    /// </summary>
+    static constexpr uint64_t kUploadRingSize = 16ull * 1024 * 1024;
+
+    /// <summary>
+    /// SRV ヒープの永続スロット数（テクスチャなど）。<br/>
+    /// ヒープは初期化時の固定サイズで、使い切っても拡張しない。
+    /// 使い切ると Debug では DescriptorAllocator の assert で止まり、
+    /// Release では無効なハンドルが返る（GetSrvAllocator()->GetStats().failedAllocations に数える）。
+    /// </summary>
+    static constexpr uint32_t kSrvPersistentCount = 32768;
+
+    /// <summary>
+    /// SRV ヒープのフレーム一時スロット数（全フレーム分の合計）。溢れたときの扱いは永続スロットと同じ
+    /// </summary>
+    static constexpr uint32_t kSrvTransientCount = 8192;
+
+    // シェーダ可視ヒープはリソースバインディング Tier 1 の上限に収める
+    static_assert(kSrvPersistentCount + kSrvTransientCount <= D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1,
+                  "SRV heap exceeds the Tier 1 shader-visible descriptor limit");
+
+    /// <summary>
+    /// 1 フレームで使える GPU タイムスタンプ数（スコープ 1 つで 2 つ使う）
+    /// </summary>
+    static constexpr uint32_t kGpuTimestampsPerFrame = 128;
 
 public:
     // ===============================
@@ -60,7 +97,7 @@ public:
 
     /// <summary>
     /// フレーム終了処理。<br/>
-    /// ImGui 描画、Present、フェンス Signal、60FPS 固定のためのスリープ調整を行う。
+    /// ImGui 描画、Present、フェンス Signal、FramePacer によるフレーム間隔の調整を行う。
     /// </summary>
     void PostDraw();
 
@@ -84,13 +121,28 @@ public:
     /// <returns>ID3D12Device のポインタ。</returns>
     ID3D12Device *GetDevice() const { return device_.Get(); }
 
-    /// <summary>グラフィックスコマンドリストを取得する。</summary>
-    /// <returns>ID3D12GraphicsCommandList のポインタ。</returns>
-    ID3D12GraphicsCommandList *GetCommandList() const { return commandList_.Get(); }
+    /// <summary>フレーム先頭のグラフィックスコマンドリスト（メインスレッド用）を取得する。</summary>
+    /// <returns>ID3D12GraphicsCommandList のポインタ。PreDraw から PostDraw の間だけ有効。</returns>
+    ID3D12GraphicsCommandList *GetCommandList() const { return commandList_; }
+
+    /// <summary>
+    /// 呼び出したスレッド専用のコマンドリストを借りる（どのスレッドからでも呼べる）。<br/>
+    /// 描画先・SRV ヒープ・VP/Scissor は設定済みで、PostDraw で order 順にまとめて実行される。
+    /// </summary>
+    /// <param name="order">
+    /// 提出順のキー。GetCommandList のリスト（kOrderFrameBegin）より後、UI（kOrderFrameEnd）より前に並ぶ。
+    /// </param>
+    /// <returns>PreDraw から PostDraw の間だけ有効なリスト。PostDraw の前に記録を終えること。</returns>
+    /// <remarks>GPU 計測（TARO_GPU_PROFILE_SCOPE）は GetCommandList のリストにだけ積める。</remarks>
+    ID3D12GraphicsCommandList *AcquireCommandList(uint32_t order);
 
     /// <summary>SRV 用ディスクリプタヒープを取得する。</summary>
     /// <returns>ID3D12DescriptorHeap のポインタ。</returns>
-    ID3D12DescriptorHeap *GetSrvHeap() const { return srvHeap_.Get(); }
+    ID3D12DescriptorHeap *GetSrvHeap() const { return srvAllocator_.GetHeap(); }
+
+    /// <summary>SRV（CBV/SRV/UAV）ディスクリプタのアロケータを取得する。</summary>
+    /// <returns>DescriptorAllocator のポインタ。</returns>
+    DescriptorAllocator *GetSrvAllocator() { return &srvAllocator_; }
 
     /// <summary>現在のバックバッファに対応する RTV を取得する。</summary>
     /// <returns>CPU ディスクリプタハンドル。</returns>
@@ -104,6 +156,18 @@ public:
     /// <returns>バックバッファインデックス。</returns>
     UINT GetCurrentBackBufferIndex() const { return currentBackBufferIndex_; }
 
+    /// <summary>フレーム内で使い捨てる定数・動的データ用のリングを取得する。</summary>
+    /// <returns>UploadRingBuffer のポインタ。</returns>
+    UploadRingBuffer *GetUploadRing() { return &uploadRing_; }
+
+    /// <summary>GPU 時間の計測（TARO_GPU_PROFILE_SCOPE に渡す）を取得する。</summary>
+    /// <returns>GpuProfiler のポインタ。</returns>
+    GpuProfiler *GetGpuProfiler() { return &gpuProfiler_; }
+
+    /// <summary>フレームペーサー（モードや目標 FPS の変更、統計の取得）を取得する。</summary>
+    /// <returns>FramePacer のポインタ。</returns>
+    FramePacer *GetFramePacer() { return &framePacer_; }
+
     /// <summary>現在のクライアント幅を取得する。</summary>
     /// <returns>幅（ピクセル）。</returns>
     uint32_t GetWidth() const { return width_; }
@@ -117,8 +181,8 @@ private:
     // 初期化処理
     // ===============================
 
-    /// <summary>FPS 固定のための初期化。現在時刻を基準として記録する。</summary>
-    void InitializeFixFPS();
+    /// <summary>フレームペーサーを初期化する。</summary>
+    void InitializeFramePacer();
 
     /// <summary>デバイスを初期化する。</summary>
     void InitializeDevice();
@@ -147,6 +211,12 @@ private:
     /// <summary>フェンスを初期化する。</summary>
     void InitializeFence();
 
+    /// <summary>定数・動的データ用の Upload リングを初期化する。</summary>
+    void InitializeUploadRing();
+
+    /// <summary>GPU タイムスタンプの計測を初期化する。</summary>
+    void InitializeGpuProfiler();
+
     /// <summary>ビューポートを初期化する。</summary>
     void InitializeViewport();
 
@@ -160,14 +230,18 @@ private:
     void InitializeImGui();
 
     // ===============================
-    // FPS固定
+    // フレームペーシング
     // ===============================
 
     /// <summary>
-    /// FPS 固定のための更新。<br/>
-    /// 1/60 秒に満たない場合は 1ms スリープを繰り返して調整する。
+    /// 待機可能スワップチェーンが次のフレームを受け付けるまで待つ（入力遅延の削減）。
     /// </summary>
-    void UpdateFixFPS();
+    void WaitForFrameLatency();
+
+    /// <summary>
+    /// スワップチェーン作成・リサイズ時のフラグ（待機可能オブジェクト、対応していればティアリング）。
+    /// </summary>
+    UINT GetSwapChainFlags() const;
 
     // ===============================
     // ユーティリティ
@@ -204,6 +278,13 @@ private:
     /// <param name="frameIndex">待機対象のフレームインデックス。</param>
     void WaitForFrame(UINT frameIndex);
 
+    /// <summary>
+    /// キャッシュ済みのディスクリプタインクリメントサイズを取得する。
+    /// </summary>
+    /// <param name="type">ヒープ種別。</param>
+    /// <returns>ディスクリプタ 1 つぶんのバイト数。</returns>
+    UINT GetDescriptorSize(D3D12_DESCRIPTOR_HEAP_TYPE type) const;
+
     /// <summary>
     /// 現在発行中の全コマンドをフラッシュして待機する。<br/>
     /// （終了時やリサイズ時専用）
@@ -227,18 +308,22 @@ private:
 
     // Command
     Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue_;
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocators_[kBufferCount];
-    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList_;
+    D3D12CommandContextBackend commandContextBackend_;
+    CommandContextPool commandContexts_;
+    ID3D12GraphicsCommandList *commandList_ = nullptr; // フレーム先頭のリスト（プールから借りたもの）
 
     // SwapChain / RenderTargets
     Microsoft::WRL::ComPtr<IDXGISwapChain4> swapChain_;
+    HANDLE frameLatencyWaitable_ = nullptr; // 待機可能スワップチェーンのオブジェクト
+    bool tearingSupported_ = false;         // 垂直同期なしの Present でティアリングを許可できるか
     Microsoft::WRL::ComPtr<ID3D12Resource> backBuffers_[kBufferCount];
     UINT currentBackBufferIndex_ = 0;
 
     // Descriptor Heaps
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> rtvHeap_;
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> dsvHeap_;
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> srvHeap_;
+    DescriptorAllocator srvAllocator_;
+    DescriptorAllocator::Handle imguiFontSrv_; // ImGui フォント用の永続スロット
     UINT descriptorSizeRTV_ = 0;
     UINT descriptorSizeDSV_ = 0;
     UINT descriptorSizeSRV_ = 0;
@@ -255,11 +340,18 @@ private:
     uint64_t fenceValues_[kBufferCount] = {};
     HANDLE fenceEvent_ = nullptr;
 
+    // 定数・動的データ用 Upload リング
+    UploadRingBuffer uploadRing_;
+
+    // GPU 時間計測
+    D3D12TimestampBackend gpuTimestamps_;
+    GpuProfiler gpuProfiler_;
+
     // DXC (シェーダコンパイラ関連)
     Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils_;
     Microsoft::WRL::ComPtr<IDxcCompiler3> dxcCompiler_;
     Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler_;
 
-    // FPS固定用
-    std::chrono::steady_clock::time_point fpsReference_{};
+    // フレームペーシング
+    FramePacer framePacer_;
 };
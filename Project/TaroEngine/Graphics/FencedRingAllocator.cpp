@@ -0,0 +1,85 @@
+#include "FencedRingAllocator.h"
+#include <cassert>
+
+namespace {
+
+    inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+} // namespace
+
+void FencedRingAllocator::Initialize(uint64_t capacity) {
+    assert(capacity > 0);
+    capacity_ = capacity;
+    head_ = 0;
+    tail_ = 0;
+    used_ = 0;
+    totalAllocated_ = 0;
+    totalReleased_ = 0;
+    frames_.clear();
+}
+
+uint64_t FencedRingAllocator::Allocate(uint64_t size, uint64_t alignment) {
+    assert(size > 0);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    if (size > capacity_ || used_ == capacity_) return kInvalidOffset;
+
+    // 空なら先頭から使い直す（無駄な折り返しを避ける）。
+    // 完了待ちのフレームも中身は空なので、終端位置を合わせておく
+    if (used_ == 0) {
+        head_ = 0;
+        tail_ = 0;
+        for (FrameMarker &frame : frames_) {
+            frame.head = 0;
+        }
+    }
+
+    uint64_t offset = AlignUp(head_, alignment);
+    uint64_t newHead = 0;
+
+    if (head_ >= tail_) {
+        // 空き：[head_, capacity_) と [0, tail_)
+        if (offset + size <= capacity_) {
+            newHead = offset + size;
+        } else if (size <= tail_) {
+            // 末尾に入らないので先頭へ折り返す（0 は常にアライン済み）
+            offset = 0;
+            newHead = size;
+        } else {
+            return kInvalidOffset;
+        }
+    } else {
+        // 空き：[head_, tail_)
+        if (offset + size > tail_) return kInvalidOffset;
+        newHead = offset + size;
+    }
+
+    // 進んだ距離（アライン・折り返しの余りを含む）を使用量に積む
+    const uint64_t advance = (newHead > head_ && offset >= head_)
+        ? newHead - head_
+        : (capacity_ - head_) + newHead;
+    used_ += advance;
+    totalAllocated_ += advance;
+    head_ = (newHead == capacity_) ? 0 : newHead;
+
+    assert(used_ <= capacity_);
+    return offset;
+}
+
+void FencedRingAllocator::FinishFrame(uint64_t fenceValue) {
+    // 前フレームから確保がなくても、フェンス順を保つためにマーカーは積む
+    assert(frames_.empty() || frames_.back().fenceValue <= fenceValue);
+    frames_.push_back({fenceValue, head_, totalAllocated_});
+}
+
+void FencedRingAllocator::Reclaim(uint64_t completedFenceValue) {
+    while (!frames_.empty() && frames_.front().fenceValue <= completedFenceValue) {
+        const FrameMarker &frame = frames_.front();
+        used_ -= frame.totalAllocated - totalReleased_;
+        totalReleased_ = frame.totalAllocated;
+        tail_ = frame.head;
+        frames_.pop_front();
+    }
+}
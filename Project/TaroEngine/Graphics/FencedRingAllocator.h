@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/// <summary>
+/// フェンス値でフレーム単位に解放されるリングアロケータ（オフセット管理のみ）。<br/>
+/// D3D12 には依存せず、確保・解放のロジックだけを持つ。
+/// 実際のメモリ（Upload ヒープなど）との対応付けは利用側で行う。
+/// </summary>
+/// <remarks>
+/// 使い方：フレーム中に Allocate → フレーム末に FinishFrame(シグナルしたフェンス値)
+/// → 次フレーム開始時に Reclaim(GPU 完了済みのフェンス値)。
+/// FinishFrame より後の確保は次の FinishFrame までが同じフレームとして扱われる。
+/// </remarks>
+class FencedRingAllocator {
+public:
+    /// <summary>
+    /// 確保失敗を表すオフセット。
+    /// </summary>
+    static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="capacity">リング全体のバイト数。</param>
+    void Initialize(uint64_t capacity);
+
+    /// <summary>
+    /// 領域を確保する。<br/>
+    /// 末尾に収まらない場合は先頭へ折り返す（末尾の余りは同じフレームの使用量として扱う）。
+    /// </summary>
+    /// <param name="size">バイト数（0 より大きいこと）。</param>
+    /// <param name="alignment">アライメント（2 の累乗）。</param>
+    /// <returns>先頭からのオフセット。空きが足りなければ kInvalidOffset。</returns>
+    uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+    /// <summary>
+    /// 現在のフレームを締める。<br/>
+    /// ここまでの確保は fenceValue が完了した時点でまとめて解放される。
+    /// </summary>
+    /// <param name="fenceValue">このフレームの最後にシグナルしたフェンス値。</param>
+    void FinishFrame(uint64_t fenceValue);
+
+    /// <summary>
+    /// 完了済みフレームの領域を解放する。
+    /// </summary>
+    /// <param name="completedFenceValue">GPU が完了したフェンス値。</param>
+    void Reclaim(uint64_t completedFenceValue);
+
+    /// <summary>全体のバイト数を取得する。</summary>
+    uint64_t GetCapacity() const { return capacity_; }
+
+    /// <summary>使用中のバイト数（折り返しによる余りを含む）を取得する。</summary>
+    uint64_t GetUsedSize() const { return used_; }
+
+    /// <summary>締め済みで GPU 完了待ちのフレーム数を取得する。</summary>
+    size_t GetPendingFrameCount() const { return frames_.size(); }
+
+private:
+    /// <summary>
+    /// 締めたフレームの終端情報。
+    /// </summary>
+    struct FrameMarker {
+        uint64_t fenceValue = 0;     // このフレームのフェンス値
+        uint64_t head = 0;           // フレーム終了時の先頭位置
+        uint64_t totalAllocated = 0; // フレーム終了時点の累計確保量
+    };
+
+    uint64_t capacity_ = 0;
+    uint64_t head_ = 0;           // 次に確保する位置
+    uint64_t tail_ = 0;           // 最も古い使用中領域の先頭
+    uint64_t used_ = 0;           // 使用中のバイト数
+    uint64_t totalAllocated_ = 0; // 累計確保量（余り含む）
+    uint64_t totalReleased_ = 0;  // 累計解放量
+
+    std::deque<FrameMarker> frames_;
+};
@@ -0,0 +1,202 @@
+#include "Frustum.h"
+#include "SimdConfig.h"
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+    // 平面と点の符号付き距離（SIMD 版と同じ加算順）
+    inline float PlaneDistance(const Frustum &f, int p, float x, float y, float z) {
+        return ((f.normalX[p] * x + f.normalY[p] * y) + f.normalZ[p] * z) + f.distance[p];
+    }
+
+    // 可視マスクの立っているレーンの番号だけを詰める（分岐なし。書き出し先は要素数分あるので余分に書いてよい）
+    inline size_t Compact(uint32_t *out, size_t written, uint32_t firstIndex, int mask, int lanes) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            out[written] = firstIndex + static_cast<uint32_t>(lane);
+            written += static_cast<size_t>((mask >> lane) & 1);
+        }
+        return written;
+    }
+
+} // namespace
+
+Frustum Frustum::FromViewProjection(const Matrix4x4 &viewProj) {
+    // 行ベクトル×右掛けなので clip の各成分は行列の列との内積。
+    // 内側の条件 -w <= x <= w, -w <= y <= w, 0 <= z <= w を列の和・差で表す（Gribb-Hartmann）
+    const auto &m = viewProj.m;
+    const float sign[kPlaneCount] = {1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f};
+    const int column[kPlaneCount] = {0, 0, 1, 1, 2, 2};
+
+    Frustum f;
+    for (int p = 0; p < kPlaneCount; ++p) {
+        const int c = column[p];
+        // near は z >= 0 なので w 列を足さない
+        const float w = (p == kNear) ? 0.0f : 1.0f;
+        float nx = w * m[0][3] + sign[p] * m[0][c];
+        float ny = w * m[1][3] + sign[p] * m[1][c];
+        float nz = w * m[2][3] + sign[p] * m[2][c];
+        float d = w * m[3][3] + sign[p] * m[3][c];
+
+        const float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (length > 0.0f) {
+            const float inv = 1.0f / length;
+            nx *= inv;
+            ny *= inv;
+            nz *= inv;
+            d *= inv;
+        }
+        f.normalX[p] = nx;
+        f.normalY[p] = ny;
+        f.normalZ[p] = nz;
+        f.distance[p] = d;
+    }
+    return f;
+}
+
+bool Frustum::IntersectsSphere(const Vector3 &center, float radius) const {
+    for (int p = 0; p < kPlaneCount; ++p) {
+        if (!(PlaneDistance(*this, p, center.x, center.y, center.z) >= -radius)) return false;
+    }
+    return true;
+}
+
+bool Frustum::IntersectsAabb(const Vector3 &center, const Vector3 &extent) const {
+    for (int p = 0; p < kPlaneCount; ++p) {
+        // 平面の法線方向へ最も張り出した頂点までの距離
+        const float r = (std::fabs(normalX[p]) * extent.x + std::fabs(normalY[p]) * extent.y) +
+            std::fabs(normalZ[p]) * extent.z;
+        if (!(PlaneDistance(*this, p, center.x, center.y, center.z) >= -r)) return false;
+    }
+    return true;
+}
+
+size_t FrustumCulling::CullSpheres(const Frustum &frustum, const SphereStreams &in, uint32_t *outVisible,
+    uint32_t indexOffset) {
+    if (in.count == 0) return 0;
+    assert(in.centerX && in.centerY && in.centerZ && in.radius && outVisible);
+    assert(in.count <= UINT32_MAX - indexOffset);
+
+    size_t written = 0;
+    size_t i = 0;
+
+#if defined(TARO_SIMD_AVX)
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= in.count; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(in.centerX + i);
+        const __m256 cy = _mm256_loadu_ps(in.centerY + i);
+        const __m256 cz = _mm256_loadu_ps(in.centerZ + i);
+        const __m256 negR = _mm256_xor_ps(_mm256_loadu_ps(in.radius + i), signBit);
+
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+            __m256 dist = _mm256_mul_ps(_mm256_set1_ps(frustum.normalX[p]), cx);
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(frustum.normalY[p]), cy));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(frustum.normalZ[p]), cz));
+            dist = _mm256_add_ps(dist, _mm256_set1_ps(frustum.distance[p]));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(dist, negR, _CMP_GE_OQ));
+        }
+        written = Compact(outVisible, written, indexOffset + static_cast<uint32_t>(i),
+            _mm256_movemask_ps(visible), 8);
+    }
+#elif defined(TARO_SIMD_SSE2)
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= in.count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(in.centerX + i);
+        const __m128 cy = _mm_loadu_ps(in.centerY + i);
+        const __m128 cz = _mm_loadu_ps(in.centerZ + i);
+        const __m128 negR = _mm_xor_ps(_mm_loadu_ps(in.radius + i), signBit);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+            __m128 dist = _mm_mul_ps(_mm_set1_ps(frustum.normalX[p]), cx);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(frustum.normalY[p]), cy));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(frustum.normalZ[p]), cz));
+            dist = _mm_add_ps(dist, _mm_set1_ps(frustum.distance[p]));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, negR));
+        }
+        written = Compact(outVisible, written, indexOffset + static_cast<uint32_t>(i),
+            _mm_movemask_ps(visible), 4);
+    }
+#endif
+
+    // 残り（とスカラ版）
+    for (; i < in.count; ++i) {
+        const Vector3 center{in.centerX[i], in.centerY[i], in.centerZ[i]};
+        outVisible[written] = indexOffset + static_cast<uint32_t>(i);
+        written += frustum.IntersectsSphere(center, in.radius[i]) ? 1 : 0;
+    }
+    return written;
+}
+
+size_t FrustumCulling::CullAabbs(const Frustum &frustum, const AabbStreams &in, uint32_t *outVisible,
+    uint32_t indexOffset) {
+    if (in.count == 0) return 0;
+    assert(in.centerX && in.centerY && in.centerZ && outVisible);
+    assert(in.extentX && in.extentY && in.extentZ);
+    assert(in.count <= UINT32_MAX - indexOffset);
+
+    size_t written = 0;
+    size_t i = 0;
+
+#if defined(TARO_SIMD_AVX)
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= in.count; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(in.centerX + i);
+        const __m256 cy = _mm256_loadu_ps(in.centerY + i);
+        const __m256 cz = _mm256_loadu_ps(in.centerZ + i);
+        const __m256 ex = _mm256_loadu_ps(in.extentX + i);
+        const __m256 ey = _mm256_loadu_ps(in.extentY + i);
+        const __m256 ez = _mm256_loadu_ps(in.extentZ + i);
+
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+            __m256 dist = _mm256_mul_ps(_mm256_set1_ps(frustum.normalX[p]), cx);
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(frustum.normalY[p]), cy));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(frustum.normalZ[p]), cz));
+            dist = _mm256_add_ps(dist, _mm256_set1_ps(frustum.distance[p]));
+
+            __m256 r = _mm256_mul_ps(_mm256_set1_ps(std::fabs(frustum.normalX[p])), ex);
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(std::fabs(frustum.normalY[p])), ey));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(std::fabs(frustum.normalZ[p])), ez));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(dist, _mm256_xor_ps(r, signBit), _CMP_GE_OQ));
+        }
+        written = Compact(outVisible, written, indexOffset + static_cast<uint32_t>(i),
+            _mm256_movemask_ps(visible), 8);
+    }
+#elif defined(TARO_SIMD_SSE2)
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= in.count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(in.centerX + i);
+        const __m128 cy = _mm_loadu_ps(in.centerY + i);
+        const __m128 cz = _mm_loadu_ps(in.centerZ + i);
+        const __m128 ex = _mm_loadu_ps(in.extentX + i);
+        const __m128 ey = _mm_loadu_ps(in.extentY + i);
+        const __m128 ez = _mm_loadu_ps(in.extentZ + i);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+            __m128 dist = _mm_mul_ps(_mm_set1_ps(frustum.normalX[p]), cx);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(frustum.normalY[p]), cy));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(frustum.normalZ[p]), cz));
+            dist = _mm_add_ps(dist, _mm_set1_ps(frustum.distance[p]));
+
+            __m128 r = _mm_mul_ps(_mm_set1_ps(std::fabs(frustum.normalX[p])), ex);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(std::fabs(frustum.normalY[p])), ey));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(std::fabs(frustum.normalZ[p])), ez));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, _mm_xor_ps(r, signBit)));
+        }
+        written = Compact(outVisible, written, indexOffset + static_cast<uint32_t>(i),
+            _mm_movemask_ps(visible), 4);
+    }
+#endif
+
+    // 残り（とスカラ版）
+    for (; i < in.count; ++i) {
+        const Vector3 center{in.centerX[i], in.centerY[i], in.centerZ[i]};
+        const Vector3 extent{in.extentX[i], in.extentY[i], in.extentZ[i]};
+        outVisible[written] = indexOffset + static_cast<uint32_t>(i);
+        written += frustum.IntersectsAabb(center, extent) ? 1 : 0;
+    }
+    return written;
+}
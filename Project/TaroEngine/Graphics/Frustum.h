@@ -0,0 +1,88 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// 視錐台（6 平面）。平面は n・p + d >= 0 を内側とし、n は正規化済み。
+/// </summary>
+struct Frustum {
+    /// <summary>平面の並び。</summary>
+    enum PlaneIndex { kLeft, kRight, kBottom, kTop, kNear, kFar, kPlaneCount };
+
+    // SoA（SIMD で 1 平面ずつ全要素へブロードキャストしやすい並び）
+    float normalX[kPlaneCount] = {};
+    float normalY[kPlaneCount] = {};
+    float normalZ[kPlaneCount] = {};
+    float distance[kPlaneCount] = {};
+
+    /// <summary>
+    /// View * Projection（行ベクトル×右掛け、D3D の z∈[0,1]）から 6 平面を取り出す。
+    /// </summary>
+    static Frustum FromViewProjection(const Matrix4x4 &viewProj);
+
+    /// <summary>球が視錐台と交差する（一部でも内側にある）か。</summary>
+    bool IntersectsSphere(const Vector3 &center, float radius) const;
+
+    /// <summary>AABB（中心と半径ベクトル）が視錐台と交差するか。</summary>
+    bool IntersectsAabb(const Vector3 &center, const Vector3 &extent) const;
+};
+
+/// <summary>
+/// 多数の境界ボリュームを視錐台で一括判定し、見えるものの番号を詰めて返すバッチカーネル群。<br/>
+/// 入力は SoA で受け取り、SimdConfig の選択に応じて 8 個（AVX）/ 4 個（SSE2）ずつ判定する。
+/// </summary>
+/// <remarks>
+/// 判定は保守的（視錐台の角付近では見えないものを残すことがある）で、
+/// 加算順をスカラ版とそろえているのでどのバックエンドでも結果は一致する。
+/// </remarks>
+namespace FrustumCulling {
+
+    /// <summary>
+    /// 境界球の SoA 入力ストリーム。
+    /// </summary>
+    struct SphereStreams {
+        const float *centerX = nullptr; ///< 中心 X
+        const float *centerY = nullptr; ///< 中心 Y
+        const float *centerZ = nullptr; ///< 中心 Z
+        const float *radius = nullptr;  ///< 半径
+        size_t count = 0;               ///< 要素数
+    };
+
+    /// <summary>
+    /// AABB の SoA 入力ストリーム（中心と各軸の半分の大きさ）。
+    /// </summary>
+    struct AabbStreams {
+        const float *centerX = nullptr; ///< 中心 X
+        const float *centerY = nullptr; ///< 中心 Y
+        const float *centerZ = nullptr; ///< 中心 Z
+        const float *extentX = nullptr; ///< X 方向の半分の大きさ
+        const float *extentY = nullptr; ///< Y 方向の半分の大きさ
+        const float *extentZ = nullptr; ///< Z 方向の半分の大きさ
+        size_t count = 0;               ///< 要素数
+    };
+
+    /// <summary>
+    /// 境界球を判定し、見えるものの番号を昇順に書き出す。
+    /// </summary>
+    /// <param name="frustum">視錐台。</param>
+    /// <param name="in">SoA 入力。</param>
+    /// <param name="outVisible">書き出し先（in.count 要素分の容量が必要）。</param>
+    /// <param name="indexOffset">書き出す番号に足す値（区間に分けて判定するとき用）。</param>
+    /// <returns>見えた数。</returns>
+    size_t CullSpheres(const Frustum &frustum, const SphereStreams &in, uint32_t *outVisible,
+        uint32_t indexOffset = 0);
+
+    /// <summary>
+    /// AABB を判定し、見えるものの番号を昇順に書き出す。
+    /// </summary>
+    /// <param name="frustum">視錐台。</param>
+    /// <param name="in">SoA 入力。</param>
+    /// <param name="outVisible">書き出し先（in.count 要素分の容量が必要）。</param>
+    /// <param name="indexOffset">書き出す番号に足す値（区間に分けて判定するとき用）。</param>
+    /// <returns>見えた数。</returns>
+    size_t CullAabbs(const Frustum &frustum, const AabbStreams &in, uint32_t *outVisible,
+        uint32_t indexOffset = 0);
+
+} // namespace FrustumCulling
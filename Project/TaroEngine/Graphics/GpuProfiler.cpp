@@ -0,0 +1,136 @@
+#include "GpuProfiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace {
+    // 平均の追従の速さ（1 フレームあたりの重み）
+    constexpr double kAverageWeight = 0.1;
+}
+
+void GpuProfiler::Initialize(IGpuTimestampBackend *backend) {
+    assert(backend);
+    backend_ = backend;
+    slots_.assign(backend_->GetFrameSlotCount(), FrameSlot{});
+    timestamps_.resize(backend_->GetMaxQueriesPerFrame());
+    frameActive_ = false;
+    ResetStats();
+}
+
+void GpuProfiler::BeginFrame(uint32_t frameSlot) {
+    assert(backend_ && frameSlot < slots_.size());
+    assert(!frameActive_);
+
+    // 前回このスロットで積んだ分は GPU が完了しているはずなので回収する
+    FrameSlot &slot = slots_[frameSlot];
+    if (slot.pending) {
+        CollectSlot(slot, frameSlot);
+    }
+    slot.scopes.clear();
+    slot.queryCount = 0;
+    slot.pending = false;
+
+    currentSlot_ = frameSlot;
+    frameActive_ = true;
+    depth_ = 0;
+    frameScope_ = BeginScope("Frame");
+}
+
+void GpuProfiler::EndFrame() {
+    if (!frameActive_) return;
+    EndScope(frameScope_);
+    frameScope_ = kInvalidScope;
+    frameActive_ = false;
+
+    FrameSlot &slot = slots_[currentSlot_];
+    if (slot.queryCount > 0) {
+        backend_->ResolveFrame(currentSlot_, slot.queryCount);
+        slot.pending = true;
+    }
+}
+
+uint32_t GpuProfiler::BeginScope(const char *name) {
+    if (!frameActive_) return kInvalidScope;
+
+    FrameSlot &slot = slots_[currentSlot_];
+    // 開始・終了の 2 つが取れないなら計測しない
+    if (slot.queryCount + 2 > backend_->GetMaxQueriesPerFrame()) {
+        ++droppedScopes_;
+        return kInvalidScope;
+    }
+
+    Scope scope;
+    scope.name = name;
+    scope.depth = depth_++;
+    scope.beginQuery = slot.queryCount++;
+    scope.endQuery = slot.queryCount++; // 終了側も先に予約しておく
+    backend_->WriteTimestamp(currentSlot_, scope.beginQuery);
+    slot.scopes.push_back(scope);
+    return static_cast<uint32_t>(slot.scopes.size() - 1);
+}
+
+void GpuProfiler::EndScope(uint32_t scope) {
+    if (!frameActive_ || scope == kInvalidScope) return;
+
+    FrameSlot &slot = slots_[currentSlot_];
+    assert(scope < slot.scopes.size() && !slot.scopes[scope].closed);
+    Scope &s = slot.scopes[scope];
+    backend_->WriteTimestamp(currentSlot_, s.endQuery);
+    s.closed = true;
+    depth_ = s.depth;
+}
+
+void GpuProfiler::ResetStats() {
+    for (ZoneStats &z : stats_) {
+        z.avgMs = z.lastMs;
+        z.maxMs = z.lastMs;
+        z.frames = 0;
+    }
+}
+
+void GpuProfiler::CollectSlot(FrameSlot &slot, uint32_t frameSlot) {
+    slot.pending = false;
+    if (!backend_->ReadFrame(frameSlot, slot.queryCount, timestamps_.data())) return;
+
+    const double tickToMs = 1000.0 / static_cast<double>(backend_->GetFrequency());
+    lastResults_.clear();
+    lastFrameMs_ = 0.0;
+
+    // 今回出てきた名前ごとの合計（同じ名前が何度出ても 1 フレーム分にまとめる）
+    std::vector<double> frameTotals(stats_.size(), 0.0);
+    std::vector<bool> seen(stats_.size(), false);
+
+    for (const Scope &s : slot.scopes) {
+        if (!s.closed) continue; // 閉じ忘れは捨てる
+        const uint64_t begin = timestamps_[s.beginQuery];
+        const uint64_t end = timestamps_[s.endQuery];
+        const double ms = end > begin ? static_cast<double>(end - begin) * tickToMs : 0.0;
+        lastResults_.push_back({s.name, s.depth, ms});
+        if (s.depth == 0 && std::strcmp(s.name, "Frame") == 0) {
+            lastFrameMs_ = ms;
+        }
+
+        auto it = std::find_if(stats_.begin(), stats_.end(),
+            [&](const ZoneStats &z) { return z.name == s.name; });
+        size_t index = static_cast<size_t>(it - stats_.begin());
+        if (it == stats_.end()) {
+            ZoneStats z;
+            z.name = s.name;
+            stats_.push_back(std::move(z));
+            frameTotals.push_back(0.0);
+            seen.push_back(false);
+        }
+        frameTotals[index] += ms;
+        seen[index] = true;
+    }
+
+    for (size_t i = 0; i < stats_.size(); ++i) {
+        if (!seen[i]) continue;
+        ZoneStats &z = stats_[i];
+        z.lastMs = frameTotals[i];
+        z.avgMs = z.frames == 0 ? z.lastMs : z.avgMs + (z.lastMs - z.avgMs) * kAverageWeight;
+        z.maxMs = z.frames == 0 ? z.lastMs : (std::max)(z.maxMs, z.lastMs);
+        ++z.frames;
+    }
+}
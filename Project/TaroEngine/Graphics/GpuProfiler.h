@@ -0,0 +1,145 @@
+#pragma once
+#include "IGpuTimestampBackend.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define TARO_GPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define TARO_GPU_PROFILE_CONCAT(a, b) TARO_GPU_PROFILE_CONCAT_INNER(a, b)
+
+/// スコープの間の GPU 時間を計測する（profiler は GpuProfiler、name は文字列リテラル）。
+#define TARO_GPU_PROFILE_SCOPE(profiler, name) \
+    GpuProfileScope TARO_GPU_PROFILE_CONCAT(taroGpuProfileScope_, __LINE__)((profiler), (name))
+
+/// <summary>
+/// 名前付きスコープで GPU 時間を計測するプロファイラ。<br/>
+/// スコープの前後にタイムスタンプを積み、フレーム末尾で解決し、
+/// 同じフレームスロットが再利用される（＝フェンスが完了した）ときに結果を読み出して集計する。
+/// </summary>
+/// <remarks>
+/// - 計測そのものは IGpuTimestampBackend に任せるので、D3D12 に依存しない。<br/>
+/// - 結果はバックバッファ数ぶん遅れて届く。<br/>
+/// - BeginFrame はフレームの全スコープを囲む "Frame" スコープを自動で開く。
+/// </remarks>
+class GpuProfiler {
+public:
+    /// <summary>無効なスコープ。</summary>
+    static constexpr uint32_t kInvalidScope = UINT32_MAX;
+
+    /// <summary>1 フレーム分の 1 スコープの結果。</summary>
+    struct ScopeResult {
+        const char *name = nullptr;
+        uint32_t depth = 0;
+        double ms = 0.0;
+    };
+
+    /// <summary>名前ごとの集計。</summary>
+    struct ZoneStats {
+        std::string name;
+        double lastMs = 0.0;  ///< 直近のフレームの合計
+        double avgMs = 0.0;   ///< 指数移動平均
+        double maxMs = 0.0;   ///< ResetStats 以降の最大
+        uint64_t frames = 0;  ///< 集計したフレーム数
+    };
+
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="backend">タイムスタンプのバックエンド（GpuProfiler より長く生存すること）。</param>
+    void Initialize(IGpuTimestampBackend *backend);
+
+    /// <summary>
+    /// フレームの計測を開始する。<br/>
+    /// frameSlot の前回の結果はこのとき読み出すので、スロットのフェンス待ちが済んでから呼ぶこと。
+    /// </summary>
+    /// <param name="frameSlot">フレームスロット（バックバッファ番号）。</param>
+    void BeginFrame(uint32_t frameSlot);
+
+    /// <summary>
+    /// フレームの計測を終え、タイムスタンプを解決する（コマンドリストを閉じる前に呼ぶ）。
+    /// </summary>
+    void EndFrame();
+
+    /// <summary>
+    /// スコープを開始する。
+    /// </summary>
+    /// <param name="name">スコープ名（文字列リテラル）。</param>
+    /// <returns>スコープ番号。フレーム外やクエリ不足のときは kInvalidScope。</returns>
+    uint32_t BeginScope(const char *name);
+
+    /// <summary>
+    /// スコープを終了する。
+    /// </summary>
+    /// <param name="scope">BeginScope の戻り値。</param>
+    void EndScope(uint32_t scope);
+
+    /// <summary>最後に読み出したフレームのスコープ（開始順）。</summary>
+    const std::vector<ScopeResult> &GetLastResults() const { return lastResults_; }
+
+    /// <summary>名前ごとの集計（初出順）。</summary>
+    const std::vector<ZoneStats> &GetStats() const { return stats_; }
+
+    /// <summary>最後に読み出したフレーム全体の GPU 時間（ms）。</summary>
+    double GetLastFrameMs() const { return lastFrameMs_; }
+
+    /// <summary>クエリが足りずに計測できなかったスコープの累計。</summary>
+    uint64_t GetDroppedScopeCount() const { return droppedScopes_; }
+
+    /// <summary>集計の最大値と平均を初期化する。</summary>
+    void ResetStats();
+
+private:
+    /// <summary>1 スコープの記録。</summary>
+    struct Scope {
+        const char *name = nullptr;
+        uint32_t depth = 0;
+        uint32_t beginQuery = 0;
+        uint32_t endQuery = 0;
+        bool closed = false;
+    };
+
+    /// <summary>1 フレームスロット分の記録。</summary>
+    struct FrameSlot {
+        std::vector<Scope> scopes;
+        uint32_t queryCount = 0;
+        bool pending = false; // 解決済みで読み出し待ち
+    };
+
+    /// <summary>スロットの結果を読み出して集計する。</summary>
+    void CollectSlot(FrameSlot &slot, uint32_t frameSlot);
+
+private:
+    IGpuTimestampBackend *backend_ = nullptr;
+    std::vector<FrameSlot> slots_;
+    std::vector<uint64_t> timestamps_; // 読み出し用の作業領域
+
+    uint32_t currentSlot_ = 0;
+    bool frameActive_ = false;
+    uint32_t frameScope_ = kInvalidScope;
+    uint32_t depth_ = 0;
+
+    std::vector<ScopeResult> lastResults_;
+    std::vector<ZoneStats> stats_;
+    double lastFrameMs_ = 0.0;
+    uint64_t droppedScopes_ = 0;
+};
+
+/// <summary>
+/// スコープの間を GPU 計測する RAII マーカー（TARO_GPU_PROFILE_SCOPE から使う）。
+/// </summary>
+class GpuProfileScope {
+public:
+    GpuProfileScope(GpuProfiler &profiler, const char *name)
+        : profiler_(profiler), scope_(profiler.BeginScope(name)) {
+    }
+
+    ~GpuProfileScope() { profiler_.EndScope(scope_); }
+
+    GpuProfileScope(const GpuProfileScope &) = delete;
+    GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+
+private:
+    GpuProfiler &profiler_;
+    uint32_t scope_;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+
+/// <summary>
+/// コマンドの記録先 1 つ（アロケータとコマンドリストの組）。<br/>
+/// 実体はバックエンドが派生クラスとして作り、CommandContextPool が使い回す。
+/// </summary>
+class CommandContext {
+public:
+    virtual ~CommandContext() = default;
+
+    /// <summary>提出順のキー（小さいほど先に実行される）。</summary>
+    uint32_t GetOrder() const { return order_; }
+
+private:
+    friend class CommandContextPool;
+    uint32_t order_ = 0;       // 提出順のキー
+    uint64_t sequence_ = 0;    // 取得順（同じ order の並びを決める）
+    uint64_t fenceValue_ = 0;  // このフェンス値の完了で再利用できる
+};
+
+/// <summary>
+/// CommandContext の作成・記録開始・記録終了・実行を抽象化したバックエンド。<br/>
+/// CommandContextPool はこのインターフェース越しにだけデバイスとキューに触れるので、
+/// 差し替えれば使い回しの規則を GPU なしで確かめられる。
+/// </summary>
+class ICommandContextBackend {
+public:
+    virtual ~ICommandContextBackend() = default;
+
+    /// <summary>新しいコンテキストを作る（記録していない状態で返す）。</summary>
+    virtual std::unique_ptr<CommandContext> CreateContext() = 0;
+
+    /// <summary>記録を始める（アロケータとリストのリセット）。GPU が使い終えたものにだけ呼ばれる。</summary>
+    virtual void BeginRecording(CommandContext &context) = 0;
+
+    /// <summary>記録を終える（リストを閉じる）。</summary>
+    virtual void EndRecording(CommandContext &context) = 0;
+
+    /// <summary>
+    /// 閉じたコンテキストを並び順のまま 1 回で実行する。
+    /// </summary>
+    /// <param name="contexts">実行するコンテキスト。</param>
+    /// <param name="count">個数。</param>
+    virtual void Execute(CommandContext *const *contexts, uint32_t count) = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// GPU タイムスタンプの書き込み・解決・読み出しを抽象化したバックエンド。<br/>
+/// GpuProfiler はこのインターフェース越しにだけ計測するので、
+/// D3D12 の実装と差し替えてスコープ・集計のロジックを GPU なしで動かせる。
+/// </summary>
+/// <remarks>
+/// クエリはフレームスロット（バックバッファ数ぶん）ごとに区切られ、
+/// 書き込み → ResolveFrame → （そのスロットのフェンス完了後に）ReadFrame の順で使う。
+/// </remarks>
+class IGpuTimestampBackend {
+public:
+    virtual ~IGpuTimestampBackend() = default;
+
+    /// <summary>フレームスロット数。</summary>
+    virtual uint32_t GetFrameSlotCount() const = 0;
+
+    /// <summary>1 フレームで書き込めるタイムスタンプ数。</summary>
+    virtual uint32_t GetMaxQueriesPerFrame() const = 0;
+
+    /// <summary>タイムスタンプの 1 秒あたりの tick 数。</summary>
+    virtual uint64_t GetFrequency() const = 0;
+
+    /// <summary>
+    /// タイムスタンプを書き込む（GPU ではコマンドとして積まれる）。
+    /// </summary>
+    /// <param name="frameSlot">フレームスロット。</param>
+    /// <param name="queryIndex">スロット内のクエリ番号。</param>
+    virtual void WriteTimestamp(uint32_t frameSlot, uint32_t queryIndex) = 0;
+
+    /// <summary>
+    /// スロットの先頭 queryCount 個を読み出し用バッファへ解決する（フレーム末尾で呼ぶ）。
+    /// </summary>
+    virtual void ResolveFrame(uint32_t frameSlot, uint32_t queryCount) = 0;
+
+    /// <summary>
+    /// 解決済みのタイムスタンプを読み出す。スロットのフェンスが完了してから呼ぶこと。
+    /// </summary>
+    /// <param name="frameSlot">フレームスロット。</param>
+    /// <param name="queryCount">読み出す数。</param>
+    /// <param name="out">書き込み先（queryCount 個）。</param>
+    /// <returns>読み出せたら true。</returns>
+    virtual bool ReadFrame(uint32_t frameSlot, uint32_t queryCount, uint64_t *out) = 0;
+};
@@ -0,0 +1,237 @@
+#include "PipelineCache.h"
+#include "HashUtil.h"
+#include <cassert>
+#include <fstream>
+#include <string>
+
+using Microsoft::WRL::ComPtr;
+namespace fs = std::filesystem;
+
+// 入力レイアウトのオフセットは D3D12 の値のままキーに入れる
+static_assert(PipelineStateKey::kAppendAlignedElement == D3D12_APPEND_ALIGNED_ELEMENT);
+
+namespace {
+
+    uint64_t HashShader(const D3D12_SHADER_BYTECODE &bc) {
+        if (!bc.pShaderBytecode || bc.BytecodeLength == 0) return 0;
+        return HashUtil::Fnv1a(bc.pShaderBytecode, bc.BytecodeLength);
+    }
+
+    // ライブラリ内の PSO 名（キーのハッシュから作る）
+    std::wstring MakeLibraryName(uint64_t hash) {
+        static const wchar_t kDigits[] = L"0123456789abcdef";
+        std::wstring name = L"PSO_0000000000000000";
+        for (int i = 0; i < 16; ++i) {
+            name[name.size() - 1 - i] = kDigits[(hash >> (i * 4)) & 0xF];
+        }
+        return name;
+    }
+
+} // namespace
+
+void PipelineCache::Initialize(ID3D12Device *device, const fs::path &libraryPath) {
+    assert(device);
+    device_ = device;
+    libraryPath_ = libraryPath;
+    entries_.clear();
+    rootSignatureHashes_.clear(); // 前のデバイスのルートシグネチャのアドレスが再利用されても取り違えない
+    stats_ = {};
+
+    // ライブラリは libraryBlob_ を参照しているので先に手放す
+    library_.Reset();
+    libraryBlob_.clear();
+    dirty_ = false;
+
+    if (!libraryPath_.empty()) {
+        LoadPipelineLibrary();
+    }
+}
+
+void PipelineCache::LoadPipelineLibrary() {
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(device_->QueryInterface(IID_PPV_ARGS(&device1)))) {
+        return; // ライブラリ非対応（メモリ上のキャッシュだけで動く）
+    }
+
+    // 既存のライブラリを読む
+    libraryBlob_.clear();
+    {
+        std::ifstream ifs(libraryPath_, std::ios::binary);
+        if (ifs) {
+            libraryBlob_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        }
+    }
+
+    if (!libraryBlob_.empty()) {
+        HRESULT hr = device1->CreatePipelineLibrary(
+            libraryBlob_.data(), libraryBlob_.size(), IID_PPV_ARGS(&library_));
+        if (SUCCEEDED(hr)) {
+            return;
+        }
+        // ドライバ・GPU の変更や破損（D3D12_ERROR_DRIVER_VERSION_MISMATCH など）は作り直す
+        OutputDebugStringA("[PipelineCache] pipeline library discarded (driver/adapter changed or corrupt)\n");
+        libraryBlob_.clear();
+    }
+
+    HRESULT hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library_));
+    if (FAILED(hr)) {
+        library_.Reset(); // 非対応ドライバ
+    } else {
+        dirty_ = true;
+    }
+}
+
+void PipelineCache::RegisterRootSignature(ID3D12RootSignature *rootSignature, const void *blob, size_t size) {
+    assert(rootSignature && blob && size > 0);
+    rootSignatureHashes_[rootSignature] = HashUtil::Fnv1a(blob, size);
+}
+
+PipelineStateKey PipelineCache::MakeKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &d, uint64_t rootSignatureHash) {
+    PipelineStateKey k;
+    k.rootSignature = rootSignatureHash;
+    k.vs = HashShader(d.VS);
+    k.ps = HashShader(d.PS);
+    k.ds = HashShader(d.DS);
+    k.hs = HashShader(d.HS);
+    k.gs = HashShader(d.GS);
+
+    k.inputLayout.reserve(d.InputLayout.NumElements);
+    for (UINT i = 0; i < d.InputLayout.NumElements; ++i) {
+        const auto &e = d.InputLayout.pInputElementDescs[i];
+        k.inputLayout.push_back({
+            e.SemanticName ? e.SemanticName : "", e.SemanticIndex, static_cast<uint32_t>(e.Format),
+            e.InputSlot, e.AlignedByteOffset, static_cast<uint32_t>(e.InputSlotClass), e.InstanceDataStepRate});
+    }
+
+    k.alphaToCoverageEnable = d.BlendState.AlphaToCoverageEnable;
+    k.independentBlendEnable = d.BlendState.IndependentBlendEnable;
+    for (UINT i = 0; i < PipelineStateKey::kMaxRenderTargets; ++i) {
+        const auto &s = d.BlendState.RenderTarget[i];
+        auto &t = k.renderTargetBlend[i];
+        t.blendEnable = s.BlendEnable;
+        t.logicOpEnable = s.LogicOpEnable;
+        t.srcBlend = s.SrcBlend;
+        t.destBlend = s.DestBlend;
+        t.blendOp = s.BlendOp;
+        t.srcBlendAlpha = s.SrcBlendAlpha;
+        t.destBlendAlpha = s.DestBlendAlpha;
+        t.blendOpAlpha = s.BlendOpAlpha;
+        t.logicOp = s.LogicOp;
+        t.writeMask = s.RenderTargetWriteMask;
+    }
+
+    const auto &r = d.RasterizerState;
+    k.fillMode = r.FillMode;
+    k.cullMode = r.CullMode;
+    k.frontCounterClockwise = r.FrontCounterClockwise;
+    k.depthBias = r.DepthBias;
+    k.depthBiasClamp = r.DepthBiasClamp;
+    k.slopeScaledDepthBias = r.SlopeScaledDepthBias;
+    k.depthClipEnable = r.DepthClipEnable;
+    k.multisampleEnable = r.MultisampleEnable;
+    k.antialiasedLineEnable = r.AntialiasedLineEnable;
+    k.forcedSampleCount = r.ForcedSampleCount;
+    k.conservativeRaster = r.ConservativeRaster;
+
+    const auto &ds = d.DepthStencilState;
+    k.depthEnable = ds.DepthEnable;
+    k.depthWriteMask = ds.DepthWriteMask;
+    k.depthFunc = ds.DepthFunc;
+    k.stencilEnable = ds.StencilEnable;
+    k.stencilReadMask = ds.StencilReadMask;
+    k.stencilWriteMask = ds.StencilWriteMask;
+    k.frontFace = {static_cast<uint32_t>(ds.FrontFace.StencilFailOp), static_cast<uint32_t>(ds.FrontFace.StencilDepthFailOp),
+        static_cast<uint32_t>(ds.FrontFace.StencilPassOp), static_cast<uint32_t>(ds.FrontFace.StencilFunc)};
+    k.backFace = {static_cast<uint32_t>(ds.BackFace.StencilFailOp), static_cast<uint32_t>(ds.BackFace.StencilDepthFailOp),
+        static_cast<uint32_t>(ds.BackFace.StencilPassOp), static_cast<uint32_t>(ds.BackFace.StencilFunc)};
+
+    k.sampleMask = d.SampleMask;
+    k.ibStripCutValue = d.IBStripCutValue;
+    k.primitiveTopologyType = d.PrimitiveTopologyType;
+    k.numRenderTargets = d.NumRenderTargets;
+    for (UINT i = 0; i < PipelineStateKey::kMaxRenderTargets; ++i) {
+        k.rtvFormats[i] = d.RTVFormats[i];
+    }
+    k.dsvFormat = d.DSVFormat;
+    k.sampleCount = d.SampleDesc.Count;
+    k.sampleQuality = d.SampleDesc.Quality;
+    k.nodeMask = d.NodeMask;
+    k.flags = d.Flags;
+
+    k.Normalize();
+    return k;
+}
+
+ID3D12PipelineState *PipelineCache::GetOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc) {
+    assert(device_);
+
+    // ルートシグネチャは登録済みなら内容ハッシュ、未登録ならポインタ値（その場合ディスクには残さない）
+    const auto rs = rootSignatureHashes_.find(desc.pRootSignature);
+    const bool persistent = (rs != rootSignatureHashes_.end());
+    const uint64_t rootSignatureHash = persistent
+        ? rs->second
+        : static_cast<uint64_t>(reinterpret_cast<uintptr_t>(desc.pRootSignature));
+
+    PipelineStateKey key = MakeKey(desc, rootSignatureHash);
+    const uint64_t hash = key.Hash();
+
+    // 1) メモリ上のキャッシュ
+    auto &bucket = entries_[hash];
+    for (const auto &e : bucket) {
+        if (e.key == key) {
+            ++stats_.memoryHits;
+            return e.pipelineState.Get();
+        }
+    }
+
+    // 2) ライブラリ（同名でも記述が違えば E_INVALIDARG で失敗するので、衝突しても誤用しない）
+    ComPtr<ID3D12PipelineState> pso;
+    const std::wstring name = MakeLibraryName(hash);
+    const bool useLibrary = persistent && library_;
+    if (useLibrary &&
+        SUCCEEDED(library_->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pso)))) {
+        ++stats_.libraryHits;
+    } else {
+        // 3) 新規作成
+        HRESULT hr = device_->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pso));
+        if (FAILED(hr)) {
+            OutputDebugStringA("[D3D12] CreateGraphicsPipelineState failed\n");
+            return nullptr;
+        }
+        ++stats_.created;
+
+        if (useLibrary && SUCCEEDED(library_->StorePipeline(name.c_str(), pso.Get()))) {
+            dirty_ = true;
+        }
+    }
+
+    bucket.push_back({std::move(key), pso});
+    return pso.Get();
+}
+
+bool PipelineCache::Save() {
+    if (!library_ || !dirty_ || libraryPath_.empty()) return true;
+
+    const SIZE_T size = library_->GetSerializedSize();
+    std::vector<uint8_t> data(size);
+    HRESULT hr = library_->Serialize(data.data(), size);
+    if (FAILED(hr)) return false;
+
+    // 途中で落ちても壊れたファイルが残らないよう、一時ファイルに書いてから置き換える
+    const fs::path tmp = libraryPath_.string() + ".tmp";
+    {
+        std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!ofs) return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, libraryPath_, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
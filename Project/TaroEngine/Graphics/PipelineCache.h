@@ -0,0 +1,94 @@
+#pragma once
+#include "PipelineStateKey.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// グラフィックス PSO のキャッシュ。<br/>
+/// D3D12_GRAPHICS_PIPELINE_STATE_DESC を PipelineStateKey に正規化してハッシュし、
+/// 同じ記述なら作成済みの PSO を返す。<br/>
+/// ID3D12PipelineLibrary が使える環境では、作成した PSO をライブラリにも登録し、
+/// Save でディスクへ書き出す。次回起動時はドライバのコンパイルを省いて読み込める。
+/// </summary>
+/// <remarks>
+/// スレッドセーフではない（初期化時にメインスレッドから使う想定）。
+/// </remarks>
+class PipelineCache {
+public:
+    /// <summary>
+    /// 統計情報。
+    /// </summary>
+    struct Stats {
+        uint32_t memoryHits = 0;  // メモリ上のキャッシュで見つかった回数
+        uint32_t libraryHits = 0; // ライブラリから読み込めた回数
+        uint32_t created = 0;     // 新規に作成した回数
+    };
+
+public:
+    /// <summary>
+    /// 初期化処理。libraryPath が指定されていればライブラリを読み込む（無い・壊れている場合は空から始める）。
+    /// </summary>
+    /// <param name="device">D3D12 デバイス。</param>
+    /// <param name="libraryPath">ライブラリの保存先（空ならディスクに保存しない）。</param>
+    void Initialize(ID3D12Device *device, const std::filesystem::path &libraryPath = {});
+
+    /// <summary>
+    /// ルートシグネチャをシリアライズ結果の内容で登録する。<br/>
+    /// 登録したルートシグネチャを使う PSO だけがライブラリ（ディスク）に保存される。
+    /// </summary>
+    /// <param name="rootSignature">ルートシグネチャ。</param>
+    /// <param name="blob">D3D12SerializeRootSignature の結果。</param>
+    /// <param name="size">blob のバイト数。</param>
+    void RegisterRootSignature(ID3D12RootSignature *rootSignature, const void *blob, size_t size);
+
+    /// <summary>
+    /// PSO を取得する。なければライブラリから読み込むか、新規に作成する。
+    /// </summary>
+    /// <param name="desc">PSO 記述。</param>
+    /// <returns>PSO（キャッシュが所有）。作成に失敗したら nullptr。</returns>
+    ID3D12PipelineState *GetOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc);
+
+    /// <summary>
+    /// ライブラリに追加があればディスクへ書き出す。
+    /// </summary>
+    /// <returns>書き出した（または書き出す必要がなかった）なら true。</returns>
+    bool Save();
+
+    /// <summary>
+    /// PSO 記述から正規化済みのキーを作る。
+    /// </summary>
+    /// <param name="desc">PSO 記述。</param>
+    /// <param name="rootSignatureHash">ルートシグネチャの内容ハッシュ。</param>
+    static PipelineStateKey MakeKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC &desc, uint64_t rootSignatureHash);
+
+    /// <summary>統計情報を取得する。</summary>
+    const Stats &GetStats() const { return stats_; }
+
+private:
+    /// <summary>
+    /// キャッシュ 1 件。ハッシュ衝突に備えてキー本体も持つ。
+    /// </summary>
+    struct Entry {
+        PipelineStateKey key;
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
+    };
+
+    /// <summary>ライブラリを読み込む（失敗したら空のライブラリを作る）。</summary>
+    void LoadPipelineLibrary();
+
+private:
+    ID3D12Device *device_ = nullptr;
+    std::filesystem::path libraryPath_;
+
+    Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> library_;
+    std::vector<uint8_t> libraryBlob_; // ライブラリが参照するため、ライブラリより長く保持する
+    bool dirty_ = false;
+
+    std::unordered_map<uint64_t, std::vector<Entry>> entries_;
+    std::unordered_map<ID3D12RootSignature *, uint64_t> rootSignatureHashes_;
+    Stats stats_{};
+};
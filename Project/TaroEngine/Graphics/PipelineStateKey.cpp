@@ -0,0 +1,153 @@
+#include "PipelineStateKey.h"
+#include "HashUtil.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+    // D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA と同じ値
+    constexpr uint32_t kPerVertexData = 0;
+
+    void NormalizeBlend(PipelineStateKey::RenderTargetBlend &rt) {
+        if (!rt.blendEnable) {
+            // ブレンド無効なら係数・演算は参照されない
+            const uint32_t writeMask = rt.writeMask;
+            const uint32_t logicOpEnable = rt.logicOpEnable;
+            const uint32_t logicOp = rt.logicOp;
+            rt = {};
+            rt.writeMask = writeMask;
+            rt.logicOpEnable = logicOpEnable;
+            rt.logicOp = logicOp;
+        }
+        if (!rt.logicOpEnable) {
+            rt.logicOp = 0;
+        }
+    }
+
+    void HashStencilOp(HashUtil::Fnv1a64 &h, const PipelineStateKey::StencilOp &op) {
+        h.AddU32(op.failOp);
+        h.AddU32(op.depthFailOp);
+        h.AddU32(op.passOp);
+        h.AddU32(op.func);
+    }
+
+} // namespace
+
+void PipelineStateKey::Normalize() {
+    // 入力レイアウト：セマンティクス名は大文字小文字を区別しない
+    for (auto &e : inputLayout) {
+        std::transform(e.semanticName.begin(), e.semanticName.end(), e.semanticName.begin(),
+            [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        if (e.inputSlotClass == kPerVertexData) {
+            e.instanceDataStepRate = 0; // 頂点単位のデータでは使われない
+        }
+    }
+
+    // レンダーターゲット：使わないスロットの形式は無視される
+    numRenderTargets = std::min(numRenderTargets, kMaxRenderTargets);
+    for (uint32_t i = numRenderTargets; i < kMaxRenderTargets; ++i) {
+        rtvFormats[i] = 0;
+    }
+
+    // ブレンド：個別ブレンド無効なら RT0 の設定だけ、有効でも使うスロット分だけが使われる
+    const uint32_t usedBlends = independentBlendEnable ? std::max(numRenderTargets, 1u) : 1u;
+    for (uint32_t i = 0; i < kMaxRenderTargets; ++i) {
+        if (i >= usedBlends) {
+            renderTargetBlend[i] = {};
+        } else {
+            NormalizeBlend(renderTargetBlend[i]);
+        }
+    }
+
+    // 深度ステンシル
+    if (!depthEnable) {
+        depthWriteMask = 0;
+        depthFunc = 0;
+    }
+    if (!stencilEnable) {
+        stencilReadMask = 0;
+        stencilWriteMask = 0;
+        frontFace = {};
+        backFace = {};
+    }
+
+    // Hash はビット列で混ぜるので、== で等しい -0.0 を +0.0 に揃える
+    if (depthBiasClamp == 0.0f) depthBiasClamp = 0.0f;
+    if (slopeScaledDepthBias == 0.0f) slopeScaledDepthBias = 0.0f;
+
+    // MSAA なしは Count=1 として扱う
+    if (sampleCount == 0) {
+        sampleCount = 1;
+    }
+}
+
+uint64_t PipelineStateKey::Hash() const {
+    HashUtil::Fnv1a64 h;
+
+    h.AddU64(rootSignature);
+    h.AddU64(vs);
+    h.AddU64(ps);
+    h.AddU64(ds);
+    h.AddU64(hs);
+    h.AddU64(gs);
+
+    h.AddU64(inputLayout.size());
+    for (const auto &e : inputLayout) {
+        h.AddString(e.semanticName);
+        h.AddU32(e.semanticIndex);
+        h.AddU32(e.format);
+        h.AddU32(e.inputSlot);
+        h.AddU32(e.alignedByteOffset);
+        h.AddU32(e.inputSlotClass);
+        h.AddU32(e.instanceDataStepRate);
+    }
+
+    h.AddU32(alphaToCoverageEnable);
+    h.AddU32(independentBlendEnable);
+    for (const auto &rt : renderTargetBlend) {
+        h.AddU32(rt.blendEnable);
+        h.AddU32(rt.logicOpEnable);
+        h.AddU32(rt.srcBlend);
+        h.AddU32(rt.destBlend);
+        h.AddU32(rt.blendOp);
+        h.AddU32(rt.srcBlendAlpha);
+        h.AddU32(rt.destBlendAlpha);
+        h.AddU32(rt.blendOpAlpha);
+        h.AddU32(rt.logicOp);
+        h.AddU32(rt.writeMask);
+    }
+
+    h.AddU32(fillMode);
+    h.AddU32(cullMode);
+    h.AddU32(frontCounterClockwise);
+    h.AddU32(static_cast<uint32_t>(depthBias));
+    h.AddFloat(depthBiasClamp);
+    h.AddFloat(slopeScaledDepthBias);
+    h.AddU32(depthClipEnable);
+    h.AddU32(multisampleEnable);
+    h.AddU32(antialiasedLineEnable);
+    h.AddU32(forcedSampleCount);
+    h.AddU32(conservativeRaster);
+
+    h.AddU32(depthEnable);
+    h.AddU32(depthWriteMask);
+    h.AddU32(depthFunc);
+    h.AddU32(stencilEnable);
+    h.AddU32(stencilReadMask);
+    h.AddU32(stencilWriteMask);
+    HashStencilOp(h, frontFace);
+    HashStencilOp(h, backFace);
+
+    h.AddU32(sampleMask);
+    h.AddU32(ibStripCutValue);
+    h.AddU32(primitiveTopologyType);
+    h.AddU32(numRenderTargets);
+    for (uint32_t f : rtvFormats) h.AddU32(f);
+    h.AddU32(dsvFormat);
+    h.AddU32(sampleCount);
+    h.AddU32(sampleQuality);
+    h.AddU32(nodeMask);
+    h.AddU32(flags);
+
+    return h.value;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// グラフィックス PSO の記述を、D3D12 ヘッダに依存しない整数・ハッシュ値だけで表したキー。<br/>
+/// シェーダやルートシグネチャはポインタではなく内容のハッシュで持つので、
+/// 実行をまたいでも同じ記述なら同じキーになる。
+/// </summary>
+/// <remarks>
+/// 列挙値は D3D12 / DXGI の値をそのまま uint32_t で保持する。
+/// 比較・ハッシュの前に Normalize で「結果に影響しない差」を消しておくこと。
+/// </remarks>
+struct PipelineStateKey {
+    static constexpr uint32_t kMaxRenderTargets = 8;
+    static constexpr uint32_t kAppendAlignedElement = 0xFFFFFFFFu; // D3D12_APPEND_ALIGNED_ELEMENT
+
+    /// <summary>入力レイアウト 1 要素（D3D12_INPUT_ELEMENT_DESC 相当）。</summary>
+    struct InputElement {
+        std::string semanticName;
+        uint32_t semanticIndex = 0;
+        uint32_t format = 0;
+        uint32_t inputSlot = 0;
+        uint32_t alignedByteOffset = 0; // kAppendAlignedElement なら直前の要素の直後（明示オフセットとは別のキー）
+        uint32_t inputSlotClass = 0;
+        uint32_t instanceDataStepRate = 0;
+
+        bool operator==(const InputElement &) const = default;
+    };
+
+    /// <summary>レンダーターゲット 1 枚分のブレンド設定（D3D12_RENDER_TARGET_BLEND_DESC 相当）。</summary>
+    struct RenderTargetBlend {
+        uint32_t blendEnable = 0;
+        uint32_t logicOpEnable = 0;
+        uint32_t srcBlend = 0;
+        uint32_t destBlend = 0;
+        uint32_t blendOp = 0;
+        uint32_t srcBlendAlpha = 0;
+        uint32_t destBlendAlpha = 0;
+        uint32_t blendOpAlpha = 0;
+        uint32_t logicOp = 0;
+        uint32_t writeMask = 0;
+
+        bool operator==(const RenderTargetBlend &) const = default;
+    };
+
+    /// <summary>ステンシル片面分の設定（D3D12_DEPTH_STENCILOP_DESC 相当）。</summary>
+    struct StencilOp {
+        uint32_t failOp = 0;
+        uint32_t depthFailOp = 0;
+        uint32_t passOp = 0;
+        uint32_t func = 0;
+
+        bool operator==(const StencilOp &) const = default;
+    };
+
+    // --- シェーダ・ルートシグネチャ（内容のハッシュ。未使用は 0） ---
+    uint64_t rootSignature = 0;
+    uint64_t vs = 0;
+    uint64_t ps = 0;
+    uint64_t ds = 0;
+    uint64_t hs = 0;
+    uint64_t gs = 0;
+
+    // --- 入力レイアウト ---
+    std::vector<InputElement> inputLayout;
+
+    // --- ブレンド ---
+    uint32_t alphaToCoverageEnable = 0;
+    uint32_t independentBlendEnable = 0;
+    RenderTargetBlend renderTargetBlend[kMaxRenderTargets]{};
+
+    // --- ラスタライザ ---
+    uint32_t fillMode = 0;
+    uint32_t cullMode = 0;
+    uint32_t frontCounterClockwise = 0;
+    int32_t depthBias = 0;
+    float depthBiasClamp = 0.0f;
+    float slopeScaledDepthBias = 0.0f;
+    uint32_t depthClipEnable = 0;
+    uint32_t multisampleEnable = 0;
+    uint32_t antialiasedLineEnable = 0;
+    uint32_t forcedSampleCount = 0;
+    uint32_t conservativeRaster = 0;
+
+    // --- 深度ステンシル ---
+    uint32_t depthEnable = 0;
+    uint32_t depthWriteMask = 0;
+    uint32_t depthFunc = 0;
+    uint32_t stencilEnable = 0;
+    uint32_t stencilReadMask = 0;
+    uint32_t stencilWriteMask = 0;
+    StencilOp frontFace{};
+    StencilOp backFace{};
+
+    // --- その他 ---
+    uint32_t sampleMask = 0;
+    uint32_t ibStripCutValue = 0;
+    uint32_t primitiveTopologyType = 0;
+    uint32_t numRenderTargets = 0;
+    uint32_t rtvFormats[kMaxRenderTargets]{};
+    uint32_t dsvFormat = 0;
+    uint32_t sampleCount = 1;
+    uint32_t sampleQuality = 0;
+    uint32_t nodeMask = 0;
+    uint32_t flags = 0;
+
+    /// <summary>
+    /// 結果に影響しない差を消す。<br/>
+    /// 例：ブレンド無効時のブレンド係数、使わないレンダーターゲットの形式、深度無効時の比較関数など。
+    /// </summary>
+    void Normalize();
+
+    /// <summary>
+    /// 全フィールドの安定ハッシュを返す（Normalize 後に呼ぶこと）。
+    /// </summary>
+    uint64_t Hash() const;
+
+    bool operator==(const PipelineStateKey &) const = default;
+};
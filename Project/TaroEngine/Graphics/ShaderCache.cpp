@@ -0,0 +1,339 @@
+#include "ShaderCache.h"
+#include "HashUtil.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // ===============================
+    // ファイル / #include 解析
+    // ===============================
+
+    bool ReadFileBytes(const fs::path &path, std::string &out) {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs) return false;
+        out.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // コメントを空白に置き換える（改行は残す）。文字列リテラル内は触らない
+    std::string StripComments(const std::string &src) {
+        std::string out = src;
+        enum class State { Code, Line, Block, String } state = State::Code;
+        for (size_t i = 0; i < out.size(); ++i) {
+            const char c = out[i];
+            const char next = (i + 1 < out.size()) ? out[i + 1] : '\0';
+            switch (state) {
+            case State::Code:
+                if (c == '/' && next == '/') { state = State::Line; out[i] = ' '; }
+                else if (c == '/' && next == '*') { state = State::Block; out[i] = ' '; out[++i] = ' '; }
+                else if (c == '"') { state = State::String; }
+                break;
+            case State::Line:
+                if (c == '\n') state = State::Code; else out[i] = ' ';
+                break;
+            case State::Block:
+                if (c == '*' && next == '/') { state = State::Code; out[i] = ' '; out[++i] = ' '; }
+                else if (c != '\n') out[i] = ' ';
+                break;
+            case State::String:
+                if (c == '\\') ++i;
+                else if (c == '"' || c == '\n') state = State::Code;
+                break;
+            }
+        }
+        return out;
+    }
+
+    // #include "x" / #include <x> の名前を出現順に取り出す。
+    // #if による分岐は評価しない（多めに拾っても鍵が保守的になるだけ）
+    std::vector<std::string> ExtractIncludes(const std::string &source) {
+        std::vector<std::string> names;
+        const std::string text = StripComments(source);
+
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == std::string::npos) end = text.size();
+
+            size_t i = pos;
+            auto skipSpace = [&] { while (i < end && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r')) ++i; };
+
+            skipSpace();
+            if (i < end && text[i] == '#') {
+                ++i;
+                skipSpace();
+                if (text.compare(i, 7, "include") == 0) {
+                    i += 7;
+                    skipSpace();
+                    if (i < end && (text[i] == '"' || text[i] == '<')) {
+                        const char close = (text[i] == '"') ? '"' : '>';
+                        const size_t nameBegin = i + 1;
+                        const size_t nameEnd = text.find(close, nameBegin);
+                        if (nameEnd != std::string::npos && nameEnd < end) {
+                            names.push_back(text.substr(nameBegin, nameEnd - nameBegin));
+                        }
+                    }
+                }
+            }
+            pos = end + 1;
+        }
+        return names;
+    }
+
+    // 引数列から -I / /I のディレクトリを取り出す
+    std::vector<fs::path> ExtractIncludeDirs(const std::vector<std::wstring> &args) {
+        std::vector<fs::path> dirs;
+        for (size_t i = 0; i < args.size(); ++i) {
+            const std::wstring &a = args[i];
+            if (a == L"-I" || a == L"/I") {
+                if (i + 1 < args.size()) dirs.emplace_back(args[++i]);
+            } else if (a.size() > 2 && (a.compare(0, 2, L"-I") == 0 || a.compare(0, 2, L"/I") == 0)) {
+                dirs.emplace_back(a.substr(2));
+            }
+        }
+        return dirs;
+    }
+
+    // ===============================
+    // キャッシュファイル形式
+    // ===============================
+
+    struct EntryHeader {
+        char magic[4];     // "TSCH"
+        uint32_t version;  // ShaderCache::kFormatVersion
+        uint64_t hash;     // キー（ファイル名と二重に確認する）
+        uint64_t size;     // 本体のバイト数
+    };
+
+    constexpr char kMagic[4] = {'T', 'S', 'C', 'H'};
+
+} // namespace
+
+std::string ShaderCache::Key::ToHex() const {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string s(16, '0');
+    for (int i = 0; i < 16; ++i) {
+        s[15 - i] = kDigits[(hash >> (i * 4)) & 0xF];
+    }
+    return s;
+}
+
+bool ShaderCache::Initialize(const fs::path &directory) {
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec || !fs::is_directory(directory, ec)) {
+        directory_.clear();
+        return false;
+    }
+    directory_ = directory;
+    hits_ = 0;
+    misses_ = 0;
+    stores_ = 0;
+    return true;
+}
+
+ShaderCache::Key ShaderCache::ComputeKey(const KeyDesc &desc) const {
+    Key key;
+    HashUtil::Fnv1a64 h;
+
+    h.AddU64(kFormatVersion);
+    h.AddString(desc.toolchain);
+    h.AddWString(desc.entry);
+    h.AddWString(desc.profile);
+
+    h.AddU64(desc.defines.size());
+    for (const auto &d : desc.defines) h.AddWString(d);
+
+    h.AddU64(desc.arguments.size());
+    for (const auto &a : desc.arguments) h.AddWString(a);
+
+    h.AddString(desc.source);
+
+    // #include 先の内容も鍵に含める（インクルードファイルの変更で別キーになる）
+    // ディレクトリを含まないファイル名なら、DXC と同じくカレントディレクトリから探す
+    fs::path currentDir;
+    if (!desc.sourcePath.empty()) {
+        currentDir = desc.sourcePath.has_parent_path() ? desc.sourcePath.parent_path() : fs::path(".");
+    }
+    std::unordered_set<std::string> visited;
+    HashIncludes(desc.source, currentDir, ExtractIncludeDirs(desc.arguments), h, key, visited);
+
+    key.hash = h.value;
+    return key;
+}
+
+void ShaderCache::HashIncludes(const std::string &source, const fs::path &currentDir,
+    const std::vector<fs::path> &includeDirs, HashUtil::Fnv1a64 &hash, Key &key,
+    std::unordered_set<std::string> &visited) const {
+    for (const std::string &name : ExtractIncludes(source)) {
+        hash.AddString(name);
+
+        // 解決順：インクルード元と同じディレクトリ → -I の順
+        fs::path resolved;
+        std::error_code ec;
+        if (!currentDir.empty() && fs::is_regular_file(currentDir / name, ec)) {
+            resolved = currentDir / name;
+        } else {
+            for (const auto &dir : includeDirs) {
+                if (fs::is_regular_file(dir / name, ec)) {
+                    resolved = dir / name;
+                    break;
+                }
+            }
+        }
+
+        if (resolved.empty()) {
+            // 見つからないこと自体も鍵に含める（後からファイルが置かれたら別キーになる）
+            hash.AddString("<missing>");
+            key.missingIncludes.push_back(name);
+            continue;
+        }
+
+        const std::string id = fs::weakly_canonical(resolved, ec).generic_string();
+        if (!visited.insert(id).second) {
+            // 2 回目以降（#pragma once / インクルードガード相当）は名前だけ
+            continue;
+        }
+
+        std::string content;
+        if (!ReadFileBytes(resolved, content)) {
+            hash.AddString("<unreadable>");
+            continue;
+        }
+
+        key.dependencies.push_back(resolved);
+        hash.AddString(content);
+        HashIncludes(content, resolved.parent_path(), includeDirs, hash, key, visited);
+    }
+}
+
+fs::path ShaderCache::MakeEntryPath(const Key &key) const {
+    return directory_ / (key.ToHex() + ".dxil");
+}
+
+std::optional<std::vector<uint8_t>> ShaderCache::Load(const Key &key) const {
+    if (!IsEnabled()) return std::nullopt;
+
+    const fs::path path = MakeEntryPath(key);
+    std::error_code ec;
+    const uintmax_t fileSize = fs::file_size(path, ec);
+    if (ec || fileSize < sizeof(EntryHeader)) return std::nullopt;
+
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return std::nullopt;
+
+    EntryHeader header{};
+    if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header))) return std::nullopt;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion || header.hash != key.hash || header.size == 0) {
+        return std::nullopt;
+    }
+    // 壊れたサイズで巨大な確保をしないよう、確保前にファイルの実サイズと突き合わせる
+    if (header.size > fileSize - sizeof(header)) return std::nullopt;
+
+    std::vector<uint8_t> data(static_cast<size_t>(header.size));
+    if (!ifs.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        return std::nullopt; // 途中で切れている（書き込み中のクラッシュなど）
+    }
+    return data;
+}
+
+bool ShaderCache::Store(const Key &key, const void *data, size_t size) {
+    if (!IsEnabled() || !data || size == 0) return false;
+
+    const fs::path path = MakeEntryPath(key);
+    // 同じキーを別スレッドが同時に書いても壊れないよう、一時ファイルに書いてから置き換える
+    const fs::path tmp = path.string() + ".tmp" +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+        std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+
+        EntryHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.hash = key.hash;
+        header.size = size;
+        ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        ofs.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        if (!ofs) {
+            ofs.close();
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    ++stores_;
+    return true;
+}
+
+bool ShaderCache::GetOrCompile(const KeyDesc &desc, const CompileFunc &compile, std::vector<uint8_t> &out) {
+    const Key key = ComputeKey(desc);
+
+    if (auto cached = Load(key)) {
+        ++hits_;
+        out = std::move(*cached);
+        return true;
+    }
+
+    ++misses_;
+    if (!compile || !compile(out) || out.empty()) {
+        return false;
+    }
+    Store(key, out.data(), out.size());
+    return true;
+}
+
+void ShaderCache::Clear() {
+    if (!IsEnabled()) return;
+    std::error_code ec;
+    for (const auto &e : fs::directory_iterator(directory_, ec)) {
+        if (e.path().extension() == ".dxil") {
+            fs::remove(e.path(), ec);
+        }
+    }
+}
+
+void ShaderCache::Prune(uint64_t maxBytes) {
+    if (!IsEnabled()) return;
+
+    struct FileInfo {
+        fs::path path;
+        fs::file_time_type time;
+        uint64_t size;
+    };
+    std::vector<FileInfo> files;
+    uint64_t total = 0;
+
+    std::error_code ec;
+    for (const auto &e : fs::directory_iterator(directory_, ec)) {
+        if (e.path().extension() != ".dxil") continue;
+        FileInfo info{e.path(), e.last_write_time(ec), e.file_size(ec)};
+        if (ec) continue;
+        total += info.size;
+        files.push_back(std::move(info));
+    }
+
+    std::sort(files.begin(), files.end(),
+        [](const FileInfo &a, const FileInfo &b) { return a.time < b.time; });
+
+    for (const auto &f : files) {
+        if (total <= maxBytes) break;
+        if (fs::remove(f.path, ec)) {
+            total -= f.size;
+        }
+    }
+}
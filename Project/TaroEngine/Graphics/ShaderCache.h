@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace HashUtil { struct Fnv1a64; }
+
+/// <summary>
+/// シェーダバイトコードのディスクキャッシュ（内容アドレス方式）。<br/>
+/// ソース本文・#include で解決されたファイルの内容・エントリ・プロファイル・マクロ・
+/// コンパイルフラグをまとめてハッシュし、そのハッシュをファイル名として DXIL を保存する。<br/>
+/// どれか 1 つでも変われば別のキーになるため、明示的な無効化は不要。
+/// </summary>
+/// <remarks>
+/// DXC には依存しない。コンパイラ本体はコールバックで受け取るので、スタブでも動作確認できる。<br/>
+/// Initialize 後は複数スレッドから同時に呼んでよい。
+/// </remarks>
+class ShaderCache {
+public:
+    /// <summary>
+    /// キャッシュファイル形式のバージョン。形式や鍵の組み立て方を変えたら上げる（全エントリが無効になる）。
+    /// </summary>
+    static constexpr uint32_t kFormatVersion = 1;
+
+    /// <summary>
+    /// キャッシュキーの材料。
+    /// </summary>
+    struct KeyDesc {
+        std::string source;                      // ソース本文（UTF-8）
+        std::filesystem::path sourcePath;        // ソースのパス（#include 解決の基準。メモリ上のソースなら仮想ファイル名）
+        std::wstring entry;                      // エントリポイント
+        std::wstring profile;                    // プロファイル
+        std::vector<std::wstring> defines;       // "-DNAME=VALUE" 形式のマクロ
+        std::vector<std::wstring> arguments;     // 最適化・デバッグ・-I など残りの引数
+        std::string toolchain;                   // コンパイラのバージョンなど
+    };
+
+    /// <summary>
+    /// 計算したキー。
+    /// </summary>
+    struct Key {
+        uint64_t hash = 0;                                  // 内容ハッシュ
+        std::vector<std::filesystem::path> dependencies;    // 解決できた #include ファイル
+        std::vector<std::string> missingIncludes;           // 解決できなかった #include 名
+
+        /// <summary>16 桁の 16 進文字列（キャッシュファイル名）。</summary>
+        std::string ToHex() const;
+    };
+
+    /// <summary>
+    /// 統計情報。
+    /// </summary>
+    struct Stats {
+        uint32_t hits = 0;      // キャッシュから読めた回数
+        uint32_t misses = 0;    // コンパイルした回数
+        uint32_t stores = 0;    // 書き込んだ回数
+    };
+
+    /// <summary>
+    /// キャッシュミス時に呼ばれるコンパイル関数。成功したら out に DXIL を入れて true を返す。
+    /// </summary>
+    using CompileFunc = std::function<bool(std::vector<uint8_t> &out)>;
+
+public:
+    /// <summary>
+    /// 初期化処理。保存先ディレクトリを作成する。
+    /// </summary>
+    /// <param name="directory">保存先（通常は Generated/ShaderCache）。</param>
+    /// <returns>ディレクトリを用意できたら true。</returns>
+    bool Initialize(const std::filesystem::path &directory);
+
+    /// <summary>
+    /// キーを計算する。#include を再帰的にたどり、見つかったファイルの内容も含める。
+    /// </summary>
+    /// <param name="desc">キーの材料。</param>
+    /// <returns>キーと依存ファイル一覧。</returns>
+    Key ComputeKey(const KeyDesc &desc) const;
+
+    /// <summary>
+    /// キャッシュからバイトコードを読む。
+    /// </summary>
+    /// <param name="key">キー。</param>
+    /// <returns>見つかればバイトコード。</returns>
+    std::optional<std::vector<uint8_t>> Load(const Key &key) const;
+
+    /// <summary>
+    /// バイトコードを保存する（一時ファイルに書いてから置き換える）。
+    /// </summary>
+    /// <param name="key">キー。</param>
+    /// <param name="data">バイトコード先頭。</param>
+    /// <param name="size">バイト数。</param>
+    /// <returns>保存できたら true。</returns>
+    bool Store(const Key &key, const void *data, size_t size);
+
+    /// <summary>
+    /// キャッシュを引き、なければ compile を呼んで結果を保存する。
+    /// </summary>
+    /// <param name="desc">キーの材料。</param>
+    /// <param name="compile">コンパイル関数。</param>
+    /// <param name="out">バイトコードの出力先。</param>
+    /// <returns>キャッシュヒットまたはコンパイル成功なら true。</returns>
+    bool GetOrCompile(const KeyDesc &desc, const CompileFunc &compile, std::vector<uint8_t> &out);
+
+    /// <summary>
+    /// 保存済みのキャッシュファイルをすべて削除する。
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 古いもの（最終書き込みが古い順）から削除して、合計サイズを上限以下にする。
+    /// </summary>
+    /// <param name="maxBytes">上限バイト数。</param>
+    void Prune(uint64_t maxBytes);
+
+    /// <summary>初期化済みか。</summary>
+    bool IsEnabled() const { return !directory_.empty(); }
+
+    /// <summary>保存先ディレクトリを取得する。</summary>
+    const std::filesystem::path &GetDirectory() const { return directory_; }
+
+    /// <summary>統計情報を取得する。</summary>
+    Stats GetStats() const { return {hits_.load(), misses_.load(), stores_.load()}; }
+
+private:
+    /// <summary>キーに対応するキャッシュファイルのパス。</summary>
+    std::filesystem::path MakeEntryPath(const Key &key) const;
+
+    /// <summary>
+    /// source 内の #include を解決し、その内容を再帰的にハッシュへ混ぜる。
+    /// </summary>
+    void HashIncludes(const std::string &source, const std::filesystem::path &currentDir,
+        const std::vector<std::filesystem::path> &includeDirs, HashUtil::Fnv1a64 &hash, Key &key,
+        std::unordered_set<std::string> &visited) const;
+
+private:
+    std::filesystem::path directory_;
+
+    // 統計（ワーカースレッドから同時に更新される）
+    std::atomic<uint32_t> hits_{0};
+    std::atomic<uint32_t> misses_{0};
+    std::atomic<uint32_t> stores_{0};
+};
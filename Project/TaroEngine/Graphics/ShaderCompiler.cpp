@@ -1,43 +1,88 @@
 #include "ShaderCompiler.h"
+#include "ShaderCache.h"
+#include "ShaderJobQueue.h"
 #include <cassert>
 
 using Microsoft::WRL::ComPtr;
 
-bool ShaderCompiler::Initialize() {
-    if (dxcUtils_ && dxcCompiler_ && includeHandler_)
-        return true;
+ShaderCompiler::ShaderCompiler() = default;
 
-    HRESULT hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxcUtils_));
+ShaderCompiler::~ShaderCompiler() {
+    // ワーカーが DxcContext を使い終えてから解放する
+    if (queue_) {
+        queue_->Stop();
+    }
+}
+
+bool ShaderCompiler::CreateContext(DxcContext &ctx) {
+    HRESULT hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&ctx.utils));
     if (FAILED(hr)) return false;
 
-    hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler_));
+    hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&ctx.compiler));
     if (FAILED(hr)) return false;
 
-    hr = dxcUtils_->CreateDefaultIncludeHandler(&includeHandler_);
+    hr = ctx.utils->CreateDefaultIncludeHandler(&ctx.includeHandler);
     if (FAILED(hr)) return false;
 
     return true;
 }
 
+bool ShaderCompiler::Initialize(uint32_t workerCount) {
+    if (mainContext_.IsValid())
+        return true;
+
+    if (!CreateContext(mainContext_)) return false;
+
+    // コンパイラが更新されたら別キーになるよう、バージョンを控えておく
+    ComPtr<IDxcVersionInfo> version;
+    if (SUCCEEDED(mainContext_.compiler.As(&version))) {
+        UINT32 major = 0, minor = 0;
+        if (SUCCEEDED(version->GetVersion(&major, &minor))) {
+            toolchain_ = "dxc " + std::to_string(major) + "." + std::to_string(minor);
+        }
+    }
+
+    // 並列コンパイル用ワーカー（コンテキストは起動前に用意しておく）
+    if (workerCount == 0) {
+        workerCount = ShaderJobQueue::DefaultWorkerCount();
+    }
+    workerContexts_.resize(workerCount);
+    for (auto &ctx : workerContexts_) {
+        if (!CreateContext(ctx)) return false;
+    }
+    queue_ = std::make_unique<ShaderJobQueue>();
+    queue_->Start(workerCount);
+
+    return true;
+}
+
 ShaderCompiler::Result ShaderCompiler::CompileFromFile(
+    const std::wstring &filePath, const std::wstring &entry,
+    const std::wstring &profile, const std::vector<Define> &defines,
+    const std::vector<std::wstring> &extraArgs) const {
+    return CompileFileWith(mainContext_, filePath, entry, profile, defines, extraArgs);
+}
+
+ShaderCompiler::Result ShaderCompiler::CompileFileWith(
+    const DxcContext &ctx,
     const std::wstring &filePath, const std::wstring &entry,
     const std::wstring &profile, const std::vector<Define> &defines,
     const std::vector<std::wstring> &extraArgs) const {
     Result out{};
 
-    if (!dxcUtils_ || !dxcCompiler_ || !includeHandler_) {
+    if (!ctx.IsValid()) {
         return out;
     }
 
     // ファイル読み込み → UTF-8 へ正規化
     ComPtr<IDxcBlobEncoding> sourceRaw;
-    HRESULT hr = dxcUtils_->LoadFile(filePath.c_str(), nullptr, &sourceRaw);
+    HRESULT hr = ctx.utils->LoadFile(filePath.c_str(), nullptr, &sourceRaw);
     if (FAILED(hr) || !sourceRaw) {
         return out;
     }
 
     ComPtr<IDxcBlobUtf8> sourceUtf8;
-    hr = dxcUtils_->GetBlobAsUtf8(sourceRaw.Get(), &sourceUtf8);
+    hr = ctx.utils->GetBlobAsUtf8(sourceRaw.Get(), &sourceUtf8);
     if (FAILED(hr) || !sourceUtf8) {
         return out;
     }
@@ -60,24 +105,33 @@ ShaderCompiler::Result ShaderCompiler::CompileFromFile(
         // パス解析に失敗しても致命ではないので黙殺
     }
 
-    auto args = BuildArguments(filePath, entry, profile, defines, extraWithDir);
-    return DoCompile(buffer, args);
+    const Arguments args = BuildArguments(filePath, entry, profile, defines, extraWithDir);
+    return CompileCached(ctx, buffer, args, std::filesystem::path(filePath), entry, profile);
 }
 
 ShaderCompiler::Result ShaderCompiler::CompileFromSource(
+    const std::wstring &virtualFileName, const std::string &sourceUtf8,
+    const std::wstring &entry, const std::wstring &profile,
+    const std::vector<Define> &defines,
+    const std::vector<std::wstring> &extraArgs) const {
+    return CompileSourceWith(mainContext_, virtualFileName, sourceUtf8, entry, profile, defines, extraArgs);
+}
+
+ShaderCompiler::Result ShaderCompiler::CompileSourceWith(
+    const DxcContext &ctx,
     const std::wstring &virtualFileName, const std::string &sourceUtf8,
     const std::wstring &entry, const std::wstring &profile,
     const std::vector<Define> &defines,
     const std::vector<std::wstring> &extraArgs) const {
     Result out{};
 
-    if (!dxcUtils_ || !dxcCompiler_ || !includeHandler_) {
+    if (!ctx.IsValid()) {
         return out;
     }
 
     // UTF-8 バッファを Blob に変換
     ComPtr<IDxcBlobEncoding> source;
-    HRESULT hr = dxcUtils_->CreateBlob(sourceUtf8.data(),
+    HRESULT hr = ctx.utils->CreateBlob(sourceUtf8.data(),
         static_cast<UINT32>(sourceUtf8.size()),
         DXC_CP_UTF8, &source);
     if (FAILED(hr) || !source) {
@@ -89,83 +143,146 @@ ShaderCompiler::Result ShaderCompiler::CompileFromSource(
     buffer.Size = source->GetBufferSize();
     buffer.Encoding = DXC_CP_UTF8;
 
-    auto args = BuildArguments(virtualFileName, entry, profile, defines, extraArgs);
-    return DoCompile(buffer, args);
+    const Arguments args = BuildArguments(virtualFileName, entry, profile, defines, extraArgs);
+    // DXC と同じく仮想ファイル名の場所を #include の基準にする（空にすると依存を追えず古い DXIL を返し続ける）
+    return CompileCached(ctx, buffer, args, std::filesystem::path(virtualFileName), entry, profile);
+}
+
+ShaderCompiler::Result ShaderCompiler::CompileRequestWith(
+    const DxcContext &ctx, const CompileRequest &r) const {
+    if (!r.sourceUtf8.empty()) {
+        return CompileSourceWith(ctx, r.filePath, r.sourceUtf8, r.entry, r.profile, r.defines, r.extraArgs);
+    }
+    return CompileFileWith(ctx, r.filePath, r.entry, r.profile, r.defines, r.extraArgs);
 }
 
-std::vector<LPCWSTR> ShaderCompiler::BuildArguments(
+std::vector<ShaderCompiler::Result> ShaderCompiler::CompileBatch(
+    const std::vector<CompileRequest> &requests) const {
+    std::vector<Result> results(requests.size());
+    if (requests.empty()) return results;
+
+    // ワーカーがなければ呼び出し元スレッドで順に処理
+    if (!queue_) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            results[i] = CompileRequestWith(mainContext_, requests[i]);
+        }
+        return results;
+    }
+
+    // 各ジョブは自分の results[i] にだけ書くので、結果側のロックは不要
+    std::vector<std::future<void>> pending;
+    pending.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto task = std::make_shared<std::packaged_task<void(uint32_t)>>(
+            [this, &requests, &results, i](uint32_t worker) {
+                results[i] = CompileRequestWith(workerContexts_[worker], requests[i]);
+            });
+        pending.push_back(task->get_future());
+        queue_->Submit([task](uint32_t worker) { (*task)(worker); });
+    }
+
+    for (auto &f : pending) {
+        f.get();
+    }
+    return results;
+}
+
+std::future<ShaderCompiler::Result> ShaderCompiler::CompileAsync(
+    CompileRequest request, CompleteCallback onComplete) const {
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+
+    if (!queue_) {
+        Result r = CompileRequestWith(mainContext_, request);
+        if (onComplete) onComplete(r);
+        promise->set_value(std::move(r));
+        return future;
+    }
+
+    queue_->Submit([this, promise, request = std::move(request),
+        onComplete = std::move(onComplete)](uint32_t worker) {
+        Result r = CompileRequestWith(workerContexts_[worker], request);
+        if (onComplete) onComplete(r);
+        promise->set_value(std::move(r));
+    });
+    return future;
+}
+
+uint32_t ShaderCompiler::GetWorkerCount() const {
+    return queue_ ? queue_->GetWorkerCount() : 0;
+}
+
+ShaderCompiler::Arguments ShaderCompiler::BuildArguments(
     const std::wstring &inputName, const std::wstring &entry,
     const std::wstring &profile, const std::vector<Define> &defines,
     const std::vector<std::wstring> &extraArgs) const {
-    // DXC に渡す引数配列
-    std::vector<LPCWSTR> args;
+    Arguments args;
+
+    // 先に文字列をすべて積み、最後にポインタ配列を作る（再確保で c_str() が無効にならないように）
+    auto &s = args.storage;
+    s.reserve(8 + defines.size() + extraArgs.size());
 
     // 入力ファイル名（仮想名でもOK）
-    args.push_back(inputName.c_str());
+    s.push_back(inputName);
 
     // -E Entry
-    args.push_back(L"-E");
-    args.push_back(entry.c_str());
+    s.push_back(L"-E");
+    s.push_back(entry);
 
     // -T Profile
-    args.push_back(L"-T");
-    args.push_back(profile.c_str());
+    s.push_back(L"-T");
+    s.push_back(profile);
 
     // デバッグ/最適化フラグ
     if (enableDebug_) {
-        args.push_back(L"-Zi");
-        args.push_back(L"-Qembed_debug");
+        s.push_back(L"-Zi");
+        s.push_back(L"-Qembed_debug");
     }
 
     switch (optLevel_) {
     default:
-    case 0: args.push_back(L"-Od"); break;
-    case 1: args.push_back(L"-O1"); break;
-    case 2: args.push_back(L"-O2"); break;
-    case 3: args.push_back(L"-O3"); break;
+    case 0: s.push_back(L"-Od"); break;
+    case 1: s.push_back(L"-O1"); break;
+    case 2: s.push_back(L"-O2"); break;
+    case 3: s.push_back(L"-O3"); break;
     }
 
     // 行優先レイアウト（packoffset の直感性向上）
-    args.push_back(L"-Zpr");
+    s.push_back(L"-Zpr");
 
     // Defines
-    static thread_local std::vector<std::wstring> defineStorage;
-    defineStorage.clear();
-    defineStorage.reserve(defines.size());
-
     for (const auto &d : defines) {
         if (d.value.empty()) {
-            defineStorage.push_back(L"-D" + d.name);
+            s.push_back(L"-D" + d.name);
         } else {
-            defineStorage.push_back(L"-D" + d.name + L"=" + d.value);
+            s.push_back(L"-D" + d.name + L"=" + d.value);
         }
-        args.push_back(defineStorage.back().c_str());
     }
 
     // 追加引数（-I など）
-    static thread_local std::vector<std::wstring> extraStorage;
-    extraStorage.clear();
-    extraStorage.reserve(extraArgs.size());
-
     for (const auto &a : extraArgs) {
-        extraStorage.push_back(a);
-        args.push_back(extraStorage.back().c_str());
+        s.push_back(a);
     }
 
+    args.pointers.reserve(s.size());
+    for (const auto &str : s) {
+        args.pointers.push_back(str.c_str());
+    }
     return args;
 }
 
 ShaderCompiler::Result ShaderCompiler::DoCompile(
-    const DxcBuffer &buffer, std::vector<LPCWSTR> &args) const {
+    const DxcContext &ctx, const DxcBuffer &buffer, const Arguments &args) const {
     Result out{};
 
-    if (!dxcCompiler_)
+    if (!ctx.compiler)
         return out;
 
     ComPtr<IDxcResult> result;
-    HRESULT hr = dxcCompiler_->Compile(
-        &buffer, args.data(), static_cast<UINT32>(args.size()),
-        includeHandler_.Get(), IID_PPV_ARGS(&result));
+    HRESULT hr = ctx.compiler->Compile(
+        &buffer, const_cast<LPCWSTR *>(args.pointers.data()),
+        static_cast<UINT32>(args.pointers.size()),
+        ctx.includeHandler.Get(), IID_PPV_ARGS(&result));
 
     if (FAILED(hr) || !result) {
         return out;
@@ -207,3 +324,59 @@ ShaderCompiler::Result ShaderCompiler::DoCompile(
     out.succeeded = (SUCCEEDED(status) && out.object != nullptr);
     return out;
 }
+
+ShaderCompiler::Result ShaderCompiler::CompileCached(
+    const DxcContext &ctx, const DxcBuffer &buffer, const Arguments &args,
+    const std::filesystem::path &sourcePath,
+    const std::wstring &entry, const std::wstring &profile) const {
+    if (!cache_ || !cache_->IsEnabled()) {
+        return DoCompile(ctx, buffer, args);
+    }
+
+    // キーの材料：ソース本文＋入力名を除いた全引数（-E/-T/-D/-O/-Zi/-I など）
+    ShaderCache::KeyDesc desc;
+    desc.source.assign(static_cast<const char *>(buffer.Ptr), buffer.Size);
+    desc.sourcePath = sourcePath;
+    desc.entry = entry;
+    desc.profile = profile;
+    desc.toolchain = toolchain_;
+    for (size_t i = 1; i < args.storage.size(); ++i) {
+        const std::wstring &a = args.storage[i];
+        if (a.compare(0, 2, L"-D") == 0) {
+            desc.defines.push_back(a);
+        } else {
+            desc.arguments.push_back(a);
+        }
+    }
+
+    // ヒットしなかったときだけ DXC を呼ぶ
+    Result compiled{};
+    bool compiledNow = false;
+    auto compile = [&](std::vector<uint8_t> &out) {
+        compiled = DoCompile(ctx, buffer, args);
+        compiledNow = true;
+        if (!compiled.succeeded) return false;
+        const auto *p = static_cast<const uint8_t *>(compiled.object->GetBufferPointer());
+        out.assign(p, p + compiled.object->GetBufferSize());
+        return true;
+    };
+
+    std::vector<uint8_t> bytecode;
+    const bool ok = cache_->GetOrCompile(desc, compile, bytecode);
+    if (!ok || compiledNow) {
+        return compiled; // 今回コンパイルした結果（失敗時の errors / pdb を含む）
+    }
+
+    // キャッシュヒット：バイトコードを Blob に包んで返す
+    Result out{};
+    ComPtr<IDxcBlobEncoding> blob;
+    HRESULT hr = ctx.utils->CreateBlob(bytecode.data(),
+        static_cast<UINT32>(bytecode.size()), DXC_CP_ACP, &blob);
+    if (FAILED(hr) || !blob) {
+        return DoCompile(ctx, buffer, args);
+    }
+    out.object = blob;
+    out.succeeded = true;
+    out.fromCache = true;
+    return out;
+}
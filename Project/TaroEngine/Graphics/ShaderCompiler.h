@@ -2,13 +2,22 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
 #include <wrl.h>
 #include <dxcapi.h>
 
+class ShaderCache;
+class ShaderJobQueue;
+
 /// <summary>
 /// HLSL シェーダのコンパイルを行うユーティリティクラス。<br/>
 /// DXC（IDxcCompiler3）を用いたファイル/文字列入力のコンパイル、
-/// マクロ定義や最適化レベル、デバッグ情報の制御を提供する。
+/// マクロ定義や最適化レベル、デバッグ情報の制御を提供する。<br/>
+/// SetCache でキャッシュを渡すと、同じ入力のコンパイル結果をディスクから再利用する。<br/>
+/// CompileBatch / CompileAsync はワーカースレッドで並列にコンパイルする
+/// （DXC インスタンスはワーカーごとに持つ）。
 /// </summary>
 class ShaderCompiler {
 public:
@@ -29,20 +38,44 @@ public:
 		std::wstring pdbName;    ///< DXC_OUT_PDB のファイル名（埋め込み名）
 		Microsoft::WRL::ComPtr<IDxcBlobUtf8> errors;     ///< DXC_OUT_ERRORS  (UTF-8)
 		bool succeeded = false; ///< Compile 成否（GetStatus + object 取得で判定）
+		bool fromCache = false; ///< キャッシュから読み込んだ場合 true（pdb / errors は空）
+	};
+
+	/// <summary>
+	/// コンパイル要求（CompileBatch / CompileAsync 用）。<br/>
+	/// sourceUtf8 が空ならファイルから、空でなければ filePath を仮想ファイル名としてソース文字列からコンパイルする。
+	/// </summary>
+	struct CompileRequest {
+		std::wstring filePath;                 ///< HLSL ファイルパス（仮想ファイル名）
+		std::string sourceUtf8;                ///< UTF-8 ソース文字列（任意）
+		std::wstring entry = L"main";          ///< エントリポイント
+		std::wstring profile;                  ///< シェーダプロファイル
+		std::vector<Define> defines;           ///< 事前定義マクロ
+		std::vector<std::wstring> extraArgs;   ///< 追加引数
 	};
 
+	/// <summary>
+	/// 非同期コンパイル完了時に呼ばれるコールバック（ワーカースレッド上で呼ばれる）。
+	/// </summary>
+	using CompleteCallback = std::function<void(const Result &)>;
+
 public:
-	ShaderCompiler() = default;
-	~ShaderCompiler() = default;
+	ShaderCompiler();
+	~ShaderCompiler();
+
+	ShaderCompiler(const ShaderCompiler &) = delete;
+	ShaderCompiler &operator=(const ShaderCompiler &) = delete;
 
 	/// <summary>
-	/// DXC ユーティリティ/コンパイラ/インクルードハンドラを初期化する。
+	/// DXC ユーティリティ/コンパイラ/インクルードハンドラを初期化し、ワーカーを起動する。
 	/// </summary>
+	/// <param name="workerCount">並列コンパイル用ワーカー数（0 なら論理コア数 - 1）。</param>
 	/// <returns>初期化に成功したら true。</returns>
-	bool Initialize();
+	bool Initialize(uint32_t workerCount = 0);
 
 	/// <summary>
-	/// デバッグ情報埋め込みの有効/無効を切り替える（既定:true）。
+	/// デバッグ情報埋め込みの有効/無効を切り替える（既定:true）。<br/>
+	/// ※オプション類はコンパイル中（バッチ実行中）に変更しないこと。
 	/// </summary>
 	void SetEnableDebug(bool enable) noexcept { enableDebug_ = enable; }
 
@@ -51,6 +84,11 @@ public:
 	/// </summary>
 	void SetOptimizationLevel(int level) noexcept { optLevel_ = level; }
 
+	/// <summary>
+	/// バイトコードのディスクキャッシュを設定する（nullptr で無効）。所有権は持たない。
+	/// </summary>
+	void SetCache(ShaderCache *cache) noexcept { cache_ = cache; }
+
 	/// <summary>
 	/// HLSL ファイルからコンパイルする。
 	/// </summary>
@@ -70,7 +108,7 @@ public:
 	/// <summary>
 	/// メモリ上の UTF-8 ソース文字列からコンパイルする。
 	/// </summary>
-	/// <param name="virtualFileName">仮想ファイル名（エラーログ表示用）</param>
+	/// <param name="virtualFileName">仮想ファイル名（エラーログ表示用。相対 #include の基準にもなる）</param>
 	/// <param name="sourceUtf8">UTF-8 ソース文字列</param>
 	/// <param name="entry">エントリポイント</param>
 	/// <param name="profile">シェーダプロファイル</param>
@@ -85,12 +123,81 @@ public:
 		const std::vector<Define> &defines = {},
 		const std::vector<std::wstring> &extraArgs = {}) const;
 
+	/// <summary>
+	/// 複数の要求をワーカーで並列にコンパイルし、すべて終わるまで待つ。
+	/// </summary>
+	/// <param name="requests">コンパイル要求</param>
+	/// <returns>requests と同じ順の結果</returns>
+	std::vector<Result> CompileBatch(const std::vector<CompileRequest> &requests) const;
+
+	/// <summary>
+	/// 1 件をワーカーでコンパイルする。
+	/// </summary>
+	/// <param name="request">コンパイル要求</param>
+	/// <param name="onComplete">完了時コールバック（任意。ワーカースレッドで呼ばれる）</param>
+	/// <returns>結果を受け取る future</returns>
+	std::future<Result> CompileAsync(CompileRequest request, CompleteCallback onComplete = {}) const;
+
+	/// <summary>並列コンパイル用のワーカー数を取得する。</summary>
+	uint32_t GetWorkerCount() const;
+
 private:
 	/// <summary>
-	/// DXC に渡す引数配列（LPCWSTR の配列）を組み立てる。
-	/// ※内部で thread_local な wstring バッファに文字を保持し、.c_str() の寿命を担保する。
+	/// DXC のインスタンス一式。IDxcCompiler3 はスレッド間で共有せず、スレッドごとに持つ。
 	/// </summary>
-	std::vector<LPCWSTR> BuildArguments(
+	struct DxcContext {
+		Microsoft::WRL::ComPtr<IDxcUtils>          utils;
+		Microsoft::WRL::ComPtr<IDxcCompiler3>      compiler;
+		Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler;
+
+		bool IsValid() const { return utils && compiler && includeHandler; }
+	};
+
+	/// <summary>
+	/// DXC に渡す引数。文字列の実体とポインタ配列を 1 ジョブ分まとめて持つ。
+	/// </summary>
+	struct Arguments {
+		std::vector<std::wstring> storage; // 文字列の実体（pointers はここを指す）
+		std::vector<LPCWSTR> pointers;     // IDxcCompiler3::Compile に渡す配列
+	};
+
+	/// <summary>
+	/// DxcContext を生成する。
+	/// </summary>
+	static bool CreateContext(DxcContext &ctx);
+
+	/// <summary>
+	/// 指定コンテキストでファイルをコンパイルする。
+	/// </summary>
+	Result CompileFileWith(
+		const DxcContext &ctx,
+		const std::wstring &filePath,
+		const std::wstring &entry,
+		const std::wstring &profile,
+		const std::vector<Define> &defines,
+		const std::vector<std::wstring> &extraArgs) const;
+
+	/// <summary>
+	/// 指定コンテキストでソース文字列をコンパイルする。
+	/// </summary>
+	Result CompileSourceWith(
+		const DxcContext &ctx,
+		const std::wstring &virtualFileName,
+		const std::string &sourceUtf8,
+		const std::wstring &entry,
+		const std::wstring &profile,
+		const std::vector<Define> &defines,
+		const std::vector<std::wstring> &extraArgs) const;
+
+	/// <summary>
+	/// 指定コンテキストで要求 1 件を処理する（ファイル／ソースの振り分け）。
+	/// </summary>
+	Result CompileRequestWith(const DxcContext &ctx, const CompileRequest &request) const;
+
+	/// <summary>
+	/// DXC に渡す引数を組み立てる。文字列は戻り値が所有するので、ジョブ間で干渉しない。
+	/// </summary>
+	Arguments BuildArguments(
 		const std::wstring &inputName,
 		const std::wstring &entry,
 		const std::wstring &profile,
@@ -100,15 +207,37 @@ private:
 	/// <summary>
 	/// 実際に IDxcCompiler3::Compile を叩き、Result を構築する。
 	/// </summary>
-	Result DoCompile(const DxcBuffer &buffer, std::vector<LPCWSTR> &args) const;
+	Result DoCompile(const DxcContext &ctx, const DxcBuffer &buffer, const Arguments &args) const;
+
+	/// <summary>
+	/// キャッシュを引き、なければ DoCompile して結果を保存する。
+	/// </summary>
+	/// <param name="buffer">ソースバッファ</param>
+	/// <param name="args">BuildArguments の結果</param>
+	/// <param name="sourcePath">ソースのパス（#include 解決用。仮想ソースなら空）</param>
+	/// <param name="entry">エントリポイント</param>
+	/// <param name="profile">シェーダプロファイル</param>
+	Result CompileCached(
+		const DxcContext &ctx,
+		const DxcBuffer &buffer,
+		const Arguments &args,
+		const std::filesystem::path &sourcePath,
+		const std::wstring &entry,
+		const std::wstring &profile) const;
 
 private:
-	// DXC core
-	Microsoft::WRL::ComPtr<IDxcUtils>      dxcUtils_;
-	Microsoft::WRL::ComPtr<IDxcCompiler3>  dxcCompiler_;
-	Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler_;
+	// DXC core（呼び出し元スレッド用）
+	DxcContext mainContext_;
+
+	// 並列コンパイル（workerContexts_[i] はワーカー i 専用）
+	std::vector<DxcContext> workerContexts_;
+	std::unique_ptr<ShaderJobQueue> queue_;
 
 	// options
 	bool enableDebug_ = true;
 	int  optLevel_ = 0;   // 0..3
+
+	// cache
+	ShaderCache *cache_ = nullptr; // 借用（nullptr なら毎回コンパイル）
+	std::string  toolchain_;       // DXC のバージョン（キャッシュキーに含める）
 };
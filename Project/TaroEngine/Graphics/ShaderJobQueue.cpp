@@ -0,0 +1,77 @@
+#include "ShaderJobQueue.h"
+#include <algorithm>
+#include <cassert>
+
+ShaderJobQueue::~ShaderJobQueue() {
+    Stop();
+}
+
+void ShaderJobQueue::Start(uint32_t workerCount) {
+    assert(workerCount > 0);
+    assert(workers_.empty() && "already started");
+
+    stopping_ = false;
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&ShaderJobQueue::WorkerMain, this, i);
+    }
+}
+
+void ShaderJobQueue::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    jobCv_.notify_all();
+
+    for (auto &t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+}
+
+void ShaderJobQueue::Submit(Job job) {
+    assert(!workers_.empty() && "not started");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    jobCv_.notify_one();
+}
+
+void ShaderJobQueue::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this] { return jobs_.empty() && running_ == 0; });
+}
+
+uint32_t ShaderJobQueue::DefaultWorkerCount() {
+    const uint32_t hw = std::thread::hardware_concurrency();
+    // メインスレッドの分を 1 つ空ける
+    return std::max(1u, hw > 1 ? hw - 1 : 1u);
+}
+
+void ShaderJobQueue::WorkerMain(uint32_t workerIndex) {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            // 停止要求が来ても、積まれたジョブは処理し切る
+            if (jobs_.empty()) return;
+
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            ++running_;
+        }
+
+        job(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --running_;
+            if (jobs_.empty() && running_ == 0) {
+                idleCv_.notify_all();
+            }
+        }
+    }
+}
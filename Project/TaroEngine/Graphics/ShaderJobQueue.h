@@ -0,0 +1,71 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// シェーダコンパイル用のワーカースレッドプール。<br/>
+/// ジョブには実行中のワーカー番号が渡されるので、ワーカーごとのコンテキスト
+/// （DXC インスタンスなど）をロックなしで使い分けられる。<br/>
+/// コンパイラ本体には依存しないため、遅延を模したダミーのジョブでも動かせる。
+/// </summary>
+class ShaderJobQueue {
+public:
+    /// <summary>
+    /// ジョブ。引数は実行しているワーカー番号（0 ～ GetWorkerCount()-1）。
+    /// </summary>
+    using Job = std::function<void(uint32_t workerIndex)>;
+
+public:
+    ShaderJobQueue() = default;
+    ~ShaderJobQueue();
+
+    ShaderJobQueue(const ShaderJobQueue &) = delete;
+    ShaderJobQueue &operator=(const ShaderJobQueue &) = delete;
+
+    /// <summary>
+    /// ワーカーを起動する。
+    /// </summary>
+    /// <param name="workerCount">ワーカー数（1 以上）。</param>
+    void Start(uint32_t workerCount);
+
+    /// <summary>
+    /// 残っているジョブを処理し終えてからワーカーを停止する。
+    /// </summary>
+    void Stop();
+
+    /// <summary>
+    /// ジョブを追加する（FIFO）。
+    /// </summary>
+    void Submit(Job job);
+
+    /// <summary>
+    /// 追加済みのジョブがすべて終わるまで待つ。
+    /// </summary>
+    void WaitIdle();
+
+    /// <summary>ワーカー数を取得する。</summary>
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    /// <summary>
+    /// 既定のワーカー数（論理コア数 - 1、最低 1）を返す。
+    /// </summary>
+    static uint32_t DefaultWorkerCount();
+
+private:
+    /// <summary>ワーカースレッドの本体。</summary>
+    void WorkerMain(uint32_t workerIndex);
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<Job> jobs_;
+    std::mutex mutex_;
+    std::condition_variable jobCv_;  // ジョブ追加／停止の通知
+    std::condition_variable idleCv_; // 全ジョブ完了の通知
+    uint32_t running_ = 0;           // 実行中のジョブ数
+    bool stopping_ = false;
+};
@@ -0,0 +1,68 @@
+#include "ShaderPermutation.h"
+#include <windows.h>
+
+void ShaderPermutation::Initialize(
+    std::wstring virtualName, std::string sourceUtf8,
+    std::wstring entry, std::wstring profile,
+    std::vector<Feature> features, ValidateFunc validate,
+    std::vector<ShaderCompiler::Define> baseDefines) {
+    virtualName_ = std::move(virtualName);
+    source_ = std::move(sourceUtf8);
+    entry_ = std::move(entry);
+    profile_ = std::move(profile);
+
+    std::vector<ShaderVariantTable::Define> base;
+    base.reserve(baseDefines.size());
+    for (auto &d : baseDefines) {
+        base.push_back({std::move(d.name), std::move(d.value)});
+    }
+    table_.Initialize(source_, std::move(features), std::move(validate), std::move(base));
+    variants_.clear();
+}
+
+std::vector<ShaderCompiler::Define> ShaderPermutation::MakeDefines(uint32_t mask) const {
+    const std::vector<ShaderVariantTable::Define> defines = table_.MakeDefines(mask);
+    std::vector<ShaderCompiler::Define> out;
+    out.reserve(defines.size());
+    for (const auto &d : defines) {
+        out.push_back({d.name, d.value});
+    }
+    return out;
+}
+
+bool ShaderPermutation::CompileAll(const ShaderCompiler &compiler) {
+    const std::vector<uint32_t> masks = Enumerate();
+
+    // 代表マスクごとにコンパイル要求を作り、まとめて並列コンパイル
+    std::vector<ShaderCompiler::CompileRequest> requests(masks.size());
+    for (size_t i = 0; i < masks.size(); ++i) {
+        auto &r = requests[i];
+        r.filePath = virtualName_;
+        r.sourceUtf8 = source_;
+        r.entry = entry_;
+        r.profile = profile_;
+        r.defines = MakeDefines(masks[i]);
+    }
+    const auto results = compiler.CompileBatch(requests);
+
+    std::vector<ShaderVariantTable::Bytecode> bytecodes(masks.size());
+    bool allSucceeded = true;
+    for (size_t i = 0; i < masks.size(); ++i) {
+        const auto &res = results[i];
+        if (!res.succeeded) {
+            if (res.errors) {
+                OutputDebugStringA(res.errors->GetStringPointer());
+            }
+            allSucceeded = false;
+            continue;
+        }
+        bytecodes[i] = {res.object->GetBufferPointer(), res.object->GetBufferSize()};
+    }
+
+    // 埋め込みデバッグ情報を除いた中身で重複排除し、代表のバイトコードだけを残す
+    variants_.clear();
+    for (size_t index : table_.Build(masks, bytecodes)) {
+        variants_.push_back(results[index].object);
+    }
+    return allSucceeded;
+}
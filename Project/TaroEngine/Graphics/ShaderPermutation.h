@@ -0,0 +1,108 @@
+#pragma once
+#include "ShaderCompiler.h"
+#include "ShaderVariantTable.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 1 つのシェーダの全バリアントを機能ビットで管理するクラス。<br/>
+/// 機能ごとにマクロ（ShaderCompiler::Define）を対応付け、取り得る組み合わせを列挙・重複排除して
+/// まとめてコンパイルし、描画時はビットマスクから配列添字 1 回でバイトコードを引ける。
+/// </summary>
+/// <remarks>
+/// 重複排除は 2 段階：<br/>
+/// 1. ソース中に名前が現れないマクロのビットは無視する（同じソースになるため）。<br/>
+/// 2. コンパイル後、デバッグ情報などを除いたバイトコードが一致したバリアントは 1 つにまとめる。<br/>
+/// マクロを #include 先でしか参照しない機能は Feature::alwaysRelevant を立てること。<br/>
+/// マスク・マクロ・重複排除の処理は ShaderVariantTable（DXC 非依存）にある。
+/// </remarks>
+class ShaderPermutation {
+public:
+    static constexpr uint32_t kMaxFeatures = ShaderVariantTable::kMaxFeatures;
+    static constexpr uint32_t kInvalidVariant = ShaderVariantTable::kInvalidVariant;
+    using Feature = ShaderVariantTable::Feature;
+    using ValidateFunc = ShaderVariantTable::ValidateFunc;
+
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="virtualName">仮想ファイル名（エラー表示・キャッシュ用）。</param>
+    /// <param name="sourceUtf8">UTF-8 ソース文字列。</param>
+    /// <param name="entry">エントリポイント。</param>
+    /// <param name="profile">シェーダプロファイル。</param>
+    /// <param name="features">機能一覧（kMaxFeatures 個まで）。</param>
+    /// <param name="validate">組み合わせの有効判定（省略時はすべて有効）。</param>
+    /// <param name="baseDefines">全バリアント共通のマクロ。</param>
+    void Initialize(
+        std::wstring virtualName,
+        std::string sourceUtf8,
+        std::wstring entry,
+        std::wstring profile,
+        std::vector<Feature> features,
+        ValidateFunc validate = {},
+        std::vector<ShaderCompiler::Define> baseDefines = {});
+
+    /// <summary>
+    /// コンパイル対象となるマスク（重複排除済み・昇順）を列挙する。
+    /// </summary>
+    std::vector<uint32_t> Enumerate() const { return table_.Enumerate(); }
+
+    /// <summary>
+    /// マスクを代表マスクへ正規化する（結果に影響しないビットを落とす）。
+    /// </summary>
+    uint32_t Canonicalize(uint32_t mask) const { return table_.Canonicalize(mask); }
+
+    /// <summary>
+    /// マスクに対応するマクロ一覧を作る（baseDefines + 各機能の 0/値）。
+    /// </summary>
+    std::vector<ShaderCompiler::Define> MakeDefines(uint32_t mask) const;
+
+    /// <summary>
+    /// 全バリアントをコンパイルし、ルックアップ表を構築する。
+    /// </summary>
+    /// <param name="compiler">ShaderCompiler（CompileBatch で並列に処理する）。</param>
+    /// <returns>すべて成功したら true。</returns>
+    bool CompileAll(const ShaderCompiler &compiler);
+
+    /// <summary>
+    /// マスクからバリアント番号を引く（文字列処理なし・表引き 1 回）。
+    /// </summary>
+    /// <returns>バリアント番号。無効な組み合わせなら kInvalidVariant。</returns>
+    uint32_t GetVariantIndex(uint32_t mask) const { return table_.GetVariantIndex(mask); }
+
+    /// <summary>
+    /// マスクからバイトコードを引く。
+    /// </summary>
+    /// <returns>バイトコード。無効な組み合わせなら nullptr。</returns>
+    IDxcBlob *GetBytecode(uint32_t mask) const {
+        const uint32_t index = GetVariantIndex(mask);
+        return (index == kInvalidVariant) ? nullptr : variants_[index].Get();
+    }
+
+    /// <summary>
+    /// バリアント番号からバイトコードを取得する（PSO 配列を並べて作るとき用）。
+    /// </summary>
+    IDxcBlob *GetVariantBytecode(uint32_t variantIndex) const { return variants_[variantIndex].Get(); }
+
+    /// <summary>重複排除後のバリアント数を取得する。</summary>
+    uint32_t GetVariantCount() const { return static_cast<uint32_t>(variants_.size()); }
+
+    /// <summary>機能数を取得する。</summary>
+    uint32_t GetFeatureCount() const { return table_.GetFeatureCount(); }
+
+    /// <summary>
+    /// マスク → バリアント番号の表を取得する（バイトコードを手放した後も引けるよう、コピーして持てる）。
+    /// </summary>
+    const ShaderVariantTable &GetTable() const { return table_; }
+
+private:
+    std::wstring virtualName_;
+    std::string source_;
+    std::wstring entry_;
+    std::wstring profile_;
+
+    ShaderVariantTable table_; // マスク → バリアント番号
+    std::vector<Microsoft::WRL::ComPtr<IDxcBlob>> variants_;
+};
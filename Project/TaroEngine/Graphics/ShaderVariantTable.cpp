@@ -0,0 +1,174 @@
+#include "ShaderVariantTable.h"
+#include "HashUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+namespace {
+
+    constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+            (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+    }
+
+    // DXIL コンテナ：FourCC + ダイジェスト 16 バイト + バージョン 2x2 + 全体サイズ + パート数、続いてパートのオフセット表
+    constexpr uint32_t kContainerFourCC = MakeFourCC('D', 'X', 'B', 'C');
+    constexpr size_t kContainerHeaderSize = 32;
+    constexpr size_t kPartCountOffset = 28;
+    constexpr size_t kPartHeaderSize = 8; // FourCC + サイズ
+
+    // コードに関係しないパート（デバッグ用 DXIL・PDB 名・シェーダハッシュ・ソース情報）
+    constexpr uint32_t kIgnoredParts[] = {
+        MakeFourCC('I', 'L', 'D', 'B'),
+        MakeFourCC('I', 'L', 'D', 'N'),
+        MakeFourCC('H', 'A', 'S', 'H'),
+        MakeFourCC('S', 'R', 'C', 'I'),
+        MakeFourCC('P', 'D', 'B', 'I'),
+    };
+
+    uint32_t ReadU32(const uint8_t *p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+            (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    // ソース中に識別子として name が現れるか（前後が識別子文字でないこと）
+    bool ContainsIdentifier(const std::string &source, const std::wstring &name) {
+        // マクロ名は ASCII 前提
+        std::string ascii;
+        ascii.reserve(name.size());
+        for (wchar_t c : name) ascii.push_back(static_cast<char>(c));
+        if (ascii.empty()) return false;
+
+        auto isIdent = [](char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        };
+
+        size_t pos = 0;
+        while ((pos = source.find(ascii, pos)) != std::string::npos) {
+            const bool startOk = (pos == 0) || !isIdent(source[pos - 1]);
+            const size_t end = pos + ascii.size();
+            const bool endOk = (end >= source.size()) || !isIdent(source[end]);
+            if (startOk && endOk) return true;
+            pos = end;
+        }
+        return false;
+    }
+
+} // namespace
+
+void ShaderVariantTable::Initialize(
+    const std::string &sourceUtf8, std::vector<Feature> features,
+    ValidateFunc validate, std::vector<Define> baseDefines) {
+    assert(features.size() <= kMaxFeatures);
+
+    features_ = std::move(features);
+    validate_ = std::move(validate);
+    baseDefines_ = std::move(baseDefines);
+
+    const uint32_t count = static_cast<uint32_t>(features_.size());
+    allMask_ = (count == 0) ? 0u : ((1u << count) - 1u);
+
+    // ソースが参照しないマクロのビットは結果を変えないので落とす
+    relevantMask_ = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (features_[i].alwaysRelevant || ContainsIdentifier(sourceUtf8, features_[i].define)) {
+            relevantMask_ |= (1u << i);
+        }
+    }
+
+    table_.assign(size_t{1} << count, kInvalidVariant);
+    variantCount_ = 0;
+}
+
+std::vector<uint32_t> ShaderVariantTable::Enumerate() const {
+    std::vector<uint32_t> masks;
+    std::vector<bool> seen(table_.size(), false);
+
+    for (uint32_t mask = 0; mask <= allMask_; ++mask) {
+        if (validate_ && !validate_(mask)) continue;
+        const uint32_t canonical = Canonicalize(mask);
+        if (!seen[canonical]) {
+            seen[canonical] = true;
+            masks.push_back(canonical);
+        }
+    }
+
+    std::sort(masks.begin(), masks.end());
+    return masks;
+}
+
+std::vector<ShaderVariantTable::Define> ShaderVariantTable::MakeDefines(uint32_t mask) const {
+    std::vector<Define> defines = baseDefines_;
+    defines.reserve(baseDefines_.size() + features_.size());
+
+    // 無効な機能も 0 で定義する（シェーダ側は #if NAME で判定する前提）
+    for (uint32_t i = 0; i < features_.size(); ++i) {
+        const bool on = (mask & (1u << i)) != 0;
+        defines.push_back({features_[i].define, on ? features_[i].value : L"0"});
+    }
+    return defines;
+}
+
+std::vector<size_t> ShaderVariantTable::Build(const std::vector<uint32_t> &masks, const std::vector<Bytecode> &bytecodes) {
+    assert(masks.size() == bytecodes.size());
+
+    // 比較用のバイト列が同じものは 1 つにまとめる
+    std::vector<size_t> representatives;
+    std::vector<std::vector<uint8_t>> stripped; // バリアント番号 → 比較用のバイト列
+    std::unordered_multimap<uint64_t, uint32_t> byHash;
+    std::vector<uint32_t> variantOfCanonical(table_.size(), kInvalidVariant);
+
+    for (size_t i = 0; i < masks.size(); ++i) {
+        if (!bytecodes[i].data) continue; // コンパイル失敗（表では無効扱い）
+
+        std::vector<uint8_t> key = StripForCompare(bytecodes[i].data, bytecodes[i].size);
+        const uint64_t h = HashUtil::Fnv1a(key.data(), key.size());
+        uint32_t index = kInvalidVariant;
+        auto range = byHash.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (stripped[it->second] == key) {
+                index = it->second;
+                break;
+            }
+        }
+        if (index == kInvalidVariant) {
+            index = static_cast<uint32_t>(representatives.size());
+            representatives.push_back(i);
+            stripped.push_back(std::move(key));
+            byHash.emplace(h, index);
+        }
+        variantOfCanonical[masks[i]] = index;
+    }
+
+    // 全マスク → バリアント番号の表（描画時はここを引くだけ）
+    for (uint32_t mask = 0; mask <= allMask_; ++mask) {
+        const bool valid = !validate_ || validate_(mask);
+        table_[mask] = valid ? variantOfCanonical[Canonicalize(mask)] : kInvalidVariant;
+    }
+    variantCount_ = static_cast<uint32_t>(representatives.size());
+    return representatives;
+}
+
+std::vector<uint8_t> ShaderVariantTable::StripForCompare(const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    const std::vector<uint8_t> whole(bytes, bytes + size);
+    if (size < kContainerHeaderSize || ReadU32(bytes) != kContainerFourCC) return whole;
+
+    const uint32_t partCount = ReadU32(bytes + kPartCountOffset);
+    if (partCount > (size - kContainerHeaderSize) / sizeof(uint32_t)) return whole;
+
+    // ヘッダ（ダイジェストは全パートから計算されるので比べない）を飛ばし、残すパートを順に連結する
+    std::vector<uint8_t> out;
+    out.reserve(size);
+    for (uint32_t i = 0; i < partCount; ++i) {
+        const size_t offset = ReadU32(bytes + kContainerHeaderSize + i * sizeof(uint32_t));
+        if (offset > size || size - offset < kPartHeaderSize) return whole;
+        const uint32_t fourCC = ReadU32(bytes + offset);
+        const size_t partSize = ReadU32(bytes + offset + 4);
+        if (partSize > size - offset - kPartHeaderSize) return whole;
+
+        if (std::find(std::begin(kIgnoredParts), std::end(kIgnoredParts), fourCC) != std::end(kIgnoredParts)) continue;
+        out.insert(out.end(), bytes + offset, bytes + offset + kPartHeaderSize + partSize);
+    }
+    return out;
+}
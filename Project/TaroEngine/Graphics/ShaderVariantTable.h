@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 機能ビット（enum の値 = ビット番号）からマスクを作る。<br/>
+/// 例：MakeFeatureMask(SpriteFeature::Textured, SpriteFeature::AlphaTest)
+/// </summary>
+template <typename... E>
+constexpr uint32_t MakeFeatureMask(E... features) {
+    return (0u | ... | (1u << static_cast<uint32_t>(features)));
+}
+
+/// <summary>
+/// シェーダバリアントの「機能マスク → バリアント番号」表。<br/>
+/// マクロの組み立て、組み合わせの列挙、バイトコードによる重複排除を受け持つ。
+/// DXC に依存しないので、ShaderPermutation から切り出して単体でテストできる。
+/// </summary>
+class ShaderVariantTable {
+public:
+    /// <summary>
+    /// 扱える機能数の上限（ルックアップ表は 2^N 要素）。
+    /// </summary>
+    static constexpr uint32_t kMaxFeatures = 16;
+
+    /// <summary>
+    /// 無効な組み合わせを表すバリアント番号。
+    /// </summary>
+    static constexpr uint32_t kInvalidVariant = UINT32_MAX;
+
+    /// <summary>
+    /// 機能 1 つぶんの定義。配列の添字がビット番号になる。
+    /// </summary>
+    struct Feature {
+        std::wstring define;          // マクロ名（有効時 define=value、無効時 define=0）
+        std::wstring value = L"1";    // 有効時の値
+        bool alwaysRelevant = false;  // ソース本文に名前が無くても区別する（#include 先で使う場合）
+    };
+
+    /// <summary>
+    /// マクロ 1 つ（ShaderCompiler::Define と同じ形）。
+    /// </summary>
+    struct Define {
+        std::wstring name;
+        std::wstring value;
+    };
+
+    /// <summary>
+    /// コンパイル結果のバイト列（借用）。data が nullptr ならコンパイル失敗。
+    /// </summary>
+    struct Bytecode {
+        const void *data = nullptr;
+        size_t size = 0;
+    };
+
+    /// <summary>
+    /// 組み合わせの有効判定（false を返したマスクはコンパイルしない）。
+    /// </summary>
+    using ValidateFunc = std::function<bool(uint32_t mask)>;
+
+public:
+    /// <summary>
+    /// 初期化処理。表は空（全マスク無効）になる。
+    /// </summary>
+    /// <param name="sourceUtf8">UTF-8 ソース文字列（参照されないマクロの判定に使う）。</param>
+    /// <param name="features">機能一覧（kMaxFeatures 個まで）。</param>
+    /// <param name="validate">組み合わせの有効判定（省略時はすべて有効）。</param>
+    /// <param name="baseDefines">全バリアント共通のマクロ。</param>
+    void Initialize(
+        const std::string &sourceUtf8,
+        std::vector<Feature> features,
+        ValidateFunc validate = {},
+        std::vector<Define> baseDefines = {});
+
+    /// <summary>
+    /// コンパイル対象となるマスク（重複排除済み・昇順）を列挙する。
+    /// </summary>
+    std::vector<uint32_t> Enumerate() const;
+
+    /// <summary>
+    /// マスクを代表マスクへ正規化する（結果に影響しないビットを落とす）。
+    /// </summary>
+    uint32_t Canonicalize(uint32_t mask) const { return mask & relevantMask_; }
+
+    /// <summary>
+    /// マスクに対応するマクロ一覧を作る（baseDefines + 各機能の 0/値）。
+    /// </summary>
+    std::vector<Define> MakeDefines(uint32_t mask) const;
+
+    /// <summary>
+    /// Enumerate の各マスクのコンパイル結果から表を作る。<br/>
+    /// デバッグ情報などを除いた中身（StripForCompare）が一致するバリアントは 1 つにまとめる。
+    /// </summary>
+    /// <param name="masks">Enumerate の結果。</param>
+    /// <param name="bytecodes">masks と同じ順のコンパイル結果。</param>
+    /// <returns>バリアント番号順に、代表にした入力の添字（masks / bytecodes の添字）。</returns>
+    std::vector<size_t> Build(const std::vector<uint32_t> &masks, const std::vector<Bytecode> &bytecodes);
+
+    /// <summary>
+    /// マスクからバリアント番号を引く（文字列処理なし・表引き 1 回）。
+    /// </summary>
+    /// <returns>バリアント番号。無効な組み合わせ・コンパイル失敗なら kInvalidVariant。</returns>
+    uint32_t GetVariantIndex(uint32_t mask) const { return table_[mask & allMask_]; }
+
+    /// <summary>重複排除後のバリアント数を取得する。</summary>
+    uint32_t GetVariantCount() const { return variantCount_; }
+
+    /// <summary>機能数を取得する。</summary>
+    uint32_t GetFeatureCount() const { return static_cast<uint32_t>(features_.size()); }
+
+    /// <summary>
+    /// 比較用に、DXIL コンテナからデバッグ情報・シェーダハッシュなど
+    /// コードに関係しないパートを除いたバイト列を作る。<br/>
+    /// -Zi -Qembed_debug の埋め込み PDB（ILDB/ILDN）や、ソースとマクロから計算される HASH は
+    /// マクロが違えば必ず変わるため、そのまま比べると重複排除が効かない。<br/>
+    /// コンテナでなければ入力をそのまま返す。
+    /// </summary>
+    static std::vector<uint8_t> StripForCompare(const void *data, size_t size);
+
+private:
+    std::vector<Feature> features_;
+    ValidateFunc validate_;
+    std::vector<Define> baseDefines_;
+
+    uint32_t allMask_ = 0;      // 全機能ビット
+    uint32_t relevantMask_ = 0; // 結果に影響するビット
+    uint32_t variantCount_ = 0;
+
+    // table_[mask] = バリアント番号（2^機能数 要素）
+    std::vector<uint32_t> table_;
+};
@@ -0,0 +1,240 @@
+#include "SpatialGrid2D.h"
+#include "MatrixUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+    inline uint64_t MakeCellKey(int32_t x, int32_t y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    inline bool Overlaps(const SpatialGrid2D::Rect &a, const SpatialGrid2D::Rect &b) {
+        return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+    }
+
+} // namespace
+
+void SpatialGrid2D::Initialize(float cellSize) {
+    assert(cellSize > 0.0f);
+    cellSize_ = cellSize;
+    invCellSize_ = 1.0f / cellSize;
+    Clear();
+}
+
+void SpatialGrid2D::Clear() {
+    proxies_.clear();
+    freeHead_ = kInvalidProxy;
+    count_ = 0;
+    cells_.clear();
+    cellLookup_.clear();
+    large_.clear();
+}
+
+SpatialGrid2D::ProxyId SpatialGrid2D::Insert(const Rect &bounds, uint32_t userData) {
+    ProxyId id;
+    if (freeHead_ != kInvalidProxy) {
+        id = freeHead_;
+        freeHead_ = proxies_[id].nextFree;
+    } else {
+        assert(proxies_.size() < kInvalidProxy);
+        id = static_cast<ProxyId>(proxies_.size());
+        proxies_.emplace_back();
+    }
+
+    Proxy &p = proxies_[id];
+    p.bounds = bounds;
+    p.userData = userData;
+    p.nextFree = kInvalidProxy;
+    Link(id);
+    ++count_;
+    return id;
+}
+
+void SpatialGrid2D::Update(ProxyId id, const Rect &bounds) {
+    assert(id < proxies_.size() && proxies_[id].cell != kFreeCell);
+    Proxy &p = proxies_[id];
+
+    // 置き場所が変わらなければ矩形を書き換えるだけ（よくあるケース）
+    const bool large = IsLarge(bounds);
+    if (large && p.cell == kLargeCell) {
+        p.bounds = bounds;
+        return;
+    }
+    if (!large && p.cell != kLargeCell) {
+        const int32_t x = ToCellCoord((bounds.minX + bounds.maxX) * 0.5f);
+        const int32_t y = ToCellCoord((bounds.minY + bounds.maxY) * 0.5f);
+        if (x == p.cellX && y == p.cellY) {
+            p.bounds = bounds;
+            return;
+        }
+    }
+
+    Unlink(id);
+    p.bounds = bounds;
+    Link(id);
+}
+
+void SpatialGrid2D::Remove(ProxyId id) {
+    assert(id < proxies_.size() && proxies_[id].cell != kFreeCell);
+    Unlink(id);
+    Proxy &p = proxies_[id];
+    p.cell = kFreeCell;
+    p.nextFree = freeHead_;
+    freeHead_ = id;
+    --count_;
+}
+
+size_t SpatialGrid2D::QueryRect(const Rect &rect, std::vector<uint32_t> &out) const {
+    size_t found = CollectOverlaps(large_, rect, out);
+    if (cells_.empty()) return found;
+
+    // 要素は中心のセルに置いてあり、はみ出しはセルの半分まで。その分だけ広げたセル範囲を見る
+    const float margin = cellSize_ * 0.5f;
+    const int32_t x0 = ToCellCoord(rect.minX - margin);
+    const int32_t x1 = ToCellCoord(rect.maxX + margin);
+    const int32_t y0 = ToCellCoord(rect.minY - margin);
+    const int32_t y1 = ToCellCoord(rect.maxY + margin);
+
+    // 範囲のセル数が実在するセル数より多ければ、実在するセルを順に見るほうが安い
+    const double rangeCells = (static_cast<double>(x1) - x0 + 1.0) * (static_cast<double>(y1) - y0 + 1.0);
+    if (rangeCells > static_cast<double>(cells_.size())) {
+        for (const Cell &cell : cells_) {
+            found += CollectOverlaps(cell.proxies, rect, out);
+        }
+        return found;
+    }
+
+    for (int32_t y = y0; y <= y1; ++y) {
+        for (int32_t x = x0; x <= x1; ++x) {
+            const auto it = cellLookup_.find(MakeCellKey(x, y));
+            if (it != cellLookup_.end()) {
+                found += CollectOverlaps(cells_[it->second].proxies, rect, out);
+            }
+        }
+    }
+    return found;
+}
+
+size_t SpatialGrid2D::QueryPoint(const Vector2 &point, std::vector<uint32_t> &out) const {
+    return QueryRect(Rect{point.x, point.y, point.x, point.y}, out);
+}
+
+const SpatialGrid2D::Rect &SpatialGrid2D::GetBounds(ProxyId id) const {
+    assert(id < proxies_.size() && proxies_[id].cell != kFreeCell);
+    return proxies_[id].bounds;
+}
+
+uint32_t SpatialGrid2D::GetUserData(ProxyId id) const {
+    assert(id < proxies_.size() && proxies_[id].cell != kFreeCell);
+    return proxies_[id].userData;
+}
+
+SpatialGrid2D::Rect SpatialGrid2D::MakeSpriteBounds(const Vector2 &position, const Vector2 &size, float rotation) {
+    // 中心基準のクアッドを回転させたときの、軸方向の半分の大きさ
+    const float c = std::fabs(std::cos(rotation));
+    const float s = std::fabs(std::sin(rotation));
+    const float hx = 0.5f * (c * std::fabs(size.x) + s * std::fabs(size.y));
+    const float hy = 0.5f * (s * std::fabs(size.x) + c * std::fabs(size.y));
+    return Rect{position.x - hx, position.y - hy, position.x + hx, position.y + hy};
+}
+
+bool SpatialGrid2D::ComputeVisibleRect(const Matrix4x4 &viewProj, float planeZ, Rect &out) {
+    Matrix4x4 inv;
+    if (!MatrixUtil::Inverse(viewProj, inv)) return false;
+
+    // NDC の点をワールドへ戻す（行ベクトル×右掛け）
+    auto unproject = [&inv](float x, float y, float z, float world[3]) {
+        float v[4];
+        for (int j = 0; j < 4; ++j) {
+            v[j] = x * inv.m[0][j] + y * inv.m[1][j] + z * inv.m[2][j] + inv.m[3][j];
+        }
+        if (!(v[3] > 0.0f)) return false;
+        world[0] = v[0] / v[3];
+        world[1] = v[1] / v[3];
+        world[2] = v[2] / v[3];
+        return true;
+    };
+
+    const float corners[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f}, {1.0f, 1.0f}};
+    Rect r{INFINITY, INFINITY, -INFINITY, -INFINITY};
+    for (const auto &corner : corners) {
+        // 隅を通る視線（near → far）と平面の交点
+        float n[3], f[3];
+        if (!unproject(corner[0], corner[1], 0.0f, n) || !unproject(corner[0], corner[1], 1.0f, f)) return false;
+        const float dz = f[2] - n[2];
+        if (std::fabs(dz) < 1e-12f) return false;
+        const float t = (planeZ - n[2]) / dz;
+        if (t < 0.0f) return false;
+
+        const float x = n[0] + (f[0] - n[0]) * t;
+        const float y = n[1] + (f[1] - n[1]) * t;
+        r.minX = (std::min)(r.minX, x);
+        r.minY = (std::min)(r.minY, y);
+        r.maxX = (std::max)(r.maxX, x);
+        r.maxY = (std::max)(r.maxY, y);
+    }
+    out = r;
+    return true;
+}
+
+int32_t SpatialGrid2D::ToCellCoord(float v) const {
+    // 極端な座標でも int32 に収める
+    const float c = std::floor(v * invCellSize_);
+    return static_cast<int32_t>(std::clamp(c, -1.0e9f, 1.0e9f));
+}
+
+bool SpatialGrid2D::IsLarge(const Rect &bounds) const {
+    return (bounds.maxX - bounds.minX) > cellSize_ || (bounds.maxY - bounds.minY) > cellSize_;
+}
+
+uint32_t SpatialGrid2D::FindOrCreateCell(int32_t x, int32_t y) {
+    const auto [it, inserted] = cellLookup_.try_emplace(MakeCellKey(x, y), static_cast<uint32_t>(cells_.size()));
+    if (inserted) {
+        cells_.emplace_back();
+    }
+    return it->second;
+}
+
+void SpatialGrid2D::Link(ProxyId id) {
+    Proxy &p = proxies_[id];
+    if (IsLarge(p.bounds)) {
+        p.cell = kLargeCell;
+        p.slot = static_cast<uint32_t>(large_.size());
+        large_.push_back(id);
+        return;
+    }
+
+    p.cellX = ToCellCoord((p.bounds.minX + p.bounds.maxX) * 0.5f);
+    p.cellY = ToCellCoord((p.bounds.minY + p.bounds.maxY) * 0.5f);
+    p.cell = FindOrCreateCell(p.cellX, p.cellY);
+    std::vector<ProxyId> &list = cells_[p.cell].proxies;
+    p.slot = static_cast<uint32_t>(list.size());
+    list.push_back(id);
+}
+
+void SpatialGrid2D::Unlink(ProxyId id) {
+    Proxy &p = proxies_[id];
+    std::vector<ProxyId> &list = (p.cell == kLargeCell) ? large_ : cells_[p.cell].proxies;
+    assert(p.slot < list.size() && list[p.slot] == id);
+
+    // 末尾と入れ替えて外す（入れ替えた要素の位置を直す）
+    const ProxyId moved = list.back();
+    list[p.slot] = moved;
+    proxies_[moved].slot = p.slot;
+    list.pop_back();
+}
+
+size_t SpatialGrid2D::CollectOverlaps(const std::vector<ProxyId> &ids, const Rect &rect,
+    std::vector<uint32_t> &out) const {
+    size_t found = 0;
+    for (const ProxyId id : ids) {
+        const Proxy &p = proxies_[id];
+        if (Overlaps(p.bounds, rect)) {
+            out.push_back(p.userData);
+            ++found;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector2.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 2D の境界矩形を登録し、矩形・点で素早く引ける動的な空間インデックス（ルーズな一様グリッド）。<br/>
+/// 各要素は中心が入るセル 1 つにだけ置き、検索時にセル半分だけ広げて拾う。
+/// 同じセルの中で動くだけなら Update は矩形の書き換えだけで済む。
+/// </summary>
+/// <remarks>
+/// - セルはハッシュで引くので、ワールドの広さに上限はない（空のセルは再利用のため残る）。<br/>
+/// - セルより大きい要素は別のリストに置き、検索のたびに総当たりで判定する。<br/>
+/// - 判定は軸平行の境界矩形どうし（回転したスプライトは MakeSpriteBounds で包む）。<br/>
+/// - D3D12 に依存しないので単体で動作確認できる。スレッドセーフではない。
+/// </remarks>
+class SpatialGrid2D {
+public:
+    /// <summary>軸平行の矩形（min/max を含む）。</summary>
+    struct Rect {
+        float minX = 0.0f;
+        float minY = 0.0f;
+        float maxX = 0.0f;
+        float maxY = 0.0f;
+    };
+
+    /// <summary>登録した要素の識別子。</summary>
+    using ProxyId = uint32_t;
+
+    /// <summary>無効な識別子。</summary>
+    static constexpr ProxyId kInvalidProxy = UINT32_MAX;
+
+public:
+    /// <summary>
+    /// 初期化処理。
+    /// </summary>
+    /// <param name="cellSize">セルの一辺（よく使う要素の大きさ～画面の数分の一が目安）。</param>
+    void Initialize(float cellSize);
+
+    /// <summary>すべての要素を取り除く。</summary>
+    void Clear();
+
+    /// <summary>
+    /// 要素を登録する。
+    /// </summary>
+    /// <param name="bounds">境界矩形。</param>
+    /// <param name="userData">検索結果として返す値（スプライト表の番号など）。</param>
+    /// <returns>識別子（Update / Remove に渡す）。</returns>
+    ProxyId Insert(const Rect &bounds, uint32_t userData);
+
+    /// <summary>
+    /// 要素の境界矩形を更新する（SetPosition / SetSize の後に呼ぶ）。
+    /// </summary>
+    void Update(ProxyId id, const Rect &bounds);
+
+    /// <summary>要素を取り除く（識別子は再利用される）。</summary>
+    void Remove(ProxyId id);
+
+    /// <summary>
+    /// 矩形と重なる要素の userData を out の末尾に追加する（順序は不定）。
+    /// </summary>
+    /// <returns>追加した数。</returns>
+    size_t QueryRect(const Rect &rect, std::vector<uint32_t> &out) const;
+
+    /// <summary>
+    /// 点を含む要素の userData を out の末尾に追加する（ピッキング用）。
+    /// </summary>
+    /// <returns>追加した数。</returns>
+    size_t QueryPoint(const Vector2 &point, std::vector<uint32_t> &out) const;
+
+    /// <summary>要素の境界矩形を取得する。</summary>
+    const Rect &GetBounds(ProxyId id) const;
+
+    /// <summary>要素の userData を取得する。</summary>
+    uint32_t GetUserData(ProxyId id) const;
+
+    /// <summary>登録中の要素数。</summary>
+    size_t GetCount() const { return count_; }
+
+    /// <summary>セルより大きく、総当たりで判定している要素数。</summary>
+    size_t GetLargeCount() const { return large_.size(); }
+
+    /// <summary>
+    /// スプライト（中心・大きさ・Z 回転）を包む境界矩形を求める。
+    /// </summary>
+    static Rect MakeSpriteBounds(const Vector2 &position, const Vector2 &size, float rotation);
+
+    /// <summary>
+    /// View * Projection で画面に映る、平面 z = planeZ 上の範囲を求める（正射影・透視投影の両方に対応）。
+    /// </summary>
+    /// <param name="viewProj">View * Projection。</param>
+    /// <param name="planeZ">スプライトを置いている平面の Z。</param>
+    /// <param name="out">範囲（画面の四隅を平面へ投げた点を包む矩形）。</param>
+    /// <returns>画面の隅が平面に届かない（地平線が映る・平面と平行）なら false。</returns>
+    static bool ComputeVisibleRect(const Matrix4x4 &viewProj, float planeZ, Rect &out);
+
+private:
+    // 特別なセル番号
+    static constexpr uint32_t kLargeCell = UINT32_MAX;     // large_ に置いている
+    static constexpr uint32_t kFreeCell = UINT32_MAX - 1;  // 未使用
+
+    /// <summary>登録された要素。</summary>
+    struct Proxy {
+        Rect bounds;
+        uint32_t userData = 0;
+        uint32_t cell = kFreeCell; // cells_ の番号（または特別なセル番号）
+        uint32_t slot = 0;         // セル（または large_）内の位置
+        int32_t cellX = 0;         // 置いているセルの座標（Update で移動の有無を判定する）
+        int32_t cellY = 0;
+        ProxyId nextFree = kInvalidProxy;
+    };
+
+    /// <summary>1 セルに置かれた要素。</summary>
+    struct Cell {
+        std::vector<ProxyId> proxies;
+    };
+
+    /// <summary>座標をセル番号へ（床関数）。</summary>
+    int32_t ToCellCoord(float v) const;
+
+    /// <summary>矩形に応じたセル（または large_）へ入れる。</summary>
+    void Link(ProxyId id);
+
+    /// <summary>今のセル（または large_）から外す。</summary>
+    void Unlink(ProxyId id);
+
+    /// <summary>セルに置けないほど大きいか（半分の大きさがセルの半分を超える）。</summary>
+    bool IsLarge(const Rect &bounds) const;
+
+    /// <summary>セルを探し、なければ作る。</summary>
+    uint32_t FindOrCreateCell(int32_t x, int32_t y);
+
+    /// <summary>セル 1 つ分の要素を判定して追加する。</summary>
+    size_t CollectOverlaps(const std::vector<ProxyId> &ids, const Rect &rect, std::vector<uint32_t> &out) const;
+
+private:
+    float cellSize_ = 1.0f;
+    float invCellSize_ = 1.0f;
+
+    std::vector<Proxy> proxies_;
+    ProxyId freeHead_ = kInvalidProxy;
+    size_t count_ = 0;
+
+    std::vector<Cell> cells_;
+    std::unordered_map<uint64_t, uint32_t> cellLookup_; // (x, y) を詰めたキー → cells_ の番号
+    std::vector<ProxyId> large_;
+};
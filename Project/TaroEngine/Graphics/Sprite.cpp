@@ -34,7 +34,7 @@ void Sprite::Initialize(ID3D12Device *device) {
     // === マテリアル ===
     materialResource_ = BufferUtil::CreateUploadBuffer(device, sizeof(Material));
     materialResource_->Map(0, nullptr, reinterpret_cast<void **>(&materialData_));
-    materialData_->color = Vector4(1, 1, 1, 1);
+    materialData_->color = color_;
     materialData_->enableLighting = false;
     materialData_->uvTransform = MatrixUtil::MakeIdentityMatrix();
 
@@ -45,6 +45,14 @@ void Sprite::Initialize(ID3D12Device *device) {
     transformMatrixData_->WVP = MatrixUtil::MakeIdentityMatrix();
 }
 
+void Sprite::SetColor(const Vector4 &c) {
+    color_ = c;
+    // Initialize 済み（個別描画）の場合はマテリアルにも反映
+    if (materialData_) {
+        materialData_->color = c;
+    }
+}
+
 // 内部共通：vp = View * Proj を受け取り、WVP を組む
 void Sprite::UpdateImpl_(const Matrix4x4 &vp) {
     // 頂点（ローカル）更新：サイズは頂点段階で反映
@@ -57,16 +65,16 @@ void Sprite::UpdateImpl_(const Matrix4x4 &vp) {
     vertexData_[3] = {{  hw,  hh, 0.0f }, { 1.0f, 0.0f }};
 
     // World：回転→平行移動（スケールは頂点で済ませたので掛けない）
-    auto R = MatrixUtil::MakeRotationZMatrix(rotation_);
-    auto T = MatrixUtil::MakeTranslationMatrix(position_.x, position_.y, 0.0f);
-    auto W = MatrixUtil::Multiply(R, T);
+    // 2D アフィン（3x2）で持ち、VP との積も閉形式で計算する
+    auto A = MatrixUtil::MakeAffine2DMatrix(rotation_, position_.x, position_.y);
+    auto W = MatrixUtil::ToMatrix4x4(A);
 
 #if SPRITE_SEND_ROW_MAJOR
     transformMatrixData_->World = W;
-    transformMatrixData_->WVP = MatrixUtil::Multiply(W, vp);
+    transformMatrixData_->WVP = MatrixUtil::MultiplyAffine2D(A, vp);
 #else
     transformMatrixData_->World = MatrixUtil::Transpose(W);
-    auto wvp = MatrixUtil::Multiply(W, vp);
+    auto wvp = MatrixUtil::MultiplyAffine2D(A, vp);
     transformMatrixData_->WVP = MatrixUtil::Transpose(wvp);
 #endif
 }
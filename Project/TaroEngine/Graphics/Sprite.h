@@ -45,6 +45,12 @@ public:
     void SetPosition(const Vector2 &p) { position_ = p; }
     void SetSize(const Vector2 &s) { size_ = s; }
     void SetRotation(float r) { rotation_ = r; }
+    void SetColor(const Vector4 &c);
+
+    const Vector2 &GetPosition() const { return position_; }
+    const Vector2 &GetSize() const { return size_; }
+    float GetRotation() const { return rotation_; }
+    const Vector4 &GetColor() const { return color_; }
 
 private:
     // GPU リソース
@@ -67,6 +73,7 @@ private:
     Vector2 position_{0.0f, 0.0f};
     Vector2 size_{100.0f, 100.0f};
     float   rotation_ = 0.0f;
+    Vector4 color_{1.0f, 1.0f, 1.0f, 1.0f};
 
     // 内部共通：頂点更新＋World 計算を行い、引数 vp（= View*Proj）で WVP を組む
     void UpdateImpl_(const struct Matrix4x4 &vp);
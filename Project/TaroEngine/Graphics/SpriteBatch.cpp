@@ -0,0 +1,119 @@
+#include "SpriteBatch.h"
+#include "BufferUtil.h"
+#include "Sprite.h"
+#include "SpriteBatchCommandSink.h"
+#include "SpriteCommon.h"
+#include "UploadRingBuffer.h"
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+    // 共有クアッドの頂点（中心原点の 1x1。サイズはインスタンスの WVP に畳み込む）
+    struct QuadVertex {
+        Vector2 position;
+        Vector2 texcoord;
+    };
+
+    // SpriteBatchBuilder::Flush のコマンドを D3D12 のコマンドリストへ流す
+    class D3D12SpriteBatchCommandSink : public ISpriteBatchCommandSink {
+    public:
+        D3D12SpriteBatchCommandSink(ID3D12GraphicsCommandList *cmdList, const SpriteCommon &common,
+            UploadRingBuffer &uploadRing, const D3D12_VERTEX_BUFFER_VIEW &quadVbv, const D3D12_INDEX_BUFFER_VIEW &quadIbv)
+            : cmdList_(cmdList), common_(common), uploadRing_(uploadRing), quadVbv_(quadVbv), quadIbv_(quadIbv) {}
+
+        InstanceBuffer AllocateInstances(uint32_t count) override {
+            // このフレーム分だけリングから切り出す（GPU 完了後に自動で回収される）
+            const UploadRingBuffer::Allocation alloc =
+                uploadRing_.Allocate(static_cast<uint64_t>(count) * sizeof(SpriteInstance));
+            InstanceBuffer buffer;
+            buffer.cpu = static_cast<SpriteInstance *>(alloc.cpu);
+            buffer.gpuAddress = alloc.gpu;
+            return buffer;
+        }
+
+        void SetInstanceBuffer(uint64_t gpuAddress, uint32_t strideInBytes, uint32_t sizeInBytes) override {
+            D3D12_VERTEX_BUFFER_VIEW views[2] = {};
+            views[0] = quadVbv_;
+            views[1].BufferLocation = gpuAddress;
+            views[1].StrideInBytes = strideInBytes;
+            views[1].SizeInBytes = sizeInBytes;
+
+            common_.ApplyInstancedDrawSettings(cmdList_);
+            cmdList_->IASetVertexBuffers(0, 2, views);
+            cmdList_->IASetIndexBuffer(&quadIbv_);
+        }
+
+        void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount) override {
+            cmdList_->DrawIndexedInstanced(indexCountPerInstance, instanceCount, 0, 0, 0);
+        }
+
+    private:
+        ID3D12GraphicsCommandList *cmdList_;
+        const SpriteCommon &common_;
+        UploadRingBuffer &uploadRing_;
+        const D3D12_VERTEX_BUFFER_VIEW &quadVbv_;
+        const D3D12_INDEX_BUFFER_VIEW &quadIbv_;
+    };
+
+} // namespace
+
+void SpriteBatch::Initialize(ID3D12Device *device, UploadRingBuffer *uploadRing) {
+    assert(device && uploadRing);
+    uploadRing_ = uploadRing;
+
+    // === 共有クアッド（Sprite と同じ並び・巻き順） ===
+    const QuadVertex vertices[4] = {
+        {{-0.5f, -0.5f}, {0.0f, 1.0f}},
+        {{-0.5f,  0.5f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f}, {1.0f, 0.0f}},
+    };
+    const uint32_t indices[SpriteBatchBuilder::kQuadIndexCount] = {0,1,2, 2,1,3};
+
+    quadVertexResource_ = BufferUtil::CreateUploadBuffer(device, sizeof(vertices));
+    quadIndexResource_ = BufferUtil::CreateUploadBuffer(device, sizeof(indices));
+
+    void *mapped = nullptr;
+    quadVertexResource_->Map(0, nullptr, &mapped);
+    std::memcpy(mapped, vertices, sizeof(vertices));
+    quadVertexResource_->Unmap(0, nullptr);
+
+    quadIndexResource_->Map(0, nullptr, &mapped);
+    std::memcpy(mapped, indices, sizeof(indices));
+    quadIndexResource_->Unmap(0, nullptr);
+
+    quadVertexBufferView_ = BufferUtil::MakeVBV(quadVertexResource_.Get(), sizeof(QuadVertex), sizeof(vertices));
+    quadIndexBufferView_ = BufferUtil::MakeIBV(quadIndexResource_.Get(), sizeof(indices));
+
+    builder_.Reserve(kInitialCapacity);
+}
+
+void SpriteBatch::Begin(const Matrix4x4 &viewProj) {
+    viewProj_ = viewProj;
+    builder_.Clear();
+}
+
+void SpriteBatch::Add(const SpriteBatchBuilder::Entry &entry) {
+    builder_.Add(entry);
+}
+
+SpriteBatchBuilder::Entry SpriteBatch::MakeEntry(const Sprite &sprite, int32_t layer) {
+    SpriteBatchBuilder::Entry e{};
+    e.position = sprite.GetPosition();
+    e.size = sprite.GetSize();
+    e.rotation = sprite.GetRotation();
+    e.color = sprite.GetColor();
+    e.layer = layer;
+    return e;
+}
+
+void SpriteBatch::Add(const Sprite &sprite, int32_t layer) {
+    builder_.Add(MakeEntry(sprite, layer));
+}
+
+void SpriteBatch::End(ID3D12GraphicsCommandList *cmdList, const SpriteCommon &common) {
+    assert(cmdList);
+    D3D12SpriteBatchCommandSink sink(cmdList, common, *uploadRing_, quadVertexBufferView_, quadIndexBufferView_);
+    builder_.Flush(viewProj_, sink);
+}
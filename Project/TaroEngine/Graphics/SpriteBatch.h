@@ -0,0 +1,75 @@
+#pragma once
+#include "SpriteBatchBuilder.h"
+#include "SpriteInstance.h"
+#include <d3d12.h>
+#include <wrl.h>
+
+class Sprite;
+class SpriteCommon;
+class UploadRingBuffer;
+
+/// <summary>
+/// スプライトをインスタンス描画でまとめて描くバッチ。<br/>
+/// 全スプライトで 1 つの静的クアッドを共有し、インスタンスデータ（WVP・色・UV 矩形）を
+/// Upload リングから切り出した領域へ詰めて、1 回の DrawIndexedInstanced で描画する。
+/// </summary>
+class SpriteBatch {
+public:
+    /// <summary>
+    /// 受付配列の初期容量（要素数）。
+    /// </summary>
+    static constexpr uint32_t kInitialCapacity = 1024;
+
+public:
+    /// <summary>
+    /// 初期化処理。共有クアッドを生成する。
+    /// </summary>
+    /// <param name="device">D3D12 デバイス。</param>
+    /// <param name="uploadRing">インスタンスデータの確保先（DirectXCommon のリング）。</param>
+    void Initialize(ID3D12Device *device, UploadRingBuffer *uploadRing);
+
+    /// <summary>
+    /// インスタンスデータの詰め込みを並列に行う JobSystem を設定する（nullptr で無効）。
+    /// </summary>
+    void SetJobSystem(JobSystem *jobSystem) { builder_.SetJobSystem(jobSystem); }
+
+    /// <summary>
+    /// バッチの受付を開始する。
+    /// </summary>
+    /// <param name="viewProj">View * Projection。</param>
+    void Begin(const Matrix4x4 &viewProj);
+
+    /// <summary>描画要求を追加する。</summary>
+    /// <param name="entry">描画パラメータ。</param>
+    void Add(const SpriteBatchBuilder::Entry &entry);
+
+    /// <summary>Sprite の現在のパラメータから描画要求を作る。</summary>
+    /// <param name="sprite">対象スプライト。</param>
+    /// <param name="layer">描画順（小さいほど先に描く）。</param>
+    /// <returns>描画パラメータ。</returns>
+    static SpriteBatchBuilder::Entry MakeEntry(const Sprite &sprite, int32_t layer = 0);
+
+    /// <summary>Sprite の現在のパラメータで描画要求を追加する。</summary>
+    /// <param name="sprite">対象スプライト。</param>
+    /// <param name="layer">描画順（小さいほど先に描く）。</param>
+    void Add(const Sprite &sprite, int32_t layer = 0);
+
+    /// <summary>
+    /// 受け付けた描画要求をインスタンスバッファへ詰め、1 回のドローで発行する。
+    /// </summary>
+    /// <param name="cmdList">描画先のコマンドリスト。</param>
+    /// <param name="common">インスタンス描画用 PSO を持つ SpriteCommon。</param>
+    void End(ID3D12GraphicsCommandList *cmdList, const SpriteCommon &common);
+
+private:
+    UploadRingBuffer *uploadRing_ = nullptr; // インスタンスデータの確保先（借用）
+
+    // 共有クアッド
+    Microsoft::WRL::ComPtr<ID3D12Resource> quadVertexResource_;
+    Microsoft::WRL::ComPtr<ID3D12Resource> quadIndexResource_;
+    D3D12_VERTEX_BUFFER_VIEW quadVertexBufferView_{};
+    D3D12_INDEX_BUFFER_VIEW quadIndexBufferView_{};
+
+    SpriteBatchBuilder builder_;
+    Matrix4x4 viewProj_{};
+};
@@ -0,0 +1,120 @@
+#include "SpriteBatchBuilder.h"
+#include "JobSystem.h"
+#include "SpriteBatchCommandSink.h"
+#include "TransformBatch.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+    // layer（符号付き）を上位 32bit、追加順を下位 32bit に詰める。
+    // 追加順が含まれるので std::sort でも同じ layer 内の順序が保たれる。
+    inline uint64_t MakeSortKey(int32_t layer, uint32_t index) {
+        const uint32_t biased = static_cast<uint32_t>(layer) ^ 0x80000000u;
+        return (static_cast<uint64_t>(biased) << 32) | index;
+    }
+
+} // namespace
+
+void SpriteBatchBuilder::Clear() {
+    positionX_.clear();
+    positionY_.clear();
+    rotation_.clear();
+    sizeX_.clear();
+    sizeY_.clear();
+    color_.clear();
+    uvRect_.clear();
+    layers_.clear();
+    sortKeys_.clear();
+    order_.clear();
+    needsSort_ = false;
+}
+
+void SpriteBatchBuilder::Reserve(size_t count) {
+    positionX_.reserve(count);
+    positionY_.reserve(count);
+    rotation_.reserve(count);
+    sizeX_.reserve(count);
+    sizeY_.reserve(count);
+    color_.reserve(count);
+    uvRect_.reserve(count);
+    layers_.reserve(count);
+}
+
+void SpriteBatchBuilder::Add(const Entry &entry) {
+    if (!layers_.empty() && entry.layer < layers_.back()) {
+        needsSort_ = true;
+    }
+    positionX_.push_back(entry.position.x);
+    positionY_.push_back(entry.position.y);
+    rotation_.push_back(entry.rotation);
+    sizeX_.push_back(entry.size.x);
+    sizeY_.push_back(entry.size.y);
+    color_.push_back(entry.color);
+    uvRect_.push_back(entry.uvRect);
+    layers_.push_back(entry.layer);
+}
+
+void SpriteBatchBuilder::Build(const Matrix4x4 &viewProj, SpriteInstance *dst) {
+    const size_t count = layers_.size();
+    if (count == 0) return;
+    assert(dst);
+    assert(count <= UINT32_MAX);
+
+    TransformBatch::SpriteStreams streams;
+    streams.positionX = positionX_.data();
+    streams.positionY = positionY_.data();
+    streams.rotation = rotation_.data();
+    streams.sizeX = sizeX_.data();
+    streams.sizeY = sizeY_.data();
+    streams.color = color_.data();
+    streams.uvRect = uvRect_.data();
+    streams.count = count;
+
+    // 既に layer 昇順で追加されていればソート不要（よくあるケース）
+    if (needsSort_) {
+        sortKeys_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            sortKeys_[i] = MakeSortKey(layers_[i], static_cast<uint32_t>(i));
+        }
+        std::sort(sortKeys_.begin(), sortKeys_.end());
+
+        order_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            order_[i] = static_cast<uint32_t>(sortKeys_[i] & 0xFFFFFFFFu);
+        }
+        streams.order = order_.data();
+    }
+
+    // 書き出しは要素ごとに独立しているので、区間に分けて並列に行える（各区間は連続書き込み）
+    if (jobSystem_) {
+        jobSystem_->ParallelFor(count, kParallelGrainSize, [&](size_t begin, size_t end) {
+            TransformBatch::ComputeSpriteInstances(streams.Slice(begin, end), viewProj, dst + begin);
+        });
+    } else {
+        TransformBatch::ComputeSpriteInstances(streams, viewProj, dst);
+    }
+}
+
+uint32_t SpriteBatchBuilder::Flush(const Matrix4x4 &viewProj, ISpriteBatchCommandSink &sink) {
+    const size_t count = layers_.size();
+    if (count == 0) return 0;
+    assert(count * sizeof(SpriteInstance) <= UINT32_MAX);
+
+    const uint32_t instanceCount = static_cast<uint32_t>(count);
+    const ISpriteBatchCommandSink::InstanceBuffer dst = sink.AllocateInstances(instanceCount);
+    if (!dst.cpu) {
+        Clear();
+        return 0;
+    }
+
+    // 並べ替え＋WVP 計算をしながら確保先へ直接書き込む
+    Build(viewProj, dst.cpu);
+
+    const uint32_t stride = static_cast<uint32_t>(sizeof(SpriteInstance));
+    sink.SetInstanceBuffer(dst.gpuAddress, stride, stride * instanceCount);
+    sink.DrawIndexedInstanced(kQuadIndexCount, instanceCount);
+
+    Clear();
+    return instanceCount;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "SpriteInstance.h"
+#include "Vector2.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ISpriteBatchCommandSink;
+class JobSystem;
+
+/// <summary>
+/// SpriteBatch の CPU 側処理（並べ替え・インスタンスデータの詰め込み）を担当するクラス。<br/>
+/// D3D12 に依存しないため、GPU なしで単体で動作確認できる。
+/// </summary>
+class SpriteBatchBuilder {
+public:
+    /// <summary>
+    /// 描画要求 1 件ぶんのパラメータ。
+    /// </summary>
+    struct Entry {
+        Vector2 position{0.0f, 0.0f};              ///< 中心座標
+        Vector2 size{100.0f, 100.0f};              ///< 幅・高さ
+        float rotation = 0.0f;                     ///< Z 軸回転（ラジアン）
+        Vector4 color{1.0f, 1.0f, 1.0f, 1.0f};     ///< 乗算カラー
+        Vector4 uvRect{0.0f, 0.0f, 1.0f, 1.0f};    ///< UV 矩形 (u0, v0, u1, v1)
+        int32_t layer = 0;                         ///< 描画順（小さいほど先に描く）
+    };
+
+    /// <summary>
+    /// Build を JobSystem で分割するときの 1 ジョブあたりの件数。
+    /// </summary>
+    static constexpr size_t kParallelGrainSize = 1024;
+
+    /// <summary>
+    /// 共有クアッド 1 枚のインデックス数。
+    /// </summary>
+    static constexpr uint32_t kQuadIndexCount = 6;
+
+public:
+    /// <summary>
+    /// Build の書き出しを分割して並列に行う JobSystem を設定する（nullptr なら呼び出し元だけで行う）。
+    /// </summary>
+    void SetJobSystem(JobSystem *jobSystem) { jobSystem_ = jobSystem; }
+
+    /// <summary>登録済みの描画要求をすべて破棄する。</summary>
+    void Clear();
+
+    /// <summary>描画要求の格納領域を予約する。</summary>
+    /// <param name="count">予約する件数。</param>
+    void Reserve(size_t count);
+
+    /// <summary>描画要求を追加する。</summary>
+    /// <param name="entry">描画パラメータ。</param>
+    void Add(const Entry &entry);
+
+    /// <summary>登録済みの描画要求数を取得する。</summary>
+    size_t GetCount() const { return layers_.size(); }
+
+    /// <summary>
+    /// layer 昇順（同じ layer 内は追加順）に並べ、SpriteInstance を dst へ書き出す。<br/>
+    /// 計算は TransformBatch::ComputeSpriteInstances（SoA カーネル）で行う。
+    /// </summary>
+    /// <param name="viewProj">View * Projection。</param>
+    /// <param name="dst">書き出し先（GetCount() 要素分。Map 済みの Upload ヒープを直接渡してよい）。</param>
+    void Build(const Matrix4x4 &viewProj, SpriteInstance *dst);
+
+    /// <summary>
+    /// sink から確保した領域へ Build し、インスタンス描画を 1 回発行して受付をクリアする。<br/>
+    /// 確保に失敗した場合は何も描かずにクリアする。
+    /// </summary>
+    /// <param name="viewProj">View * Projection。</param>
+    /// <param name="sink">描画コマンドの発行先。</param>
+    /// <returns>描画したインスタンス数。</returns>
+    uint32_t Flush(const Matrix4x4 &viewProj, ISpriteBatchCommandSink &sink);
+
+private:
+    // 描画要求（追加順、SoA）
+    std::vector<float> positionX_;
+    std::vector<float> positionY_;
+    std::vector<float> rotation_;
+    std::vector<float> sizeX_;
+    std::vector<float> sizeY_;
+    std::vector<Vector4> color_;
+    std::vector<Vector4> uvRect_;
+    std::vector<int32_t> layers_;
+
+    std::vector<uint64_t> sortKeys_;  // (layer, 追加順) を詰めたソートキー
+    std::vector<uint32_t> order_;     // ソート後の読み出し順（カーネルへ渡す）
+    bool needsSort_ = false;          // 追加順が layer 昇順になっていなければ true
+    JobSystem *jobSystem_ = nullptr;  // 書き出しの並列化に使う（借用、任意）
+};
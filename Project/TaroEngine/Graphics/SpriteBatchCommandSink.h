@@ -0,0 +1,43 @@
+#pragma once
+#include "SpriteInstance.h"
+#include <cstdint>
+
+/// <summary>
+/// SpriteBatchBuilder::Flush が発行する描画コマンドの受け口。<br/>
+/// D3D12 版（SpriteBatch 内）はコマンドリストと Upload リングへ流し、
+/// テストでは呼び出しを記録するだけの実装に差し替える。
+/// </summary>
+class ISpriteBatchCommandSink {
+public:
+    /// <summary>
+    /// インスタンスデータの書き込み先。
+    /// </summary>
+    struct InstanceBuffer {
+        SpriteInstance *cpu = nullptr; ///< 書き込み先（確保失敗なら nullptr）
+        uint64_t gpuAddress = 0;       ///< 頂点バッファとして渡す GPU アドレス
+    };
+
+public:
+    virtual ~ISpriteBatchCommandSink() = default;
+
+    /// <summary>
+    /// インスタンス count 件ぶんの領域を確保する。
+    /// </summary>
+    /// <returns>確保した領域。容量不足なら cpu が nullptr。</returns>
+    virtual InstanceBuffer AllocateInstances(uint32_t count) = 0;
+
+    /// <summary>
+    /// 描画設定（RS/PSO/トポロジ・共有クアッド）と、インスタンスデータを slot 1 の頂点バッファに設定する。
+    /// </summary>
+    /// <param name="gpuAddress">AllocateInstances で得た GPU アドレス。</param>
+    /// <param name="strideInBytes">1 インスタンスのバイト数。</param>
+    /// <param name="sizeInBytes">全体のバイト数。</param>
+    virtual void SetInstanceBuffer(uint64_t gpuAddress, uint32_t strideInBytes, uint32_t sizeInBytes) = 0;
+
+    /// <summary>
+    /// 共有クアッドをインスタンス描画する。
+    /// </summary>
+    /// <param name="indexCountPerInstance">1 インスタンスのインデックス数。</param>
+    /// <param name="instanceCount">インスタンス数。</param>
+    virtual void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount) = 0;
+};
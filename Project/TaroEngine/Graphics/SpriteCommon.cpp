@@ -1,16 +1,43 @@
 #include "SpriteCommon.h"
+#include "PipelineCache.h"
 #include "ShaderCompiler.h"
+#include "ShaderPermutation.h"
 #include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <vector>
 #include <wrl.h>
 #include <d3d12.h>
 
 using Microsoft::WRL::ComPtr;
 
+namespace {
+
+	// SpriteFeature の並びと同じ順（添字 = ビット番号）
+	std::vector<ShaderPermutation::Feature> MakeSpriteFeatures() {
+		std::vector<ShaderPermutation::Feature> features(2);
+		features[static_cast<uint32_t>(SpriteFeature::Textured)].define = L"SPRITE_TEXTURED";
+		features[static_cast<uint32_t>(SpriteFeature::AlphaTest)].define = L"SPRITE_ALPHA_TEST";
+		return features;
+	}
+
+	bool ReadTextFile(const std::wstring &path, std::string &out) {
+		std::ifstream ifs(std::filesystem::path(path), std::ios::binary);
+		if (!ifs) return false;
+		out.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+} // namespace
+
 // ===============================
 // Public
 // ===============================
-void SpriteCommon::Initialize(ID3D12Device *device) {
+void SpriteCommon::Initialize(ID3D12Device *device, PipelineCache *pipelineCache) {
 	assert(device);
+	pipelineCache_ = pipelineCache;
 	CreateRootSignature(device);
 }
 
@@ -24,30 +51,6 @@ void SpriteCommon::CreateGraphicsPipeline(
 	const std::wstring &psEntry) {
 	assert(device && rootSignature_);
 
-	// VS / PS をコンパイル（エントリとプロファイルは引数で指定）
-	auto vsRes = compiler.CompileFromFile(vsPath, vsEntry, L"vs_6_0");
-	auto psRes = compiler.CompileFromFile(psPath, psEntry, L"ps_6_0");
-
-	// 失敗時ログ
-	if (!vsRes.succeeded) {
-		if (vsRes.errors) {
-			OutputDebugStringA(vsRes.errors->GetStringPointer());
-		} else {
-			OutputDebugStringW((L"[DXC] VS compile failed: " + vsPath + L"\n").c_str());
-		}
-		assert(false);
-		return;
-	}
-	if (!psRes.succeeded) {
-		if (psRes.errors) {
-			OutputDebugStringA(psRes.errors->GetStringPointer());
-		} else {
-			OutputDebugStringW((L"[DXC] PS compile failed: " + psPath + L"\n").c_str());
-		}
-		assert(false);
-		return;
-	}
-
 	// 入力レイアウト（POSITION(float3) + TEXCOORD(float2)）
 	D3D12_INPUT_ELEMENT_DESC elems[2] = {};
 	elems[0].SemanticName = "POSITION";
@@ -70,6 +73,127 @@ void SpriteCommon::CreateGraphicsPipeline(
 	il.pInputElementDescs = elems;
 	il.NumElements = _countof(elems);
 
+	CreatePipelineState(compiler, device, vsPath, psPath, vsEntry, psEntry,
+		il, formats, pipelines_);
+}
+
+void SpriteCommon::CreateInstancedPipeline(
+	ShaderCompiler &compiler,
+	ID3D12Device *device,
+	const std::wstring &vsPath,
+	const std::wstring &psPath,
+	const PipelineFormats &formats,
+	const std::wstring &vsEntry,
+	const std::wstring &psEntry) {
+	assert(device && rootSignature_);
+
+	// スロット0: 共有クアッド（POSITION(float2) + TEXCOORD(float2)）
+	// スロット1: インスタンス（WVP 4 行 + COLOR + UVRECT）。SpriteInstance と同じ並び
+	D3D12_INPUT_ELEMENT_DESC elems[8] = {};
+	elems[0] = {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 0,
+		D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0};
+	elems[1] = {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+		D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0};
+	for (UINT i = 0; i < 4; ++i) {
+		elems[2 + i] = {"WVP", i, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1};
+	}
+	elems[6] = {"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT,
+		D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1};
+	elems[7] = {"UVRECT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT,
+		D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1};
+
+	D3D12_INPUT_LAYOUT_DESC il{};
+	il.pInputElementDescs = elems;
+	il.NumElements = _countof(elems);
+
+	CreatePipelineState(compiler, device, vsPath, psPath, vsEntry, psEntry,
+		il, formats, instancedPipelines_);
+}
+
+void SpriteCommon::ApplyCommonDrawSettings(
+	ID3D12GraphicsCommandList *cmd,
+	D3D12_PRIMITIVE_TOPOLOGY topology,
+	uint32_t features) const {
+	assert(cmd);
+	assert(rootSignature_);
+	ID3D12PipelineState *pipelineState = pipelines_.Get(features);
+	assert(pipelineState);
+
+	cmd->SetGraphicsRootSignature(rootSignature_.Get());
+	cmd->SetPipelineState(pipelineState);
+	cmd->IASetPrimitiveTopology(topology);
+}
+
+void SpriteCommon::ApplyInstancedDrawSettings(
+	ID3D12GraphicsCommandList *cmd,
+	D3D12_PRIMITIVE_TOPOLOGY topology,
+	uint32_t features) const {
+	assert(cmd);
+	assert(rootSignature_);
+	ID3D12PipelineState *pipelineState = instancedPipelines_.Get(features);
+	assert(pipelineState);
+
+	cmd->SetGraphicsRootSignature(rootSignature_.Get());
+	cmd->SetPipelineState(pipelineState);
+	cmd->IASetPrimitiveTopology(topology);
+}
+
+// ===============================
+// Private
+// ===============================
+ID3D12PipelineState *SpriteCommon::PipelineVariants::Get(uint32_t features) const {
+	if (pipelineStates.empty()) return nullptr;
+	const uint32_t index = table.GetVariantIndex(features);
+	return (index == ShaderVariantTable::kInvalidVariant) ? nullptr : pipelineStates[index].Get();
+}
+
+void SpriteCommon::CreatePipelineState(
+	ShaderCompiler &compiler,
+	ID3D12Device *device,
+	const std::wstring &vsPath,
+	const std::wstring &psPath,
+	const std::wstring &vsEntry,
+	const std::wstring &psEntry,
+	const D3D12_INPUT_LAYOUT_DESC &inputLayout,
+	const PipelineFormats &formats,
+	PipelineVariants &outPipelines) {
+	// PS は SpriteFeature の全組み合わせをバリアントとして作る。
+	// 仮想ファイル名を psPath にするので、相対 #include は元のファイルと同じ場所から解決される
+	std::string psSource;
+	if (!ReadTextFile(psPath, psSource)) {
+		OutputDebugStringW((L"[DXC] PS source not found: " + psPath + L"\n").c_str());
+		assert(false);
+		return;
+	}
+	ShaderPermutation ps;
+	ps.Initialize(psPath, std::move(psSource), psEntry, L"ps_6_0", MakeSpriteFeatures());
+
+	// VS はワーカーへ投げ、その間に PS の全バリアントをまとめて並列コンパイル
+	ShaderCompiler::CompileRequest vsRequest;
+	vsRequest.filePath = vsPath;
+	vsRequest.entry = vsEntry;
+	vsRequest.profile = L"vs_6_0";
+	std::future<ShaderCompiler::Result> vsFuture = compiler.CompileAsync(std::move(vsRequest));
+	const bool psSucceeded = ps.CompileAll(compiler); // 失敗時のログは CompileAll が出す
+	const ShaderCompiler::Result vsRes = vsFuture.get();
+
+	// 失敗時ログ
+	if (!vsRes.succeeded) {
+		if (vsRes.errors) {
+			OutputDebugStringA(vsRes.errors->GetStringPointer());
+		} else {
+			OutputDebugStringW((L"[DXC] VS compile failed: " + vsPath + L"\n").c_str());
+		}
+		assert(false);
+		return;
+	}
+	if (!psSucceeded) {
+		OutputDebugStringW((L"[DXC] PS compile failed: " + psPath + L"\n").c_str());
+		assert(false);
+		return;
+	}
+
 	// ブレンド（必要に応じてアルファブレンド化）
 	D3D12_BLEND_DESC blend{};
 	blend.AlphaToCoverageEnable = FALSE;
@@ -101,9 +225,8 @@ void SpriteCommon::CreateGraphicsPipeline(
 	// PSO 記述子
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC pso{};
 	pso.pRootSignature = rootSignature_.Get();
-	pso.InputLayout = il;
+	pso.InputLayout = inputLayout;
 	pso.VS = {vsRes.object->GetBufferPointer(), vsRes.object->GetBufferSize()};
-	pso.PS = {psRes.object->GetBufferPointer(), psRes.object->GetBufferSize()};
 	pso.BlendState = blend;
 	pso.RasterizerState = rast;
 	pso.DepthStencilState = ds;
@@ -116,30 +239,28 @@ void SpriteCommon::CreateGraphicsPipeline(
 	pso.DSVFormat = formats.dsvFormat;
 	pso.SampleDesc.Count = 1;
 
-	// PSO 作成
-	HRESULT hr = device->CreateGraphicsPipelineState(
-		&pso, IID_PPV_ARGS(pipelineState_.ReleaseAndGetAddressOf()));
-	if (FAILED(hr)) {
-		OutputDebugStringA("[D3D12] CreateGraphicsPipelineState failed\n");
-		assert(false);
-	}
-}
+	// PS のバリアントごとに PSO を作成（キャッシュがあれば同じ記述の PSO を使い回す）
+	outPipelines.table = ps.GetTable();
+	outPipelines.pipelineStates.assign(ps.GetVariantCount(), nullptr);
+	for (uint32_t v = 0; v < ps.GetVariantCount(); ++v) {
+		IDxcBlob *psBlob = ps.GetVariantBytecode(v);
+		pso.PS = {psBlob->GetBufferPointer(), psBlob->GetBufferSize()};
 
-void SpriteCommon::ApplyCommonDrawSettings(
-	ID3D12GraphicsCommandList *cmd,
-	D3D12_PRIMITIVE_TOPOLOGY topology) const {
-	assert(cmd);
-	assert(rootSignature_);
-	assert(pipelineState_);
-
-	cmd->SetGraphicsRootSignature(rootSignature_.Get());
-	cmd->SetPipelineState(pipelineState_.Get());
-	cmd->IASetPrimitiveTopology(topology);
+		ComPtr<ID3D12PipelineState> &out = outPipelines.pipelineStates[v];
+		if (pipelineCache_) {
+			out = pipelineCache_->GetOrCreate(pso);
+			assert(out);
+			continue;
+		}
+		HRESULT hr = device->CreateGraphicsPipelineState(
+			&pso, IID_PPV_ARGS(out.ReleaseAndGetAddressOf()));
+		if (FAILED(hr)) {
+			OutputDebugStringA("[D3D12] CreateGraphicsPipelineState failed\n");
+			assert(false);
+		}
+	}
 }
 
-// ===============================
-// Private
-// ===============================
 void SpriteCommon::CreateRootSignature(ID3D12Device *device) {
 	// SRV (t0) のレンジ
 	D3D12_DESCRIPTOR_RANGE srvRange{};
@@ -210,4 +331,10 @@ void SpriteCommon::CreateRootSignature(ID3D12Device *device) {
 		OutputDebugStringA("[D3D12] CreateRootSignature failed\n");
 		assert(false);
 	}
+
+	// 内容ハッシュで登録しておくと、PSO をディスクのライブラリに残せる
+	if (pipelineCache_) {
+		pipelineCache_->RegisterRootSignature(
+			rootSignature_.Get(), sig->GetBufferPointer(), sig->GetBufferSize());
+	}
 }
@@ -1,13 +1,27 @@
 #pragma once
+#include "ShaderVariantTable.h"
+#include <cstdint>
 #include <d3d12.h>
 #include <string>
+#include <vector>
 #include <wrl.h>
 
 class ShaderCompiler; // 前方宣言
+class PipelineCache;  // 前方宣言
+
+/// <summary>
+/// スプライト PS の機能ビット（値 = ビット番号）。MakeFeatureMask で組み合わせて描画設定に渡す。
+/// </summary>
+enum class SpriteFeature : uint32_t {
+	Textured,  ///< t0 のテクスチャを色に乗算する（ルートパラメータ 2 に SRV テーブルを設定すること）
+	AlphaTest, ///< α が 0.5 未満のピクセルを捨てる
+};
 
 /// <summary>
 /// スプライト描画の「共通描画ルール」（RootSignature / PSO）を一括管理し、
-/// 毎フレームの描画前にまとめて設定できるユーティリティ。
+/// 毎フレームの描画前にまとめて設定できるユーティリティ。<br/>
+/// PS は SpriteFeature の組み合わせごとのバリアントを ShaderPermutation で作り、
+/// バリアントごとの PSO を PipelineCache 経由で用意しておく（描画時は機能マスクで表を引くだけ）。
 /// </summary>
 class SpriteCommon {
 public:
@@ -28,7 +42,8 @@ public:
 	/// 初期化処理。Device を保持し、RootSignature を作成する。
 	/// </summary>
 	/// <param name="device">Direct3D デバイス</param>
-	void Initialize(ID3D12Device *device);
+	/// <param name="pipelineCache">PSO キャッシュ（nullptr なら毎回作成する）</param>
+	void Initialize(ID3D12Device *device, PipelineCache *pipelineCache = nullptr);
 
 	/// <summary>
 	/// グラフィックスパイプライン（PSO）を生成する。
@@ -49,21 +64,67 @@ public:
 		const std::wstring &vsEntry = L"main",
 		const std::wstring &psEntry = L"main");
 
+	/// <summary>
+	/// インスタンス描画用（SpriteBatch 用）のグラフィックスパイプラインを生成する。<br/>
+	/// 入力スロット0に共有クアッド、スロット1に SpriteInstance の配列を受け取る。
+	/// </summary>
+	/// <param name="compiler">ShaderCompiler（DXC ラッパー）</param>
+	/// <param name="device">Direct3D デバイス</param>
+	/// <param name="vsPath">頂点シェーダファイルのパス</param>
+	/// <param name="psPath">ピクセルシェーダファイルのパス</param>
+	/// <param name="formats">RTV/DSV のフォーマット設定</param>
+	/// <param name="vsEntry">頂点シェーダのエントリポイント（既定: L"main"）</param>
+	/// <param name="psEntry">ピクセルシェーダのエントリポイント（既定: L"main"）</param>
+	void CreateInstancedPipeline(
+		ShaderCompiler &compiler,
+		ID3D12Device *device,
+		const std::wstring &vsPath,
+		const std::wstring &psPath,
+		const PipelineFormats &formats = {},
+		const std::wstring &vsEntry = L"main",
+		const std::wstring &psEntry = L"main");
+
 	/// <summary>
 	/// 共通の描画設定（RS/PSO/トポロジ）をコマンドリストに適用する。
 	/// </summary>
 	/// <param name="cmd">描画先のコマンドリスト</param>
 	/// <param name="topology">プリミティブトポロジ（デフォルト: 三角形リスト）</param>
+	/// <param name="features">SpriteFeature の機能マスク（MakeFeatureMask で作る）</param>
 	void ApplyCommonDrawSettings(
 		ID3D12GraphicsCommandList *cmd,
 		D3D12_PRIMITIVE_TOPOLOGY topology =
-		D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST) const;
+		D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+		uint32_t features = 0) const;
+
+	/// <summary>
+	/// インスタンス描画用の描画設定（RS/PSO/トポロジ）をコマンドリストに適用する。
+	/// </summary>
+	/// <param name="cmd">描画先のコマンドリスト</param>
+	/// <param name="topology">プリミティブトポロジ（デフォルト: 三角形リスト）</param>
+	/// <param name="features">SpriteFeature の機能マスク（MakeFeatureMask で作る）</param>
+	void ApplyInstancedDrawSettings(
+		ID3D12GraphicsCommandList *cmd,
+		D3D12_PRIMITIVE_TOPOLOGY topology =
+		D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+		uint32_t features = 0) const;
 
 	/// <summary>作成済みの RootSignature を取得する。</summary>
 	ID3D12RootSignature *GetRootSignature() const { return rootSignature_.Get(); }
 
-	/// <summary>作成済みの PipelineState を取得する。</summary>
-	ID3D12PipelineState *GetPipelineState() const { return pipelineState_.Get(); }
+	/// <summary>作成済みの PipelineState を機能マスクから取得する（無ければ nullptr）。</summary>
+	ID3D12PipelineState *GetPipelineState(uint32_t features = 0) const { return pipelines_.Get(features); }
+
+private:
+	/// <summary>
+	/// PS の機能バリアントごとの PSO。機能マスク → バリアント番号 → PSO の順に引く。
+	/// </summary>
+	struct PipelineVariants {
+		ShaderVariantTable table; ///< 機能マスク → バリアント番号
+		std::vector<Microsoft::WRL::ComPtr<ID3D12PipelineState>> pipelineStates; ///< バリアント番号 → PSO
+
+		/// <summary>機能マスクから PSO を引く（未作成・無効な組み合わせなら nullptr）。</summary>
+		ID3D12PipelineState *Get(uint32_t features) const;
+	};
 
 private:
 	/// <summary>
@@ -72,9 +133,35 @@ private:
 	/// <param name="device">	Direct3D デバイス</param>
 	void CreateRootSignature(ID3D12Device *device);
 
+	/// <summary>
+	/// VS と PS の全機能バリアントをコンパイルし、共通のブレンド/ラスタライザ/深度設定で
+	/// バリアントごとの PSO を作成する。
+	/// </summary>
+	/// <param name="compiler">ShaderCompiler（DXC ラッパー）</param>
+	/// <param name="device">Direct3D デバイス</param>
+	/// <param name="vsPath">頂点シェーダファイルのパス</param>
+	/// <param name="psPath">ピクセルシェーダファイルのパス</param>
+	/// <param name="vsEntry">頂点シェーダのエントリポイント</param>
+	/// <param name="psEntry">ピクセルシェーダのエントリポイント</param>
+	/// <param name="inputLayout">入力レイアウト</param>
+	/// <param name="formats">RTV/DSV のフォーマット設定</param>
+	/// <param name="outPipelines">作成した PSO の格納先</param>
+	void CreatePipelineState(
+		ShaderCompiler &compiler,
+		ID3D12Device *device,
+		const std::wstring &vsPath,
+		const std::wstring &psPath,
+		const std::wstring &vsEntry,
+		const std::wstring &psEntry,
+		const D3D12_INPUT_LAYOUT_DESC &inputLayout,
+		const PipelineFormats &formats,
+		PipelineVariants &outPipelines);
+
 private:
 	ID3D12Device *device_ = nullptr; ///< D3D12 デバイス（借用）
+	PipelineCache *pipelineCache_ = nullptr; ///< PSO キャッシュ（借用・任意）
 
 	Microsoft::WRL::ComPtr<ID3D12RootSignature>	rootSignature_; ///< ルートシグネチャ
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_; ///< パイプラインステート
+	PipelineVariants pipelines_;          ///< パイプラインステート（機能バリアントごと）
+	PipelineVariants instancedPipelines_; ///< インスタンス描画用パイプラインステート（機能バリアントごと）
 };
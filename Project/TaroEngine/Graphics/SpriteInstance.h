@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector4.h"
+
+/// <summary>
+/// インスタンス描画 1 件ぶんのデータ（頂点入力スロット1に並べる）。<br/>
+/// 並びは SpriteCommon::CreateInstancedPipeline の入力レイアウトと一致させること。
+/// </summary>
+struct SpriteInstance {
+  Matrix4x4 wvp;  ///< サイズ込みのワールド×ビュー×射影（行メジャーのまま送る）
+  Vector4 color;  ///< 乗算カラー
+  Vector4 uvRect; ///< UV 矩形 (u0, v0, u1, v1)
+};
+
+static_assert(sizeof(SpriteInstance) == 96, "SpriteInstance layout must match the instanced input layout");
@@ -0,0 +1,40 @@
+#include "TransformBatch.h"
+#include "MatrixUtil.h"
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+    // 1 件ぶんを計算して書き込む。
+    // 出力先は Write-Combined な Upload ヒープであることが多いので、
+    // 読み戻しをせず、1 レコードを連続した 1 回のコピーで書き込む。
+    inline void StoreInstance(SpriteInstance *dst, const TransformBatch::SpriteStreams &in, size_t src,
+        const Matrix4x4 &viewProj) {
+        const Matrix3x2 world = MatrixUtil::MakeAffine2DMatrix(
+            in.sizeX[src], in.sizeY[src], in.rotation[src], in.positionX[src], in.positionY[src]);
+
+        SpriteInstance inst;
+        inst.wvp = MatrixUtil::MultiplyAffine2D(world, viewProj);
+        inst.color = in.color[src];
+        inst.uvRect = in.uvRect[src];
+        std::memcpy(dst, &inst, sizeof(inst));
+    }
+
+} // namespace
+
+void TransformBatch::ComputeSpriteInstances(const SpriteStreams &in, const Matrix4x4 &viewProj, SpriteInstance *out) {
+    if (in.count == 0) return;
+    assert(in.positionX && in.positionY && in.rotation && in.sizeX && in.sizeY);
+    assert(in.color && in.uvRect && out);
+
+    // 並び替えの有無でループを分け、並び替えなしの場合は全ストリームを先頭から順に読む
+    if (in.order) {
+        for (size_t i = 0; i < in.count; ++i) {
+            StoreInstance(out + i, in, in.order[i], viewProj);
+        }
+    } else {
+        for (size_t i = 0; i < in.count; ++i) {
+            StoreInstance(out + i, in, i, viewProj);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "SpriteInstance.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// 多数のオブジェクトの WVP を 1 回の呼び出しでまとめて計算するバッチカーネル群。<br/>
+/// 入力は SoA（要素ごとの連続配列）で受け取り、結果はレコードの連続配列へ書き出す。
+/// </summary>
+namespace TransformBatch {
+
+    /// <summary>
+    /// スプライトのインスタンス用の SoA 入力ストリーム（SpriteBatchBuilder が持つ）。
+    /// </summary>
+    struct SpriteStreams {
+        const float *positionX = nullptr; ///< 中心の X 座標
+        const float *positionY = nullptr; ///< 中心の Y 座標
+        const float *rotation = nullptr;  ///< Z 軸回転（ラジアン）
+        const float *sizeX = nullptr;     ///< 幅（1x1 のクアッドに掛けるスケール）
+        const float *sizeY = nullptr;     ///< 高さ
+        const Vector4 *color = nullptr;   ///< 乗算カラー
+        const Vector4 *uvRect = nullptr;  ///< UV 矩形 (u0, v0, u1, v1)
+        const uint32_t *order = nullptr;  ///< 読み出す要素番号の並び（nullptr なら 0, 1, 2, ...）
+        size_t count = 0;                 ///< 書き出す要素数
+
+        /// <summary>
+        /// 出力の [begin, end) に対応する部分ストリームを返す（区間ごとに並列に書き出す用）。
+        /// </summary>
+        SpriteStreams Slice(size_t begin, size_t end) const {
+            SpriteStreams s = *this;
+            s.count = end - begin;
+            if (order) {
+                s.order = order + begin; // 並び替え済みなら番号の列だけずらす
+            } else {
+                s.positionX += begin;
+                s.positionY += begin;
+                s.rotation += begin;
+                s.sizeX += begin;
+                s.sizeY += begin;
+                s.color += begin;
+                s.uvRect += begin;
+            }
+            return s;
+        }
+    };
+
+    /// <summary>
+    /// スプライトのインスタンスデータ（サイズ込みの WVP・色・UV 矩形）をまとめて書き出す。<br/>
+    /// WVP は MakeAffine2DMatrix(size, rotation, position) と viewProj の閉形式の積で、
+    /// Sprite::Update の WVP にサイズを畳み込んだものと一致する。
+    /// </summary>
+    /// <param name="in">SoA 入力。</param>
+    /// <param name="viewProj">View * Projection。</param>
+    /// <param name="out">出力先（in.count 要素分。Map 済みの Upload ヒープを直接渡してよい）。</param>
+    void ComputeSpriteInstances(const SpriteStreams &in, const Matrix4x4 &viewProj, SpriteInstance *out);
+
+} // namespace TransformBatch
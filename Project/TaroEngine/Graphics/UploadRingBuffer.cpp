@@ -0,0 +1,40 @@
+#include "UploadRingBuffer.h"
+#include "BufferUtil.h"
+#include <cassert>
+
+void UploadRingBuffer::Initialize(ID3D12Device *device, uint64_t capacity) {
+    assert(device);
+    assert(capacity > 0);
+
+    resource_ = BufferUtil::CreateUploadBuffer(device, static_cast<size_t>(capacity));
+
+    // Upload ヒープは Map したままでよい（CPU から読まないので読み取り範囲は空）
+    D3D12_RANGE readRange{0, 0};
+    HRESULT hr = resource_->Map(0, &readRange, reinterpret_cast<void **>(&mapped_));
+    assert(SUCCEEDED(hr));
+    (void)hr;
+
+    gpuBase_ = resource_->GetGPUVirtualAddress();
+    allocator_.Initialize(capacity);
+}
+
+UploadRingBuffer::Allocation UploadRingBuffer::Allocate(uint64_t size, uint64_t alignment) {
+    const uint64_t offset = allocator_.Allocate(size, alignment);
+    if (offset == FencedRingAllocator::kInvalidOffset) {
+        assert(false && "UploadRingBuffer: out of space (increase capacity)");
+        return {};
+    }
+
+    Allocation a;
+    a.cpu = mapped_ + offset;
+    a.gpu = gpuBase_ + offset;
+    a.resource = resource_.Get();
+    a.offset = offset;
+    a.size = size;
+    return a;
+}
+
+UploadRingBuffer::Allocation UploadRingBuffer::AllocateConstant(uint64_t size) {
+    const uint64_t aligned = BufferUtil::AlignConstantBufferSize(static_cast<UINT>(size));
+    return Allocate(aligned, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+}
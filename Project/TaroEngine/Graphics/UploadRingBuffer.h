@@ -0,0 +1,91 @@
+#pragma once
+#include "FencedRingAllocator.h"
+#include <cstdint>
+#include <cstring>
+#include <d3d12.h>
+#include <wrl.h>
+
+/// <summary>
+/// 永続 Map した 1 つの大きな Upload バッファから、
+/// フレーム内で使い捨てる定数・動的データを切り出すリングバッファ。<br/>
+/// 領域はフェンス値で管理され、そのフレームの GPU 完了後に再利用される。
+/// </summary>
+class UploadRingBuffer {
+public:
+    /// <summary>
+    /// 切り出した領域。
+    /// </summary>
+    struct Allocation {
+        void *cpu = nullptr;                   // 書き込み先（Write-Combined）
+        D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;     // GPU 仮想アドレス
+        ID3D12Resource *resource = nullptr;    // 元のリソース（借用）
+        uint64_t offset = 0;                   // リソース先頭からのオフセット
+        uint64_t size = 0;                     // 要求したバイト数
+
+        /// <summary>確保に成功したか。</summary>
+        explicit operator bool() const { return cpu != nullptr; }
+    };
+
+public:
+    /// <summary>
+    /// 初期化処理。Upload バッファを生成して永続 Map する。
+    /// </summary>
+    /// <param name="device">D3D12 デバイス。</param>
+    /// <param name="capacity">バッファ全体のバイト数。</param>
+    void Initialize(ID3D12Device *device, uint64_t capacity);
+
+    /// <summary>
+    /// 任意アライメントで領域を確保する（頂点・インスタンスデータ用）。
+    /// </summary>
+    /// <param name="size">バイト数。</param>
+    /// <param name="alignment">アライメント（2 の累乗）。</param>
+    /// <returns>確保した領域。容量不足なら空。</returns>
+    Allocation Allocate(uint64_t size, uint64_t alignment = 16);
+
+    /// <summary>
+    /// 定数バッファ用に 256B アラインで領域を確保する。
+    /// </summary>
+    /// <param name="size">バイト数（256B 単位に切り上げる）。</param>
+    /// <returns>確保した領域。容量不足なら空。</returns>
+    Allocation AllocateConstant(uint64_t size);
+
+    /// <summary>
+    /// 値をコピーして定数バッファとして確保する。
+    /// </summary>
+    /// <returns>確保した領域。容量不足なら空。</returns>
+    template <typename T>
+    Allocation PushConstant(const T &value);
+
+    /// <summary>
+    /// 現在のフレームを締める。PostDraw でフェンスをシグナルした直後に呼ぶ。
+    /// </summary>
+    /// <param name="fenceValue">シグナルしたフェンス値。</param>
+    void FinishFrame(uint64_t fenceValue) { allocator_.FinishFrame(fenceValue); }
+
+    /// <summary>
+    /// GPU 完了済みフレームの領域を解放する。PreDraw の待機後に呼ぶ。
+    /// </summary>
+    /// <param name="completedFenceValue">完了済みのフェンス値。</param>
+    void Reclaim(uint64_t completedFenceValue) { allocator_.Reclaim(completedFenceValue); }
+
+    /// <summary>全体のバイト数を取得する。</summary>
+    uint64_t GetCapacity() const { return allocator_.GetCapacity(); }
+
+    /// <summary>使用中のバイト数を取得する。</summary>
+    uint64_t GetUsedSize() const { return allocator_.GetUsedSize(); }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+    uint8_t *mapped_ = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS gpuBase_ = 0;
+    FencedRingAllocator allocator_;
+};
+
+template <typename T>
+UploadRingBuffer::Allocation UploadRingBuffer::PushConstant(const T &value) {
+    Allocation a = AllocateConstant(sizeof(T));
+    if (a) {
+        std::memcpy(a.cpu, &value, sizeof(T));
+    }
+    return a;
+}
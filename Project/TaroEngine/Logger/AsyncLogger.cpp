@@ -0,0 +1,205 @@
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <format>
+
+AsyncLogger::AsyncLogger(std::shared_ptr<ILogger> sink)
+    : AsyncLogger(std::move(sink), Options{}) {
+}
+
+AsyncLogger::AsyncLogger(std::shared_ptr<ILogger> sink, const Options &options)
+    : sink_(std::move(sink)), options_(options) {
+    assert(sink_);
+    options_.maxBatch = (std::max)(options_.maxBatch, size_t{1});
+
+    const size_t capacity = std::bit_ceil((std::max)(options_.capacity, size_t{2}));
+    options_.capacity = capacity;
+    mask_ = capacity - 1;
+    cells_ = std::make_unique<Cell[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    worker_ = std::thread([this] { WorkerMain(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+    running_.store(false, std::memory_order_release);
+    wakeSignal_.fetch_add(1, std::memory_order_release);
+    wakeSignal_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    sink_->Flush();
+}
+
+void AsyncLogger::Log(LogLevel level, const std::string &msg) {
+    Write(level, msg, std::chrono::system_clock::now());
+}
+
+void AsyncLogger::Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+    // エラーは捨てず、ディスクに届くまで待つ（直後にクラッシュしても残るように）
+    const bool mustDeliver = (level >= options_.flushLevel);
+
+    if (mustDeliver || options_.policy == OverflowPolicy::Block) {
+        PushBlocking(level, msg, time);
+    } else if (!TryPush(level, msg, time)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    WakeWorker();
+
+    if (mustDeliver) {
+        Flush();
+    }
+}
+
+void AsyncLogger::Flush() {
+    // sink の中からログを出された場合など、ワーカー自身が待つと止まってしまう
+    if (std::this_thread::get_id() == worker_.get_id()) {
+        sink_->Flush();
+        return;
+    }
+
+    const size_t target = enqueuePos_.load(std::memory_order_acquire);
+    size_t current = flushTarget_.load(std::memory_order_relaxed);
+    while (current < target &&
+        !flushTarget_.compare_exchange_weak(current, target, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+
+    wakeSignal_.fetch_add(1, std::memory_order_release);
+    wakeSignal_.notify_one();
+
+    std::unique_lock<std::mutex> lock(flushMutex_);
+    flushCv_.wait(lock, [&] { return flushedPos_.load(std::memory_order_acquire) >= target; });
+}
+
+AsyncLogger::Stats AsyncLogger::GetStats() const {
+    Stats s;
+    s.written = written_.load(std::memory_order_relaxed);
+    s.dropped = dropped_.load(std::memory_order_relaxed);
+    s.batches = batches_.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool AsyncLogger::TryPush(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = cells_[pos & mask_];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // このセルを確保できたら書き込む
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.level = level;
+                cell.time = time;
+                cell.message.assign(msg); // 容量は使い回すので、定常状態では確保が起きない
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // 満杯（ワーカーがまだ読んでいない）
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void AsyncLogger::PushBlocking(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+    for (uint32_t spin = 0; !TryPush(level, msg, time); ++spin) {
+        wakeSignal_.fetch_add(1, std::memory_order_release);
+        wakeSignal_.notify_one();
+        if (spin < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+void AsyncLogger::WakeWorker() {
+    // 書き込みの公開とワーカーの待機フラグの確認の順序を保証する（ワーカー側と対）
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (workerWaiting_.load(std::memory_order_relaxed)) {
+        wakeSignal_.fetch_add(1, std::memory_order_release);
+        wakeSignal_.notify_one();
+    }
+}
+
+size_t AsyncLogger::DrainBatch() {
+    size_t count = 0;
+    while (count < options_.maxBatch) {
+        Cell &cell = cells_[dequeuePos_ & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+            break;
+        }
+        sink_->Write(cell.level, cell.message, cell.time);
+        cell.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+        ++dequeuePos_;
+        ++count;
+    }
+    if (count > 0) {
+        written_.fetch_add(count, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void AsyncLogger::WorkerMain() {
+    bool dirty = false; // Flush していない書き込みがあるか
+
+    for (;;) {
+        // 起床通知の取りこぼし防止のため、確認より先に読んでおく
+        const uint32_t observed = wakeSignal_.load(std::memory_order_acquire);
+
+        const size_t count = DrainBatch();
+        dirty |= (count > 0);
+
+        // 捨てた件数はまとめて報告する
+        const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped_) {
+            sink_->Write(LogLevel::WARN,
+                std::format("AsyncLogger: {} messages dropped (queue full)", dropped - reportedDropped_),
+                std::chrono::system_clock::now());
+            reportedDropped_ = dropped;
+            dirty = true;
+        }
+
+        // 明示的な Flush 要求
+        const size_t target = flushTarget_.load(std::memory_order_acquire);
+        if (target > flushedPos_.load(std::memory_order_relaxed) && dequeuePos_ >= target) {
+            sink_->Flush();
+            dirty = false;
+            {
+                std::lock_guard<std::mutex> lock(flushMutex_);
+                flushedPos_.store(dequeuePos_, std::memory_order_release);
+            }
+            flushCv_.notify_all();
+        }
+
+        if (count > 0) {
+            continue; // まだ残っているかもしれない
+        }
+
+        // 空になったらまとめて Flush する
+        if (dirty) {
+            sink_->Flush();
+            dirty = false;
+        }
+
+        if (!running_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        // 眠る前にもう一度確認する（生産者側の WakeWorker と対）
+        workerWaiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const Cell &next = cells_[dequeuePos_ & mask_];
+        if (next.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+            wakeSignal_.wait(observed, std::memory_order_acquire);
+        }
+        workerWaiting_.store(false, std::memory_order_relaxed);
+    }
+}
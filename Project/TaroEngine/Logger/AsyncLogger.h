@@ -0,0 +1,173 @@
+#pragma once
+#include "ILogger.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // alignas によるパディング（キャッシュライン分離のため意図的）
+#endif
+
+/// <summary>
+/// 別のロガーへの出力をバックグラウンドスレッドで行うロガー。<br/>
+/// 呼び出し側は固定長のロックフリーなリングバッファ（多生産者・単一消費者）へ積むだけで戻り、
+/// 整形とファイル書き込みはワーカースレッドがまとめて行う。
+/// </summary>
+/// <remarks>
+/// - リングが満杯のときの挙動は OverflowPolicy で選ぶ（破棄 or 空くまで待機）。<br/>
+/// - flushLevel 以上のメッセージは破棄せず、書き出しと sink の Flush が終わるまで待ってから戻る。<br/>
+/// - 破棄した件数はワーカーが WARN としてまとめて出力する。
+/// </remarks>
+class AsyncLogger : public ILogger {
+public:
+    /// <summary>
+    /// リングが満杯のときの挙動。
+    /// </summary>
+    enum class OverflowPolicy {
+        Drop,  ///< メッセージを捨てて即座に戻る（呼び出し側を止めない）
+        Block, ///< 空きができるまで待つ（メッセージを失わない）
+    };
+
+    /// <summary>
+    /// 設定。
+    /// </summary>
+    struct Options {
+        size_t capacity = 8192;                     ///< リングの要素数（2 の累乗に切り上げる）
+        OverflowPolicy policy = OverflowPolicy::Block; ///< 満杯時の挙動
+        LogLevel flushLevel = LogLevel::ERR;        ///< このレベル以上は書き出し完了まで待つ
+        size_t maxBatch = 256;                      ///< 1 回の Flush までにまとめて書く最大件数
+    };
+
+    /// <summary>
+    /// 統計情報。
+    /// </summary>
+    struct Stats {
+        uint64_t written = 0; ///< sink に書き出した件数
+        uint64_t dropped = 0; ///< 満杯のため捨てた件数
+        uint64_t batches = 0; ///< ワーカーがまとめて書き出した回数
+    };
+
+public:
+    /// <summary>
+    /// コンストラクタ。既定の設定でワーカースレッドを起動する。
+    /// </summary>
+    /// <param name="sink">実際に出力するロガー。</param>
+    explicit AsyncLogger(std::shared_ptr<ILogger> sink);
+
+    /// <summary>
+    /// コンストラクタ。ワーカースレッドを起動する。
+    /// </summary>
+    /// <param name="sink">実際に出力するロガー。</param>
+    /// <param name="options">設定。</param>
+    AsyncLogger(std::shared_ptr<ILogger> sink, const Options &options);
+
+    /// <summary>
+    /// デストラクタ。残りのメッセージをすべて書き出してからワーカーを止める。
+    /// </summary>
+    ~AsyncLogger() override;
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    /// <summary>
+    /// メッセージをキューに積みます。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    void Log(LogLevel level, const std::string &msg) override;
+
+    /// <summary>
+    /// 記録時刻付きでメッセージをキューに積みます。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    /// <param name="time">メッセージを記録した時刻。</param>
+    void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) override;
+
+    /// <summary>
+    /// 呼び出し時点までに積まれたメッセージを書き出し、sink を Flush するまで待ちます。
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// 統計情報を取得します。
+    /// </summary>
+    Stats GetStats() const;
+
+private:
+    /// <summary>
+    /// リングの 1 要素。sequence で「書き込み可」「読み出し可」を表す。
+    /// </summary>
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point time{};
+        std::string message;
+    };
+
+    /// <summary>
+    /// リングに 1 件積む。満杯なら false。
+    /// </summary>
+    bool TryPush(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time);
+
+    /// <summary>
+    /// 空きができるまで待ってから積む。
+    /// </summary>
+    void PushBlocking(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time);
+
+    /// <summary>
+    /// 寝ているワーカーを起こす。
+    /// </summary>
+    void WakeWorker();
+
+    /// <summary>
+    /// ワーカースレッド本体。
+    /// </summary>
+    void WorkerMain();
+
+    /// <summary>
+    /// 読み出せるだけ（最大 maxBatch 件）sink に書き出す。
+    /// </summary>
+    /// <returns>書き出した件数。</returns>
+    size_t DrainBatch();
+
+private:
+    std::shared_ptr<ILogger> sink_;
+    Options options_;
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+
+    // 生産者側と消費者側で別のキャッシュラインに置く
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0; // ワーカーだけが触る
+
+    // ワーカーの起床
+    alignas(64) std::atomic<uint32_t> wakeSignal_{0};
+    std::atomic<bool> workerWaiting_{false};
+    std::atomic<bool> running_{true};
+
+    // Flush 待ち
+    std::atomic<size_t> flushTarget_{0};  // この位置まで書いたら sink を Flush する
+    std::atomic<size_t> flushedPos_{0};   // Flush 済みの位置
+    std::mutex flushMutex_;
+    std::condition_variable flushCv_;
+
+    // 統計
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> batches_{0};
+    uint64_t reportedDropped_ = 0; // ワーカーだけが触る
+
+    std::thread worker_;
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
@@ -0,0 +1,259 @@
+#include "BinaryLogDecoder.h"
+#include "BinaryLogFormat.h"
+#include "LogLevelUtil.h"
+#include "LogTimeUtil.h"
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <unordered_map>
+
+using namespace BinaryLogFormat;
+
+namespace {
+
+    /// <summary>
+    /// 範囲チェック付きの読み取りカーソル。
+    /// </summary>
+    struct Reader {
+        const uint8_t *p;
+        const uint8_t *end;
+
+        bool Has(size_t n) const { return static_cast<size_t>(end - p) >= n; }
+
+        template <class T>
+        bool Read(T &value) {
+            if (!Has(sizeof(T))) return false;
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(std::string &s) {
+            uint32_t length = 0;
+            if (!Read(length) || !Has(length)) return false;
+            s.assign(reinterpret_cast<const char *>(p), length);
+            p += length;
+            return true;
+        }
+    };
+
+    bool ReadArg(Reader &r, BinaryLogDecoder::Arg &arg) {
+        uint8_t type = 0;
+        if (!r.Read(type)) return false;
+
+        switch (static_cast<ArgType>(type)) {
+        case ArgType::Int: { int64_t v; if (!r.Read(v)) return false; arg = v; return true; }
+        case ArgType::UInt: { uint64_t v; if (!r.Read(v)) return false; arg = v; return true; }
+        case ArgType::Float: { double v; if (!r.Read(v)) return false; arg = v; return true; }
+        case ArgType::Bool: { uint8_t v; if (!r.Read(v)) return false; arg = (v != 0); return true; }
+        case ArgType::Char: { char v; if (!r.Read(v)) return false; arg = v; return true; }
+        case ArgType::String: { std::string v; if (!r.ReadString(v)) return false; arg = std::move(v); return true; }
+        default: return false;
+        }
+    }
+
+    // 書式指定なしの "{}" は std::format を通さず変換する（出力は std::format と同じ）
+    void AppendDefault(std::string &out, const BinaryLogDecoder::Arg &arg) {
+        std::visit([&](const auto &v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                out += v;
+            } else if constexpr (std::is_same_v<T, bool>) {
+                out += v ? "true" : "false";
+            } else if constexpr (std::is_same_v<T, char>) {
+                out += v;
+            } else {
+                char buf[64];
+                auto result = std::to_chars(buf, buf + sizeof(buf), v);
+                out.append(buf, result.ptr);
+            }
+        }, arg);
+    }
+
+    void AppendWithSpec(std::string &out, const BinaryLogDecoder::Arg &arg, std::string_view spec) {
+        const std::string fmt = "{:" + std::string(spec) + "}";
+        try {
+            std::visit([&](const auto &v) {
+                out += std::vformat(fmt, std::make_format_args(v));
+            }, arg);
+        } catch (const std::format_error &) {
+            out += "{?}";
+        }
+    }
+
+} // namespace
+
+std::string BinaryLogDecoder::FormatMessage(std::string_view format, const std::vector<Arg> &args) {
+    std::string out;
+    out.reserve(format.size() + args.size() * 8);
+    size_t nextArg = 0;
+
+    for (size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        if (c == '}') {
+            if (i + 1 < format.size() && format[i + 1] == '}') ++i;
+            out += '}';
+            continue;
+        }
+        if (c != '{') {
+            out += c;
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '{') {
+            out += '{';
+            ++i;
+            continue;
+        }
+
+        const size_t close = format.find('}', i + 1);
+        if (close == std::string_view::npos) {
+            out.append(format.substr(i)); // 閉じていない "{" はそのまま
+            break;
+        }
+
+        // "{index:spec}" を分解する
+        std::string_view field = format.substr(i + 1, close - i - 1);
+        std::string_view spec;
+        const size_t colon = field.find(':');
+        if (colon != std::string_view::npos) {
+            spec = field.substr(colon + 1);
+            field = field.substr(0, colon);
+        }
+        size_t index = nextArg++;
+        if (!field.empty()) {
+            std::from_chars(field.data(), field.data() + field.size(), index);
+        }
+
+        if (index >= args.size()) {
+            out += "{missing}";
+        } else if (spec.empty()) {
+            AppendDefault(out, args[index]);
+        } else {
+            AppendWithSpec(out, args[index], spec);
+        }
+        i = close;
+    }
+    return out;
+}
+
+bool BinaryLogDecoder::Decode(const uint8_t *data, size_t size, std::vector<Entry> &out, std::string *error) {
+    auto fail = [&](const char *reason) {
+        if (error) *error = reason;
+        return false;
+    };
+
+    Reader r{data, data + size};
+    std::unordered_map<uint32_t, std::string> formats;
+    std::vector<Arg> args;
+    bool inSession = false;
+    uint32_t session = 0;
+    uint64_t ticksPerSecond = 1;
+    uint64_t startTicks = 0;
+    int64_t startUnixNs = 0;
+
+    while (r.p < r.end) {
+        uint8_t type = 0;
+        r.Read(type);
+
+        switch (static_cast<RecordType>(type)) {
+        case RecordType::Session: {
+            uint32_t magic = 0;
+            uint16_t version = 0;
+            if (!r.Read(magic) || !r.Read(version) || !r.Read(ticksPerSecond) ||
+                !r.Read(startTicks) || !r.Read(startUnixNs)) {
+                return fail("truncated session record");
+            }
+            if (magic != kMagic) return fail("bad magic");
+            if (version != kVersion) return fail("unsupported version");
+            if (ticksPerSecond == 0) return fail("bad tick frequency");
+            if (inSession) ++session;
+            inSession = true;
+            formats.clear();
+            formats[kTextFormatId] = "{}";
+            break;
+        }
+        case RecordType::FormatDef: {
+            uint32_t id = 0;
+            std::string fmt;
+            if (!r.Read(id) || !r.ReadString(fmt)) return fail("truncated format record");
+            formats[id] = std::move(fmt);
+            break;
+        }
+        case RecordType::Message: {
+            if (!inSession) return fail("message before session record");
+            uint32_t id = 0;
+            uint8_t level = 0;
+            uint64_t ticks = 0;
+            uint8_t argCount = 0;
+            if (!r.Read(id) || !r.Read(level) || !r.Read(ticks) || !r.Read(argCount)) {
+                return fail("truncated message record");
+            }
+            args.clear();
+            for (uint8_t a = 0; a < argCount; ++a) {
+                Arg arg;
+                if (!ReadArg(r, arg)) return fail("truncated or unknown argument");
+                args.push_back(std::move(arg));
+            }
+
+            auto it = formats.find(id);
+            if (it == formats.end()) return fail("message references undefined format");
+
+            // tick → 時刻（セッション開始時刻からの経過で復元する）
+            const int64_t deltaTicks = static_cast<int64_t>(ticks - startTicks);
+            const int64_t deltaNs = static_cast<int64_t>(
+                static_cast<long double>(deltaTicks) * 1'000'000'000.0L / static_cast<long double>(ticksPerSecond));
+
+            Entry e;
+            e.session = session;
+            e.level = static_cast<LogLevel>(level);
+            e.time = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(startUnixNs + deltaNs)));
+            e.message = FormatMessage(it->second, args);
+            out.push_back(std::move(e));
+            break;
+        }
+        default:
+            return fail("unknown record type");
+        }
+    }
+    return true;
+}
+
+bool BinaryLogDecoder::DecodeFile(const std::filesystem::path &path, std::vector<Entry> &out, std::string *error) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        if (error) *error = "cannot open " + path.string();
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    return Decode(data.data(), data.size(), out, error);
+}
+
+bool BinaryLogDecoder::DecodeFileToText(const std::filesystem::path &inputPath,
+    const std::filesystem::path &outputPath, std::string *error) {
+    std::vector<Entry> entries;
+    const bool complete = DecodeFile(inputPath, entries, error);
+
+    std::ofstream ofs(outputPath, std::ios::trunc);
+    if (!ofs) {
+        if (error) *error = "cannot open " + outputPath.string();
+        return false;
+    }
+
+    uint32_t session = UINT32_MAX;
+    for (const auto &e : entries) {
+        if (e.session != session) {
+            session = e.session;
+            ofs << "===== Log session " << session << " started at " << LogTimeUtil::Format(e.time) << " =====\n";
+        }
+        ofs << FormatLine(e) << '\n';
+    }
+    return complete;
+}
+
+std::string BinaryLogDecoder::FormatLine(const Entry &entry) {
+    return std::format("[{}] [{:<5}] {}", LogTimeUtil::Format(entry.time),
+        LogLevelUtil::ToString(entry.level), entry.message);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "LogLevel.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+/// <summary>
+/// BinaryLogger が書き出したバイナリログを読み、テキストに復元するデコーダ。
+/// </summary>
+/// <remarks>
+/// 出力は FileLogger と同じ "[HH:MM:SS] [LEVEL] message" 形式。
+/// 末尾のレコードが途中で切れている場合（書き込み中のクラッシュなど）は、そこまでを復元して false を返す。
+/// </remarks>
+class BinaryLogDecoder {
+public:
+    /// <summary>
+    /// 引数 1 つ分の値。
+    /// </summary>
+    using Arg = std::variant<int64_t, uint64_t, double, std::string, bool, char>;
+
+    /// <summary>
+    /// 復元したログ 1 件。
+    /// </summary>
+    struct Entry {
+        uint32_t session = 0; ///< ファイル内のセッション番号（0 始まり）
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point time{};
+        std::string message;
+    };
+
+public:
+    /// <summary>
+    /// メモリ上のバイナリログを復元する。
+    /// </summary>
+    /// <param name="data">ファイルの内容。</param>
+    /// <param name="size">バイト数。</param>
+    /// <param name="out">復元したログの追加先。</param>
+    /// <param name="error">失敗時の理由（省略可）。</param>
+    /// <returns>最後まで読めたら true。</returns>
+    static bool Decode(const uint8_t *data, size_t size, std::vector<Entry> &out, std::string *error = nullptr);
+
+    /// <summary>
+    /// バイナリログファイルを復元する。
+    /// </summary>
+    static bool DecodeFile(const std::filesystem::path &path, std::vector<Entry> &out, std::string *error = nullptr);
+
+    /// <summary>
+    /// バイナリログファイルをテキストログに変換する。
+    /// </summary>
+    /// <param name="inputPath">BinaryLogger の出力ファイル。</param>
+    /// <param name="outputPath">書き出すテキストファイル。</param>
+    /// <param name="error">失敗時の理由（省略可）。</param>
+    /// <returns>最後まで変換できたら true（途中で切れていても、読めた分は書き出す）。</returns>
+    static bool DecodeFileToText(const std::filesystem::path &inputPath, const std::filesystem::path &outputPath,
+        std::string *error = nullptr);
+
+    /// <summary>
+    /// 1 件を FileLogger と同じ形式の 1 行にする（改行なし）。
+    /// </summary>
+    static std::string FormatLine(const Entry &entry);
+
+    /// <summary>
+    /// 書式文字列に引数を埋め込む（"{}"・"{0}"・"{:spec}"・"{{" / "}}" に対応）。
+    /// </summary>
+    /// <param name="format">書式文字列。</param>
+    /// <param name="args">引数。</param>
+    /// <returns>整形結果。</returns>
+    static std::string FormatMessage(std::string_view format, const std::vector<Arg> &args);
+};
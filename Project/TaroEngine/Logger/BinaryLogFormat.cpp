@@ -0,0 +1,40 @@
+#include "BinaryLogFormat.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+    /// <summary>
+    /// プロセス全体の書式文字列表。
+    /// </summary>
+    struct FormatRegistry {
+        std::mutex mutex;
+        std::unordered_map<std::string, uint32_t> ids;
+        std::vector<std::string> formats{"{}"}; // ID 0 は整形済み文字列用
+
+        static FormatRegistry &Get() {
+            static FormatRegistry instance;
+            return instance;
+        }
+    };
+
+} // namespace
+
+uint32_t BinaryLogFormat::RegisterFormat(std::string_view format) {
+    auto &reg = FormatRegistry::Get();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    auto it = reg.ids.find(std::string(format));
+    if (it != reg.ids.end()) return it->second;
+
+    const uint32_t id = static_cast<uint32_t>(reg.formats.size());
+    reg.formats.emplace_back(format);
+    reg.ids.emplace(std::string(format), id);
+    return id;
+}
+
+std::string BinaryLogFormat::GetFormat(uint32_t id) {
+    auto &reg = FormatRegistry::Get();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return id < reg.formats.size() ? reg.formats[id] : std::string();
+}
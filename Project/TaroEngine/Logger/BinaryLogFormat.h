@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// バイナリログ（BinaryLogger / BinaryLogDecoder）の共通定義。
+/// </summary>
+/// <remarks>
+/// ファイルはレコードの列（値はすべてリトルエンディアン）。
+/// <code>
+/// Session   : u8 type=1, u32 magic "TLOG", u16 version, u64 ticksPerSecond, u64 startTicks, i64 startUnixNs
+/// FormatDef : u8 type=2, u32 id, u32 length, char[length]
+/// Message   : u8 type=3, u32 id, u8 level, u64 ticks, u8 argCount, Arg[argCount]
+/// Arg       : u8 ArgType, 値（Int/UInt/Float は 8 バイト、Bool/Char は 1 バイト、String は u32 length + char[length]）
+/// </code>
+/// 書式 ID はセッションごとに、最初に使われた時点で FormatDef として書き出される。
+/// ID 0 は常に "{}"（ILogger::Log で渡された整形済み文字列用）。
+/// </remarks>
+namespace BinaryLogFormat {
+
+    constexpr uint32_t kMagic = 0x474F4C54; // "TLOG"
+    constexpr uint16_t kVersion = 1;
+    constexpr uint32_t kTextFormatId = 0;   // "{}"
+
+    /// <summary>レコード種別。</summary>
+    enum class RecordType : uint8_t {
+        Session = 1,
+        FormatDef = 2,
+        Message = 3,
+    };
+
+    /// <summary>引数の型タグ。</summary>
+    enum class ArgType : uint8_t {
+        Int = 1,
+        UInt = 2,
+        Float = 3,
+        String = 4,
+        Bool = 5,
+        Char = 6,
+    };
+
+    /// <summary>
+    /// 書式文字列をテンプレート引数として渡すための型（呼び出し箇所ごとに ID を 1 回だけ登録する）。
+    /// </summary>
+    template <size_t N>
+    struct Literal {
+        char value[N]{};
+
+        constexpr Literal(const char (&s)[N]) {
+            for (size_t i = 0; i < N; ++i) value[i] = s[i];
+        }
+    };
+
+    /// <summary>
+    /// 書式文字列をプロセス全体の表に登録し、ID を返す（同じ文字列なら同じ ID）。スレッドセーフ。
+    /// </summary>
+    /// <param name="format">書式文字列（std::format と同じ "{}" 記法）。</param>
+    /// <returns>書式 ID。</returns>
+    uint32_t RegisterFormat(std::string_view format);
+
+    /// <summary>
+    /// ID から書式文字列を取得する。
+    /// </summary>
+    /// <param name="id">書式 ID。</param>
+    /// <returns>書式文字列（未登録なら空）。</returns>
+    std::string GetFormat(uint32_t id);
+
+    // ===============================
+    // エンコード
+    // ===============================
+
+    template <class T>
+    inline void AppendPod(std::vector<uint8_t> &out, const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    inline void AppendString(std::vector<uint8_t> &out, std::string_view s) {
+        AppendPod(out, static_cast<uint32_t>(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    /// <summary>
+    /// 引数 1 つを型タグ付きで書き込む。
+    /// </summary>
+    template <class T>
+    inline void AppendArg(std::vector<uint8_t> &out, const T &value) {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            out.push_back(static_cast<uint8_t>(ArgType::Bool));
+            out.push_back(value ? 1 : 0);
+        } else if constexpr (std::is_same_v<U, char>) {
+            out.push_back(static_cast<uint8_t>(ArgType::Char));
+            out.push_back(static_cast<uint8_t>(value));
+        } else if constexpr (std::is_enum_v<U>) {
+            AppendArg(out, static_cast<std::underlying_type_t<U>>(value));
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            out.push_back(static_cast<uint8_t>(ArgType::Int));
+            AppendPod(out, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<U>) {
+            out.push_back(static_cast<uint8_t>(ArgType::UInt));
+            AppendPod(out, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<U>) {
+            out.push_back(static_cast<uint8_t>(ArgType::Float));
+            AppendPod(out, static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const U &, std::string_view>) {
+            out.push_back(static_cast<uint8_t>(ArgType::String));
+            AppendString(out, std::string_view(value));
+        } else if constexpr (std::is_pointer_v<U>) {
+            out.push_back(static_cast<uint8_t>(ArgType::UInt));
+            AppendPod(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        } else {
+            static_assert(sizeof(U) == 0, "BinaryLogger: unsupported argument type");
+        }
+    }
+
+} // namespace BinaryLogFormat
@@ -0,0 +1,92 @@
+#include "BinaryLogger.h"
+
+using namespace BinaryLogFormat;
+
+BinaryLogger::BinaryLogger(const std::string &filePath, size_t bufferBytes)
+    : ofs_(filePath, std::ios::binary | std::ios::app), bufferBytes_(bufferBytes) {
+    buffer_.reserve(bufferBytes_ + 256);
+    definedFormats_.assign(1, true); // ID 0 はデコーダ側で既知
+
+    startTicks_ = NowTicks();
+    startTime_ = std::chrono::system_clock::now();
+
+    if (!ofs_.is_open()) return;
+
+    // セッションレコード（以降の tick を時刻に戻すための基準）
+    using Ticks = std::chrono::steady_clock::period;
+    buffer_.push_back(static_cast<uint8_t>(RecordType::Session));
+    AppendPod(buffer_, kMagic);
+    AppendPod(buffer_, kVersion);
+    AppendPod(buffer_, static_cast<uint64_t>(Ticks::den / Ticks::num));
+    AppendPod(buffer_, startTicks_);
+    AppendPod(buffer_, static_cast<int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(startTime_.time_since_epoch()).count()));
+    FlushBuffer();
+    ofs_.flush();
+}
+
+BinaryLogger::~BinaryLogger() {
+    Flush();
+}
+
+void BinaryLogger::Log(LogLevel level, const std::string &msg) {
+    Write(level, msg, std::chrono::system_clock::now());
+}
+
+void BinaryLogger::Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+    // 記録時刻を tick に換算する（AsyncLogger 越しなど、呼び出し時刻と異なる場合がある）
+    const auto elapsed = std::chrono::duration_cast<std::chrono::steady_clock::duration>(time - startTime_);
+    const uint64_t ticks = startTicks_ + static_cast<uint64_t>(elapsed.count());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ofs_.is_open()) return;
+    BeginMessage(kTextFormatId, level, ticks, 1);
+    AppendArg(buffer_, msg);
+    EndMessage(level);
+}
+
+void BinaryLogger::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ofs_.is_open()) return;
+    FlushBuffer();
+    ofs_.flush();
+}
+
+uint64_t BinaryLogger::NowTicks() {
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+void BinaryLogger::BeginMessage(uint32_t formatId, LogLevel level, uint64_t ticks, uint8_t argCount) {
+    // 書式はセッション内で最初に使われたときだけ定義を書く
+    if (formatId >= definedFormats_.size()) {
+        definedFormats_.resize(formatId + 1, false);
+    }
+    if (!definedFormats_[formatId]) {
+        buffer_.push_back(static_cast<uint8_t>(RecordType::FormatDef));
+        AppendPod(buffer_, formatId);
+        AppendString(buffer_, GetFormat(formatId));
+        definedFormats_[formatId] = true;
+    }
+
+    buffer_.push_back(static_cast<uint8_t>(RecordType::Message));
+    AppendPod(buffer_, formatId);
+    buffer_.push_back(static_cast<uint8_t>(level));
+    AppendPod(buffer_, ticks);
+    buffer_.push_back(argCount);
+}
+
+void BinaryLogger::EndMessage(LogLevel level) {
+    if (level >= LogLevel::ERR) {
+        // エラー直後に落ちても残るよう、すぐにディスクへ送る
+        FlushBuffer();
+        ofs_.flush();
+    } else if (buffer_.size() >= bufferBytes_) {
+        FlushBuffer();
+    }
+}
+
+void BinaryLogger::FlushBuffer() {
+    if (buffer_.empty()) return;
+    ofs_.write(reinterpret_cast<const char *>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
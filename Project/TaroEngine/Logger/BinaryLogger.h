@@ -0,0 +1,118 @@
+#pragma once
+#include "BinaryLogFormat.h"
+#include "ILogger.h"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// ログを整形せずにバイナリで書き出すロガー。<br/>
+/// 書式 ID・レベル・時刻（steady_clock の tick）・引数の生の値だけを記録し、
+/// 文字列化は BinaryLogDecoder で後から行う。
+/// </summary>
+/// <remarks>
+/// 高頻度のログは Logf を使う（書式は呼び出し箇所ごとに 1 回だけ登録され、以降は ID で記録する）。
+/// <code>
+/// binaryLogger->Logf&lt;"spawn id={} pos=({:.1f}, {:.1f})"&gt;(LogLevel::DEBUG, id, x, y);
+/// </code>
+/// ILogger::Log で渡された文字列は書式 "{}" の引数として記録するので、MultiLogger にもそのまま追加できる。
+/// </remarks>
+class BinaryLogger : public ILogger {
+public:
+    /// <summary>
+    /// コンストラクタ。ファイルを追記モードで開き、セッションレコードを書き込む。
+    /// </summary>
+    /// <param name="filePath">出力先のファイルパス（例: Generated/Logs/app.tlog）。</param>
+    /// <param name="bufferBytes">ファイルへ書き出すまでに溜めるバイト数。</param>
+    explicit BinaryLogger(const std::string &filePath, size_t bufferBytes = 64 * 1024);
+
+    /// <summary>
+    /// デストラクタ。残りのバッファを書き出す。
+    /// </summary>
+    ~BinaryLogger() override;
+
+    BinaryLogger(const BinaryLogger &) = delete;
+    BinaryLogger &operator=(const BinaryLogger &) = delete;
+
+    /// <summary>
+    /// 整形済みの文字列を記録します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    void Log(LogLevel level, const std::string &msg) override;
+
+    /// <summary>
+    /// 記録時刻を指定して整形済みの文字列を記録します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    /// <param name="time">メッセージを記録した時刻。</param>
+    void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) override;
+
+    /// <summary>
+    /// バッファをファイルへ書き出します。
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// 書式と引数を整形せずに記録します。
+    /// </summary>
+    /// <typeparam name="Format">書式文字列（std::format と同じ記法）。</typeparam>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="args">引数（整数・浮動小数・bool・char・文字列・列挙型・ポインタ）。</param>
+    template <BinaryLogFormat::Literal Format, class... Args>
+    void Logf(LogLevel level, const Args &...args) {
+        static const uint32_t id = BinaryLogFormat::RegisterFormat(Format.value);
+        LogId(level, id, args...);
+    }
+
+    /// <summary>
+    /// 登録済みの書式 ID と引数を記録します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="formatId">BinaryLogFormat::RegisterFormat で得た ID。</param>
+    /// <param name="args">引数。</param>
+    template <class... Args>
+    void LogId(LogLevel level, uint32_t formatId, const Args &...args) {
+        static_assert(sizeof...(Args) <= 255, "BinaryLogger: too many arguments");
+        if (!IsEnabled(level)) return;
+        const uint64_t ticks = NowTicks();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ofs_.is_open()) return;
+        BeginMessage(formatId, level, ticks, static_cast<uint8_t>(sizeof...(Args)));
+        (BinaryLogFormat::AppendArg(buffer_, args), ...);
+        EndMessage(level);
+    }
+
+    /// <summary>
+    /// ファイルが正常に開けているかを確認します。
+    /// </summary>
+    /// <returns>開けている場合 true。</returns>
+    bool IsOpen() const { return ofs_.is_open(); }
+
+private:
+    /// <summary>現在の steady_clock の tick を取得する。</summary>
+    static uint64_t NowTicks();
+
+    /// <summary>メッセージレコードの先頭を書く（未出力の書式なら定義も書く）。mutex_ を保持して呼ぶ。</summary>
+    void BeginMessage(uint32_t formatId, LogLevel level, uint64_t ticks, uint8_t argCount);
+
+    /// <summary>レコードを書き終えた後の処理（溜まるか ERR ならファイルへ）。mutex_ を保持して呼ぶ。</summary>
+    void EndMessage(LogLevel level);
+
+    /// <summary>バッファをファイルへ書き出す。mutex_ を保持して呼ぶ。</summary>
+    void FlushBuffer();
+
+private:
+    std::ofstream ofs_;
+    std::mutex mutex_;
+    std::vector<uint8_t> buffer_;
+    size_t bufferBytes_ = 0;
+    std::vector<bool> definedFormats_; // このセッションで FormatDef を書いた ID
+
+    // セッション開始時点の時刻（system_clock ⇔ tick の変換用）
+    uint64_t startTicks_ = 0;
+    std::chrono::system_clock::time_point startTime_{};
+};
@@ -1,8 +1,8 @@
 #include "FileLogger.h"
-#include <format>
+#include "LogLineUtil.h"
 
-FileLogger::FileLogger(const std::string &filePath)
-    : filePath_(filePath), ofs_(filePath, std::ios::app)
+FileLogger::FileLogger(const std::string &filePath, bool autoFlush)
+    : ofs_(filePath, std::ios::app), filePath_(filePath), autoFlush_(autoFlush)
 {
     if (ofs_.is_open()) {
         ofs_ << "===== Log session started at "
@@ -21,18 +21,39 @@ FileLogger::~FileLogger() {
 }
 
 void FileLogger::Log(LogLevel level, const std::string &msg) {
+    Write(level, msg, std::chrono::system_clock::now());
+}
+
+void FileLogger::Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!ofs_.is_open()) return;
 
-    std::string timeStr = LogTimeUtil::GetCurrentTimeString();
-    const char *levelStr = LogLevelUtil::ToString(level);
+    line_.clear();
+    LogLineUtil::AppendLine(line_, level, msg, time, precision_, includeTicks_);
 
-    std::string formatted = std::format("[{}] [{:<5}] {}\n", timeStr, levelStr, msg);
+    ofs_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    if (autoFlush_ || level >= LogLevel::ERR) {
+        ofs_.flush();
+    }
+}
 
-    ofs_ << formatted;
-    ofs_.flush(); 
+void FileLogger::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ofs_.is_open()) {
+        ofs_.flush();
+    }
 }
 
 bool FileLogger::IsOpen() const {
     return ofs_.is_open();
 }
+
+void FileLogger::SetTimePrecision(LogTimeUtil::Precision precision) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    precision_ = precision;
+}
+
+void FileLogger::SetIncludeTicks(bool enable) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    includeTicks_ = enable;
+}
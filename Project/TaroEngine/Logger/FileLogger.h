@@ -15,7 +15,11 @@ public:
     /// コンストラクタ。
     /// </summary>
     /// <param name="filePath">出力先のファイルパス。</param>
-    explicit FileLogger(const std::string &filePath);
+    /// <param name="autoFlush">
+    /// true なら 1 行ごとに flush する。AsyncLogger 越しに使う場合は false にし、
+    /// バッチ単位の Flush に任せる（ERR 以上は常に flush する）。
+    /// </param>
+    explicit FileLogger(const std::string &filePath, bool autoFlush = true);
 
     /// <summary>
     /// デストラクタ。
@@ -29,14 +33,43 @@ public:
     /// <param name="msg">出力するメッセージ。</param>
     void Log(LogLevel level, const std::string &msg) override;
 
+    /// <summary>
+    /// 記録時刻を指定してログを出力します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    /// <param name="time">メッセージを記録した時刻。</param>
+    void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) override;
+
+    /// <summary>
+    /// ファイルへの書き出しを確定します。
+    /// </summary>
+    void Flush() override;
+
     /// <summary>
     /// ファイルが正常に開けているかを確認します。
     /// </summary>
     /// <returns>開けている場合 true。</returns>
     bool IsOpen() const;
 
+    /// <summary>
+    /// 時刻の秒未満の表示精度を設定します（既定は秒まで）。
+    /// </summary>
+    /// <param name="precision">表示精度。</param>
+    void SetTimePrecision(LogTimeUtil::Precision precision);
+
+    /// <summary>
+    /// 各行に単調増加の tick（steady_clock）を併記するかを設定します。
+    /// </summary>
+    /// <param name="enable">併記するなら true。</param>
+    void SetIncludeTicks(bool enable);
+
 private:
     std::ofstream ofs_;
     std::mutex mutex_;
     std::string filePath_;
+    bool autoFlush_ = true;
+    LogTimeUtil::Precision precision_ = LogTimeUtil::Precision::Seconds;
+    bool includeTicks_ = false;
+    std::string line_; // 1 行分の作業バッファ（容量を使い回す）
 };
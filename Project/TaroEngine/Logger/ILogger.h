@@ -1,10 +1,17 @@
 #pragma once
 #include "LogLevel.h"
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <string_view>
 
 /// <summary>
 /// ロガーの共通インターフェイス。
 /// </summary>
+/// <remarks>
+/// 各ロガーは実行時の出力下限（SetMinLevel）を持つ。下限の判定は配信する側
+/// （MultiLogger や、ロガーを直接呼ぶコード）が IsEnabled で行う。
+/// </remarks>
 class ILogger {
 public:
     /// <summary>
@@ -18,4 +25,43 @@ public:
     /// <param name="level">ログレベル。</param>
     /// <param name="msg">出力するメッセージ文字列。</param>
     virtual void Log(LogLevel level, const std::string &msg) = 0;
+
+    /// <summary>
+    /// 記録時刻を指定してメッセージを出力します。<br/>
+    /// 非同期ロガーのように、記録した時刻と実際に書き出す時刻が異なる場合に使います。
+    /// 既定では時刻を無視して Log に転送します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ文字列。</param>
+    /// <param name="time">メッセージを記録した時刻。</param>
+    virtual void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+        (void)time;
+        Log(level, std::string(msg));
+    }
+
+    /// <summary>
+    /// バッファリングされている出力を書き出します（既定では何もしません）。
+    /// </summary>
+    virtual void Flush() {}
+
+    /// <summary>
+    /// このロガーが出力する最低レベルを設定します（既定は DEBUG）。スレッドセーフ。
+    /// </summary>
+    /// <param name="level">これ未満のレベルは出力しない。</param>
+    void SetMinLevel(LogLevel level) { minLevel_.store(level, std::memory_order_relaxed); }
+
+    /// <summary>
+    /// このロガーが出力する最低レベルを取得します。
+    /// </summary>
+    LogLevel GetMinLevel() const { return minLevel_.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// 指定レベルのメッセージをこのロガーが受け付けるかを返します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <returns>受け付けるなら true。</returns>
+    bool IsEnabled(LogLevel level) const { return level >= minLevel_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<LogLevel> minLevel_{LogLevel::DEBUG};
 };
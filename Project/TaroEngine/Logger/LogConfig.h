@@ -0,0 +1,52 @@
+#pragma once
+#include "LogLevel.h"
+
+// ===============================
+// コンパイル時のログレベル下限
+// ===============================
+// TARO_LOG_MIN_LEVEL 未満のレベルは TARO_LOG_* マクロごと消える（引数も評価されない）。
+// 0=DEBUG, 1=INFO, 2=WARN, 3=ERR。未定義ならデバッグビルドは DEBUG、リリースビルドは INFO。
+
+#if !defined(TARO_LOG_MIN_LEVEL)
+#if defined(NDEBUG)
+#define TARO_LOG_MIN_LEVEL 1
+#else
+#define TARO_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+namespace LogConfig {
+
+    /// <summary>
+    /// コンパイル時に有効なログレベルの下限。
+    /// </summary>
+    constexpr LogLevel kMinLevel = static_cast<LogLevel>(TARO_LOG_MIN_LEVEL);
+
+    /// <summary>
+    /// 指定レベルのログがビルドに含まれるかを返す。
+    /// </summary>
+    constexpr bool IsCompiledIn(LogLevel level) { return level >= kMinLevel; }
+
+} // namespace LogConfig
+
+// 使い方: TARO_LOG_INFO(*engine.multiLogger, "loaded {} sprites", count);
+// logger は Logf(LogLevel, std::format_string, ...) を持つもの（MultiLogger）。
+#if TARO_LOG_MIN_LEVEL <= 0
+#define TARO_LOG_DEBUG(logger, ...) (logger).Logf(LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define TARO_LOG_DEBUG(logger, ...) ((void)0)
+#endif
+
+#if TARO_LOG_MIN_LEVEL <= 1
+#define TARO_LOG_INFO(logger, ...) (logger).Logf(LogLevel::INFO, __VA_ARGS__)
+#else
+#define TARO_LOG_INFO(logger, ...) ((void)0)
+#endif
+
+#if TARO_LOG_MIN_LEVEL <= 2
+#define TARO_LOG_WARN(logger, ...) (logger).Logf(LogLevel::WARN, __VA_ARGS__)
+#else
+#define TARO_LOG_WARN(logger, ...) ((void)0)
+#endif
+
+#define TARO_LOG_ERROR(logger, ...) (logger).Logf(LogLevel::ERR, __VA_ARGS__)
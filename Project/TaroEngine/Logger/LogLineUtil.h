@@ -0,0 +1,44 @@
+#pragma once
+#include "LogLevelUtil.h"
+#include "LogTimeUtil.h"
+#include <charconv>
+#include <string>
+#include <string_view>
+
+/// <summary>
+/// テキストログ 1 行の組み立て（FileLogger / RotatingFileLogger 共通）。
+/// </summary>
+namespace LogLineUtil {
+
+    /// <summary>
+    /// "[時刻] [LEVEL] メッセージ\n"（tick 有効時は "[時刻] [tick] [LEVEL] メッセージ\n"）を末尾に追加します。
+    /// </summary>
+    /// <param name="out">追加先。</param>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">メッセージ。</param>
+    /// <param name="time">記録時刻。</param>
+    /// <param name="precision">時刻の秒未満の表示精度。</param>
+    /// <param name="includeTicks">単調増加の tick を併記するか。</param>
+    inline void AppendLine(std::string &out, LogLevel level, std::string_view msg,
+        const std::chrono::system_clock::time_point &time,
+        LogTimeUtil::Precision precision = LogTimeUtil::Precision::Seconds, bool includeTicks = false) {
+        char timeStr[LogTimeUtil::kMaxTimeStringLength];
+        const size_t timeLength = LogTimeUtil::FormatTo(timeStr, time, precision);
+
+        out += '[';
+        out.append(timeStr, timeLength);
+        out += "] [";
+        if (includeTicks) {
+            char tickStr[24];
+            const auto result = std::to_chars(tickStr, tickStr + sizeof(tickStr), LogTimeUtil::GetMonotonicTicks());
+            out.append(tickStr, result.ptr);
+            out += "] [";
+        }
+        const std::string_view levelStr = LogLevelUtil::ToString(level);
+        out += levelStr;
+        if (levelStr.size() < 5) out.append(5 - levelStr.size(), ' ');
+        out += "] ";
+        out += msg;
+        out += '\n';
+    }
+}
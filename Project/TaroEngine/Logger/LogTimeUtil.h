@@ -1,48 +1,192 @@
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <iomanip>
-#include <sstream>
+#include <string_view>
 #include <ctime>
 
 /// <summary>
 /// ログ用の時刻ユーティリティ関数群。
 /// </summary>
+/// <remarks>
+/// 時刻文字列は localtime やストリームを使わず、UTC 秒にローカル時刻との差（UTC オフセット）を足して
+/// 算術的に組み立てる。オフセットは 15 分単位の区間ごとに 1 回だけ localtime で求めてキャッシュし、
+/// 読み取りは atomic の 1 回のロードだけで済む（待ちなし）。
+/// </remarks>
 namespace LogTimeUtil {
 
     /// <summary>
-    /// 現在時刻を "HH:MM:SS" 形式で文字列に変換します。
+    /// 秒未満の表示精度。
     /// </summary>
-    /// <returns>フォーマット済みの現在時刻文字列。</returns>
-    inline std::string GetCurrentTimeString() {
-        using namespace std::chrono;
-        std::time_t t = system_clock::to_time_t(system_clock::now());
-        std::tm tm{};
+    enum class Precision {
+        Seconds,      ///< "HH:MM:SS"
+        Milliseconds, ///< "HH:MM:SS.mmm"
+        Microseconds, ///< "HH:MM:SS.uuuuuu"
+    };
+
+    /// <summary>
+    /// FormatTo に渡すバッファの最小サイズ（終端文字を含む）。
+    /// </summary>
+    constexpr size_t kMaxTimeStringLength = 16;
+
+    namespace Detail {
+
+        // オフセットを再計算する区間（秒）。夏時間の切り替えは 15 分単位の境界で起きる。
+        constexpr int64_t kOffsetBucketSeconds = 15 * 60;
+
+        // 上位 32bit: BucketKey（0 は未計算）、下位 32bit: UTC オフセット（秒、符号付き）
+        inline std::atomic<uint64_t> cachedOffset{0};
+
+        /// <summary>
+        /// 暦日から 1970-01-01 からの日数を求める（proleptic グレゴリオ暦）。
+        /// </summary>
+        constexpr int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d) {
+            y -= m <= 2;
+            const int64_t era = (y >= 0 ? y : y - 399) / 400;
+            const unsigned yoe = static_cast<unsigned>(y - era * 400);
+            const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + static_cast<int64_t>(doe) - 719468;
+        }
+
+        /// <summary>
+        /// localtime を使って UTC オフセット（秒）を求める。
+        /// </summary>
+        inline int32_t ComputeOffset(int64_t unixSeconds) {
+            const std::time_t t = static_cast<std::time_t>(unixSeconds);
+            std::tm tm{};
 #if defined(_WIN32)
-        localtime_s(&tm, &t);
+            localtime_s(&tm, &t);
 #else
-        localtime_r(&t, &tm);
+            localtime_r(&t, &tm);
 #endif
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%H:%M:%S");
-        return oss.str();
+            const int64_t localAsUtc =
+                DaysFromCivil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1), static_cast<unsigned>(tm.tm_mday)) * 86400 +
+                tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+            return static_cast<int32_t>(localAsUtc - unixSeconds);
+        }
+
+        /// <summary>
+        /// 床関数つきの除算（負の時刻でも正しい区間・日を得るため）。
+        /// </summary>
+        constexpr int64_t FloorDiv(int64_t a, int64_t b) {
+            return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+        }
+
+        /// <summary>
+        /// キャッシュのキー。最上位ビットを立てて未計算（0）と区別し、区間番号は下位 31bit で持つ
+        /// （約 6 万年離れた区間だけが同じキーになる）。エポック直前の区間（番号 -1）も 0 にならない。
+        /// </summary>
+        constexpr uint32_t BucketKey(int64_t unixSeconds) {
+            return 0x80000000u | (static_cast<uint32_t>(FloorDiv(unixSeconds, kOffsetBucketSeconds)) & 0x7FFFFFFFu);
+        }
+
+        inline char *Put2(char *p, uint32_t v) {
+            p[0] = static_cast<char>('0' + v / 10);
+            p[1] = static_cast<char>('0' + v % 10);
+            return p + 2;
+        }
+
+        inline char *PutDigits(char *p, uint32_t v, int digits) {
+            for (int i = digits - 1; i >= 0; --i) {
+                p[i] = static_cast<char>('0' + v % 10);
+                v /= 10;
+            }
+            return p + digits;
+        }
+
+    } // namespace Detail
+
+    /// <summary>
+    /// 指定した UTC 秒におけるローカル時刻との差（秒）を返します。15 分区間ごとにキャッシュされます。
+    /// </summary>
+    /// <param name="unixSeconds">1970-01-01 UTC からの秒数。</param>
+    /// <returns>ローカル時刻 - UTC（秒）。</returns>
+    inline int32_t GetUtcOffsetSeconds(int64_t unixSeconds) {
+        const uint32_t key = Detail::BucketKey(unixSeconds);
+        const uint64_t cached = Detail::cachedOffset.load(std::memory_order_relaxed);
+        if (static_cast<uint32_t>(cached >> 32) == key) {
+            return static_cast<int32_t>(static_cast<uint32_t>(cached));
+        }
+
+        // 区間が変わったときだけ計算する（複数スレッドが同時に計算しても結果は同じ）
+        const int32_t offset = Detail::ComputeOffset(unixSeconds);
+        Detail::cachedOffset.store((static_cast<uint64_t>(key) << 32) | static_cast<uint32_t>(offset),
+            std::memory_order_relaxed);
+        return offset;
+    }
+
+    /// <summary>
+    /// 時刻をローカル時刻の文字列にしてバッファへ書き込みます（確保なし）。
+    /// </summary>
+    /// <param name="out">書き込み先（kMaxTimeStringLength バイト以上）。終端文字も書き込む。</param>
+    /// <param name="tp">変換対象の時刻。</param>
+    /// <param name="precision">秒未満の表示精度。</param>
+    /// <returns>書き込んだ文字数（終端文字を除く）。</returns>
+    inline size_t FormatTo(char *out, const std::chrono::system_clock::time_point &tp,
+        Precision precision = Precision::Seconds) {
+        using namespace std::chrono;
+        const int64_t us = duration_cast<microseconds>(tp.time_since_epoch()).count();
+        const int64_t unixSeconds = Detail::FloorDiv(us, 1000000);
+        const uint32_t subMicro = static_cast<uint32_t>(us - unixSeconds * 1000000);
+
+        const int64_t local = unixSeconds + GetUtcOffsetSeconds(unixSeconds);
+        const uint32_t secOfDay = static_cast<uint32_t>(local - Detail::FloorDiv(local, 86400) * 86400);
+
+        char *p = out;
+        p = Detail::Put2(p, secOfDay / 3600);
+        *p++ = ':';
+        p = Detail::Put2(p, secOfDay / 60 % 60);
+        *p++ = ':';
+        p = Detail::Put2(p, secOfDay % 60);
+        if (precision == Precision::Milliseconds) {
+            *p++ = '.';
+            p = Detail::PutDigits(p, subMicro / 1000, 3);
+        } else if (precision == Precision::Microseconds) {
+            *p++ = '.';
+            p = Detail::PutDigits(p, subMicro, 6);
+        }
+        *p = '\0';
+        return static_cast<size_t>(p - out);
     }
 
     /// <summary>
     /// 任意の時刻を "HH:MM:SS" 形式で文字列に変換します。
     /// </summary>
     /// <param name="tp">変換対象の時刻。</param>
+    /// <param name="precision">秒未満の表示精度。</param>
     /// <returns>フォーマット済みの時刻文字列。</returns>
-    inline std::string Format(const std::chrono::system_clock::time_point &tp) {
-        std::time_t t = std::chrono::system_clock::to_time_t(tp);
-        std::tm tm{};
-#if defined(_WIN32)
-        localtime_s(&tm, &t);
-#else
-        localtime_r(&t, &tm);
-#endif
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%H:%M:%S");
-        return oss.str();
+    inline std::string Format(const std::chrono::system_clock::time_point &tp,
+        Precision precision = Precision::Seconds) {
+        char buf[kMaxTimeStringLength];
+        const size_t length = FormatTo(buf, tp, precision);
+        return std::string(buf, length);
+    }
+
+    /// <summary>
+    /// 現在時刻を "HH:MM:SS" 形式で文字列に変換します。
+    /// </summary>
+    /// <param name="precision">秒未満の表示精度。</param>
+    /// <returns>フォーマット済みの現在時刻文字列。</returns>
+    inline std::string GetCurrentTimeString(Precision precision = Precision::Seconds) {
+        return Format(std::chrono::system_clock::now(), precision);
+    }
+
+    /// <summary>
+    /// 単調増加する tick（steady_clock）を取得します。時刻の前後関係や間隔の計測用です。
+    /// </summary>
+    /// <returns>tick 数。</returns>
+    inline uint64_t GetMonotonicTicks() {
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    /// <summary>
+    /// 1 秒あたりの tick 数を返します。
+    /// </summary>
+    constexpr uint64_t GetTicksPerSecond() {
+        using Period = std::chrono::steady_clock::period;
+        return static_cast<uint64_t>(Period::den / Period::num);
     }
 }
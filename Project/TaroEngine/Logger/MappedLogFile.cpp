@@ -0,0 +1,184 @@
+#include "MappedLogFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    // マップのオフセットはこの粒度の倍数でなければならない
+    uint64_t GetMapGranularity() {
+#if defined(_WIN32)
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+} // namespace
+
+MappedLogFile::~MappedLogFile() {
+    Close();
+}
+
+bool MappedLogFile::Open(const std::filesystem::path &path, uint64_t segmentBytes) {
+    Close();
+
+    const uint64_t granularity = GetMapGranularity();
+    segmentBytes_ = (std::max)(granularity, (segmentBytes + granularity - 1) / granularity * granularity);
+    viewOffset_ = 0;
+    written_ = 0;
+
+#if defined(_WIN32)
+    // 書き込み中も他のプロセスから読めるようにする
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    file_ = file;
+#else
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) return false;
+#endif
+
+    if (!MapSegment(0)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedLogFile::Close() {
+    Unmap();
+
+#if defined(_WIN32)
+    if (file_) {
+        LARGE_INTEGER size{};
+        size.QuadPart = static_cast<LONGLONG>(written_);
+        SetFilePointerEx(file_, size, nullptr, FILE_BEGIN);
+        SetEndOfFile(file_);
+        CloseHandle(file_);
+        file_ = nullptr;
+    }
+#else
+    if (fd_ >= 0) {
+        (void)::ftruncate(fd_, static_cast<off_t>(written_));
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+}
+
+bool MappedLogFile::Append(const void *data, size_t size) {
+    const char *src = static_cast<const char *>(data);
+    while (size > 0) {
+        if (!view_) return false;
+
+        uint64_t pos = written_ - viewOffset_;
+        if (pos == segmentBytes_) {
+            // セグメントを使い切ったら次へ
+            if (!MapSegment(viewOffset_ + segmentBytes_)) return false;
+            pos = 0;
+        }
+
+        const size_t chunk = static_cast<size_t>((std::min)(static_cast<uint64_t>(size), segmentBytes_ - pos));
+        std::memcpy(view_ + pos, src, chunk);
+        written_ += chunk;
+        src += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+bool MappedLogFile::Sync() {
+    if (!view_) return false;
+    const size_t used = static_cast<size_t>(written_ - viewOffset_);
+    if (used == 0) return true;
+#if defined(_WIN32)
+    return FlushViewOfFile(view_, used) && FlushFileBuffers(file_);
+#else
+    return ::msync(view_, used, MS_SYNC) == 0 && ::fsync(fd_) == 0;
+#endif
+}
+
+bool MappedLogFile::MapSegment(uint64_t offset) {
+    Unmap();
+    const uint64_t end = offset + segmentBytes_;
+
+#if defined(_WIN32)
+    // マッピングの作成でファイルは end まで伸びる
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(end >> 32), static_cast<DWORD>(end & 0xFFFFFFFFu), nullptr);
+    if (!mapping_) return false;
+    view_ = static_cast<char *>(MapViewOfFile(mapping_, FILE_MAP_WRITE,
+        static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFFFFFFu), static_cast<SIZE_T>(segmentBytes_)));
+    if (!view_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+        return false;
+    }
+#else
+    if (::ftruncate(fd_, static_cast<off_t>(end)) != 0) return false;
+    void *p = ::mmap(nullptr, static_cast<size_t>(segmentBytes_), PROT_READ | PROT_WRITE, MAP_SHARED,
+        fd_, static_cast<off_t>(offset));
+    if (p == MAP_FAILED) return false;
+    view_ = static_cast<char *>(p);
+#endif
+
+    viewOffset_ = offset;
+    return true;
+}
+
+void MappedLogFile::Unmap() {
+    if (view_) {
+#if defined(_WIN32)
+        UnmapViewOfFile(view_);
+#else
+        ::munmap(view_, static_cast<size_t>(segmentBytes_));
+#endif
+        view_ = nullptr;
+    }
+#if defined(_WIN32)
+    if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+#endif
+}
+
+void MappedLogFile::TrimTrailingZeros(const std::filesystem::path &path) {
+    std::error_code ec;
+    const uint64_t size = std::filesystem::file_size(path, ec);
+    if (ec || size == 0) return;
+
+    // 0 埋めは最大 1 セグメントなので、末尾から読めば足りる
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return;
+    uint64_t end = size;
+    std::vector<char> buf(64 * 1024);
+    while (end > 0) {
+        const uint64_t chunk = (std::min)(end, static_cast<uint64_t>(buf.size()));
+        ifs.seekg(static_cast<std::streamoff>(end - chunk));
+        ifs.read(buf.data(), static_cast<std::streamsize>(chunk));
+        if (!ifs) return;
+
+        uint64_t i = chunk;
+        while (i > 0 && buf[static_cast<size_t>(i - 1)] == '\0') --i;
+        end -= chunk - i;
+        if (i > 0) break;
+    }
+    ifs.close();
+
+    if (end != size) {
+        std::filesystem::resize_file(path, end, ec);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/// <summary>
+/// 追記専用のメモリマップドファイル。<br/>
+/// ファイルを一定サイズのセグメント単位で伸ばしてマップし、書き込みは memcpy だけで行う
+/// （1 行ごとのシステムコールが発生しない）。ディスクへの確定は Sync で行う。
+/// </summary>
+/// <remarks>
+/// Close で実際に書いたサイズまで切り詰める。異常終了した場合は末尾に最大 1 セグメント分の 0 が残る
+/// （TrimTrailingZeros で取り除ける）。
+/// </remarks>
+class MappedLogFile {
+public:
+    MappedLogFile() = default;
+    ~MappedLogFile();
+
+    MappedLogFile(const MappedLogFile &) = delete;
+    MappedLogFile &operator=(const MappedLogFile &) = delete;
+
+    /// <summary>
+    /// ファイルを新規作成（既存なら空に）してマップする。
+    /// </summary>
+    /// <param name="path">ファイルパス。</param>
+    /// <param name="segmentBytes">1 回にマップするバイト数（OS の割り当て粒度に切り上げる）。</param>
+    /// <returns>成功したら true。</returns>
+    bool Open(const std::filesystem::path &path, uint64_t segmentBytes);
+
+    /// <summary>
+    /// マップを解除し、書いたサイズに切り詰めて閉じる。
+    /// </summary>
+    void Close();
+
+    /// <summary>
+    /// 末尾に追記する。セグメントの終わりに達したら次のセグメントをマップする。
+    /// </summary>
+    /// <returns>成功したら true。</returns>
+    bool Append(const void *data, size_t size);
+
+    /// <summary>
+    /// 書き込んだ内容をディスクへ確定する（FlushViewOfFile + FlushFileBuffers / msync + fsync）。
+    /// </summary>
+    /// <returns>成功したら true。</returns>
+    bool Sync();
+
+    /// <summary>開いているか。</summary>
+    bool IsOpen() const { return view_ != nullptr; }
+
+    /// <summary>書き込んだバイト数。</summary>
+    uint64_t GetSize() const { return written_; }
+
+    /// <summary>
+    /// 異常終了で末尾に残った 0 埋めを取り除く（閉じているファイルに対して使う）。
+    /// </summary>
+    /// <param name="path">ファイルパス。</param>
+    static void TrimTrailingZeros(const std::filesystem::path &path);
+
+private:
+    /// <summary>offset から 1 セグメントをマップする（必要ならファイルを伸ばす）。</summary>
+    bool MapSegment(uint64_t offset);
+
+    /// <summary>現在のマップを解除する。</summary>
+    void Unmap();
+
+private:
+#if defined(_WIN32)
+    void *file_ = nullptr;    // HANDLE
+    void *mapping_ = nullptr; // HANDLE
+#else
+    int fd_ = -1;
+#endif
+    char *view_ = nullptr;
+    uint64_t viewOffset_ = 0;
+    uint64_t segmentBytes_ = 0;
+    uint64_t written_ = 0;
+};
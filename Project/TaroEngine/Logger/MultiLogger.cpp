@@ -2,15 +2,41 @@
 
 void MultiLogger::AddLogger(const std::shared_ptr<ILogger> &logger) {
     if (!logger) return;
-    std::lock_guard<std::mutex> lock(mutex_);
-    loggers_.push_back(logger);
+    std::lock_guard<std::mutex> lock(addMutex_);
+    // 配信中のスレッドが古い一覧を使い続けられるよう、コピーしてから差し替える
+    auto next = std::make_shared<LoggerList>(*loggers_.load(std::memory_order_acquire));
+    next->push_back(logger);
+    loggers_.store(std::move(next), std::memory_order_release);
 }
 
 void MultiLogger::Log(LogLevel level, const std::string &msg) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto &logger : loggers_) {
-        if (logger) {
-            logger->Log(level, msg);
+    Write(level, msg, std::chrono::system_clock::now());
+}
+
+void MultiLogger::Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+    if (!IsEnabled(level)) return;
+    Dispatch(*loggers_.load(std::memory_order_acquire), level, msg, time);
+}
+
+void MultiLogger::Flush() {
+    const auto loggers = loggers_.load(std::memory_order_acquire);
+    for (const auto &logger : *loggers) {
+        logger->Flush();
+    }
+}
+
+bool MultiLogger::AnyAccepts(const LoggerList &loggers, LogLevel level) {
+    for (const auto &logger : loggers) {
+        if (logger->IsEnabled(level)) return true;
+    }
+    return false;
+}
+
+void MultiLogger::Dispatch(const LoggerList &loggers, LogLevel level, std::string_view msg,
+    std::chrono::system_clock::time_point time) {
+    for (const auto &logger : loggers) {
+        if (logger->IsEnabled(level)) {
+            logger->Write(level, msg, time);
         }
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
 #include "ILogger.h"
+#include "LogConfig.h"
+#include <atomic>
+#include <format>
 #include <vector>
 #include <memory>
 #include <mutex>
@@ -7,6 +10,11 @@
 /// <summary>
 /// 複数の ILogger に一括でメッセージを配信するロガー。
 /// </summary>
+/// <remarks>
+/// 登録済みロガーの一覧は不変のスナップショットとして持ち、配信中はロックを握らない。
+/// （各ロガーの排他はロガー自身に任せるので、遅いロガーが他のスレッドの配信を止めない）<br/>
+/// 自身の SetMinLevel は全体の下限、各ロガーの SetMinLevel はロガーごとの下限として働く。
+/// </remarks>
 class MultiLogger : public ILogger {
 public:
     /// <summary>
@@ -27,7 +35,49 @@ public:
     /// <param name="msg">出力するメッセージ。</param>
     void Log(LogLevel level, const std::string &msg) override;
 
+    /// <summary>
+    /// すべての登録ロガーに記録時刻付きでメッセージを送ります。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    /// <param name="time">メッセージを記録した時刻。</param>
+    void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) override;
+
+    /// <summary>
+    /// すべての登録ロガーの出力を書き出します。
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// 書式と引数でメッセージを送ります。<br/>
+    /// どのロガーも受け付けないレベルなら文字列を作らずに戻る。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="fmt">std::format と同じ書式文字列（コンパイル時に検査される）。</param>
+    /// <param name="args">引数。</param>
+    template <class... Args>
+    void Logf(LogLevel level, std::format_string<Args...> fmt, Args &&...args) {
+        if (!LogConfig::IsCompiledIn(level) || !IsEnabled(level)) return;
+
+        const auto loggers = loggers_.load(std::memory_order_acquire);
+        if (!AnyAccepts(*loggers, level)) return;
+
+        const auto time = std::chrono::system_clock::now();
+        const std::string msg = std::format(fmt, std::forward<Args>(args)...);
+        Dispatch(*loggers, level, msg, time);
+    }
+
+private:
+    using LoggerList = std::vector<std::shared_ptr<ILogger>>;
+
+    /// <summary>いずれかのロガーが受け付けるか。</summary>
+    static bool AnyAccepts(const LoggerList &loggers, LogLevel level);
+
+    /// <summary>受け付けるロガーにだけ配信する。</summary>
+    static void Dispatch(const LoggerList &loggers, LogLevel level, std::string_view msg,
+        std::chrono::system_clock::time_point time);
+
 private:
-    std::vector<std::shared_ptr<ILogger>> loggers_;
-    std::mutex mutex_;
+    std::atomic<std::shared_ptr<const LoggerList>> loggers_{std::make_shared<const LoggerList>()};
+    std::mutex addMutex_; ///< AddLogger 同士の排他（配信側は使わない）
 };
@@ -4,8 +4,13 @@
 #include <windows.h>
 
 void OutputLogger::Log(LogLevel level, const std::string &msg) {
+    Write(level, msg, std::chrono::system_clock::now());
+}
+
+void OutputLogger::Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::string timeStr = LogTimeUtil::GetCurrentTimeString();
+    char timeStr[LogTimeUtil::kMaxTimeStringLength];
+    LogTimeUtil::FormatTo(timeStr, time);
     const char *levelStr = LogLevelUtil::ToString(level);
 
     std::string formatted = std::format("[{}] [{:<5}] {}\n", timeStr, levelStr, msg);
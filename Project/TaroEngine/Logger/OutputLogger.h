@@ -20,6 +20,14 @@ public:
 	/// <param name="msg">出力するメッセージ文字列。</param>
 	void Log(LogLevel level, const std::string &msg) override;
 
+	/// <summary>
+	/// 記録時刻を指定してメッセージを出力します。
+	/// </summary>
+	/// <param name="level">ログレベル。</param>
+	/// <param name="msg">出力するメッセージ文字列。</param>
+	/// <param name="time">メッセージを記録した時刻。</param>
+	void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) override;
+
 private:
 	std::mutex mutex_; ///< マルチスレッド出力防止用。
 };
@@ -0,0 +1,125 @@
+#include "RotatingFileLogger.h"
+#include "LogLineUtil.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // 切り替え時に古いファイルの末尾へ書く行（maxFileBytes にはこの行の分も含める）
+    constexpr std::string_view kContinuesLine = "===== Log continues in next file =====\n";
+
+} // namespace
+
+RotatingFileLogger::RotatingFileLogger(const fs::path &filePath)
+    : RotatingFileLogger(filePath, Options{}) {
+}
+
+RotatingFileLogger::RotatingFileLogger(const fs::path &filePath, const Options &options)
+    : filePath_(filePath), options_(options) {
+    // 前回のファイル（異常終了なら末尾が 0 埋め）は 1 つ古い番号へ送る
+    std::error_code ec;
+    if (fs::exists(filePath_, ec) && fs::file_size(filePath_, ec) > 0) {
+        MappedLogFile::TrimTrailingZeros(filePath_);
+        ShiftFiles();
+    }
+    OpenFile("===== Log session started at ");
+}
+
+RotatingFileLogger::~RotatingFileLogger() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_.IsOpen()) return;
+    Append("===== Log session ended at " + LogTimeUtil::GetCurrentTimeString(options_.precision) + " =====\n");
+    file_.Sync();
+    file_.Close();
+}
+
+void RotatingFileLogger::Log(LogLevel level, const std::string &msg) {
+    Write(level, msg, std::chrono::system_clock::now());
+}
+
+void RotatingFileLogger::Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_.IsOpen()) return;
+
+    line_.clear();
+    LogLineUtil::AppendLine(line_, level, msg, time, options_.precision);
+
+    // サイズ・経過時間による切り替え（空のファイルでは切り替えない）。
+    // 切り替え時の末尾行が入る分を残しておく
+    const auto now = std::chrono::steady_clock::now();
+    const bool tooLarge = file_.GetSize() + line_.size() + kContinuesLine.size() > options_.maxFileBytes;
+    const bool tooOld = options_.maxFileAge.count() > 0 && now - openedAt_ >= options_.maxFileAge;
+    if ((tooLarge || tooOld) && file_.GetSize() > 0) {
+        Rotate();
+        if (!file_.IsOpen()) return;
+    }
+
+    Append(line_);
+    SyncIfDue(level >= LogLevel::ERR);
+}
+
+void RotatingFileLogger::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SyncIfDue(true);
+}
+
+bool RotatingFileLogger::IsOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_.IsOpen();
+}
+
+fs::path RotatingFileLogger::GetFilePath(uint32_t index) const {
+    if (index == 0) return filePath_;
+    // app.log → app.1.log
+    fs::path p = filePath_;
+    p.replace_filename(filePath_.stem().string() + "." + std::to_string(index) + filePath_.extension().string());
+    return p;
+}
+
+void RotatingFileLogger::ShiftFiles() {
+    std::error_code ec;
+    if (options_.retention == 0) {
+        fs::remove(filePath_, ec);
+        return;
+    }
+    // 一番古いものを消してから、後ろから順にずらす
+    fs::remove(GetFilePath(options_.retention), ec);
+    for (uint32_t i = options_.retention; i > 0; --i) {
+        const fs::path from = GetFilePath(i - 1);
+        if (fs::exists(from, ec)) {
+            fs::rename(from, GetFilePath(i), ec);
+        }
+    }
+}
+
+void RotatingFileLogger::OpenFile(const char *header) {
+    if (!file_.Open(filePath_, options_.segmentBytes)) return;
+    openedAt_ = std::chrono::steady_clock::now();
+    lastSync_ = openedAt_;
+    unsynced_ = false;
+    Append(std::string(header) + LogTimeUtil::GetCurrentTimeString(options_.precision) + " =====\n");
+}
+
+void RotatingFileLogger::Rotate() {
+    Append(kContinuesLine);
+    file_.Sync();
+    file_.Close();
+    ShiftFiles();
+    OpenFile("===== Log continued at ");
+}
+
+void RotatingFileLogger::Append(std::string_view text) {
+    if (file_.Append(text.data(), text.size())) {
+        unsynced_ = true;
+    }
+}
+
+void RotatingFileLogger::SyncIfDue(bool force) {
+    if (!unsynced_ || !file_.IsOpen()) return;
+    const auto now = std::chrono::steady_clock::now();
+    if (force || now - lastSync_ >= options_.syncInterval) {
+        file_.Sync();
+        lastSync_ = now;
+        unsynced_ = false;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "ILogger.h"
+#include "LogTimeUtil.h"
+#include "MappedLogFile.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+/// <summary>
+/// サイズ・経過時間でファイルを切り替え、古いものを一定数だけ残すロガー。<br/>
+/// 書き込みはメモリマップしたセグメントへのコピーで行い、ディスクへの確定は一定間隔でまとめて行う。
+/// </summary>
+/// <remarks>
+/// app.log に書き、切り替え時に app.log → app.1.log → app.2.log … とずらして retention 個を超えた分を削除する。
+/// 起動時に前回の app.log が残っていれば、それも app.1.log に送ってから新しいファイルを始める。
+/// </remarks>
+class RotatingFileLogger : public ILogger {
+public:
+    /// <summary>
+    /// 設定。
+    /// </summary>
+    struct Options {
+        uint64_t maxFileBytes = 8ull * 1024 * 1024;       ///< これを超えないように切り替える（切り替え時の末尾行を含む）
+        std::chrono::seconds maxFileAge{0};               ///< これだけ経ったら切り替える（0 なら時間では切り替えない）
+        uint32_t retention = 5;                           ///< 残す古いファイルの数
+        uint64_t segmentBytes = 1024 * 1024;              ///< 1 回にマップするバイト数
+        std::chrono::milliseconds syncInterval{1000};     ///< ディスクへ確定する間隔（ERR は即時）
+        LogTimeUtil::Precision precision = LogTimeUtil::Precision::Milliseconds; ///< 時刻の精度
+    };
+
+public:
+    /// <summary>
+    /// コンストラクタ。既定の設定でファイルを開く。
+    /// </summary>
+    /// <param name="filePath">出力先（例: PathUtil::DefaultLogFilePath()）。</param>
+    explicit RotatingFileLogger(const std::filesystem::path &filePath);
+
+    /// <summary>
+    /// コンストラクタ。
+    /// </summary>
+    /// <param name="filePath">出力先（例: PathUtil::DefaultLogFilePath()）。</param>
+    /// <param name="options">設定。</param>
+    RotatingFileLogger(const std::filesystem::path &filePath, const Options &options);
+
+    /// <summary>
+    /// デストラクタ。終了行を書き、ディスクへ確定して閉じる。
+    /// </summary>
+    ~RotatingFileLogger() override;
+
+    /// <summary>
+    /// 指定レベルでログを出力します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    void Log(LogLevel level, const std::string &msg) override;
+
+    /// <summary>
+    /// 記録時刻を指定してログを出力します。
+    /// </summary>
+    /// <param name="level">ログレベル。</param>
+    /// <param name="msg">出力するメッセージ。</param>
+    /// <param name="time">メッセージを記録した時刻。</param>
+    void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point time) override;
+
+    /// <summary>
+    /// 書き込んだ内容をディスクへ確定します。
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// ファイルが正常に開けているかを確認します。
+    /// </summary>
+    /// <returns>開けている場合 true。</returns>
+    bool IsOpen() const;
+
+    /// <summary>
+    /// index 番目の古いファイルのパスを返します（0 なら現在のファイル）。
+    /// </summary>
+    std::filesystem::path GetFilePath(uint32_t index) const;
+
+private:
+    /// <summary>既存のファイルを 1 つずつずらし、retention を超えた分を削除する。</summary>
+    void ShiftFiles();
+
+    /// <summary>新しいファイルを開いて見出し行を書く。</summary>
+    void OpenFile(const char *header);
+
+    /// <summary>現在のファイルを閉じて次のファイルへ切り替える。</summary>
+    void Rotate();
+
+    /// <summary>文字列をそのまま書き込む。</summary>
+    void Append(std::string_view text);
+
+    /// <summary>前回の確定から syncInterval 経っていれば（force なら常に）確定する。</summary>
+    void SyncIfDue(bool force);
+
+private:
+    std::filesystem::path filePath_;
+    Options options_;
+    MappedLogFile file_;
+    mutable std::mutex mutex_; // file_ 以下を守る（IsOpen からも取る）
+    std::string line_; // 1 行分の作業バッファ
+
+    std::chrono::steady_clock::time_point openedAt_{};
+    std::chrono::steady_clock::time_point lastSync_{};
+    bool unsynced_ = false;
+};
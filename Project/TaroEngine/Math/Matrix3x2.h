@@ -0,0 +1,9 @@
+#pragma once
+
+/// <summary>
+/// 2D アフィン変換（行メジャー×右掛け）。<br/>
+/// 1,2 行目が回転・スケール、3 行目が平行移動。
+/// </summary>
+struct Matrix3x2 {
+  float m[3][2]; ///< 3x2 行列の各要素
+};
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cmath>
+#include "Matrix3x2.h"
 #include "Matrix4x4.h"
+#include "SimdConfig.h"
 #include "Vector3.h"
 
 namespace MatrixUtil {
@@ -55,8 +57,47 @@ namespace MatrixUtil {
 		return r;
 	}
 
+	/// <summary>
+	/// 行列積 a * b（行メジャー×右掛け）。<br/>
+	/// SIMD 版も各要素を (a0*b0 + a1*b1) + a2*b2 + a3*b3 の順で加算するため、
+	/// FMA 無効時はスカラ版とビット単位で一致する。
+	/// </summary>
 	inline Matrix4x4 Multiply(const Matrix4x4 &a, const Matrix4x4 &b) {
-		Matrix4x4 r{};
+		Matrix4x4 r;
+#if defined(TARO_SIMD_AVX)
+		// b の各行を上下レーンに複製し、a の 2 行ぶんを同時に計算する
+		const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b.m[0]));
+		const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b.m[1]));
+		const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b.m[2]));
+		const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b.m[3]));
+		for (int i = 0; i < 4; i += 2) {
+			const __m256 a2 = _mm256_loadu_ps(a.m[i]); // a.m[i] と a.m[i + 1] は連続
+#if defined(TARO_SIMD_FMA)
+			__m256 v = _mm256_mul_ps(_mm256_permute_ps(a2, 0x00), b0);
+			v = _mm256_fmadd_ps(_mm256_permute_ps(a2, 0x55), b1, v);
+			v = _mm256_fmadd_ps(_mm256_permute_ps(a2, 0xAA), b2, v);
+			v = _mm256_fmadd_ps(_mm256_permute_ps(a2, 0xFF), b3, v);
+#else
+			__m256 v = _mm256_mul_ps(_mm256_permute_ps(a2, 0x00), b0);
+			v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_permute_ps(a2, 0x55), b1));
+			v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_permute_ps(a2, 0xAA), b2));
+			v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_permute_ps(a2, 0xFF), b3));
+#endif
+			_mm256_storeu_ps(r.m[i], v);
+		}
+#elif defined(TARO_SIMD_SSE2)
+		const __m128 b0 = _mm_loadu_ps(b.m[0]);
+		const __m128 b1 = _mm_loadu_ps(b.m[1]);
+		const __m128 b2 = _mm_loadu_ps(b.m[2]);
+		const __m128 b3 = _mm_loadu_ps(b.m[3]);
+		for (int i = 0; i < 4; i++) {
+			__m128 v = _mm_mul_ps(_mm_set1_ps(a.m[i][0]), b0);
+			v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), b1));
+			v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), b2));
+			v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a.m[i][3]), b3));
+			_mm_storeu_ps(r.m[i], v);
+		}
+#else
 		for (int i = 0; i < 4; i++) {
 			for (int j = 0; j < 4; j++) {
 				r.m[i][j] = a.m[i][0] * b.m[0][j] +
@@ -65,16 +106,93 @@ namespace MatrixUtil {
 					a.m[i][3] * b.m[3][j];
 			}
 		}
+#endif
 		return r;
 	}
 
+	/// <summary>転置行列（要素の並べ替えのみなので全バックエンドで完全一致）。</summary>
 	inline Matrix4x4 Transpose(const Matrix4x4 &a) {
-		Matrix4x4 r{};
+		Matrix4x4 r;
+#if defined(TARO_SIMD_SSE2)
+		__m128 r0 = _mm_loadu_ps(a.m[0]);
+		__m128 r1 = _mm_loadu_ps(a.m[1]);
+		__m128 r2 = _mm_loadu_ps(a.m[2]);
+		__m128 r3 = _mm_loadu_ps(a.m[3]);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(r.m[0], r0);
+		_mm_storeu_ps(r.m[1], r1);
+		_mm_storeu_ps(r.m[2], r2);
+		_mm_storeu_ps(r.m[3], r3);
+#else
 		for (int i = 0; i < 4; i++)
 			for (int j = 0; j < 4; j++)
 				r.m[i][j] = a.m[j][i];
+#endif
 		return r;
 	}
+	// ---------- 2D アフィン（スプライト用の閉形式） ----------
+	/// <summary>
+	/// Z 回転 → 平行移動の 2D アフィン行列（MakeRotationZMatrix * MakeTranslationMatrix 相当）。
+	/// </summary>
+	inline Matrix3x2 MakeAffine2DMatrix(float rad, float tx, float ty) {
+		float c = std::cos(rad);
+		float s = std::sin(rad);
+		Matrix3x2 r;
+		r.m[0][0] = c;  r.m[0][1] = s;
+		r.m[1][0] = -s; r.m[1][1] = c;
+		r.m[2][0] = tx; r.m[2][1] = ty;
+		return r;
+	}
+
+	/// <summary>
+	/// スケール → Z 回転 → 平行移動の 2D アフィン行列。
+	/// </summary>
+	inline Matrix3x2 MakeAffine2DMatrix(float sx, float sy, float rad, float tx, float ty) {
+		Matrix3x2 r = MakeAffine2DMatrix(rad, tx, ty);
+		r.m[0][0] *= sx; r.m[0][1] *= sx;
+		r.m[1][0] *= sy; r.m[1][1] *= sy;
+		return r;
+	}
+
+	/// <summary>2D アフィン行列を 4x4（Z はそのまま）に展開する。</summary>
+	inline Matrix4x4 ToMatrix4x4(const Matrix3x2 &a) {
+		Matrix4x4 r{};
+		r.m[0][0] = a.m[0][0]; r.m[0][1] = a.m[0][1];
+		r.m[1][0] = a.m[1][0]; r.m[1][1] = a.m[1][1];
+		r.m[2][2] = 1.0f;
+		r.m[3][0] = a.m[2][0]; r.m[3][1] = a.m[2][1]; r.m[3][3] = 1.0f;
+		return r;
+	}
+
+	/// <summary>
+	/// Multiply(ToMatrix4x4(a), b) の閉形式。<br/>
+	/// 0 / 1 の要素との積を省くので、一般の 4x4 積（64 乗算）に対して 12 乗算で済む。
+	/// 加算順は一般版と同じなので、符号付きゼロを除き結果は一致する。
+	/// </summary>
+	inline Matrix4x4 MultiplyAffine2D(const Matrix3x2 &a, const Matrix4x4 &b) {
+		Matrix4x4 r;
+#if defined(TARO_SIMD_SSE2)
+		const __m128 b0 = _mm_loadu_ps(b.m[0]);
+		const __m128 b1 = _mm_loadu_ps(b.m[1]);
+		const __m128 r0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.m[0][0]), b0), _mm_mul_ps(_mm_set1_ps(a.m[0][1]), b1));
+		const __m128 r1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.m[1][0]), b0), _mm_mul_ps(_mm_set1_ps(a.m[1][1]), b1));
+		__m128 r3 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.m[2][0]), b0), _mm_mul_ps(_mm_set1_ps(a.m[2][1]), b1));
+		r3 = _mm_add_ps(r3, _mm_loadu_ps(b.m[3]));
+		_mm_storeu_ps(r.m[0], r0);
+		_mm_storeu_ps(r.m[1], r1);
+		_mm_storeu_ps(r.m[2], _mm_loadu_ps(b.m[2]));
+		_mm_storeu_ps(r.m[3], r3);
+#else
+		for (int j = 0; j < 4; j++) {
+			r.m[0][j] = a.m[0][0] * b.m[0][j] + a.m[0][1] * b.m[1][j];
+			r.m[1][j] = a.m[1][0] * b.m[0][j] + a.m[1][1] * b.m[1][j];
+			r.m[2][j] = b.m[2][j];
+			r.m[3][j] = a.m[2][0] * b.m[0][j] + a.m[2][1] * b.m[1][j] + b.m[3][j];
+		}
+#endif
+		return r;
+	}
+
 	// ---------- ベクトルユーティリティ ----------
 	/// <summary>ドット積。</summary>
 	inline float Dot(const Vector3 &a, const Vector3 &b) {
@@ -190,16 +308,25 @@ namespace MatrixUtil {
 	// ---------- TRS 合成と剛体逆行列 ----------
 	/// <summary>
 	/// 行メジャー×右掛けの TRS 行列（S → RzRyRx → T の順で合成）。<br/>
-	/// スケール→回転→平行移動で作る一般的なワールド行列。
+	/// スケール→回転→平行移動で作る一般的なワールド行列。<br/>
+	/// Multiply(Multiply(S, Multiply(Multiply(Rx, Ry), Rz)), T) の閉形式で、
+	/// 回転行列の各行を s で拡大し、4 行目に t を書くだけにしている（0 / 1 との積を省いたのみで積の順は同じ）。
 	/// </summary>
 	inline Matrix4x4 MakeTRS(const Vector3 &t, const Vector3 &rXYZRadians, const Vector3 &s) {
-		auto S = MakeScaleMatrix(s.x, s.y, s.z);
-		auto Rx = MakeRotationXMatrix(rXYZRadians.x);
-		auto Ry = MakeRotationYMatrix(rXYZRadians.y);
-		auto Rz = MakeRotationZMatrix(rXYZRadians.z);
-		auto R = Multiply(Multiply(Rx, Ry), Rz);
-		auto T = MakeTranslationMatrix(t.x, t.y, t.z);
-		return Multiply(Multiply(S, R), T);
+		const float cx = std::cos(rXYZRadians.x), sx = std::sin(rXYZRadians.x);
+		const float cy = std::cos(rXYZRadians.y), sy = std::sin(rXYZRadians.y);
+		const float cz = std::cos(rXYZRadians.z), sz = std::sin(rXYZRadians.z);
+
+		// Rx * Ry の行
+		const float sxsy = sx * sy, sxcy = sx * cy;
+		const float cxsy = cx * sy, cxcy = cx * cy;
+
+		Matrix4x4 r;
+		r.m[0][0] = s.x * (cy * cz);            r.m[0][1] = s.x * (cy * sz);            r.m[0][2] = s.x * -sy;  r.m[0][3] = 0.0f;
+		r.m[1][0] = s.y * (sxsy * cz - cx * sz); r.m[1][1] = s.y * (sxsy * sz + cx * cz); r.m[1][2] = s.y * sxcy; r.m[1][3] = 0.0f;
+		r.m[2][0] = s.z * (cxsy * cz + sx * sz); r.m[2][1] = s.z * (cxsy * sz - sx * cz); r.m[2][2] = s.z * cxcy; r.m[2][3] = 0.0f;
+		r.m[3][0] = t.x;                         r.m[3][1] = t.y;                         r.m[3][2] = t.z;        r.m[3][3] = 1.0f;
+		return r;
 	}
 
 	/// <summary>
@@ -207,6 +334,29 @@ namespace MatrixUtil {
 	/// R と T だけの行列に対し、R^T と -T を用いて逆を構成する。
 	/// </summary>
 	inline Matrix4x4 InverseRigid(const Matrix4x4 &m) {
+#if defined(TARO_SIMD_SSE2)
+		// 上 3x3 を w=0 にして 4x4 転置（4 行目は (0,0,0,1) として扱う）
+		const __m128 maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		__m128 c0 = _mm_and_ps(_mm_loadu_ps(m.m[0]), maskXYZ);
+		__m128 c1 = _mm_and_ps(_mm_loadu_ps(m.m[1]), maskXYZ);
+		__m128 c2 = _mm_and_ps(_mm_loadu_ps(m.m[2]), maskXYZ);
+		__m128 c3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		// 平行移動を逆回転して符号反転（スカラ版と同じ加算順）
+		__m128 t = _mm_mul_ps(_mm_set1_ps(m.m[3][0]), c0);
+		t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m.m[3][1]), c1));
+		t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m.m[3][2]), c2));
+		t = _mm_xor_ps(t, _mm_set1_ps(-0.0f));
+
+		Matrix4x4 r;
+		_mm_storeu_ps(r.m[0], c0);
+		_mm_storeu_ps(r.m[1], c1);
+		_mm_storeu_ps(r.m[2], c2);
+		_mm_storeu_ps(r.m[3], t);
+		r.m[3][3] = 1.0f;
+		return r;
+#else
 		// 回転部分（上3x3）を転置
 		Matrix4x4 r = MakeIdentityMatrix();
 		r.m[0][0] = m.m[0][0]; r.m[0][1] = m.m[1][0]; r.m[0][2] = m.m[2][0];
@@ -220,6 +370,60 @@ namespace MatrixUtil {
 		r.m[3][2] = -(tx * r.m[0][2] + ty * r.m[1][2] + tz * r.m[2][2]);
 		r.m[3][3] = 1.0f;
 		return r;
+#endif
+	}
+
+	/// <summary>
+	/// 一般の 4x4 逆行列（余因子展開）。射影を含む行列にも使える。
+	/// </summary>
+	/// <param name="m">対象の行列。</param>
+	/// <param name="out">逆行列の書き出し先（失敗時は変更しない）。</param>
+	/// <returns>行列式が 0（に極めて近い）なら false。</returns>
+	inline bool Inverse(const Matrix4x4 &m, Matrix4x4 &out) {
+		const auto &a = m.m;
+
+		// 上 2 行と下 2 行の 2x2 小行列式
+		const float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+		const float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+		const float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+		const float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+		const float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+		const float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+		const float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+		const float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+		const float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+		const float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+		const float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+		const float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+		const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		if (std::fabs(det) < 1e-20f) return false;
+		const float inv = 1.0f / det;
+
+		Matrix4x4 r;
+		r.m[0][0] = ( a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * inv;
+		r.m[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * inv;
+		r.m[0][2] = ( a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * inv;
+		r.m[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * inv;
+
+		r.m[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * inv;
+		r.m[1][1] = ( a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * inv;
+		r.m[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * inv;
+		r.m[1][3] = ( a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * inv;
+
+		r.m[2][0] = ( a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * inv;
+		r.m[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * inv;
+		r.m[2][2] = ( a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * inv;
+		r.m[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * inv;
+
+		r.m[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * inv;
+		r.m[3][1] = ( a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * inv;
+		r.m[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * inv;
+		r.m[3][3] = ( a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * inv;
+
+		out = r;
+		return true;
 	}
 
 } // namespace MatrixUtil
\ No newline at end of file
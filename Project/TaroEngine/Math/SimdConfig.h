@@ -0,0 +1,47 @@
+#pragma once
+
+// ===============================
+// SIMD バックエンド選択（コンパイル時）
+// ===============================
+// 優先順位: AVX → SSE2 → スカラ。
+// - TARO_MATH_FORCE_SCALAR を定義するとスカラ実装に固定する（比較・デバッグ用）。
+// - AVX は /arch:AVX 以上（__AVX__ 定義時）のみ有効。x64 では SSE2 が常に使える。
+// - FMA は丸め結果がスカラ版と一致しなくなるため、TARO_MATH_ENABLE_FMA を
+//   明示的に定義し、かつ /arch:AVX2 以上のときだけ使用する。
+
+#if !defined(TARO_MATH_FORCE_SCALAR)
+#if defined(__AVX__)
+#define TARO_SIMD_AVX 1
+#endif
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TARO_SIMD_SSE2 1
+#endif
+#if defined(TARO_SIMD_AVX) && defined(TARO_MATH_ENABLE_FMA) && (defined(__FMA__) || defined(__AVX2__))
+#define TARO_SIMD_FMA 1
+#endif
+#endif
+
+#if defined(TARO_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(TARO_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace SimdConfig {
+
+	/// <summary>
+	/// コンパイル時に選択された SIMD バックエンド名を返す（ログ・デバッグ表示用）。
+	/// </summary>
+	constexpr const char *GetBackendName() {
+#if defined(TARO_SIMD_FMA)
+		return "AVX+FMA";
+#elif defined(TARO_SIMD_AVX)
+		return "AVX";
+#elif defined(TARO_SIMD_SSE2)
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+} // namespace SimdConfig
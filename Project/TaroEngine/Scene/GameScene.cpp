@@ -1,10 +1,18 @@
 #define USE_MATH_DEFINES_
+#include <algorithm>
 #include <cmath>
 #include "GameScene.h"
+#include "SpriteBatch.h"
 #include "imgui.h"
 #include "MultiLogger.h"
 #include "LogLevel.h"
 
+namespace {
+
+	constexpr float kTwoPi = 6.28318531f;
+
+} // namespace
+
 void GameScene::Initialize(const EngineContext &engine) {
 	// --- カメラ初期化 ---
 	camera_.Initialize(1280.0f, 720.0f, camFovDeg_ * 3.14159265f / 180.0f, camNear_, camFar_);
@@ -13,8 +21,22 @@ void GameScene::Initialize(const EngineContext &engine) {
 	camera_.Update();
 
 	// --- スプライト初期化 ---
-	sprite_.Initialize(engine.device);
-	engine.multiLogger->Log(LogLevel::INFO, "GameScene: Sprite initialized.");
+	// 描画は SpriteBatch が行うので、スプライト個別の GPU バッファは作らない
+	sprite_.SetPosition({0.0f, 0.0f});
+
+	// 空間グリッドへ登録（描画時は画面に映るものだけを引く）
+	spriteGrid_.Initialize(kSpriteGridCellSize);
+	spriteTable_ = {&sprite_};
+	spriteProxies_.clear();
+	prevTransforms_.clear();
+	for (uint32_t i = 0; i < spriteTable_.size(); ++i) {
+		const Sprite &s = *spriteTable_[i];
+		spriteProxies_.push_back(spriteGrid_.Insert(
+			SpatialGrid2D::MakeSpriteBounds(s.GetPosition(), s.GetSize(), s.GetRotation()), i));
+		prevTransforms_.push_back({s.GetPosition(), s.GetRotation()});
+	}
+	spriteVelocityX_ = kSpriteSwaySpeed;
+	TARO_LOG_INFO(*engine.multiLogger, "GameScene: Sprite initialized.");
 }
 
 void GameScene::OnResize(uint32_t w, uint32_t h) {
@@ -22,15 +44,89 @@ void GameScene::OnResize(uint32_t w, uint32_t h) {
 	camera_.SetViewportSize(static_cast<float>(w), static_cast<float>(h));
 }
 
+void GameScene::FixedUpdate(float fixedDt) {
+	// 描画時の補間用に、進める前の姿勢を残す
+	for (uint32_t i = 0; i < spriteTable_.size(); ++i) {
+		prevTransforms_[i] = {spriteTable_[i]->GetPosition(), spriteTable_[i]->GetRotation()};
+	}
+
+	// スプライトを回しながら左右に往復させる（sprite_ は spriteTable_ の 0 番）
+	Vector2 pos = sprite_.GetPosition();
+	pos.x += spriteVelocityX_ * fixedDt;
+	if (std::abs(pos.x) >= kSpriteSwayRange) {
+		pos.x = std::clamp(pos.x, -kSpriteSwayRange, kSpriteSwayRange);
+		spriteVelocityX_ = -spriteVelocityX_;
+	}
+	sprite_.SetPosition(pos);
+
+	// 角度は 1 周ごとに前回の値と一緒に戻す（補間が逆回りにならないように）
+	float rotation = sprite_.GetRotation() + kSpriteSpinSpeed * fixedDt;
+	if (rotation >= kTwoPi) {
+		rotation -= kTwoPi;
+		prevTransforms_[0].rotation -= kTwoPi;
+	}
+	sprite_.SetRotation(rotation);
+}
+
 void GameScene::Update(float /*dt*/) {
-	// カメラ行列更新
+	// カメラ行列更新（スプライトの WVP は描画時にバッチでまとめて計算する）
 	camera_.Update();
 
-	// スプライト更新
-	sprite_.Update(camera_);
+	// スプライトの境界（最新ステップの姿勢）をグリッドへ反映（同じセル内の移動なら書き換えだけ）
+	for (uint32_t i = 0; i < spriteTable_.size(); ++i) {
+		const Sprite &s = *spriteTable_[i];
+		spriteGrid_.Update(spriteProxies_[i],
+			SpatialGrid2D::MakeSpriteBounds(s.GetPosition(), s.GetSize(), s.GetRotation()));
+	}
+}
+
+void GameScene::CollectVisibleSprites() {
+	visibleSprites_.clear();
+
+	// スプライトは z = 0 の平面にある。画面の隅が平面に届かない（地平線が映る）ときは全件を描く
+	SpatialGrid2D::Rect view;
+	if (SpatialGrid2D::ComputeVisibleRect(camera_.GetViewProjection(), 0.0f, view)) {
+		spriteGrid_.QueryRect(view, visibleSprites_);
+		std::sort(visibleSprites_.begin(), visibleSprites_.end()); // 追加順（= 同じ layer 内の描画順）を保つ
+	} else {
+		for (uint32_t i = 0; i < spriteTable_.size(); ++i) {
+			visibleSprites_.push_back(i);
+		}
+	}
+}
+
+SpriteBatchBuilder::Entry GameScene::MakeInterpolatedEntry(uint32_t index, float alpha) const {
+	SpriteBatchBuilder::Entry e = SpriteBatch::MakeEntry(*spriteTable_[index]);
+	const SpriteTransform &prev = prevTransforms_[index];
+	e.position.x = prev.position.x + (e.position.x - prev.position.x) * alpha;
+	e.position.y = prev.position.y + (e.position.y - prev.position.y) * alpha;
+	e.rotation = prev.rotation + (e.rotation - prev.rotation) * alpha;
+	return e;
 }
 
 void GameScene::Draw(const EngineContext &engine, const RenderContext &rc) {
+	DrawUI();
+
+	// スプライト描画（画面に映るものだけを、ステップ間を補間してインスタンス描画で 1 ドローにまとめる）
+	CollectVisibleSprites();
+	engine.spriteBatch->Begin(camera_.GetViewProjection());
+	for (uint32_t index : visibleSprites_) {
+		engine.spriteBatch->Add(MakeInterpolatedEntry(index, rc.interpolationAlpha));
+	}
+	engine.spriteBatch->End(rc.commandList, *engine.spriteCommon);
+}
+
+bool GameScene::ExtractRenderData(RenderSnapshot &out) {
+	out.viewProj = camera_.GetViewProjection();
+	CollectVisibleSprites();
+	// 補間係数は呼び出し側がこのフレームの固定ステップを進めた後に設定している
+	for (uint32_t index : visibleSprites_) {
+		out.sprites.push_back(MakeInterpolatedEntry(index, out.interpolationAlpha));
+	}
+	return true;
+}
+
+void GameScene::DrawUI() {
 	// ==== ImGui: Camera パネル ====
 	if (ImGui::Begin("Camera")) {
 		// 位置／注視点
@@ -88,15 +184,11 @@ void GameScene::Draw(const EngineContext &engine, const RenderContext &rc) {
 			camera_.SetLens(camFovDeg_ * 3.14159265f / 180.0f, camera_.GetAspect(), camNear_, camFar_);
 		}
 
+		ImGui::SeparatorText("Sprites");
+		ImGui::Text("Visible: %zu / %zu", visibleSprites_.size(), spriteGrid_.GetCount());
+
 		ImGui::End();
 	}
-
-	// 共通 PSO / ルートシグネチャ適用
-	engine.spriteCommon->ApplyCommonDrawSettings(
-		rc.commandList, D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-	// スプライト描画
-	sprite_.Draw(rc.commandList);
 }
 
 void GameScene::Finalize() {
@@ -3,6 +3,9 @@
 #include "Sprite.h"
 #include "SpriteCommon.h"
 #include "Camera.h"      // ★ 追加
+#include "SpatialGrid2D.h"
+#include "SpriteBatchBuilder.h"
+#include <vector>
 
 /// <summary>
 /// 実際のゲーム用のシーン。<br/>
@@ -17,6 +20,13 @@ public:
     /// <param name="engine">エンジンの共有コンテキスト。</param>
     void Initialize(const EngineContext &engine) override;
 
+    /// <summary>
+    /// 固定ステップの更新処理。<br/>
+    /// スプライトの動き（回転と左右の往復）を一定の刻みで進める。
+    /// </summary>
+    /// <param name="fixedDt">1 ステップの秒数。</param>
+    void FixedUpdate(float fixedDt) override;
+
     /// <summary>
     /// ゲーム更新処理。<br/>
     /// 入力やアニメーション、オブジェクトの状態を更新する。
@@ -26,12 +36,25 @@ public:
 
     /// <summary>
     /// 描画処理。<br/>
-    /// 共通のPSOを適用した後、スプライトを個別に描画する。
+    /// スプライトを前回と最新のステップの間で補間して SpriteBatch に積み、インスタンス描画でまとめて描画する。
     /// </summary>
     /// <param name="engine">エンジンの共有コンテキスト。</param>
     /// <param name="rc">描画コンテキスト。</param>
     void Draw(const EngineContext &engine, const RenderContext &rc) override;
 
+    /// <summary>
+    /// カメラとスプライトの描画データをスナップショットへ書き出す。<br/>
+    /// スプライトは out.interpolationAlpha で補間した姿勢で書き出す。
+    /// </summary>
+    /// <param name="out">書き出し先。</param>
+    /// <returns>常に true。</returns>
+    bool ExtractRenderData(RenderSnapshot &out) override;
+
+    /// <summary>
+    /// カメラ操作用の ImGui パネルを描く。
+    /// </summary>
+    void DrawUI() override;
+
     /// <summary>
     /// 終了処理。<br/>
     /// ゲームシーン固有のリソースを解放する。
@@ -47,9 +70,48 @@ public:
     void OnResize(uint32_t w, uint32_t h);
 
 private:
+    /// <summary>
+    /// カメラに映るスプライトの番号（spriteTable_ の添字）を visibleSprites_ に集める。
+    /// </summary>
+    void CollectVisibleSprites();
+
+    /// <summary>
+    /// index 番目のスプライトを、前回と最新のステップの間で補間した描画要求にする。
+    /// </summary>
+    /// <param name="index">spriteTable_ の添字。</param>
+    /// <param name="alpha">補間係数（0: 前回ステップ, 1: 最新ステップ）。</param>
+    SpriteBatchBuilder::Entry MakeInterpolatedEntry(uint32_t index, float alpha) const;
+
+private:
+    /// <summary>補間用に残す 1 ステップ前の姿勢。</summary>
+    struct SpriteTransform {
+        Vector2 position{0.0f, 0.0f};
+        float rotation = 0.0f;
+    };
+
+    /// <summary>スプライト用の空間グリッドのセルの一辺（ワールド単位）。</summary>
+    static constexpr float kSpriteGridCellSize = 256.0f;
+
+    /// <summary>スプライトの回転の速さ（ラジアン/秒）。</summary>
+    static constexpr float kSpriteSpinSpeed = 1.0f;
+    /// <summary>スプライトが左右に動く速さ（ワールド単位/秒）。</summary>
+    static constexpr float kSpriteSwaySpeed = 120.0f;
+    /// <summary>スプライトが往復する範囲（原点からの距離）。</summary>
+    static constexpr float kSpriteSwayRange = 200.0f;
+
     Sprite sprite_; // このシーンで使う単独スプライト
     Camera camera_; // 3D カメラ
 
+    // スプライトの可視判定（userData は spriteTable_ の添字）
+    SpatialGrid2D spriteGrid_;
+    std::vector<const Sprite *> spriteTable_;
+    std::vector<SpatialGrid2D::ProxyId> spriteProxies_; // spriteTable_ と同じ並び
+    std::vector<uint32_t> visibleSprites_;
+
+    // 固定ステップのシミュレーション（Sprite 自身が最新ステップの姿勢を持つ）
+    std::vector<SpriteTransform> prevTransforms_; // spriteTable_ と同じ並び
+    float spriteVelocityX_ = kSpriteSwaySpeed;
+
     // IMGUI 用一時値（ドラッグ操作をスムーズにするため保持）
     Vector3 camPos_{0.0f, 3.0f, -8.0f};
     Vector3 camTarget_{0.0f, 1.0f, 0.0f};
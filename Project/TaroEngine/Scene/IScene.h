@@ -1,5 +1,6 @@
 #pragma once
 #include "EngineContext.h"
+#include "RenderSnapshot.h"
 
 /// <summary>
 /// シーンの共通インターフェイス。<br/>
@@ -20,6 +21,14 @@ public:
     /// <param name="engine">エンジンの共有コンテキスト。</param>
     virtual void Initialize(const EngineContext &engine) = 0;
 
+    /// <summary>
+    /// 固定ステップの更新処理（既定では何もしない）。<br/>
+    /// 物理などの重いシミュレーションや決定的に進めたい処理は、描画レートと切り離してここで進める。
+    /// 1 フレームに 0 回以上、Update より前に呼ばれる。
+    /// </summary>
+    /// <param name="fixedDt">1 ステップの秒数（一定）。</param>
+    virtual void FixedUpdate(float fixedDt) { (void)fixedDt; }
+
     /// <summary>
     /// 毎フレームの更新処理。<br/>
     /// 入力やアニメーション、ゲームロジックを進行させる。
@@ -32,9 +41,29 @@ public:
     /// エンジンのコマンドリストなどを利用して、シーン内のオブジェクトを描画する。
     /// </summary>
     /// <param name="engine">エンジンの共有コンテキスト。</param>
-    /// <param name="rc">描画コンテキスト（コマンドリストやターゲット情報）。</param>
+    /// <param name="rc">
+    /// 描画コンテキスト（コマンドリストやターゲット情報）。<br/>
+    /// FixedUpdate で動かす物体は rc.interpolationAlpha で前回と最新のステップの状態を補間して描く。
+    /// </param>
     virtual void Draw(const EngineContext &engine, const RenderContext &rc) = 0;
 
+    /// <summary>
+    /// 描画データをスナップショットへ書き出す（シミュレーションスレッドで Update の後に呼ばれる）。<br/>
+    /// 対応するシーンは描画スレッドと並行して次のフレームを更新できる（パイプライン実行）。
+    /// </summary>
+    /// <param name="out">書き出し先（空にしてから渡される。interpolationAlpha は設定済み）。</param>
+    /// <returns>書き出したら true。false（既定）なら Draw を同じスレッドで呼ぶ従来の方式で描く。</returns>
+    virtual bool ExtractRenderData(RenderSnapshot &out) {
+        (void)out;
+        return false;
+    }
+
+    /// <summary>
+    /// ImGui などシーンの状態に直接触れる UI を描く（パイプライン実行時のみ、描画スレッドで呼ばれる）。<br/>
+    /// この間シミュレーションは止まっているので、シーンの状態を書き換えてよい。
+    /// </summary>
+    virtual void DrawUI() {}
+
     /// <summary>
     /// 終了処理。<br/>
     /// シーン固有のリソースを解放する。
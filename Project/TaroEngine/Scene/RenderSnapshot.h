@@ -0,0 +1,25 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "SpriteBatchBuilder.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 1 フレームを描画するのに必要なデータの不変コピー。<br/>
+/// シミュレーションスレッドが IScene::ExtractRenderData で書き、
+/// 描画スレッドはシーン本体に触れずにこれだけを見てコマンドを積む。
+/// </summary>
+struct RenderSnapshot {
+    uint64_t frameIndex = 0;         ///< シミュレーションのフレーム番号
+    float interpolationAlpha = 1.0f; ///< 固定ステップ間の補間係数
+    bool extracted = false;          ///< シーンが描画データを書き出したか（false なら従来の Draw で描く）
+
+    Matrix4x4 viewProj{};                             ///< View * Projection
+    std::vector<SpriteBatchBuilder::Entry> sprites;   ///< スプライトの描画要求
+
+    /// <summary>次のフレーム用に中身を空にする（容量は残す）。</summary>
+    void Clear() {
+        extracted = false;
+        sprites.clear();
+    }
+};
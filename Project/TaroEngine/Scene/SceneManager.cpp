@@ -1,4 +1,7 @@
 #include "SceneManager.h"
+#include "Profiler.h"
+#include "SpriteBatch.h"
+#include "SpriteCommon.h"
 
 void SceneManager::Initialize(const EngineContext &engine) {
     engine_ = &engine;
@@ -16,7 +19,7 @@ void SceneManager::Finalize() {
 }
 
 void SceneManager::ChangeScene(std::unique_ptr<IScene> next) {
-    // 次フレームの Update 冒頭で確実に切り替える
+    // 次フレームの FixedUpdate / Update 冒頭で確実に切り替える
     pending_ = std::move(next);
 }
 
@@ -38,7 +41,18 @@ void SceneManager::ProcessPendingChange() {
     }
 }
 
+void SceneManager::FixedUpdate(float fixedDt) {
+    TARO_PROFILE_FUNCTION();
+    // 切替は更新の先頭で行う（このフレームで最初に呼ばれた方で切り替わる）
+    ProcessPendingChange();
+
+    if (currentInitialized_ && current_) {
+        current_->FixedUpdate(fixedDt);
+    }
+}
+
 void SceneManager::Update(float dt) {
+    TARO_PROFILE_FUNCTION();
     // 切替は Update の先頭で行う（安全に）
     ProcessPendingChange();
 
@@ -48,7 +62,34 @@ void SceneManager::Update(float dt) {
 }
 
 void SceneManager::Draw(const RenderContext &rc) {
+    TARO_PROFILE_FUNCTION();
     if (currentInitialized_ && current_ && engine_) {
         current_->Draw(*engine_, rc);
     }
 }
+
+bool SceneManager::ExtractRenderData(RenderSnapshot &out) {
+    TARO_PROFILE_FUNCTION();
+    if (currentInitialized_ && current_) {
+        return current_->ExtractRenderData(out);
+    }
+    return false;
+}
+
+void SceneManager::DrawUI() {
+    if (currentInitialized_ && current_) {
+        current_->DrawUI();
+    }
+}
+
+void SceneManager::DrawSnapshot(const RenderContext &rc, const RenderSnapshot &snapshot) {
+    TARO_PROFILE_FUNCTION();
+    if (!engine_ || snapshot.sprites.empty()) return;
+
+    // スプライト描画（インスタンス描画で 1 ドローにまとめる）
+    engine_->spriteBatch->Begin(snapshot.viewProj);
+    for (const SpriteBatchBuilder::Entry &entry : snapshot.sprites) {
+        engine_->spriteBatch->Add(entry);
+    }
+    engine_->spriteBatch->End(rc.commandList, *engine_->spriteCommon);
+}
@@ -19,7 +19,7 @@ std::unique_ptr<IScene> MakeScene(Args&&... args) {
 /// <summary>
 /// シーン遷移を管理する最小限のマネージャ。<br/>
 /// - ChangeScene() で次のシーンを予約<br/>
-/// - Update() の先頭で安全に切替（Finalize/Initialize を自動実行）
+/// - FixedUpdate() / Update() の先頭で安全に切替（Finalize/Initialize を自動実行）
 /// </summary>
 class SceneManager {
 public:
@@ -29,6 +29,13 @@ public:
     /// <param name="engine">エンジンの共有コンテキスト。</param>
     void Initialize(const EngineContext &engine);
 
+    /// <summary>
+    /// 固定ステップの更新処理（FixedTimestep が返した回数だけ呼ぶ）。<br/>
+    /// 必要ならこの時点でシーンを切替する。
+    /// </summary>
+    /// <param name="fixedDt">1 ステップの秒数。</param>
+    void FixedUpdate(float fixedDt);
+
     /// <summary>
     /// フレーム更新処理。<br/>
     /// 必要ならこの時点でシーンを切替する。
@@ -42,6 +49,26 @@ public:
     /// <param name="rc">描画コンテキスト。</param>
     void Draw(const RenderContext &rc);
 
+    /// <summary>
+    /// 現在のシーンの描画データをスナップショットへ書き出す（シミュレーションスレッドで呼ぶ）。
+    /// </summary>
+    /// <param name="out">書き出し先。</param>
+    /// <returns>シーンが対応していて書き出したら true。</returns>
+    bool ExtractRenderData(RenderSnapshot &out);
+
+    /// <summary>
+    /// 現在のシーンの UI を描く（シミュレーションが止まっている間に描画スレッドで呼ぶ）。
+    /// </summary>
+    void DrawUI();
+
+    /// <summary>
+    /// スナップショットの内容を描画する。シーン本体には触れないので、
+    /// シミュレーションスレッドが次のフレームを更新している間に呼んでよい。
+    /// </summary>
+    /// <param name="rc">描画コンテキスト。</param>
+    /// <param name="snapshot">描画するスナップショット。</param>
+    void DrawSnapshot(const RenderContext &rc, const RenderSnapshot &snapshot);
+
     /// <summary>
     /// 破棄処理。<br/>
     /// 現在のシーンを Finalize する。
@@ -50,7 +77,7 @@ public:
 
     /// <summary>
     /// 次のシーンへ切替を予約する。<br/>
-    /// （即時ではなく、次フレームの Update 冒頭で切替される）
+    /// （即時ではなく、次フレームの FixedUpdate / Update 冒頭で切替される）
     /// </summary>
     /// <param name="next">次のシーン。</param>
     void ChangeScene(std::unique_ptr<IScene> next);
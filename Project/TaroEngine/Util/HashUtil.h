@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/// <summary>
+/// 安定したハッシュ値（実行ごと・環境ごとに変わらない）を求めるユーティリティ。<br/>
+/// ディスクキャッシュのキーなど、保存して次回起動時に照合する用途で使う。
+/// std::hash は実装依存なのでこの用途には使わない。
+/// </summary>
+namespace HashUtil {
+
+    /// <summary>
+    /// FNV-1a 64bit の逐次計算器。
+    /// </summary>
+    struct Fnv1a64 {
+        static constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+        static constexpr uint64_t kPrime = 1099511628211ull;
+
+        uint64_t value = kOffsetBasis;
+
+        /// <summary>バイト列を混ぜる。</summary>
+        void AddBytes(const void *data, size_t size) {
+            const auto *p = static_cast<const uint8_t *>(data);
+            for (size_t i = 0; i < size; ++i) {
+                value ^= p[i];
+                value *= kPrime;
+            }
+        }
+
+        /// <summary>32bit 値をリトルエンディアンで混ぜる。</summary>
+        void AddU32(uint32_t v) {
+            const uint8_t bytes[4] = {
+                static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8),
+                static_cast<uint8_t>(v >> 16), static_cast<uint8_t>(v >> 24)};
+            AddBytes(bytes, sizeof(bytes));
+        }
+
+        /// <summary>64bit 値をリトルエンディアンで混ぜる。</summary>
+        void AddU64(uint64_t v) {
+            AddU32(static_cast<uint32_t>(v));
+            AddU32(static_cast<uint32_t>(v >> 32));
+        }
+
+        /// <summary>float をビット列のまま混ぜる（-0.0 と 0.0 は区別される）。</summary>
+        void AddFloat(float f) {
+            uint32_t bits = 0;
+            static_assert(sizeof(bits) == sizeof(f));
+            std::memcpy(&bits, &f, sizeof(bits));
+            AddU32(bits);
+        }
+
+        /// <summary>長さを前置して文字列を混ぜる（"ab"+"c" と "a"+"bc" を区別する）。</summary>
+        void AddString(const std::string &s) {
+            AddU64(s.size());
+            AddBytes(s.data(), s.size());
+        }
+
+        /// <summary>長さを前置してワイド文字列を混ぜる（コード単位は 32bit に揃える）。</summary>
+        void AddWString(const std::wstring &s) {
+            AddU64(s.size());
+            for (wchar_t c : s) AddU32(static_cast<uint32_t>(c));
+        }
+    };
+
+    /// <summary>
+    /// バイト列の FNV-1a 64bit ハッシュを返す。
+    /// </summary>
+    inline uint64_t Fnv1a(const void *data, size_t size) {
+        Fnv1a64 h;
+        h.AddBytes(data, size);
+        return h.value;
+    }
+
+} // namespace HashUtil
@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// TaroEngineBench 用の最小限のベンチマーク枠組み。<br/>
+/// TARO_BENCH(Name) { ... } で定義した関数が起動時に登録され、BenchMain から順に呼ばれる。
+/// </summary>
+namespace Bench {
+
+    /// <summary>
+    /// 1 つのベンチマーク関数に渡される実行条件と結果の出力先。
+    /// </summary>
+    class Context {
+    public:
+        explicit Context(bool quick) : quick_(quick) {}
+
+        /// <summary>--quick（ctest からの動作確認）なら true。</summary>
+        bool IsQuick() const { return quick_; }
+
+        /// <summary>通常時は full、--quick 時は quick を返す（問題サイズの切り替え用）。</summary>
+        size_t Scale(size_t full, size_t quick) const { return quick_ ? quick : full; }
+
+        /// <summary>計測の繰り返し回数（最小値を採用する）。</summary>
+        int GetRepeat() const { return quick_ ? 1 : 5; }
+
+        /// <summary>
+        /// 1 行ぶんの結果を出力する。
+        /// </summary>
+        /// <param name="caseName">計測ケース名。</param>
+        /// <param name="ms">所要時間（ミリ秒）。</param>
+        /// <param name="items">処理した要素数（0 なら 1 要素あたりの時間を出さない）。</param>
+        void Report(const std::string &caseName, double ms, size_t items = 0) const;
+
+        /// <summary>補足情報（パーセンタイルなど）を 1 行出力する。</summary>
+        void Note(const std::string &text) const;
+
+        /// <summary>
+        /// fn を GetRepeat() 回実行し、最短の所要時間（ミリ秒）を返す。
+        /// </summary>
+        template <typename F>
+        double Measure(F &&fn) const {
+            double best = 0.0;
+            for (int r = 0; r < GetRepeat(); ++r) {
+                const auto t0 = std::chrono::steady_clock::now();
+                fn();
+                const auto t1 = std::chrono::steady_clock::now();
+                const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+                if (r == 0 || ms < best) best = ms;
+            }
+            return best;
+        }
+
+    private:
+        bool quick_ = false;
+    };
+
+    using Function = void (*)(Context &);
+
+    /// <summary>ベンチマーク関数を登録する（TARO_BENCH から使う）。</summary>
+    bool Register(const char *name, Function fn);
+
+    /// <summary>値を使ったことにして、計算が最適化で消えるのを防ぐ。</summary>
+    void DoNotOptimize(const void *p);
+
+    template <typename T>
+    inline void DoNotOptimize(const T &value) { DoNotOptimize(static_cast<const void *>(&value)); }
+
+} // namespace Bench
+
+#define TARO_BENCH(name)                                                         \
+    static void TaroBench_##name(Bench::Context &ctx);                           \
+    static const bool kTaroBenchRegistered_##name = Bench::Register(#name, &TaroBench_##name); \
+    static void TaroBench_##name([[maybe_unused]] Bench::Context &ctx)
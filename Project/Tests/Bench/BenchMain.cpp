@@ -0,0 +1,78 @@
+#include "Bench.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    struct Entry {
+        const char *name;
+        Bench::Function fn;
+    };
+
+    // DoNotOptimize の書き込み先（volatile なので書き込みは消えない）
+    const void *volatile gSink = nullptr;
+
+    std::vector<Entry> &GetRegistry() {
+        static std::vector<Entry> registry;
+        return registry;
+    }
+
+} // namespace
+
+bool Bench::Register(const char *name, Function fn) {
+    GetRegistry().push_back({name, fn});
+    return true;
+}
+
+void Bench::DoNotOptimize(const void *p) {
+    gSink = p;
+}
+
+void Bench::Context::Report(const std::string &caseName, double ms, size_t items) const {
+    if (items > 0) {
+        std::printf("  %-40s %10.3f ms  %9.2f ns/item\n", caseName.c_str(), ms,
+            ms * 1.0e6 / static_cast<double>(items));
+    } else {
+        std::printf("  %-40s %10.3f ms\n", caseName.c_str(), ms);
+    }
+    std::fflush(stdout);
+}
+
+void Bench::Context::Note(const std::string &text) const {
+    std::printf("      %s\n", text.c_str());
+    std::fflush(stdout);
+}
+
+/// 使い方: TaroEngineBench [--quick] [名前の一部 ...]
+int main(int argc, char **argv) {
+    bool quick = false;
+    std::vector<const char *> filters;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else {
+            filters.push_back(argv[i]);
+        }
+    }
+
+    int ran = 0;
+    for (const Entry &e : GetRegistry()) {
+        bool match = filters.empty();
+        for (const char *f : filters) {
+            if (std::strstr(e.name, f)) match = true;
+        }
+        if (!match) continue;
+
+        std::printf("[%s]\n", e.name);
+        Bench::Context ctx(quick);
+        e.fn(ctx);
+        ++ran;
+    }
+
+    if (ran == 0) {
+        std::fprintf(stderr, "no benchmark matched\n");
+        return 1;
+    }
+    return 0;
+}
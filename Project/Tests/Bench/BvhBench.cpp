@@ -0,0 +1,149 @@
+#include "Bench.h"
+#include "Bvh.h"
+#include "JobSystem.h"
+#include "MatrixUtil.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Bvh の構築・追従・検索のコストを測る。
+//   Build      : 直列と JobSystem 付き（大きな部分木とビン集計を並列化）
+//   Refit      : 全オブジェクトを少し動かした後の付け直し（毎フレームの想定）
+//   Frustum    : QueryFrustum と、全オブジェクトの SoA を FrustumCulling::CullAabbs で総当たりする場合
+//   Raycast    : ピッキング 1 回と、全オブジェクトへのスラブ判定の総当たり
+// 配置は広い範囲に散らばる箱と、カメラの正面に固まった箱（全体の 1/4）の混在。
+// 固まった側がまとめて映るので可視率は 3 割ほどあり、BVH の視錐台検索が総当たりに勝つのは可視率がもっと低いとき
+namespace {
+
+    std::vector<Bvh::Aabb> MakeScene(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> wide(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> cluster(-20.0f, 20.0f);
+        std::uniform_real_distribution<float> half(0.1f, 2.0f);
+        std::vector<Bvh::Aabb> boxes(count);
+        for (size_t i = 0; i < count; ++i) {
+            const bool clustered = (i % 4) == 0;
+            const Vector3 c = clustered ? Vector3(cluster(rng), cluster(rng), 200.0f + cluster(rng))
+                                        : Vector3(wide(rng), wide(rng), wide(rng));
+            const Vector3 h(half(rng), half(rng), half(rng));
+            boxes[i] = {Vector3(c.x - h.x, c.y - h.y, c.z - h.z), Vector3(c.x + h.x, c.y + h.y, c.z + h.z)};
+        }
+        return boxes;
+    }
+
+    Frustum MakeFrustum() {
+        const Matrix4x4 view = MatrixUtil::MakeViewMatrix(Vector3(0.0f, 20.0f, -100.0f), Vector3(0.0f, 0.0f, 200.0f),
+            Vector3(0.0f, 1.0f, 0.0f));
+        const Matrix4x4 proj = MatrixUtil::MakePerspectiveFovMatrix(1.0471976f, 16.0f / 9.0f, 0.1f, 800.0f);
+        return Frustum::FromViewProjection(MatrixUtil::Multiply(view, proj));
+    }
+
+    // Bvh と同じスラブ判定（総当たりの比較用）
+    float RayEntry(const Bvh::Aabb &a, const Vector3 &origin, const Vector3 &invDir, float maxT) {
+        const float tx0 = (a.min.x - origin.x) * invDir.x, tx1 = (a.max.x - origin.x) * invDir.x;
+        const float ty0 = (a.min.y - origin.y) * invDir.y, ty1 = (a.max.y - origin.y) * invDir.y;
+        const float tz0 = (a.min.z - origin.z) * invDir.z, tz1 = (a.max.z - origin.z) * invDir.z;
+        const float tNear = std::fmax(std::fmax(std::fmin(tx0, tx1), std::fmin(ty0, ty1)), std::fmax(std::fmin(tz0, tz1), 0.0f));
+        const float tFar = std::fmin(std::fmin(std::fmax(tx0, tx1), std::fmax(ty0, ty1)), std::fmin(std::fmax(tz0, tz1), maxT));
+        return tNear <= tFar ? tNear : INFINITY;
+    }
+
+} // namespace
+
+TARO_BENCH(Bvh) {
+    const size_t count = ctx.Scale(1000000, 20000);
+    const std::vector<Bvh::Aabb> boxes = MakeScene(count);
+    const uint32_t n = static_cast<uint32_t>(count);
+    const std::string suffix = " (" + std::to_string(count) + ")";
+    char name[96];
+
+    // --- 構築 ---
+    Bvh bvh;
+    const double msBuild = ctx.Measure([&] { bvh.Build(boxes.data(), n); });
+    ctx.Report("Build serial" + suffix, msBuild, count);
+
+    JobSystem jobs;
+    jobs.Initialize(ctx.IsQuick() ? 2u : JobSystem::DefaultWorkerCount());
+    const double msBuildJobs = ctx.Measure([&] { bvh.Build(boxes.data(), n, &jobs); });
+    std::snprintf(name, sizeof(name), "Build jobs x%u (speedup %.2f)", jobs.GetWorkerCount() + 1, msBuild / msBuildJobs);
+    ctx.Report(name + suffix, msBuildJobs, count);
+    jobs.Finalize();
+
+    std::snprintf(name, sizeof(name), "%zu nodes, SAH cost %.1f", bvh.GetNodes().size(), bvh.ComputeSahCost());
+    ctx.Note(name);
+
+    // --- 追従（全オブジェクトを少しずつ動かす） ---
+    std::vector<Bvh::Aabb> moved = boxes;
+    for (size_t i = 0; i < count; ++i) {
+        const float d = static_cast<float>(i % 7) * 0.1f - 0.3f;
+        moved[i].min.x += d;
+        moved[i].max.x += d;
+    }
+    const double msRefit = ctx.Measure([&] { bvh.Refit(moved.data()); });
+    ctx.Report("Refit" + suffix, msRefit, count);
+    std::snprintf(name, sizeof(name), "quality after refit %.3f (rebuild above %.1f)", bvh.GetQualityRatio(),
+        Bvh::kRebuildCostRatio);
+    ctx.Note(name);
+    bvh.Build(boxes.data(), n);
+
+    // --- 視錐台 ---
+    const Frustum frustum = MakeFrustum();
+    std::vector<uint32_t> found;
+    found.reserve(count);
+    const double msQuery = ctx.Measure([&] {
+        found.clear();
+        bvh.QueryFrustum(frustum, found);
+        Bench::DoNotOptimize(found.data());
+    });
+    ctx.Report("QueryFrustum" + suffix, msQuery, count);
+    const size_t visible = found.size();
+
+    std::vector<float> cx(count), cy(count), cz(count), ex(count), ey(count), ez(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Bvh::Aabb &b = boxes[i];
+        cx[i] = (b.min.x + b.max.x) * 0.5f;
+        cy[i] = (b.min.y + b.max.y) * 0.5f;
+        cz[i] = (b.min.z + b.max.z) * 0.5f;
+        ex[i] = (b.max.x - b.min.x) * 0.5f;
+        ey[i] = (b.max.y - b.min.y) * 0.5f;
+        ez[i] = (b.max.z - b.min.z) * 0.5f;
+    }
+    const FrustumCulling::AabbStreams streams{cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data(), count};
+    std::vector<uint32_t> visibleList(count);
+    const double msCull = ctx.Measure([&] {
+        Bench::DoNotOptimize(FrustumCulling::CullAabbs(frustum, streams, visibleList.data()));
+    });
+    std::snprintf(name, sizeof(name), "CullAabbs all (BVH x%.1f)", msCull / msQuery);
+    ctx.Report(name + suffix, msCull, count);
+    std::snprintf(name, sizeof(name), "visible %zu (%.2f%%)", visible, 100.0 * static_cast<double>(visible) / count);
+    ctx.Note(name);
+
+    // --- レイ（ピッキング） ---
+    constexpr int kRays = 64;
+    std::vector<Vector3> directions;
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> spread(-0.3f, 0.3f);
+    for (int r = 0; r < kRays; ++r) directions.emplace_back(spread(rng), spread(rng), 1.0f);
+    const Vector3 origin(0.0f, 20.0f, -100.0f);
+
+    const double msRay = ctx.Measure([&] {
+        Bvh::RayHit hit;
+        for (const Vector3 &d : directions) {
+            Bench::DoNotOptimize(bvh.Raycast(origin, d, INFINITY, hit));
+        }
+    });
+    ctx.Report("Raycast" + suffix, msRay, kRays);
+
+    const double msRayBrute = ctx.Measure([&] {
+        for (const Vector3 &d : directions) {
+            const Vector3 inv(1.0f / d.x, 1.0f / d.y, 1.0f / d.z);
+            float best = INFINITY;
+            for (const Bvh::Aabb &b : boxes) best = std::fmin(best, RayEntry(b, origin, inv, best));
+            Bench::DoNotOptimize(best);
+        }
+    });
+    std::snprintf(name, sizeof(name), "Raycast all (BVH x%.0f)", msRayBrute / msRay);
+    ctx.Report(name + suffix, msRayBrute, kRays);
+}
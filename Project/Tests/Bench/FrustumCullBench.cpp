@@ -0,0 +1,96 @@
+#include "Bench.h"
+#include "Frustum.h"
+#include "MatrixUtil.h"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// N 個の境界ボリュームの視錐台カリングを、経路ごとに比べる。
+//   PerElement: Frustum::IntersectsSphere / IntersectsAabb を 1 つずつ呼んで可視リストを作る（AoS からの素朴な判定）
+//   Batch     : FrustumCulling::CullSpheres / CullAabbs（SoA を SimdConfig のバックエンドでまとめて判定）
+// 可視率はカメラの向きで変わるので、視野の外にも大半が散らばる配置で測る
+namespace {
+
+    struct BoundsSoA {
+        std::vector<float> x, y, z, radius, ex, ey, ez;
+    };
+
+    BoundsSoA MakeBounds(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.5f, 4.0f);
+        BoundsSoA b;
+        for (size_t i = 0; i < count; ++i) {
+            b.x.push_back(pos(rng));
+            b.y.push_back(pos(rng));
+            b.z.push_back(pos(rng));
+            b.radius.push_back(size(rng));
+            b.ex.push_back(size(rng));
+            b.ey.push_back(size(rng));
+            b.ez.push_back(size(rng));
+        }
+        return b;
+    }
+
+    Frustum MakeFrustum() {
+        const Matrix4x4 view = MatrixUtil::MakeViewMatrix(Vector3(0.0f, 10.0f, -50.0f), Vector3(0.0f, 0.0f, 100.0f),
+            Vector3(0.0f, 1.0f, 0.0f));
+        const Matrix4x4 proj = MatrixUtil::MakePerspectiveFovMatrix(1.0471976f, 16.0f / 9.0f, 0.1f, 400.0f);
+        return Frustum::FromViewProjection(MatrixUtil::Multiply(view, proj));
+    }
+
+} // namespace
+
+TARO_BENCH(FrustumCull) {
+    const size_t count = ctx.Scale(1000000, 4096);
+    const BoundsSoA b = MakeBounds(count);
+    const Frustum frustum = MakeFrustum();
+    std::vector<uint32_t> visible(count);
+    size_t visibleCount = 0;
+
+    const double msSpheres = ctx.Measure([&] {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (frustum.IntersectsSphere(Vector3(b.x[i], b.y[i], b.z[i]), b.radius[i])) {
+                visible[n++] = static_cast<uint32_t>(i);
+            }
+        }
+        visibleCount = n;
+        Bench::DoNotOptimize(visible.data());
+    });
+    ctx.Report("Spheres PerElement", msSpheres, count);
+
+    const FrustumCulling::SphereStreams spheres{b.x.data(), b.y.data(), b.z.data(), b.radius.data(), count};
+    const double msSpheresBatch = ctx.Measure([&] {
+        visibleCount = FrustumCulling::CullSpheres(frustum, spheres, visible.data());
+        Bench::DoNotOptimize(visible.data());
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "Spheres Batch (speedup %.2f)", msSpheres / msSpheresBatch);
+    ctx.Report(name, msSpheresBatch, count);
+
+    std::snprintf(name, sizeof(name), "visible %.1f%% of %zu", 100.0 * static_cast<double>(visibleCount) / count, count);
+    ctx.Note(name);
+
+    const double msAabbs = ctx.Measure([&] {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (frustum.IntersectsAabb(Vector3(b.x[i], b.y[i], b.z[i]), Vector3(b.ex[i], b.ey[i], b.ez[i]))) {
+                visible[n++] = static_cast<uint32_t>(i);
+            }
+        }
+        visibleCount = n;
+        Bench::DoNotOptimize(visible.data());
+    });
+    ctx.Report("Aabbs PerElement", msAabbs, count);
+
+    const FrustumCulling::AabbStreams aabbs{
+        b.x.data(), b.y.data(), b.z.data(), b.ex.data(), b.ey.data(), b.ez.data(), count};
+    const double msAabbsBatch = ctx.Measure([&] {
+        visibleCount = FrustumCulling::CullAabbs(frustum, aabbs, visible.data());
+        Bench::DoNotOptimize(visible.data());
+    });
+    std::snprintf(name, sizeof(name), "Aabbs Batch (speedup %.2f)", msAabbs / msAabbsBatch);
+    ctx.Report(name, msAabbsBatch, count);
+}
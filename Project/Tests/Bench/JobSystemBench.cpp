@@ -0,0 +1,149 @@
+#include "Bench.h"
+#include "JobSystem.h"
+#include "WorkStealingDeque.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// JobSystem（ワークスティーリング）のスケジューリングコストとスケーリングを測る。
+//   Fib        : 再帰的に子ジョブを積んで待つ（細かいジョブの生成・盗み・入れ子 Wait のコスト）
+//   ParallelFor: 1 要素あたり一定の計算をワーカー数を変えて分割する（物理コア数で頭打ちになる）
+//   Deque      : 所有スレッドの Push / Pop と、盗むスレッドの数を変えたときの Steal の取り合い
+// いずれも共有状態はアトミックか各ジョブ専用の領域だけを触るので、ThreadSanitizer 下でもそのまま動く
+namespace {
+
+    // この深さより下は直列で計算する（ジョブ 1 つが小さすぎるとスケジューリングだけになる）
+    constexpr uint32_t kFibCutoff = 12;
+
+    uint64_t SerialFib(uint32_t n) {
+        return n < 2 ? n : SerialFib(n - 1) + SerialFib(n - 2);
+    }
+
+    uint64_t JobFib(JobSystem &jobs, uint32_t n) {
+        if (n < kFibCutoff) return SerialFib(n);
+        uint64_t a = 0;
+        JobCounter counter;
+        jobs.Run(counter, [&] { a = JobFib(jobs, n - 1); });
+        const uint64_t b = JobFib(jobs, n - 2);
+        jobs.Wait(counter);
+        return a + b;
+    }
+
+    // 1 要素分の仕事（数百 ns 程度の浮動小数点演算）
+    float Work(size_t i) {
+        float x = static_cast<float>(i) * 0.001f;
+        for (int k = 0; k < 32; ++k) x = std::sin(x) * 0.5f + 0.25f;
+        return x;
+    }
+
+    uint32_t MaxWorkers(Bench::Context &ctx) {
+        return ctx.IsQuick() ? 2u : (std::max)(JobSystem::DefaultWorkerCount(), 1u);
+    }
+
+} // namespace
+
+TARO_BENCH(JobSystemFib) {
+    const uint32_t n = static_cast<uint32_t>(ctx.Scale(30, 22));
+    const double serial = ctx.Measure([&] { Bench::DoNotOptimize(SerialFib(n)); });
+    ctx.Report("serial", serial, 1);
+
+    for (uint32_t workers = 0; workers <= MaxWorkers(ctx); workers = workers == 0 ? 1 : workers * 2) {
+        JobSystem jobs;
+        jobs.Initialize(workers);
+        const double ms = ctx.Measure([&] { Bench::DoNotOptimize(JobFib(jobs, n)); });
+        jobs.Finalize();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "jobs x%u (speedup %.2f)", workers, serial / ms);
+        ctx.Report(name, ms, 1);
+    }
+}
+
+TARO_BENCH(JobSystemParallelFor) {
+    const size_t count = static_cast<size_t>(ctx.Scale(1 << 20, 1 << 14));
+    std::vector<float> out(count);
+
+    const double serial = ctx.Measure([&] {
+        for (size_t i = 0; i < count; ++i) out[i] = Work(i);
+        Bench::DoNotOptimize(out.data());
+    });
+    ctx.Report("serial", serial, count);
+
+    for (uint32_t workers = 1; workers <= MaxWorkers(ctx); workers *= 2) {
+        JobSystem jobs;
+        jobs.Initialize(workers);
+        for (const size_t grain : {size_t{256}, size_t{4096}}) {
+            const double ms = ctx.Measure([&] {
+                jobs.ParallelFor(count, grain, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) out[i] = Work(i);
+                });
+                Bench::DoNotOptimize(out.data());
+            });
+            char name[64];
+            std::snprintf(name, sizeof(name), "x%u grain %zu (speedup %.2f)", workers, grain, serial / ms);
+            ctx.Report(name, ms, count);
+        }
+        jobs.Finalize();
+    }
+}
+
+TARO_BENCH(WorkStealingDeque) {
+    const int items = static_cast<int>(ctx.Scale(1 << 20, 1 << 14));
+
+    // 盗むスレッドなし: 所有スレッドの Push / Pop だけ（フェンスの素のコスト）
+    {
+        WorkStealingDeque<int> deque(1024);
+        const double ms = ctx.Measure([&] {
+            int v = 0;
+            int64_t sum = 0;
+            for (int i = 0; i < items; ++i) {
+                deque.Push(i);
+                if (deque.Pop(v)) sum += v;
+            }
+            Bench::DoNotOptimize(sum);
+        });
+        ctx.Report("push+pop", ms, static_cast<uint64_t>(items));
+    }
+
+    // 盗むスレッドを増やして、所有スレッドが積んだものを取り合う
+    const uint32_t maxThieves = ctx.IsQuick() ? 1u : 4u;
+    for (uint32_t thieves = 1; thieves <= maxThieves; thieves *= 2) {
+        const double ms = ctx.Measure([&] {
+            WorkStealingDeque<int> deque(1024);
+            std::atomic<bool> done{false};
+            std::atomic<int64_t> stolen{0};
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < thieves; ++t) {
+                threads.emplace_back([&] {
+                    int v = 0;
+                    int64_t local = 0;
+                    while (!done.load(std::memory_order_acquire)) {
+                        if (deque.Steal(v)) ++local;
+                        else std::this_thread::yield();
+                    }
+                    stolen.fetch_add(local, std::memory_order_relaxed);
+                });
+            }
+            int v = 0;
+            int64_t popped = 0;
+            for (int i = 0; i < items; ++i) {
+                while (!deque.Push(i)) {
+                    if (deque.Pop(v)) ++popped;
+                }
+                if ((i & 1) && deque.Pop(v)) ++popped;
+            }
+            while (deque.Pop(v)) ++popped;
+            done.store(true, std::memory_order_release);
+            for (auto &t : threads) t.join();
+            Bench::DoNotOptimize(popped + stolen.load());
+        });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "push+pop with %u thieves", thieves);
+        ctx.Report(name, ms, static_cast<uint64_t>(items));
+    }
+}
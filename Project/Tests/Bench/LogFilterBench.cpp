@@ -0,0 +1,107 @@
+#include "Bench.h"
+#include "LogConfig.h"
+#include "MultiLogger.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// 出力されないログ呼び出しの 1 回あたりのコスト。
+//   Log(eager string)      : 従来の呼び方。呼び出し側で文字列を組み立ててから捨てられる
+//   Logf (global off)      : MultiLogger 全体の下限で弾く（整形しない）
+//   Logf (every sink off)  : 全体は通し、各ロガーの下限を見て誰も受け付けないので戻る
+//   TARO_LOG_DEBUG         : TARO_LOG_MIN_LEVEL でビルドから消える（リリースビルドの既定）
+// 比較用に、受け付けられて整形まで行う Logf（enabled）も測る。
+// 判定だけのループが丸ごと消えないよう、どのケースも 1 回ごとに DoNotOptimize を呼ぶ（その分は全ケース共通）。
+namespace {
+
+    /// <summary>受け取った件数と長さだけを数えるロガー（書き出しのコストを除くため）。</summary>
+    class CountingLogger : public ILogger {
+    public:
+        void Log(LogLevel level, const std::string &msg) override {
+            Write(level, msg, std::chrono::system_clock::time_point{});
+        }
+
+        void Write(LogLevel, std::string_view msg, std::chrono::system_clock::time_point) override {
+            ++count;
+            bytes += msg.size();
+        }
+
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    struct Position {
+        float x;
+        float y;
+    };
+
+} // namespace
+
+TARO_BENCH(LogFilter) {
+    const size_t calls = ctx.Scale(2000000, 20000);
+
+    MultiLogger logger;
+    auto sinkA = std::make_shared<CountingLogger>();
+    auto sinkB = std::make_shared<CountingLogger>();
+    logger.AddLogger(sinkA);
+    logger.AddLogger(sinkB);
+
+    Position pos{12.5f, -3.25f};
+    Bench::DoNotOptimize(pos);
+
+    // --- 全体の下限で弾く ---
+    logger.SetMinLevel(LogLevel::INFO);
+    const double eager = ctx.Measure([&] {
+        for (size_t i = 0; i < calls; ++i) {
+            logger.Log(LogLevel::DEBUG, "entity " + std::to_string(i) + " pos=(" + std::to_string(pos.x) + ", " +
+                std::to_string(pos.y) + ")");
+            Bench::DoNotOptimize(i);
+        }
+    });
+    ctx.Report("Log(eager string), global off", eager, calls);
+
+    const double globalOff = ctx.Measure([&] {
+        for (size_t i = 0; i < calls; ++i) {
+            logger.Logf(LogLevel::DEBUG, "entity {} pos=({:.2f}, {:.2f})", i, pos.x, pos.y);
+            Bench::DoNotOptimize(i);
+        }
+    });
+    ctx.Report("Logf, global off", globalOff, calls);
+
+    // --- 全体は通すが、どのロガーも受け付けない ---
+    logger.SetMinLevel(LogLevel::DEBUG);
+    sinkA->SetMinLevel(LogLevel::WARN);
+    sinkB->SetMinLevel(LogLevel::ERR);
+    const double sinksOff = ctx.Measure([&] {
+        for (size_t i = 0; i < calls; ++i) {
+            logger.Logf(LogLevel::DEBUG, "entity {} pos=({:.2f}, {:.2f})", i, pos.x, pos.y);
+            Bench::DoNotOptimize(i);
+        }
+    });
+    ctx.Report("Logf, every sink off", sinksOff, calls);
+
+    // --- ビルドから消える ---
+    const double compiledOut = ctx.Measure([&] {
+        for (size_t i = 0; i < calls; ++i) {
+            TARO_LOG_DEBUG(logger, "entity {} pos=({:.2f}, {:.2f})", i, pos.x, pos.y);
+            Bench::DoNotOptimize(i);
+        }
+    });
+    ctx.Report(LogConfig::IsCompiledIn(LogLevel::DEBUG) ? "TARO_LOG_DEBUG (compiled in, every sink off)"
+        : "TARO_LOG_DEBUG (compiled out)", compiledOut, calls);
+
+    // --- 受け付けられる（整形して 1 つのロガーへ配信する） ---
+    const double enabled = ctx.Measure([&] {
+        for (size_t i = 0; i < calls; ++i) {
+            logger.Logf(LogLevel::WARN, "entity {} pos=({:.2f}, {:.2f})", i, pos.x, pos.y);
+            Bench::DoNotOptimize(i);
+        }
+    });
+    ctx.Report("Logf, enabled (format + 1 sink)", enabled, calls);
+
+    // 捨てられたメッセージはロガーに届いていないこと
+    const uint64_t expected = static_cast<uint64_t>(calls) * static_cast<uint64_t>(ctx.GetRepeat());
+    ctx.Note("delivered: sinkA " + std::to_string(sinkA->count) + ", sinkB " + std::to_string(sinkB->count) +
+        " (expected " + std::to_string(expected) + " / 0)");
+    Bench::DoNotOptimize(sinkA->bytes);
+}
@@ -0,0 +1,114 @@
+#include "AsyncLogger.h"
+#include "Bench.h"
+#include "FileLogger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 複数スレッドから同時にログを書いたときのスループットと、呼び出し側の 1 回あたりの待ち時間（レイテンシ）。
+//   FileLogger          : 同期（ミューテックスを取ってその場で整形・書き込み）
+//   AsyncLogger(Block)  : リングに積むだけで戻る。満杯なら空くまで待つ
+//   AsyncLogger(Drop)   : 満杯なら捨てて戻る
+// 所要時間は最後の Flush（ファイルへ書き終わるまで）を含む。
+namespace {
+
+    constexpr size_t kLatencySampleInterval = 16; // 何回に 1 回レイテンシを測るか
+
+    struct RunResult {
+        double ms = 0.0;
+        std::vector<uint32_t> latencyNs; // 全スレッドの標本
+    };
+
+    RunResult Run(ILogger &logger, uint32_t threadCount, size_t perThread) {
+        RunResult result;
+        std::vector<std::vector<uint32_t>> samples(threadCount);
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+
+        for (uint32_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                std::vector<uint32_t> &mine = samples[t];
+                mine.reserve(perThread / kLatencySampleInterval + 1);
+                const std::string base = "worker " + std::to_string(t) + " frame update, entity count = ";
+                std::string msg;
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+                for (size_t i = 0; i < perThread; ++i) {
+                    msg = base;
+                    msg += std::to_string(i);
+                    if (i % kLatencySampleInterval == 0) {
+                        const auto t0 = std::chrono::steady_clock::now();
+                        logger.Log(LogLevel::INFO, msg);
+                        const auto t1 = std::chrono::steady_clock::now();
+                        mine.push_back(static_cast<uint32_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+                    } else {
+                        logger.Log(LogLevel::INFO, msg);
+                    }
+                }
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto &th : threads) th.join();
+        logger.Flush();
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for (auto &s : samples) result.latencyNs.insert(result.latencyNs.end(), s.begin(), s.end());
+        return result;
+    }
+
+    std::string Percentiles(std::vector<uint32_t> v) {
+        if (v.empty()) return "latency: -";
+        std::sort(v.begin(), v.end());
+        auto at = [&](double p) { return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))]; };
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "latency p50 %u ns, p99 %u ns, p99.9 %u ns, max %u ns",
+            at(0.50), at(0.99), at(0.999), v.back());
+        return buf;
+    }
+
+} // namespace
+
+TARO_BENCH(Logger) {
+    const size_t perThread = ctx.Scale(100000, 2000);
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "TaroLoggerBench";
+    std::filesystem::create_directories(dir);
+
+    const uint32_t maxThreads = ctx.IsQuick() ? 2u : 8u;
+    for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+        const size_t total = perThread * threads;
+        const std::string suffix = " x" + std::to_string(threads) + " threads";
+
+        {
+            FileLogger file((dir / "sync.log").string(), false);
+            const RunResult r = Run(file, threads, perThread);
+            ctx.Report("FileLogger" + suffix, r.ms, total);
+            ctx.Note(Percentiles(r.latencyNs));
+        }
+
+        for (const auto policy : {AsyncLogger::OverflowPolicy::Block, AsyncLogger::OverflowPolicy::Drop}) {
+            const bool block = policy == AsyncLogger::OverflowPolicy::Block;
+            AsyncLogger::Options options;
+            options.policy = policy;
+            auto sink = std::make_shared<FileLogger>((dir / (block ? "block.log" : "drop.log")).string(), false);
+            AsyncLogger async(sink, options);
+
+            const RunResult r = Run(async, threads, perThread);
+            const AsyncLogger::Stats stats = async.GetStats();
+            ctx.Report(std::string(block ? "AsyncLogger(Block)" : "AsyncLogger(Drop)") + suffix, r.ms, total);
+            ctx.Note(Percentiles(r.latencyNs) + ", dropped " + std::to_string(stats.dropped) +
+                ", batches " + std::to_string(stats.batches));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
@@ -0,0 +1,79 @@
+#include "Bench.h"
+#include "ShaderJobQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// 偽のコンパイラで ShaderJobQueue のスケーリングを測る。
+//   Sleep: 1 件ごとに一定時間待つ（I/O・外部プロセス待ちを含むコンパイルの近似）
+//   Spin : 1 件ごとに一定時間 CPU を回す（DXC 本体の近似。物理コア数で頭打ちになる）
+// 各ジョブはワーカー番号で自分専用の「コンテキスト」を使う（ShaderCompiler の DXC インスタンスと同じ形）
+namespace {
+
+    struct FakeCompilerContext {
+        uint64_t compiled = 0;
+        uint64_t checksum = 0;
+    };
+
+    void FakeCompile(FakeCompilerContext &ctx, uint32_t job, std::chrono::microseconds latency, bool spin) {
+        if (spin) {
+            const auto until = std::chrono::steady_clock::now() + latency;
+            uint64_t x = job;
+            while (std::chrono::steady_clock::now() < until) {
+                x = x * 6364136223846793005ull + 1442695040888963407ull;
+            }
+            ctx.checksum += x;
+        } else {
+            std::this_thread::sleep_for(latency);
+            ctx.checksum += job;
+        }
+        ++ctx.compiled;
+    }
+
+    void RunMode(Bench::Context &ctx, const char *mode, bool spin) {
+        const uint32_t jobCount = static_cast<uint32_t>(ctx.Scale(256, 16));
+        const std::chrono::microseconds latency(ctx.IsQuick() ? 200 : 2000);
+
+        // 直列（従来のメインスレッドでの逐次コンパイル）
+        const double serial = ctx.Measure([&] {
+            FakeCompilerContext c;
+            for (uint32_t i = 0; i < jobCount; ++i) FakeCompile(c, i, latency, spin);
+            Bench::DoNotOptimize(c.checksum);
+        });
+        ctx.Report(std::string(mode) + " serial", serial, jobCount);
+
+        const uint32_t maxWorkers = ctx.IsQuick() ? 2u : 16u;
+        for (uint32_t workers = 1; workers <= maxWorkers; workers *= 2) {
+            ShaderJobQueue queue;
+            queue.Start(workers);
+            std::vector<FakeCompilerContext> contexts(workers);
+
+            const double ms = ctx.Measure([&] {
+                for (uint32_t i = 0; i < jobCount; ++i) {
+                    queue.Submit([&contexts, i, latency, spin](uint32_t worker) {
+                        FakeCompile(contexts[worker], i, latency, spin);
+                    });
+                }
+                queue.WaitIdle();
+            });
+            queue.Stop();
+
+            uint64_t compiled = 0;
+            for (const FakeCompilerContext &c : contexts) compiled += c.compiled;
+            Bench::DoNotOptimize(compiled);
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "%s queue x%u (speedup %.2f)", mode, workers, serial / ms);
+            ctx.Report(name, ms, jobCount);
+        }
+    }
+
+} // namespace
+
+TARO_BENCH(ShaderJobQueue) {
+    RunMode(ctx, "Sleep", false);
+    RunMode(ctx, "Spin", true);
+}
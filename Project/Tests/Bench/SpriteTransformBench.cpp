@@ -0,0 +1,99 @@
+#include "Bench.h"
+#include "JobSystem.h"
+#include "MatrixUtil.h"
+#include "SpriteBatchBuilder.h"
+#include "TransformMatrix.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// スプライト N 枚ぶんの WVP 計算を、経路ごとに比べる。
+//   PerSprite4x4   : 旧 Sprite::Update（Rz * T を 4x4 で作り VP と一般積、転置して TransformMatrix へ）
+//   PerSpriteAffine: 現 Sprite::Update（3x2 アフィンと VP の閉形式の積、転置して TransformMatrix へ）
+//   Builder        : SpriteBatchBuilder::Build（SoA カーネルで SpriteInstance へ）
+namespace {
+
+    struct SpriteParams {
+        float x, y, rot, w, h;
+    };
+
+    std::vector<SpriteParams> MakeSprites(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(0.0f, 1280.0f);
+        std::uniform_real_distribution<float> ang(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> size(8.0f, 128.0f);
+        std::vector<SpriteParams> sprites(count);
+        for (SpriteParams &s : sprites) {
+            s = {pos(rng), pos(rng), ang(rng), size(rng), size(rng)};
+        }
+        return sprites;
+    }
+
+    Matrix4x4 MakeViewProj() {
+        return MatrixUtil::Multiply(MatrixUtil::MakeIdentityMatrix(),
+            MatrixUtil::MakeOrthographicMatrix(1280.0f, 720.0f, 0.0f, 1.0f));
+    }
+
+} // namespace
+
+TARO_BENCH(SpriteTransform) {
+    const size_t count = ctx.Scale(100000, 2000);
+    const std::vector<SpriteParams> sprites = MakeSprites(count);
+    const Matrix4x4 vp = MakeViewProj();
+    const std::string suffix = " (" + std::to_string(count) + ")";
+
+    std::vector<TransformMatrix> records(count);
+
+    const double ms4x4 = ctx.Measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            const SpriteParams &s = sprites[i];
+            const Matrix4x4 world = MatrixUtil::Multiply(
+                MatrixUtil::MakeRotationZMatrix(s.rot), MatrixUtil::MakeTranslationMatrix(s.x, s.y, 0.0f));
+            const Matrix4x4 wvp = MatrixUtil::Multiply(world, vp);
+            records[i].World = MatrixUtil::Transpose(world);
+            records[i].WVP = MatrixUtil::Transpose(wvp);
+        }
+        Bench::DoNotOptimize(records.data());
+    });
+    ctx.Report("PerSprite4x4" + suffix, ms4x4, count);
+
+    const double msAffine = ctx.Measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            const SpriteParams &s = sprites[i];
+            const Matrix3x2 a = MatrixUtil::MakeAffine2DMatrix(s.rot, s.x, s.y);
+            records[i].World = MatrixUtil::Transpose(MatrixUtil::ToMatrix4x4(a));
+            records[i].WVP = MatrixUtil::Transpose(MatrixUtil::MultiplyAffine2D(a, vp));
+        }
+        Bench::DoNotOptimize(records.data());
+    });
+    ctx.Report("PerSpriteAffine" + suffix, msAffine, count);
+
+    SpriteBatchBuilder builder;
+    builder.Reserve(count);
+    for (const SpriteParams &s : sprites) {
+        SpriteBatchBuilder::Entry e;
+        e.position = {s.x, s.y};
+        e.size = {s.w, s.h};
+        e.rotation = s.rot;
+        builder.Add(e);
+    }
+    std::vector<SpriteInstance> instances(count);
+
+    const double msBuilder = ctx.Measure([&] {
+        builder.Build(vp, instances.data());
+        Bench::DoNotOptimize(instances.data());
+    });
+    ctx.Report("Builder" + suffix, msBuilder, count);
+
+    JobSystem jobs;
+    jobs.Initialize(JobSystem::DefaultWorkerCount());
+    builder.SetJobSystem(&jobs);
+    const double msParallel = ctx.Measure([&] {
+        builder.Build(vp, instances.data());
+        Bench::DoNotOptimize(instances.data());
+    });
+    ctx.Report("Builder+JobSystem x" + std::to_string(jobs.GetWorkerCount() + 1) + suffix, msParallel, count);
+    builder.SetJobSystem(nullptr);
+    jobs.Finalize();
+}
@@ -0,0 +1,269 @@
+#include "AsyncLogger.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // 受け取ったメッセージと Flush の時点を記録する sink。
+    // Hold 中は Write の中で止まるので、ワーカーを止めてリングを満杯にできる
+    class RecordingSink : public ILogger {
+    public:
+        struct Entry {
+            LogLevel level;
+            std::string message;
+        };
+
+        void Log(LogLevel level, const std::string &msg) override {
+            Write(level, msg, std::chrono::system_clock::now());
+        }
+
+        void Write(LogLevel level, std::string_view msg, std::chrono::system_clock::time_point) override {
+            std::unique_lock<std::mutex> lock(mutex_);
+            entries_.push_back({level, std::string(msg)});
+            if (held_) {
+                blocked_ = true;
+                cv_.notify_all();
+                cv_.wait(lock, [&] { return !held_; });
+                blocked_ = false;
+            }
+        }
+
+        void Flush() override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++flushCount_;
+            entriesAtLastFlush_ = entries_.size();
+        }
+
+        void Hold() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            held_ = true;
+        }
+
+        void Release() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            held_ = false;
+            cv_.notify_all();
+        }
+
+        // ワーカーが Write の中で止まるまで待つ
+        bool WaitUntilBlocked() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cv_.wait_for(lock, std::chrono::seconds(5), [&] { return blocked_; });
+        }
+
+        std::vector<Entry> Entries() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entries_;
+        }
+
+        size_t EntriesAtLastFlush() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entriesAtLastFlush_;
+        }
+
+        int FlushCount() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return flushCount_;
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<Entry> entries_;
+        size_t entriesAtLastFlush_ = 0;
+        int flushCount_ = 0;
+        bool held_ = false;
+        bool blocked_ = false;
+    };
+
+    std::vector<std::string> Messages(const std::vector<RecordingSink::Entry> &entries) {
+        std::vector<std::string> out;
+        for (const auto &e : entries) out.push_back(e.message);
+        return out;
+    }
+
+    // 満杯まで待たせられるよう小さなリングにする
+    AsyncLogger::Options SmallRing(AsyncLogger::OverflowPolicy policy) {
+        AsyncLogger::Options options;
+        options.capacity = 4;
+        options.policy = policy;
+        return options;
+    }
+
+} // namespace
+
+TEST(AsyncLoggerTest, SingleProducerKeepsOrder) {
+    auto sink = std::make_shared<RecordingSink>();
+    AsyncLogger::Options options;
+    options.capacity = 64; // 折り返しを何度も通す
+    AsyncLogger logger(sink, options);
+
+    constexpr int kCount = 10000;
+    for (int i = 0; i < kCount; ++i) {
+        logger.Log(LogLevel::INFO, std::to_string(i));
+    }
+    logger.Flush();
+
+    const std::vector<RecordingSink::Entry> entries = sink->Entries();
+    ASSERT_EQ(entries.size(), static_cast<size_t>(kCount));
+    for (int i = 0; i < kCount; ++i) {
+        EXPECT_EQ(entries[i].message, std::to_string(i));
+        EXPECT_EQ(entries[i].level, LogLevel::INFO);
+    }
+    EXPECT_EQ(logger.GetStats().written, static_cast<uint64_t>(kCount));
+    EXPECT_EQ(logger.GetStats().dropped, 0u);
+    EXPECT_GE(sink->EntriesAtLastFlush(), static_cast<size_t>(kCount)); // Flush は書き出しの後
+}
+
+TEST(AsyncLoggerTest, MultipleProducersLoseNothing) {
+    auto sink = std::make_shared<RecordingSink>();
+    AsyncLogger::Options options;
+    options.capacity = 16; // 生産者同士がセルを取り合う
+    AsyncLogger logger(sink, options);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&logger, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                logger.Log(LogLevel::DEBUG, std::to_string(t) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto &th : producers) th.join();
+    logger.Flush();
+
+    // スレッドごとの順序は保たれ、全件が 1 回ずつ届く
+    std::vector<int> next(kThreads, 0);
+    const std::vector<RecordingSink::Entry> entries = sink->Entries();
+    ASSERT_EQ(entries.size(), static_cast<size_t>(kThreads * kPerThread));
+    for (const auto &e : entries) {
+        const size_t colon = e.message.find(':');
+        const int t = std::stoi(e.message.substr(0, colon));
+        const int i = std::stoi(e.message.substr(colon + 1));
+        ASSERT_TRUE(t >= 0 && t < kThreads) << e.message;
+        EXPECT_EQ(i, next[t]) << "thread " << t;
+        next[t] = i + 1;
+    }
+    for (int t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(next[t], kPerThread) << "thread " << t;
+    }
+    EXPECT_EQ(logger.GetStats().dropped, 0u);
+}
+
+TEST(AsyncLoggerTest, DropPolicyReportsDroppedCountAsWarning) {
+    auto sink = std::make_shared<RecordingSink>();
+    AsyncLogger logger(sink, SmallRing(AsyncLogger::OverflowPolicy::Drop));
+
+    // 1 件目を書いている途中でワーカーを止める（そのセルもまだ空かない）
+    sink->Hold();
+    logger.Log(LogLevel::INFO, "m0");
+    if (!sink->WaitUntilBlocked()) {
+        sink->Release();
+        FAIL() << "worker did not reach the sink";
+    }
+
+    // 残り 3 セルが埋まり、その後の 5 件は待たずに捨てられる
+    for (int i = 1; i < 9; ++i) {
+        logger.Log(LogLevel::INFO, "m" + std::to_string(i));
+    }
+    EXPECT_EQ(logger.GetStats().dropped, 5u);
+
+    sink->Release();
+    logger.Flush();
+
+    const std::vector<RecordingSink::Entry> entries = sink->Entries();
+    EXPECT_EQ(Messages(entries), (std::vector<std::string>{
+        "m0", "m1", "m2", "m3", "AsyncLogger: 5 messages dropped (queue full)"}));
+    ASSERT_EQ(entries.size(), 5u);
+    EXPECT_EQ(entries.back().level, LogLevel::WARN);
+    EXPECT_EQ(logger.GetStats().written, 4u); // 報告は件数に含めない
+}
+
+TEST(AsyncLoggerTest, BlockPolicyWaitsForSpace) {
+    auto sink = std::make_shared<RecordingSink>();
+    AsyncLogger logger(sink, SmallRing(AsyncLogger::OverflowPolicy::Block));
+
+    sink->Hold();
+    logger.Log(LogLevel::INFO, "m0");
+    if (!sink->WaitUntilBlocked()) {
+        sink->Release();
+        FAIL() << "worker did not reach the sink";
+    }
+
+    // ワーカーが止まっている間は 3 件までしか積めず、生産者は 5 件目で待つ
+    constexpr int kCount = 20;
+    std::atomic<int> returned{0};
+    std::thread producer([&] {
+        for (int i = 1; i < kCount; ++i) {
+            logger.Log(LogLevel::INFO, "m" + std::to_string(i));
+            ++returned;
+        }
+    });
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (returned.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(returned.load(), 3);
+
+    sink->Release();
+    producer.join();
+    logger.Flush();
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < kCount; ++i) expected.push_back("m" + std::to_string(i));
+    EXPECT_EQ(Messages(sink->Entries()), expected);
+    EXPECT_EQ(logger.GetStats().dropped, 0u);
+}
+
+TEST(AsyncLoggerTest, FlushLevelWaitsForWriteAndSinkFlush) {
+    auto sink = std::make_shared<RecordingSink>();
+    AsyncLogger::Options options;
+    options.flushLevel = LogLevel::WARN;
+    AsyncLogger logger(sink, options);
+
+    for (int i = 0; i < 100; ++i) {
+        logger.Log(LogLevel::INFO, "info");
+    }
+    // 戻った時点で、それまでの分も含めて sink に書かれ、その後に Flush されている
+    logger.Log(LogLevel::WARN, "warn");
+    const std::vector<RecordingSink::Entry> entries = sink->Entries();
+    ASSERT_EQ(entries.size(), 101u);
+    EXPECT_EQ(entries.back().message, "warn");
+    EXPECT_GE(sink->FlushCount(), 1);
+    EXPECT_EQ(sink->EntriesAtLastFlush(), 101u);
+}
+
+TEST(AsyncLoggerTest, FlushLevelIsNeverDroppedWhenFull) {
+    auto sink = std::make_shared<RecordingSink>();
+    AsyncLogger logger(sink, SmallRing(AsyncLogger::OverflowPolicy::Drop));
+
+    sink->Hold();
+    logger.Log(LogLevel::INFO, "m0");
+    if (!sink->WaitUntilBlocked()) {
+        sink->Release();
+        FAIL() << "worker did not reach the sink";
+    }
+    for (int i = 1; i < 4; ++i) {
+        logger.Log(LogLevel::INFO, "m" + std::to_string(i));
+    }
+
+    // 満杯でも ERR は空くまで待って届ける
+    std::thread producer([&] { logger.Log(LogLevel::ERR, "error"); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    sink->Release();
+    producer.join();
+
+    EXPECT_EQ(Messages(sink->Entries()), (std::vector<std::string>{"m0", "m1", "m2", "m3", "error"}));
+    EXPECT_EQ(logger.GetStats().dropped, 0u);
+}
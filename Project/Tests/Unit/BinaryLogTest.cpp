@@ -0,0 +1,210 @@
+#include "BinaryLogDecoder.h"
+#include "BinaryLogger.h"
+#include <cstdint>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    enum class Team : uint8_t { Red = 1, Blue = 2 };
+
+    // 一時ディレクトリに .tlog を書き、読み戻すフィクスチャ
+    class BinaryLogTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            std::random_device rd;
+            root_ = fs::temp_directory_path() / ("TaroBinaryLogTest_" + std::to_string(rd()));
+            fs::create_directories(root_);
+            path_ = root_ / "app.tlog";
+        }
+
+        void TearDown() override {
+            std::error_code ec;
+            fs::remove_all(root_, ec);
+        }
+
+        std::vector<uint8_t> ReadAll() const {
+            std::ifstream ifs(path_, std::ios::binary);
+            return std::vector<uint8_t>((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        }
+
+        fs::path root_;
+        fs::path path_;
+    };
+
+} // namespace
+
+TEST_F(BinaryLogTest, RoundTripsEveryArgumentType) {
+    const int value = 42;
+    {
+        BinaryLogger logger(path_.string());
+        ASSERT_TRUE(logger.IsOpen());
+        logger.Logf<"int={} uint={} neg={}">(LogLevel::INFO, -7, 4000000000u, int64_t{-9000000000});
+        logger.Logf<"float={} fixed={:.2f} double={}">(LogLevel::DEBUG, 0.5f, 3.14159, 1e-3);
+        logger.Logf<"str={} view={} bool={}/{} char={}">(LogLevel::WARN,
+            std::string("hello"), std::string_view("view"), true, false, 'x');
+        logger.Logf<"enum={} ptr={}">(LogLevel::ERR, Team::Blue, &value);
+        logger.Logf<"{1}-{0} {{literal}} {:>4}|">(LogLevel::INFO, 1, 2);
+        logger.Log(LogLevel::INFO, "plain text {not a format}");
+    }
+
+    std::vector<BinaryLogDecoder::Entry> entries;
+    std::string error;
+    ASSERT_TRUE(BinaryLogDecoder::DecodeFile(path_, entries, &error)) << error;
+    ASSERT_EQ(entries.size(), 6u);
+
+    EXPECT_EQ(entries[0].level, LogLevel::INFO);
+    EXPECT_EQ(entries[0].message, "int=-7 uint=4000000000 neg=-9000000000");
+    EXPECT_EQ(entries[1].level, LogLevel::DEBUG);
+    EXPECT_EQ(entries[1].message, "float=0.5 fixed=3.14 double=0.001");
+    EXPECT_EQ(entries[2].level, LogLevel::WARN);
+    EXPECT_EQ(entries[2].message, "str=hello view=view bool=true/false char=x");
+    EXPECT_EQ(entries[3].level, LogLevel::ERR);
+    EXPECT_EQ(entries[3].message,
+        "enum=2 ptr=" + std::to_string(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&value))));
+    EXPECT_EQ(entries[4].message, "2-1 {literal} {missing}|");
+    EXPECT_EQ(entries[5].message, "plain text {not a format}");
+
+    for (const auto &e : entries) {
+        EXPECT_EQ(e.session, 0u);
+    }
+    // 時刻はセッション内で単調（同じ steady_clock から復元している）
+    for (size_t i = 1; i < entries.size(); ++i) {
+        EXPECT_LE(entries[i - 1].time, entries[i].time);
+    }
+}
+
+TEST_F(BinaryLogTest, FormatMessageMatchesStdFormatForSpecs) {
+    using Arg = BinaryLogDecoder::Arg;
+    EXPECT_EQ(BinaryLogDecoder::FormatMessage("{:>5}|{:<3}|{:x}", {Arg{int64_t{12}}, Arg{'a'}, Arg{uint64_t{255}}}),
+        "   12|a  |ff");
+    EXPECT_EQ(BinaryLogDecoder::FormatMessage("{:.1f} {}", {Arg{2.25}, Arg{std::string("s")}}), "2.2 s");
+    EXPECT_EQ(BinaryLogDecoder::FormatMessage("{:q}", {Arg{int64_t{1}}}), "{?}");
+    EXPECT_EQ(BinaryLogDecoder::FormatMessage("open {", {}), "open {");
+}
+
+TEST_F(BinaryLogTest, AppendedSessionsRedefineFormats) {
+    // 同じ呼び出し箇所（= 同じ書式 ID）を 2 セッションで使う
+    auto logSpawn = [](BinaryLogger &logger, int id) {
+        logger.Logf<"spawn id={}">(LogLevel::INFO, id);
+    };
+    {
+        BinaryLogger logger(path_.string());
+        logSpawn(logger, 1);
+        logger.Log(LogLevel::INFO, "first");
+    }
+    {
+        BinaryLogger logger(path_.string()); // 追記モードで 2 つ目のセッションになる
+        logSpawn(logger, 2);
+        logSpawn(logger, 3);
+    }
+
+    std::vector<BinaryLogDecoder::Entry> entries;
+    std::string error;
+    ASSERT_TRUE(BinaryLogDecoder::DecodeFile(path_, entries, &error)) << error;
+    ASSERT_EQ(entries.size(), 4u);
+    EXPECT_EQ(entries[0].session, 0u);
+    EXPECT_EQ(entries[0].message, "spawn id=1");
+    EXPECT_EQ(entries[1].session, 0u);
+    EXPECT_EQ(entries[1].message, "first");
+    EXPECT_EQ(entries[2].session, 1u);
+    EXPECT_EQ(entries[2].message, "spawn id=2");
+    EXPECT_EQ(entries[3].session, 1u);
+    EXPECT_EQ(entries[3].message, "spawn id=3");
+
+    // テキスト変換ではセッションごとに見出しが入る
+    const fs::path textPath = root_ / "app.txt";
+    ASSERT_TRUE(BinaryLogDecoder::DecodeFileToText(path_, textPath, &error)) << error;
+    std::ifstream ifs(textPath);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(ifs, line);) lines.push_back(line);
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0].rfind("===== Log session 0 started at ", 0), 0u);
+    EXPECT_NE(lines[1].find("] [INFO ] spawn id=1"), std::string::npos);
+    EXPECT_EQ(lines[3].rfind("===== Log session 1 started at ", 0), 0u);
+    EXPECT_NE(lines[5].find("spawn id=3"), std::string::npos);
+}
+
+TEST_F(BinaryLogTest, TruncatedFileKeepsCompleteRecords) {
+    {
+        BinaryLogger logger(path_.string());
+        logger.Logf<"a={} b={}">(LogLevel::INFO, 1, std::string("two"));
+        logger.Logf<"c={}">(LogLevel::INFO, 3.5);
+        logger.Log(LogLevel::INFO, "last message");
+    }
+    const std::vector<uint8_t> full = ReadAll();
+
+    std::vector<BinaryLogDecoder::Entry> complete;
+    ASSERT_TRUE(BinaryLogDecoder::Decode(full.data(), full.size(), complete));
+    ASSERT_EQ(complete.size(), 3u);
+
+    // 末尾を 1 バイトずつ削っていき、どこで切れても読めた分だけが返り、壊れた値は出ないことを確認する
+    for (size_t size = 0; size < full.size(); ++size) {
+        std::vector<BinaryLogDecoder::Entry> entries;
+        std::string error;
+        const bool ok = BinaryLogDecoder::Decode(full.data(), size, entries, &error);
+        ASSERT_LE(entries.size(), complete.size()) << "size=" << size;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            EXPECT_EQ(entries[i].message, complete[i].message) << "size=" << size;
+        }
+        if (!ok) {
+            EXPECT_FALSE(error.empty()) << "size=" << size;
+        } else {
+            // レコード境界で切れた場合だけ成功する
+            EXPECT_LT(entries.size(), complete.size()) << "size=" << size;
+        }
+    }
+
+    // ファイル経由でも、切れた位置までをテキストにして false を返す
+    {
+        std::ofstream ofs(path_, std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<const char *>(full.data()), static_cast<std::streamsize>(full.size() - 3));
+    }
+    std::vector<BinaryLogDecoder::Entry> entries;
+    std::string error;
+    EXPECT_FALSE(BinaryLogDecoder::DecodeFile(path_, entries, &error));
+    EXPECT_EQ(error, "truncated or unknown argument");
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[1].message, "c=3.5");
+}
+
+TEST_F(BinaryLogTest, RejectsCorruptHeaders) {
+    {
+        BinaryLogger logger(path_.string());
+        logger.Log(LogLevel::INFO, "x");
+    }
+    std::vector<uint8_t> data = ReadAll();
+    std::vector<BinaryLogDecoder::Entry> entries;
+    std::string error;
+
+    std::vector<uint8_t> badMagic = data;
+    badMagic[1] ^= 0xFF;
+    EXPECT_FALSE(BinaryLogDecoder::Decode(badMagic.data(), badMagic.size(), entries, &error));
+    EXPECT_EQ(error, "bad magic");
+
+    std::vector<uint8_t> badType = data;
+    badType[0] = 0x7F;
+    EXPECT_FALSE(BinaryLogDecoder::Decode(badType.data(), badType.size(), entries, &error));
+    EXPECT_EQ(error, "unknown record type");
+    EXPECT_TRUE(entries.empty());
+
+    EXPECT_FALSE(BinaryLogDecoder::DecodeFile(root_ / "missing.tlog", entries, &error));
+}
+
+TEST_F(BinaryLogTest, MinLevelFiltersLogf) {
+    {
+        BinaryLogger logger(path_.string());
+        logger.SetMinLevel(LogLevel::WARN);
+        logger.Logf<"dropped {}">(LogLevel::INFO, 1);
+        logger.Logf<"kept {}">(LogLevel::ERR, 2);
+    }
+    std::vector<BinaryLogDecoder::Entry> entries;
+    ASSERT_TRUE(BinaryLogDecoder::DecodeFile(path_, entries));
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].message, "kept 2");
+}
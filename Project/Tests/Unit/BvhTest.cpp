@@ -0,0 +1,247 @@
+#include "Bvh.h"
+#include "JobSystem.h"
+#include "MatrixUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Aabb = Bvh::Aabb;
+
+    Aabb MakeBox(const Vector3 &center, const Vector3 &half) {
+        return Aabb{Vector3(center.x - half.x, center.y - half.y, center.z - half.z),
+            Vector3(center.x + half.x, center.y + half.y, center.z + half.z)};
+    }
+
+    // 広い範囲に散らばる箱と、狭い範囲に固まった箱を混ぜる（SAH が偏った分割を選ぶ場面を含める）
+    std::vector<Aabb> MakeScene(std::mt19937 &rng, size_t count) {
+        std::uniform_real_distribution<float> wide(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> cluster(-5.0f, 5.0f);
+        std::uniform_real_distribution<float> half(0.05f, 3.0f);
+        std::vector<Aabb> boxes;
+        boxes.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const bool clustered = (i % 4) == 0;
+            const Vector3 c = clustered ? Vector3(100.0f + cluster(rng), cluster(rng), 50.0f + cluster(rng))
+                                        : Vector3(wide(rng), wide(rng), wide(rng));
+            boxes.push_back(MakeBox(c, Vector3(half(rng), half(rng), half(rng))));
+        }
+        return boxes;
+    }
+
+    bool Contains(const Aabb &outer, const Aabb &inner) {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+            inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+
+    bool Overlaps(const Aabb &a, const Aabb &b) {
+        return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+            a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+    // Bvh と同じスラブ判定（当たらなければ INFINITY）
+    float RayEntry(const Aabb &a, const Vector3 &origin, const Vector3 &dir, float maxT) {
+        const Vector3 inv(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+        const float tx0 = (a.min.x - origin.x) * inv.x, tx1 = (a.max.x - origin.x) * inv.x;
+        const float ty0 = (a.min.y - origin.y) * inv.y, ty1 = (a.max.y - origin.y) * inv.y;
+        const float tz0 = (a.min.z - origin.z) * inv.z, tz1 = (a.max.z - origin.z) * inv.z;
+        const float tNear = std::fmax(std::fmax(std::fmin(tx0, tx1), std::fmin(ty0, ty1)), std::fmax(std::fmin(tz0, tz1), 0.0f));
+        const float tFar = std::fmin(std::fmin(std::fmax(tx0, tx1), std::fmax(ty0, ty1)), std::fmin(std::fmax(tz0, tz1), maxT));
+        return tNear <= tFar ? tNear : INFINITY;
+    }
+
+    Frustum MakeFrustum(const Vector3 &eye, const Vector3 &target) {
+        const Matrix4x4 view = MatrixUtil::MakeViewMatrix(eye, target, Vector3(0.0f, 1.0f, 0.0f));
+        const Matrix4x4 proj = MatrixUtil::MakePerspectiveFovMatrix(1.0471976f, 16.0f / 9.0f, 0.5f, 600.0f);
+        return Frustum::FromViewProjection(MatrixUtil::Multiply(view, proj));
+    }
+
+    std::vector<uint32_t> Sorted(std::vector<uint32_t> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    // 木の形の不変条件（全プリミティブがちょうど 1 回ずつ葉にあり、親の箱が子を包む）
+    void ExpectValidTree(const Bvh &bvh, const std::vector<Aabb> &boxes) {
+        const auto &nodes = bvh.GetNodes();
+        const auto &indices = bvh.GetPrimitiveIndices();
+        ASSERT_EQ(indices.size(), boxes.size());
+        ASSERT_LE(nodes.size(), boxes.size() * 2);
+
+        std::vector<uint32_t> seen(boxes.size(), 0);
+        uint32_t leafPrims = 0;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const Bvh::Node &node = nodes[i];
+            if (node.count > 0) {
+                leafPrims += node.count;
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    ++seen[indices[k]];
+                    EXPECT_TRUE(Contains(node.bounds, boxes[indices[k]])) << "leaf " << i;
+                }
+            } else {
+                ASSERT_GT(node.first, i); // 子は親より後ろ（Refit が後ろから付け直せる）
+                ASSERT_LT(node.first + 1, nodes.size());
+                EXPECT_TRUE(Contains(node.bounds, nodes[node.first].bounds)) << "node " << i;
+                EXPECT_TRUE(Contains(node.bounds, nodes[node.first + 1].bounds)) << "node " << i;
+            }
+        }
+        EXPECT_EQ(leafPrims, boxes.size());
+        EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](uint32_t n) { return n == 1; }));
+    }
+
+    // 検索結果を入力の箱に対する総当たりと比べる
+    void ExpectQueriesMatchBruteForce(const Bvh &bvh, const std::vector<Aabb> &boxes, std::mt19937 &rng) {
+        std::uniform_real_distribution<float> pos(-450.0f, 450.0f);
+        std::uniform_real_distribution<float> half(1.0f, 80.0f);
+        std::uniform_real_distribution<float> dir(-1.0f, 1.0f);
+
+        for (int q = 0; q < 10; ++q) {
+            const Frustum frustum = MakeFrustum(Vector3(pos(rng), pos(rng), pos(rng)), Vector3(pos(rng), pos(rng), pos(rng)));
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < boxes.size(); ++i) {
+                const Aabb &b = boxes[i];
+                const Vector3 c((b.min.x + b.max.x) * 0.5f, (b.min.y + b.max.y) * 0.5f, (b.min.z + b.max.z) * 0.5f);
+                const Vector3 e((b.max.x - b.min.x) * 0.5f, (b.max.y - b.min.y) * 0.5f, (b.max.z - b.min.z) * 0.5f);
+                if (frustum.IntersectsAabb(c, e)) expected.push_back(i);
+            }
+            std::vector<uint32_t> found;
+            const size_t added = bvh.QueryFrustum(frustum, found);
+            EXPECT_EQ(added, found.size());
+            EXPECT_EQ(Sorted(found), expected) << "frustum " << q;
+        }
+
+        for (int q = 0; q < 20; ++q) {
+            const Aabb query = MakeBox(Vector3(pos(rng), pos(rng), pos(rng)), Vector3(half(rng), half(rng), half(rng)));
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < boxes.size(); ++i) {
+                if (Overlaps(boxes[i], query)) expected.push_back(i);
+            }
+            std::vector<uint32_t> found;
+            bvh.QueryAabb(query, found);
+            EXPECT_EQ(Sorted(found), expected) << "aabb " << q;
+        }
+
+        for (int q = 0; q < 50; ++q) {
+            // 半分は固まった箱の方へ向けて当てる
+            const Vector3 origin(pos(rng), pos(rng), pos(rng));
+            const Vector3 direction = (q % 2 == 0)
+                ? Vector3(100.0f - origin.x, -origin.y, 50.0f - origin.z)
+                : Vector3(dir(rng), dir(rng), dir(rng));
+            const float maxDistance = (q % 5 == 0) ? 0.5f : INFINITY;
+
+            float best = INFINITY;
+            for (const Aabb &b : boxes) best = std::fmin(best, RayEntry(b, origin, direction, maxDistance));
+
+            Bvh::RayHit hit;
+            const bool hitSomething = bvh.Raycast(origin, direction, maxDistance, hit);
+            ASSERT_EQ(hitSomething, best != INFINITY) << "ray " << q;
+            if (!hitSomething) continue;
+            EXPECT_EQ(hit.distance, best) << "ray " << q;
+            ASSERT_LT(hit.primitive, boxes.size());
+            EXPECT_EQ(RayEntry(boxes[hit.primitive], origin, direction, maxDistance), best) << "ray " << q;
+        }
+    }
+
+} // namespace
+
+TEST(BvhTest, BuildProducesAValidTreeAndQueriesMatchBruteForce) {
+    std::mt19937 rng(5);
+    const std::vector<Aabb> boxes = MakeScene(rng, 5000);
+    Bvh bvh;
+    bvh.Build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    ExpectValidTree(bvh, boxes);
+    for (const Bvh::Node &node : bvh.GetNodes()) {
+        EXPECT_LE(node.count, Bvh::kMaxLeafSize); // 重心がばらけていれば葉は上限以下に分かれる
+    }
+    EXPECT_GT(bvh.ComputeSahCost(), 0.0f);
+    EXPECT_FLOAT_EQ(bvh.GetQualityRatio(), 1.0f);
+    ExpectQueriesMatchBruteForce(bvh, boxes, rng);
+}
+
+TEST(BvhTest, ParallelBuildMatchesTheSerialTree) {
+    std::mt19937 rng(6);
+    const std::vector<Aabb> boxes = MakeScene(rng, Bvh::kParallelThreshold * 3); // 並列に作る部分木ができる大きさ
+
+    Bvh serial;
+    serial.Build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    JobSystem jobs;
+    jobs.Initialize(3);
+    Bvh parallel;
+    parallel.Build(boxes.data(), static_cast<uint32_t>(boxes.size()), &jobs);
+    jobs.Finalize();
+
+    ExpectValidTree(parallel, boxes);
+    // ノードの番号の振り方は実行順で変わるが、分割は同じなのでノード数とコストは一致する
+    EXPECT_EQ(parallel.GetNodes().size(), serial.GetNodes().size());
+    EXPECT_NEAR(parallel.ComputeSahCost(), serial.ComputeSahCost(), serial.ComputeSahCost() * 1e-4f);
+    ExpectQueriesMatchBruteForce(parallel, boxes, rng);
+}
+
+TEST(BvhTest, RefitTracksMovesAndUpdateRebuildsWhenQualityDrops) {
+    std::mt19937 rng(7);
+    std::vector<Aabb> boxes = MakeScene(rng, 4000);
+    Bvh bvh;
+    bvh.Build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    // 小さく動かすだけなら Refit で済み、作り直さない
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    for (Aabb &b : boxes) {
+        const Vector3 d(jitter(rng), jitter(rng), jitter(rng));
+        b = Aabb{Vector3(b.min.x + d.x, b.min.y + d.y, b.min.z + d.z), Vector3(b.max.x + d.x, b.max.y + d.y, b.max.z + d.z)};
+    }
+    EXPECT_FALSE(bvh.Update(boxes.data()));
+    EXPECT_LT(bvh.GetQualityRatio(), Bvh::kRebuildCostRatio);
+    ExpectValidTree(bvh, boxes);
+    ExpectQueriesMatchBruteForce(bvh, boxes, rng);
+
+    // 箱を入れ替えて散らす。木の形は元のままなので、Refit だけでは質が大きく落ちる
+    std::vector<Aabb> shuffled = boxes;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    bvh.Refit(shuffled.data());
+    ExpectValidTree(bvh, shuffled);
+    ExpectQueriesMatchBruteForce(bvh, shuffled, rng); // 質が落ちても結果は正しい
+    EXPECT_GT(bvh.GetQualityRatio(), Bvh::kRebuildCostRatio);
+
+    EXPECT_TRUE(bvh.Update(shuffled.data()));
+    EXPECT_FLOAT_EQ(bvh.GetQualityRatio(), 1.0f);
+    ExpectValidTree(bvh, shuffled);
+    ExpectQueriesMatchBruteForce(bvh, shuffled, rng);
+}
+
+TEST(BvhTest, HandlesEmptySingleAndDegenerateInput) {
+    Bvh bvh;
+    bvh.Build(nullptr, 0);
+    EXPECT_TRUE(bvh.GetNodes().empty());
+    std::vector<uint32_t> found;
+    EXPECT_EQ(bvh.QueryAabb(MakeBox(Vector3(0, 0, 0), Vector3(1e6f, 1e6f, 1e6f)), found), 0u);
+    EXPECT_EQ(bvh.QueryFrustum(MakeFrustum(Vector3(0, 0, -10), Vector3(0, 0, 0)), found), 0u);
+    Bvh::RayHit hit;
+    EXPECT_FALSE(bvh.Raycast(Vector3(0, 0, 0), Vector3(0, 0, 1), INFINITY, hit));
+    bvh.Refit(nullptr); // 空なら何もしない
+    EXPECT_EQ(bvh.ComputeSahCost(), 0.0f);
+
+    const Aabb one = MakeBox(Vector3(0.0f, 0.0f, 10.0f), Vector3(1.0f, 1.0f, 1.0f));
+    bvh.Build(&one, 1);
+    ASSERT_EQ(bvh.GetNodes().size(), 1u);
+    ASSERT_TRUE(bvh.Raycast(Vector3(0, 0, 0), Vector3(0, 0, 2), INFINITY, hit));
+    EXPECT_EQ(hit.primitive, 0u);
+    EXPECT_FLOAT_EQ(hit.distance, 4.5f); // direction の長さを単位とする（9 / 2）
+    EXPECT_FALSE(bvh.Raycast(Vector3(0, 0, 0), Vector3(0, 0, 1), 8.0f, hit)); // maxDistance より遠い
+
+    // 重心がすべて同じ箱と、厚みのない箱（分けられないので 1 つの葉に残る）
+    std::vector<Aabb> same(100, MakeBox(Vector3(3.0f, 3.0f, 3.0f), Vector3(0.0f, 2.0f, 0.0f)));
+    for (size_t i = 0; i < same.size(); i += 2) same[i] = MakeBox(Vector3(3.0f, 3.0f, 3.0f), Vector3(1.0f, 1.0f, 1.0f));
+    bvh.Build(same.data(), static_cast<uint32_t>(same.size()));
+    ExpectValidTree(bvh, same);
+    found.clear();
+    EXPECT_EQ(bvh.QueryAabb(MakeBox(Vector3(3.0f, 3.5f, 3.0f), Vector3(0.1f, 0.1f, 0.1f)), found), 100u);
+    ASSERT_TRUE(bvh.Raycast(Vector3(3.0f, 3.0f, -10.0f), Vector3(0, 0, 1), INFINITY, hit));
+    EXPECT_FLOAT_EQ(hit.distance, 12.0f);
+    EXPECT_EQ(hit.primitive % 2, 0u); // 当たるのは厚みのある箱
+}
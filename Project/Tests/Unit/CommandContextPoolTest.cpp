@@ -0,0 +1,289 @@
+#include "CommandContextPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    class FakeCommandContextBackend;
+
+    // 記録の状態と、記録したスレッドを覚えるだけのコンテキスト
+    class FakeContext : public CommandContext {
+    public:
+        FakeContext(FakeCommandContextBackend &owner, int id) : id(id), owner_(owner) {}
+        ~FakeContext() override;
+
+        const int id;
+        bool recording = false;
+        int resets = 0;
+        std::thread::id recordedOn;
+        std::vector<int> commands; // 記録したコマンド（テストが積む値）
+
+    private:
+        FakeCommandContextBackend &owner_;
+    };
+
+    /// <summary>
+    /// デバイスとキューの代わり。実行したコンテキストに「GPU で使用中」の印を付け、
+    /// CompleteFence で進めた値より前のものだけを GPU が使い終えたものとして扱う。
+    /// </summary>
+    class FakeCommandContextBackend : public ICommandContextBackend {
+    public:
+        std::unique_ptr<CommandContext> CreateContext() override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++created;
+            return std::make_unique<FakeContext>(*this, nextId_++);
+        }
+
+        void BeginRecording(CommandContext &context) override {
+            auto &c = static_cast<FakeContext &>(context);
+            std::lock_guard<std::mutex> lock(mutex_);
+            // GPU がまだ使っているアロケータをリセットしていないか
+            auto it = gpuBusyUntil_.find(&c);
+            if (it != gpuBusyUntil_.end() && it->second > completedFence_) ++resetWhileInFlight;
+            if (c.recording) ++doubleBegin;
+            c.recording = true;
+            ++c.resets;
+            c.recordedOn = std::this_thread::get_id();
+            c.commands.clear();
+        }
+
+        void EndRecording(CommandContext &context) override {
+            auto &c = static_cast<FakeContext &>(context);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!c.recording) ++endWithoutBegin;
+            c.recording = false;
+        }
+
+        void Execute(CommandContext *const *contexts, uint32_t count) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++executeCalls;
+            lastExecuted_.clear();
+            std::vector<int> batch;
+            for (uint32_t i = 0; i < count; ++i) {
+                auto *c = static_cast<FakeContext *>(contexts[i]);
+                if (c->recording) ++executedOpen;
+                batch.push_back(c->id);
+                lastExecuted_.push_back(c);
+            }
+            executed.push_back(std::move(batch));
+        }
+
+        /// <summary>直前に実行した分が fenceValue の完了まで GPU で使われることを記録する。</summary>
+        void Signal(uint64_t fenceValue) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (FakeContext *c : lastExecuted_) gpuBusyUntil_[c] = fenceValue;
+            lastExecuted_.clear();
+        }
+
+        void CompleteFence(uint64_t value) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completedFence_ = value;
+        }
+
+        void OnDestroyed(FakeContext *c) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            gpuBusyUntil_.erase(c);
+            ++destroyed;
+        }
+
+        int created = 0;
+        int destroyed = 0;
+        int executeCalls = 0;
+        int resetWhileInFlight = 0;
+        int doubleBegin = 0;
+        int endWithoutBegin = 0;
+        int executedOpen = 0;
+        std::vector<std::vector<int>> executed; // Execute ごとの ID の並び
+
+    private:
+        std::mutex mutex_;
+        int nextId_ = 0;
+        uint64_t completedFence_ = 0;
+        std::unordered_map<FakeContext *, uint64_t> gpuBusyUntil_;
+        std::vector<FakeContext *> lastExecuted_;
+    };
+
+    FakeContext::~FakeContext() {
+        owner_.OnDestroyed(this);
+    }
+
+    FakeContext *Acquire(CommandContextPool &pool, uint32_t order) {
+        return static_cast<FakeContext *>(pool.Acquire(order));
+    }
+
+    // フレームを締める（Submit → シグナル → FinishFrame）
+    void EndFrame(CommandContextPool &pool, FakeCommandContextBackend &backend, uint64_t fenceValue) {
+        pool.Submit();
+        backend.Signal(fenceValue);
+        pool.FinishFrame(fenceValue);
+    }
+
+} // namespace
+
+TEST(CommandContextPoolTest, ReusesContextsOnlyAfterTheirFenceCompletes) {
+    FakeCommandContextBackend backend;
+    CommandContextPool pool;
+    pool.Initialize(&backend);
+
+    // フレーム 1: 2 つ借りる
+    FakeContext *a = Acquire(pool, 0);
+    FakeContext *b = Acquire(pool, 1);
+    EXPECT_EQ(pool.GetCreatedCount(), 2u);
+    EndFrame(pool, backend, 1);
+    EXPECT_EQ(pool.GetInFlightCount(), 2u);
+    EXPECT_EQ(pool.GetFreeCount(), 0u);
+
+    // フレーム 2: GPU がまだフェンス 1 を終えていないので新しく作る
+    pool.Reclaim(0);
+    FakeContext *c = Acquire(pool, 0);
+    FakeContext *d = Acquire(pool, 1);
+    EXPECT_EQ(pool.GetCreatedCount(), 4u);
+    EXPECT_NE(c, a);
+    EXPECT_NE(c, b);
+    EXPECT_NE(d, a);
+    EXPECT_NE(d, b);
+    EndFrame(pool, backend, 2);
+
+    // フレーム 3: フェンス 1 が終わったので a / b を使い回す（c / d はまだ使えない）
+    backend.CompleteFence(1);
+    pool.Reclaim(1);
+    EXPECT_EQ(pool.GetFreeCount(), 2u);
+    EXPECT_EQ(pool.GetInFlightCount(), 2u);
+    FakeContext *e = Acquire(pool, 0);
+    FakeContext *f = Acquire(pool, 1);
+    EXPECT_EQ(pool.GetCreatedCount(), 4u);
+    EXPECT_TRUE((e == a && f == b) || (e == b && f == a));
+    EXPECT_EQ(e->resets, 2);
+    EndFrame(pool, backend, 3);
+
+    EXPECT_EQ(backend.resetWhileInFlight, 0);
+    EXPECT_EQ(backend.doubleBegin, 0);
+    EXPECT_EQ(backend.endWithoutBegin, 0);
+    EXPECT_EQ(backend.executedOpen, 0);
+
+    backend.CompleteFence(3);
+    pool.Reclaim(3);
+    EXPECT_EQ(pool.GetFreeCount(), 4u);
+    EXPECT_EQ(pool.GetInFlightCount(), 0u);
+    pool.Finalize();
+    EXPECT_EQ(backend.destroyed, 4);
+}
+
+TEST(CommandContextPoolTest, SubmitsOnceInOrderThenAcquireSequence) {
+    FakeCommandContextBackend backend;
+    CommandContextPool pool;
+    pool.Initialize(&backend);
+
+    const int mid1 = Acquire(pool, 5)->id;
+    const int begin = Acquire(pool, CommandContextPool::kOrderFrameBegin)->id;
+    const int end = Acquire(pool, CommandContextPool::kOrderFrameEnd)->id;
+    const int mid2 = Acquire(pool, 5)->id; // 同じ order は取得順
+    const int early = Acquire(pool, 2)->id;
+
+    EXPECT_EQ(pool.Submit(), 5u);
+    ASSERT_EQ(backend.executeCalls, 1);
+    EXPECT_EQ(backend.executed[0], (std::vector<int>{begin, early, mid1, mid2, end}));
+    EXPECT_EQ(backend.executedOpen, 0); // 実行前にすべて閉じている
+
+    // 何も借りていなければ実行しない
+    EXPECT_EQ(pool.Submit(), 0u);
+    EXPECT_EQ(backend.executeCalls, 1);
+
+    backend.Signal(1);
+    pool.FinishFrame(1);
+    backend.CompleteFence(1);
+    pool.Reclaim(1);
+    pool.Finalize();
+}
+
+TEST(CommandContextPoolTest, WorkerThreadsRecordInParallelAndSubmitDeterministically) {
+    constexpr uint32_t kWorkers = 6;
+    constexpr uint64_t kFrames = 60;
+    constexpr uint64_t kFramesInFlight = 2; // GPU が 2 フレーム遅れて完了する
+
+    FakeCommandContextBackend backend;
+    CommandContextPool pool;
+    pool.Initialize(&backend);
+
+    for (uint64_t frame = 1; frame <= kFrames; ++frame) {
+        const uint64_t completed = frame > kFramesInFlight ? frame - kFramesInFlight : 0;
+        backend.CompleteFence(completed);
+        pool.Reclaim(completed);
+
+        FakeContext *begin = Acquire(pool, CommandContextPool::kOrderFrameBegin);
+        begin->commands.push_back(0);
+
+        // 各ワーカーは自分のコンテキストを借りて、同時に記録する
+        std::atomic<uint32_t> wrongThread{0};
+        std::vector<int> workerIds(kWorkers);
+        std::vector<std::thread> workers;
+        for (uint32_t w = 0; w < kWorkers; ++w) {
+            workers.emplace_back([&, w] {
+                // 借りる順番を崩して、提出順が取得順に依存しないことを確かめる
+                std::this_thread::sleep_for(std::chrono::microseconds((kWorkers - w) * 50));
+                FakeContext *c = Acquire(pool, w + 1);
+                workerIds[w] = c->id;
+                if (c->recordedOn != std::this_thread::get_id()) ++wrongThread;
+                for (int i = 0; i < 100; ++i) c->commands.push_back(static_cast<int>(w + 1));
+            });
+        }
+        for (auto &t : workers) t.join();
+        EXPECT_EQ(wrongThread.load(), 0u);
+
+        FakeContext *endList = Acquire(pool, CommandContextPool::kOrderFrameEnd);
+        endList->commands.push_back(-1);
+        EndFrame(pool, backend, frame);
+
+        // 提出順はフレームをまたいで常に begin → ワーカー 1..N → end
+        std::vector<int> expected{begin->id};
+        expected.insert(expected.end(), workerIds.begin(), workerIds.end());
+        expected.push_back(endList->id);
+        EXPECT_EQ(backend.executed.back(), expected) << "frame " << frame;
+    }
+
+    EXPECT_EQ(backend.executeCalls, static_cast<int>(kFrames));
+    EXPECT_EQ(backend.resetWhileInFlight, 0);
+    EXPECT_EQ(backend.doubleBegin, 0);
+    EXPECT_EQ(backend.executedOpen, 0);
+    // 使い回しが効いていれば、作るのは（GPU 待ちのフレーム数 + 1）フレーム分で済む
+    EXPECT_LE(pool.GetCreatedCount(), (kWorkers + 2) * (kFramesInFlight + 1));
+
+    backend.CompleteFence(kFrames);
+    pool.Reclaim(kFrames);
+    EXPECT_EQ(pool.GetFreeCount(), pool.GetCreatedCount());
+    pool.Finalize();
+}
+
+TEST(CommandContextPoolTest, WorkerCommandsLandInTheirOwnContext) {
+    FakeCommandContextBackend backend;
+    CommandContextPool pool;
+    pool.Initialize(&backend);
+
+    constexpr uint32_t kWorkers = 4;
+    std::vector<FakeContext *> contexts(kWorkers);
+    std::vector<std::thread> workers;
+    for (uint32_t w = 0; w < kWorkers; ++w) {
+        workers.emplace_back([&, w] {
+            contexts[w] = Acquire(pool, w + 1);
+            for (int i = 0; i < 1000; ++i) contexts[w]->commands.push_back(static_cast<int>(w));
+        });
+    }
+    for (auto &t : workers) t.join();
+
+    for (uint32_t w = 0; w < kWorkers; ++w) {
+        ASSERT_EQ(contexts[w]->commands.size(), 1000u);
+        EXPECT_TRUE(std::all_of(contexts[w]->commands.begin(), contexts[w]->commands.end(),
+            [w](int v) { return v == static_cast<int>(w); }));
+    }
+    EndFrame(pool, backend, 1);
+    backend.CompleteFence(1);
+    pool.Reclaim(1);
+    pool.Finalize();
+}
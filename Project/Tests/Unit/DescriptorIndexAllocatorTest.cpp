@@ -0,0 +1,104 @@
+#include "DescriptorIndexAllocator.h"
+#include <gtest/gtest.h>
+#include <set>
+
+TEST(DescriptorIndexAllocator, PersistentReusesLowestFreedSlot) {
+    DescriptorIndexAllocator alloc;
+    alloc.Initialize(256, 16);
+    for (uint32_t i = 0; i < 200; ++i) {
+        ASSERT_EQ(alloc.AllocatePersistent(), i);
+    }
+
+    alloc.FreePersistent(70);
+    alloc.FreePersistent(5);
+    EXPECT_EQ(alloc.AllocatePersistent(), 5u);
+    EXPECT_EQ(alloc.AllocatePersistent(), 70u);
+    EXPECT_EQ(alloc.AllocatePersistent(), 200u);
+
+    const DescriptorIndexAllocator::Stats stats = alloc.GetStats();
+    EXPECT_EQ(stats.persistentUsed, 201u);
+    EXPECT_EQ(stats.persistentPeak, 201u);
+    EXPECT_EQ(stats.failedAllocations, 0u);
+}
+
+TEST(DescriptorIndexAllocator, TailBitsBeyondCapacityAreNeverReturned) {
+    // 64 の倍数でない容量では、末尾語の範囲外ビットが使用中として扱われる
+    for (uint32_t capacity : {1u, 63u, 64u, 65u, 70u, 128u, 130u}) {
+        DescriptorIndexAllocator alloc;
+        alloc.Initialize(capacity, 8);
+
+        std::set<uint32_t> seen;
+        for (uint32_t i = 0; i < capacity; ++i) {
+            const uint32_t index = alloc.AllocatePersistent();
+            ASSERT_LT(index, capacity) << "capacity " << capacity;
+            ASSERT_TRUE(seen.insert(index).second);
+        }
+        EXPECT_EQ(alloc.AllocatePersistent(), DescriptorIndexAllocator::kInvalidIndex) << "capacity " << capacity;
+        EXPECT_EQ(alloc.GetStats().failedAllocations, 1u);
+    }
+}
+
+TEST(DescriptorIndexAllocator, ExhaustedPersistentRecoversAfterFree) {
+    DescriptorIndexAllocator alloc;
+    alloc.Initialize(130, 8);
+    for (uint32_t i = 0; i < 130; ++i) alloc.AllocatePersistent();
+    EXPECT_EQ(alloc.AllocatePersistent(), DescriptorIndexAllocator::kInvalidIndex);
+    EXPECT_EQ(alloc.AllocatePersistent(), DescriptorIndexAllocator::kInvalidIndex);
+
+    alloc.FreePersistent(3);
+    alloc.FreePersistent(129);
+    EXPECT_EQ(alloc.AllocatePersistent(), 3u);
+    EXPECT_EQ(alloc.AllocatePersistent(), 129u);
+    EXPECT_EQ(alloc.AllocatePersistent(), DescriptorIndexAllocator::kInvalidIndex);
+
+    const DescriptorIndexAllocator::Stats stats = alloc.GetStats();
+    EXPECT_EQ(stats.persistentUsed, 130u);
+    EXPECT_EQ(stats.failedAllocations, 3u);
+}
+
+TEST(DescriptorIndexAllocator, NoPersistentRegion) {
+    DescriptorIndexAllocator alloc;
+    alloc.Initialize(0, 8);
+    EXPECT_EQ(alloc.AllocatePersistent(), DescriptorIndexAllocator::kInvalidIndex);
+    EXPECT_EQ(alloc.AllocateTransient(8), 0u);
+    EXPECT_EQ(alloc.GetTotalCount(), 8u);
+}
+
+TEST(DescriptorIndexAllocator, TransientIndicesFollowPersistentRegion) {
+    DescriptorIndexAllocator alloc;
+    alloc.Initialize(100, 16);
+    EXPECT_EQ(alloc.AllocateTransient(4), 100u);
+    EXPECT_EQ(alloc.AllocateTransient(3), 104u);
+    EXPECT_EQ(alloc.GetTotalCount(), 116u);
+
+    // 永続側の確保は一時領域に影響しない
+    EXPECT_EQ(alloc.AllocatePersistent(), 0u);
+    EXPECT_EQ(alloc.AllocateTransient(1), 107u);
+}
+
+TEST(DescriptorIndexAllocator, TransientSlotsReturnAfterFenceCompletes) {
+    DescriptorIndexAllocator alloc;
+    alloc.Initialize(4, 16);
+
+    EXPECT_EQ(alloc.AllocateTransient(10), 4u);
+    alloc.FinishFrame(1);
+    EXPECT_EQ(alloc.AllocateTransient(6), 14u);
+    alloc.FinishFrame(2);
+
+    // 全部使用中（フレーム 1, 2 とも GPU 未完了）
+    EXPECT_EQ(alloc.AllocateTransient(1), DescriptorIndexAllocator::kInvalidIndex);
+    EXPECT_EQ(alloc.GetStats().transientUsed, 16u);
+
+    // フレーム 1 が完了すると、その 10 スロットが先頭から再利用される（テーブルは連続のまま）
+    alloc.Reclaim(1);
+    EXPECT_EQ(alloc.GetStats().transientUsed, 6u);
+    EXPECT_EQ(alloc.AllocateTransient(11), DescriptorIndexAllocator::kInvalidIndex);
+    EXPECT_EQ(alloc.AllocateTransient(10), 4u);
+    alloc.FinishFrame(3);
+
+    alloc.Reclaim(3);
+    const DescriptorIndexAllocator::Stats stats = alloc.GetStats();
+    EXPECT_EQ(stats.transientUsed, 0u);
+    EXPECT_EQ(stats.transientPeak, 16u);
+    EXPECT_EQ(stats.failedAllocations, 2u);
+}
@@ -0,0 +1,149 @@
+#include "FencedRingAllocator.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+TEST(FencedRingAllocator, SequentialAllocationsAreContiguous) {
+    FencedRingAllocator ring;
+    ring.Initialize(1024);
+    EXPECT_EQ(ring.Allocate(100, 1), 0u);
+    EXPECT_EQ(ring.Allocate(50, 1), 100u);
+    EXPECT_EQ(ring.GetUsedSize(), 150u);
+    EXPECT_EQ(ring.GetCapacity(), 1024u);
+}
+
+TEST(FencedRingAllocator, AlignmentPaddingCountsAsUsed) {
+    FencedRingAllocator ring;
+    ring.Initialize(1024);
+    EXPECT_EQ(ring.Allocate(10, 1), 0u);
+    EXPECT_EQ(ring.Allocate(16, 256), 256u);
+    EXPECT_EQ(ring.GetUsedSize(), 272u); // 10 + 余り 246 + 16
+
+    // 余りも含めてフレームと一緒に解放される
+    ring.FinishFrame(1);
+    ring.Reclaim(1);
+    EXPECT_EQ(ring.GetUsedSize(), 0u);
+}
+
+TEST(FencedRingAllocator, WrapsToFrontWhenTailFits) {
+    FencedRingAllocator ring;
+    ring.Initialize(1024);
+    EXPECT_EQ(ring.Allocate(600, 1), 0u);
+    ring.FinishFrame(1);
+    EXPECT_EQ(ring.Allocate(300, 1), 600u);
+    ring.FinishFrame(2);
+
+    // 末尾 [900, 1024) に入らない。フレーム 1 の完了前は先頭も空いていない
+    EXPECT_EQ(ring.Allocate(200, 1), FencedRingAllocator::kInvalidOffset);
+
+    ring.Reclaim(1);
+    EXPECT_EQ(ring.Allocate(200, 1), 0u);
+    EXPECT_EQ(ring.GetUsedSize(), 300u + 124u + 200u); // 末尾の余り 124 を含む
+
+    // 折り返した先の空きは [200, 600) だけ
+    EXPECT_EQ(ring.Allocate(401, 1), FencedRingAllocator::kInvalidOffset);
+    EXPECT_EQ(ring.Allocate(400, 1), 200u);
+    EXPECT_EQ(ring.Allocate(1, 1), FencedRingAllocator::kInvalidOffset);
+
+    ring.FinishFrame(3);
+    ring.Reclaim(3);
+    EXPECT_EQ(ring.GetUsedSize(), 0u);
+    EXPECT_EQ(ring.GetPendingFrameCount(), 0u);
+}
+
+TEST(FencedRingAllocator, RejectsOversizedRequests) {
+    FencedRingAllocator ring;
+    ring.Initialize(256);
+    EXPECT_EQ(ring.Allocate(257, 1), FencedRingAllocator::kInvalidOffset);
+    EXPECT_EQ(ring.Allocate(256, 1), 0u);
+    EXPECT_EQ(ring.Allocate(1, 1), FencedRingAllocator::kInvalidOffset);
+    EXPECT_EQ(ring.GetUsedSize(), 256u);
+}
+
+TEST(FencedRingAllocator, ReclaimStopsAtIncompleteFence) {
+    FencedRingAllocator ring;
+    ring.Initialize(1024);
+    for (uint64_t fence = 1; fence <= 3; ++fence) {
+        ring.Allocate(100, 1);
+        ring.FinishFrame(fence);
+    }
+    EXPECT_EQ(ring.GetPendingFrameCount(), 3u);
+
+    ring.Reclaim(2);
+    EXPECT_EQ(ring.GetPendingFrameCount(), 1u);
+    EXPECT_EQ(ring.GetUsedSize(), 100u);
+
+    ring.Reclaim(2); // 同じ値で呼んでも何も起きない
+    EXPECT_EQ(ring.GetUsedSize(), 100u);
+}
+
+TEST(FencedRingAllocator, EmptyRingRestartsAtFrontAndRewritesPendingHeads) {
+    FencedRingAllocator ring;
+    ring.Initialize(1024);
+    EXPECT_EQ(ring.Allocate(600, 1), 0u);
+    ring.FinishFrame(1);
+    ring.FinishFrame(2); // 確保のない完了待ちフレーム（終端は 600 のまま）
+    ring.Reclaim(1);
+    ASSERT_EQ(ring.GetUsedSize(), 0u);
+    ASSERT_EQ(ring.GetPendingFrameCount(), 1u);
+
+    // 空なので 600 ではなく先頭から使い直す
+    EXPECT_EQ(ring.Allocate(100, 1), 0u);
+    ring.FinishFrame(3);
+
+    // フレーム 2 の終端も 0 に書き換わっていれば、解放後の空きは [100, 1024) 全体。
+    // 書き換わっていないと tail が 600 に戻り、空きが [100, 600) と誤判定される
+    ring.Reclaim(2);
+    EXPECT_EQ(ring.GetUsedSize(), 100u);
+    EXPECT_EQ(ring.Allocate(800, 1), 100u);
+}
+
+TEST(FencedRingAllocator, RandomizedAllocationsNeverOverlap) {
+    struct Live {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t fence;
+    };
+
+    constexpr uint64_t kCapacity = 4096;
+    FencedRingAllocator ring;
+    ring.Initialize(kCapacity);
+
+    std::mt19937 rng(1);
+    std::vector<Live> live;
+    uint64_t fence = 0;
+    uint64_t completed = 0;
+
+    for (int frame = 0; frame < 20000; ++frame) {
+        const int count = static_cast<int>(rng() % 6);
+        for (int i = 0; i < count; ++i) {
+            const uint64_t size = 1 + rng() % 700;
+            const uint64_t alignment = 1ull << (rng() % 9);
+            const uint64_t offset = ring.Allocate(size, alignment);
+            if (offset == FencedRingAllocator::kInvalidOffset) continue;
+
+            ASSERT_EQ(offset % alignment, 0u);
+            ASSERT_LE(offset + size, kCapacity);
+            for (const Live &other : live) {
+                ASSERT_FALSE(offset < other.offset + other.size && other.offset < offset + size)
+                    << "frame " << frame << ": [" << offset << ", " << offset + size << ") overlaps ["
+                    << other.offset << ", " << other.offset + other.size << ")";
+            }
+            live.push_back({offset, size, fence + 1});
+        }
+        ring.FinishFrame(++fence);
+
+        // GPU が 0〜3 フレーム遅れて追いかける
+        if (fence > 3 || rng() % 3 == 0) {
+            completed = (std::max)(completed, fence > 3 ? fence - 3 : completed);
+            if (rng() % 4 == 0) completed = fence;
+            ring.Reclaim(completed);
+            std::erase_if(live, [&](const Live &a) { return a.fence <= completed; });
+        }
+        ASSERT_TRUE(ring.GetPendingFrameCount() != 0 || ring.GetUsedSize() == 0);
+    }
+
+    ring.Reclaim(fence);
+    EXPECT_EQ(ring.GetUsedSize(), 0u);
+}
@@ -0,0 +1,73 @@
+#include "FixedTimestep.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// 刻みは 2 の冪の秒数（0.25 秒 = 4 Hz）にして、ためた時間の計算を誤差なく比べる
+
+TEST(FixedTimestepTest, StepCountFollowsAccumulatedTime) {
+    FixedTimestep timestep;
+    timestep.Initialize(4.0, 8, 10.0);
+    EXPECT_EQ(timestep.GetStepSeconds(), 0.25);
+
+    EXPECT_EQ(timestep.Advance(0.25), 1u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.0f);
+
+    // 刻みに満たない時間はためて次のフレームに回す
+    EXPECT_EQ(timestep.Advance(0.125), 0u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.5f);
+    EXPECT_EQ(timestep.Advance(0.125), 1u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.0f);
+
+    EXPECT_EQ(timestep.Advance(0.8125), 3u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.25f);
+
+    EXPECT_EQ(timestep.GetTotalSteps(), 5u);
+    EXPECT_EQ(timestep.GetDroppedSeconds(), 0.0);
+}
+
+TEST(FixedTimestepTest, MaxSubstepsCapsStepsAndDropsBacklog) {
+    FixedTimestep timestep;
+    timestep.Initialize(4.0, 2, 10.0);
+
+    // 4.5 ステップ分ためても 2 ステップで打ち切り、追いつけない 2 ステップ分は捨てる。
+    // 刻み未満の端数は残すので補間係数は 1 未満のまま
+    EXPECT_EQ(timestep.Advance(1.125), 2u);
+    EXPECT_EQ(timestep.GetDroppedSeconds(), 0.5);
+    EXPECT_EQ(timestep.GetAlpha(), 0.5f);
+
+    // 捨てた分を次のフレームで取り戻そうとはしない
+    EXPECT_EQ(timestep.Advance(0.0), 0u);
+    EXPECT_EQ(timestep.GetTotalSteps(), 2u);
+}
+
+TEST(FixedTimestepTest, LongFramesAreClampedToMaxFrameSeconds) {
+    FixedTimestep timestep;
+    timestep.Initialize(4.0, 8, 0.5);
+
+    // ブレークポイントなどで 3 秒止まっても 0.5 秒ぶんしか進めない
+    EXPECT_EQ(timestep.Advance(3.0), 2u);
+    EXPECT_EQ(timestep.GetDroppedSeconds(), 2.5);
+    EXPECT_EQ(timestep.GetAlpha(), 0.0f);
+
+    // 時計が巻き戻っても進めない
+    EXPECT_EQ(timestep.Advance(0.125), 0u);
+    EXPECT_EQ(timestep.Advance(-1.0), 0u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.5f);
+
+    timestep.Reset();
+    EXPECT_EQ(timestep.GetAlpha(), 0.0f);
+}
+
+TEST(FixedTimestepTest, AlphaStaysBelowOneForIrregularFrames) {
+    FixedTimestep timestep;
+    timestep.Initialize(60.0, 4, 0.25);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> frame(0.0, 0.3); // 上限を超えるスパイクも混ぜる
+    for (int i = 0; i < 10000; ++i) {
+        const uint32_t steps = timestep.Advance(frame(rng));
+        ASSERT_LE(steps, 4u);
+        ASSERT_GE(timestep.GetAlpha(), 0.0f);
+        ASSERT_LT(timestep.GetAlpha(), 1.0f);
+    }
+}
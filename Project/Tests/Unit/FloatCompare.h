@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "Matrix4x4.h"
+
+/// <summary>
+/// テスト用の浮動小数点比較。
+/// </summary>
+namespace FloatCompare {
+
+    /// <summary>
+    /// 2 つの float の ULP 距離（+0 と -0 は 0、NaN を含むと最大値）。
+    /// </summary>
+    inline int64_t UlpDistance(float a, float b) {
+        if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<int64_t>::max();
+        if (a == b) return 0;
+
+        // 符号付き大きさ表現を、大小関係が保たれる整数に写す
+        auto toOrdered = [](float f) {
+            int32_t i;
+            std::memcpy(&i, &f, sizeof(i));
+            return i < 0 ? static_cast<int64_t>(INT32_MIN) - i : static_cast<int64_t>(i);
+        };
+        const int64_t d = toOrdered(a) - toOrdered(b);
+        return d < 0 ? -d : d;
+    }
+
+    /// <summary>4x4 行列の要素ごとの ULP 距離の最大値。</summary>
+    inline int64_t MaxUlpDistance(const Matrix4x4 &a, const Matrix4x4 &b) {
+        int64_t worst = 0;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                const int64_t d = UlpDistance(a.m[i][j], b.m[i][j]);
+                worst = d > worst ? d : worst;
+            }
+        }
+        return worst;
+    }
+
+    /// <summary>4x4 行列の要素ごとの絶対誤差の最大値。</summary>
+    inline float MaxAbsDifference(const Matrix4x4 &a, const Matrix4x4 &b) {
+        float worst = 0.0f;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                worst = (std::max)(worst, std::fabs(a.m[i][j] - b.m[i][j]));
+            }
+        }
+        return worst;
+    }
+
+} // namespace FloatCompare
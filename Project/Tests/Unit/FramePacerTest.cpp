@@ -0,0 +1,181 @@
+#include "FramePacer.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace {
+
+    /// <summary>
+    /// 手で進める時計。NowNs は呼ばれるたびに tickNs だけ進み（スピンが終わるように）、
+    /// SleepNs は要求 + oversleepNs だけ進む。
+    /// </summary>
+    class FakeClock : public IFrameClock {
+    public:
+        uint64_t NowNs() override {
+            now += tickNs;
+            return now;
+        }
+
+        void SleepNs(uint64_t ns) override {
+            ++sleeps;
+            sleptNs += ns;
+            now += ns + oversleepNs;
+        }
+
+        uint64_t now = 1000000000ull;
+        uint64_t tickNs = 1000;
+        uint64_t oversleepNs = 0;
+        uint64_t sleeps = 0;
+        uint64_t sleptNs = 0;
+    };
+
+    constexpr double kNsToMs = 1.0 / 1000000.0;
+
+} // namespace
+
+TEST(FramePacerTest, UncappedAndVSyncDoNotWait) {
+    FakeClock clock;
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+
+    for (const auto mode : {FramePacer::Mode::Uncapped, FramePacer::Mode::VSync}) {
+        pacer.SetMode(mode);
+        EXPECT_EQ(pacer.GetSyncInterval(), mode == FramePacer::Mode::VSync ? 1u : 0u);
+        for (int i = 0; i < 10; ++i) {
+            clock.now += 3000000; // 3ms の処理
+            pacer.Wait();
+        }
+    }
+    EXPECT_EQ(clock.sleeps, 0u);
+    const FramePacer::Stats stats = pacer.GetStats();
+    EXPECT_EQ(stats.samples, 20u);
+    EXPECT_NEAR(stats.p50Ms, 3.0, 0.01);
+}
+
+TEST(FramePacerTest, FixedRateHoldsThePeriodWithSleepAndSpin) {
+    FakeClock clock;
+    clock.oversleepNs = 500000; // 毎回 0.5ms 寝過ごす
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+    pacer.SetMode(FramePacer::Mode::FixedRate);
+    pacer.SetTargetFps(60.0);
+    EXPECT_EQ(pacer.GetSyncInterval(), 0u);
+
+    const double periodMs = 1000.0 / 60.0;
+    for (int i = 0; i < 120; ++i) {
+        clock.now += (i % 3 + 2) * 1000000ull; // 2〜4ms の処理
+        pacer.Wait();
+    }
+
+    const FramePacer::Stats stats = pacer.GetStats();
+    EXPECT_EQ(stats.samples, 120u);
+    // 寝過ごしはスピンの余裕で吸収され、締め切りぴったり（時計の 1 tick 以内）に抜ける
+    EXPECT_NEAR(stats.p50Ms, periodMs, 0.01);
+    EXPECT_NEAR(stats.p99Ms, periodMs, 0.01);
+    EXPECT_NEAR(stats.meanMs, periodMs, 0.01);
+    EXPECT_LT(stats.stdDevMs, 0.01);
+    EXPECT_GT(clock.sleeps, 0u);
+    // 寝過ごし量を学習して、スピンの余裕はそれ以上に保たれる
+    EXPECT_GE(pacer.GetSpinMarginNs(), clock.oversleepNs);
+}
+
+TEST(FramePacerTest, DeadlinesDoNotDriftWithLateWakeups) {
+    FakeClock clock;
+    clock.tickNs = 7000; // 粗い時計でも締め切りは前回の締め切りから積み上げる
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+    pacer.SetMode(FramePacer::Mode::FixedRate);
+    pacer.SetTargetFps(100.0);
+
+    const uint64_t start = clock.now;
+    constexpr int kFrames = 200;
+    for (int i = 0; i < kFrames; ++i) {
+        clock.now += 1000000;
+        pacer.Wait();
+    }
+    // 1 回ごとの遅れ（最大 1 tick）は累積しない
+    const uint64_t expected = start + static_cast<uint64_t>(kFrames) * 10000000ull;
+    EXPECT_LE(clock.now - expected, 3 * clock.tickNs);
+}
+
+TEST(FramePacerTest, MissedDeadlineRestartsInsteadOfBursting) {
+    FakeClock clock;
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+    pacer.SetMode(FramePacer::Mode::FixedRate);
+    pacer.SetTargetFps(50.0); // 20ms
+
+    for (int i = 0; i < 5; ++i) {
+        clock.now += 1000000;
+        pacer.Wait();
+    }
+    clock.now += 75000000; // 75ms のスパイク
+    pacer.Wait();
+
+    // 後続のフレームは取り返そうと 0ms で連続せず、20ms 間隔に戻る
+    for (int i = 0; i < 5; ++i) {
+        const uint64_t before = clock.now;
+        clock.now += 1000000;
+        pacer.Wait();
+        EXPECT_NEAR((clock.now - before) * kNsToMs, 20.0, 0.01) << "frame " << i;
+    }
+}
+
+TEST(FramePacerTest, SpinMarginShrinksWhenSleepIsAccurate) {
+    FakeClock clock;
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+    pacer.SetMode(FramePacer::Mode::FixedRate);
+    pacer.SetTargetFps(60.0);
+    const uint64_t initial = pacer.GetSpinMarginNs();
+
+    clock.oversleepNs = 3000000; // 3ms 寝過ごす環境ではすぐ広がる
+    clock.now += 1000000;
+    pacer.Wait();
+    EXPECT_GE(pacer.GetSpinMarginNs(), 3000000u);
+
+    clock.oversleepNs = 0; // 正確になったらゆっくり下限まで縮む
+    for (int i = 0; i < 300; ++i) {
+        clock.now += 1000000;
+        pacer.Wait();
+    }
+    EXPECT_LT(pacer.GetSpinMarginNs(), initial);
+    EXPECT_EQ(pacer.GetSpinMarginNs(), 200000u);
+}
+
+TEST(FramePacerTest, StatsUseTheLatestWindow) {
+    FakeClock clock;
+    clock.tickNs = 0; // 待たないモードなので時計は手で進めるだけ
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+    pacer.SetMode(FramePacer::Mode::Uncapped);
+
+    // 窓から外れる古いフレーム（すべて 1000ms）
+    for (int i = 0; i < 50; ++i) {
+        clock.now += 1000000000ull;
+        pacer.Wait();
+    }
+    // 1ms, 2ms, ..., 240ms
+    for (uint32_t i = 1; i <= FramePacer::kStatsWindow; ++i) {
+        clock.now += i * 1000000ull;
+        pacer.Wait();
+    }
+
+    const FramePacer::Stats stats = pacer.GetStats();
+    EXPECT_EQ(stats.samples, FramePacer::kStatsWindow);
+    EXPECT_DOUBLE_EQ(stats.minMs, 1.0);
+    EXPECT_DOUBLE_EQ(stats.maxMs, 240.0);
+    EXPECT_DOUBLE_EQ(stats.p50Ms, 120.0);
+    EXPECT_DOUBLE_EQ(stats.p99Ms, 238.0); // ceil(0.99 * 240) = 238 番目
+    EXPECT_DOUBLE_EQ(stats.meanMs, 120.5);
+    // 1..n の母標準偏差は sqrt((n^2 - 1) / 12)
+    EXPECT_NEAR(stats.stdDevMs, std::sqrt((240.0 * 240.0 - 1.0) / 12.0), 1e-9);
+}
+
+TEST(FramePacerTest, EmptyStatsAreZero) {
+    FakeClock clock;
+    FramePacer pacer;
+    pacer.Initialize(&clock);
+    const FramePacer::Stats stats = pacer.GetStats();
+    EXPECT_EQ(stats.samples, 0u);
+    EXPECT_EQ(stats.p99Ms, 0.0);
+}
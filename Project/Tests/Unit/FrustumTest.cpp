@@ -0,0 +1,171 @@
+#include "Frustum.h"
+#include "MatrixUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+// 視錐台の平面抽出と、バッチカーネル（このテストのビルド設定で選ばれたバックエンド）の比較。
+// バッチ版は 1 要素ずつの判定と加算順を揃えてあるので、可視リストは完全に一致する。
+
+namespace {
+
+    // 原点から +Z を見る 60 度、16:9、near 1 / far 100 のカメラを少し回して置く
+    Matrix4x4 MakeCameraViewProj() {
+        const Matrix4x4 view = MatrixUtil::MakeViewMatrix(Vector3(3.0f, 2.0f, -5.0f), Vector3(4.0f, 1.5f, 10.0f),
+            Vector3(0.0f, 1.0f, 0.0f));
+        const Matrix4x4 proj = MatrixUtil::MakePerspectiveFovMatrix(1.0471976f, 16.0f / 9.0f, 1.0f, 100.0f);
+        return MatrixUtil::Multiply(view, proj);
+    }
+
+    // 行ベクトル (x, y, z, 1) を右から m で変換したクリップ座標
+    void ToClip(const Matrix4x4 &m, const Vector3 &p, float clip[4]) {
+        for (int c = 0; c < 4; ++c) {
+            clip[c] = p.x * m.m[0][c] + p.y * m.m[1][c] + p.z * m.m[2][c] + m.m[3][c];
+        }
+    }
+
+    // SoA の入力を持つだけの入れ物
+    struct Bounds {
+        std::vector<float> x, y, z, radius, ex, ey, ez;
+
+        Bounds(std::mt19937 &rng, size_t count) {
+            std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+            std::uniform_real_distribution<float> size(0.0f, 8.0f);
+            for (size_t i = 0; i < count; ++i) {
+                x.push_back(pos(rng));
+                y.push_back(pos(rng));
+                z.push_back(pos(rng));
+                radius.push_back(size(rng));
+                ex.push_back(size(rng));
+                ey.push_back(size(rng));
+                ez.push_back(size(rng));
+            }
+        }
+
+        FrustumCulling::SphereStreams Spheres(size_t begin, size_t count) const {
+            return {x.data() + begin, y.data() + begin, z.data() + begin, radius.data() + begin, count};
+        }
+
+        FrustumCulling::AabbStreams Aabbs(size_t begin, size_t count) const {
+            return {x.data() + begin, y.data() + begin, z.data() + begin,
+                ex.data() + begin, ey.data() + begin, ez.data() + begin, count};
+        }
+    };
+
+} // namespace
+
+TEST(FrustumTest, PlanesAgreeWithClipSpaceContainment) {
+    const Matrix4x4 vp = MakeCameraViewProj();
+    const Frustum frustum = Frustum::FromViewProjection(vp);
+
+    for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+        const float length = std::sqrt(frustum.normalX[p] * frustum.normalX[p] +
+            frustum.normalY[p] * frustum.normalY[p] + frustum.normalZ[p] * frustum.normalZ[p]);
+        EXPECT_NEAR(length, 1.0f, 1e-5f) << "plane " << p;
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+    int inside = 0;
+    int mismatches = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const Vector3 point(pos(rng), pos(rng), pos(rng));
+        float clip[4];
+        ToClip(vp, point, clip);
+        // 境界すれすれは丸めでどちらにも転ぶので比べない
+        const float margin = 1e-3f * std::fabs(clip[3]) + 1e-4f;
+        const float slack[] = {clip[3] - clip[0], clip[3] + clip[0], clip[3] - clip[1], clip[3] + clip[1],
+            clip[2], clip[3] - clip[2]};
+        bool expected = true;
+        bool nearBoundary = false;
+        for (float s : slack) {
+            expected = expected && s >= 0.0f;
+            nearBoundary = nearBoundary || std::fabs(s) < margin;
+        }
+        if (nearBoundary) continue;
+        inside += expected ? 1 : 0;
+        if (frustum.IntersectsSphere(point, 0.0f) != expected) ++mismatches;
+    }
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_GT(inside, 100); // 内側の点も十分に含まれている
+}
+
+TEST(FrustumTest, SpheresAndBoxesAgainstKnownPlanes) {
+    // ビュー = 単位行列なので、カメラは原点から +Z を向く
+    const Frustum frustum =
+        Frustum::FromViewProjection(MatrixUtil::MakePerspectiveFovMatrix(1.5707964f, 1.0f, 1.0f, 100.0f));
+
+    EXPECT_TRUE(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, 50.0f), 0.5f));
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, -5.0f), 1.0f));   // 背後
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, 110.0f), 5.0f));  // far の先
+    EXPECT_TRUE(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, 103.0f), 5.0f));   // far をまたぐ
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, 0.5f), 0.4f));    // near の手前
+    // 90 度の視野なので x = z が左右の境界。中心が外でも半径で届けば残す
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(12.0f, 0.0f, 10.0f), 1.0f));
+    EXPECT_TRUE(frustum.IntersectsSphere(Vector3(12.0f, 0.0f, 10.0f), 2.0f));
+
+    EXPECT_TRUE(frustum.IntersectsAabb(Vector3(0.0f, 0.0f, 50.0f), Vector3(1.0f, 1.0f, 1.0f)));
+    EXPECT_FALSE(frustum.IntersectsAabb(Vector3(0.0f, 30.0f, 10.0f), Vector3(1.0f, 1.0f, 1.0f)));
+    EXPECT_TRUE(frustum.IntersectsAabb(Vector3(0.0f, 30.0f, 10.0f), Vector3(1.0f, 25.0f, 1.0f)));
+    EXPECT_TRUE(frustum.IntersectsAabb(Vector3(0.0f, 0.0f, -10.0f), Vector3(1.0f, 1.0f, 20.0f)));
+}
+
+TEST(FrustumCullingTest, BatchMatchesPerElementTests) {
+    const Frustum frustum = Frustum::FromViewProjection(MakeCameraViewProj());
+    std::mt19937 rng(11);
+
+    // SIMD の幅で割り切れない数（端数はスカラで処理される）も含める
+    for (const size_t count : {size_t{1}, size_t{3}, size_t{4}, size_t{7}, size_t{8}, size_t{13}, size_t{4099}}) {
+        const Bounds bounds(rng, count);
+        std::vector<uint32_t> expectedSpheres;
+        std::vector<uint32_t> expectedAabbs;
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 c(bounds.x[i], bounds.y[i], bounds.z[i]);
+            if (frustum.IntersectsSphere(c, bounds.radius[i])) expectedSpheres.push_back(static_cast<uint32_t>(i));
+            if (frustum.IntersectsAabb(c, Vector3(bounds.ex[i], bounds.ey[i], bounds.ez[i]))) {
+                expectedAabbs.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        std::vector<uint32_t> visible(count);
+        visible.resize(FrustumCulling::CullSpheres(frustum, bounds.Spheres(0, count), visible.data()));
+        EXPECT_EQ(visible, expectedSpheres) << "count " << count;
+
+        visible.assign(count, 0);
+        visible.resize(FrustumCulling::CullAabbs(frustum, bounds.Aabbs(0, count), visible.data()));
+        EXPECT_EQ(visible, expectedAabbs) << "count " << count;
+    }
+}
+
+TEST(FrustumCullingTest, ChunksWithIndexOffsetMatchOneBatch) {
+    const Frustum frustum = Frustum::FromViewProjection(MakeCameraViewProj());
+    std::mt19937 rng(13);
+    constexpr size_t kCount = 10000;
+    constexpr size_t kChunk = 333; // ジョブに分けて判定する使い方
+    const Bounds bounds(rng, kCount);
+
+    std::vector<uint32_t> whole(kCount);
+    whole.resize(FrustumCulling::CullAabbs(frustum, bounds.Aabbs(0, kCount), whole.data()));
+    ASSERT_FALSE(whole.empty());
+    ASSERT_LT(whole.size(), kCount);
+
+    std::vector<uint32_t> chunked;
+    std::vector<uint32_t> scratch(kChunk);
+    for (size_t begin = 0; begin < kCount; begin += kChunk) {
+        const size_t n = (std::min)(kChunk, kCount - begin);
+        const size_t visible = FrustumCulling::CullAabbs(frustum, bounds.Aabbs(begin, n), scratch.data(),
+            static_cast<uint32_t>(begin));
+        chunked.insert(chunked.end(), scratch.begin(), scratch.begin() + static_cast<ptrdiff_t>(visible));
+    }
+    EXPECT_EQ(chunked, whole);
+}
+
+TEST(FrustumCullingTest, EmptyInputWritesNothing) {
+    const Frustum frustum = Frustum::FromViewProjection(MakeCameraViewProj());
+    EXPECT_EQ(FrustumCulling::CullSpheres(frustum, {}, nullptr), 0u);
+    EXPECT_EQ(FrustumCulling::CullAabbs(frustum, {}, nullptr), 0u);
+}
@@ -0,0 +1,194 @@
+#include "CpuTimestampBackend.h"
+#include "GpuProfiler.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+namespace {
+
+    // 手で進める時計（1 tick = 1 ms）で CpuTimestampBackend を動かすフィクスチャ
+    class GpuProfilerTest : public ::testing::Test {
+    protected:
+        static constexpr uint32_t kSlots = 2;
+
+        void Init(uint32_t maxQueries = 64) {
+            backend_ = std::make_unique<CpuTimestampBackend>(kSlots, maxQueries, [this] { return now_; }, 1000);
+            profiler_.Initialize(backend_.get());
+        }
+
+        const GpuProfiler::ZoneStats *FindStats(const std::string &name) const {
+            for (const auto &z : profiler_.GetStats()) {
+                if (z.name == name) return &z;
+            }
+            return nullptr;
+        }
+
+        // Frame の中に "Work" を 1 つだけ積むフレーム（Work は workMs）
+        void SimpleFrame(uint32_t slot, uint64_t workMs) {
+            profiler_.BeginFrame(slot);
+            {
+                TARO_GPU_PROFILE_SCOPE(profiler_, "Work");
+                now_ += workMs;
+            }
+            now_ += 1;
+            profiler_.EndFrame();
+        }
+
+        uint64_t now_ = 0;
+        std::unique_ptr<CpuTimestampBackend> backend_;
+        GpuProfiler profiler_;
+    };
+
+} // namespace
+
+TEST_F(GpuProfilerTest, ResultsArriveWhenTheSlotIsReused) {
+    Init();
+    SimpleFrame(0, 5);
+    EXPECT_TRUE(profiler_.GetLastResults().empty());
+    SimpleFrame(1, 7);
+    EXPECT_TRUE(profiler_.GetLastResults().empty()); // まだどのスロットも再利用されていない
+
+    profiler_.BeginFrame(0); // スロット 0 の 1 フレーム目を回収する
+    ASSERT_EQ(profiler_.GetLastResults().size(), 2u);
+    EXPECT_DOUBLE_EQ(profiler_.GetLastResults()[1].ms, 5.0);
+    EXPECT_DOUBLE_EQ(profiler_.GetLastFrameMs(), 6.0);
+    profiler_.EndFrame();
+
+    profiler_.BeginFrame(1);
+    EXPECT_DOUBLE_EQ(profiler_.GetLastResults()[1].ms, 7.0);
+    EXPECT_DOUBLE_EQ(profiler_.GetLastFrameMs(), 8.0);
+    profiler_.EndFrame();
+}
+
+TEST_F(GpuProfilerTest, NestedScopesKeepOrderAndDepth) {
+    Init();
+    profiler_.BeginFrame(0);
+    now_ += 1;
+    {
+        TARO_GPU_PROFILE_SCOPE(profiler_, "Sprites");
+        now_ += 2;
+        {
+            TARO_GPU_PROFILE_SCOPE(profiler_, "Upload");
+            now_ += 3;
+        }
+        now_ += 4;
+    }
+    {
+        TARO_GPU_PROFILE_SCOPE(profiler_, "ImGui");
+        now_ += 5;
+    }
+    profiler_.EndFrame();
+    profiler_.BeginFrame(0);
+
+    const auto &results = profiler_.GetLastResults();
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_STREQ(results[0].name, "Frame");
+    EXPECT_EQ(results[0].depth, 0u);
+    EXPECT_DOUBLE_EQ(results[0].ms, 15.0);
+    EXPECT_STREQ(results[1].name, "Sprites");
+    EXPECT_EQ(results[1].depth, 1u);
+    EXPECT_DOUBLE_EQ(results[1].ms, 9.0);
+    EXPECT_STREQ(results[2].name, "Upload");
+    EXPECT_EQ(results[2].depth, 2u);
+    EXPECT_DOUBLE_EQ(results[2].ms, 3.0);
+    EXPECT_STREQ(results[3].name, "ImGui");
+    EXPECT_EQ(results[3].depth, 1u); // 兄弟スコープは同じ深さに戻る
+    EXPECT_DOUBLE_EQ(results[3].ms, 5.0);
+    profiler_.EndFrame();
+}
+
+TEST_F(GpuProfilerTest, AggregatesRepeatedNamesAcrossFrames) {
+    Init();
+    // 1 フレームに同じ名前が 2 回出たら合計する
+    auto frame = [&](uint32_t slot, uint64_t a, uint64_t b) {
+        profiler_.BeginFrame(slot);
+        const uint32_t s0 = profiler_.BeginScope("Draw");
+        now_ += a;
+        profiler_.EndScope(s0);
+        const uint32_t s1 = profiler_.BeginScope("Draw");
+        now_ += b;
+        profiler_.EndScope(s1);
+        profiler_.EndFrame();
+    };
+    frame(0, 1, 1);  // Draw 2 ms
+    frame(1, 3, 3);  // Draw 6 ms（スロット 0 を回収する時点でまだ読まれない）
+    frame(0, 2, 2);  // 1 フレーム目を回収
+    frame(1, 5, 5);  // 2 フレーム目を回収
+    profiler_.BeginFrame(0); // 3 フレーム目を回収
+
+    const GpuProfiler::ZoneStats *draw = FindStats("Draw");
+    ASSERT_NE(draw, nullptr);
+    EXPECT_EQ(draw->frames, 3u);
+    EXPECT_DOUBLE_EQ(draw->lastMs, 4.0);
+    EXPECT_DOUBLE_EQ(draw->maxMs, 6.0);
+    // 指数移動平均: 2 → 2 + (6 - 2) * 0.1 → 2.4 + (4 - 2.4) * 0.1
+    EXPECT_NEAR(draw->avgMs, 2.56, 1e-9);
+    ASSERT_NE(FindStats("Frame"), nullptr);
+    EXPECT_EQ(profiler_.GetStats().front().name, "Frame"); // 初出順
+
+    profiler_.ResetStats();
+    EXPECT_EQ(draw->frames, 0u);
+    EXPECT_DOUBLE_EQ(draw->maxMs, 4.0);
+    profiler_.EndFrame();
+}
+
+TEST_F(GpuProfilerTest, DropsScopesWhenQueriesRunOut) {
+    Init(4); // Frame + 1 スコープ分
+    profiler_.BeginFrame(0);
+    const uint32_t first = profiler_.BeginScope("First");
+    const uint32_t second = profiler_.BeginScope("Second");
+    EXPECT_NE(first, GpuProfiler::kInvalidScope);
+    EXPECT_EQ(second, GpuProfiler::kInvalidScope);
+    now_ += 2;
+    profiler_.EndScope(second); // 無効なスコープの終了は何もしない
+    profiler_.EndScope(first);
+    profiler_.EndFrame();
+    EXPECT_EQ(profiler_.GetDroppedScopeCount(), 1u);
+
+    profiler_.BeginFrame(0);
+    ASSERT_EQ(profiler_.GetLastResults().size(), 2u);
+    EXPECT_STREQ(profiler_.GetLastResults()[1].name, "First");
+    EXPECT_DOUBLE_EQ(profiler_.GetLastResults()[1].ms, 2.0);
+    profiler_.EndFrame();
+}
+
+TEST_F(GpuProfilerTest, IgnoresScopesOutsideFramesAndUnclosedScopes) {
+    Init();
+    EXPECT_EQ(profiler_.BeginScope("Outside"), GpuProfiler::kInvalidScope);
+
+    profiler_.BeginFrame(0);
+    profiler_.BeginScope("Leaked"); // 閉じ忘れ
+    now_ += 3;
+    profiler_.EndFrame();
+
+    profiler_.BeginFrame(0);
+    ASSERT_EQ(profiler_.GetLastResults().size(), 1u);
+    EXPECT_STREQ(profiler_.GetLastResults()[0].name, "Frame");
+    EXPECT_DOUBLE_EQ(profiler_.GetLastFrameMs(), 3.0);
+    EXPECT_EQ(FindStats("Leaked"), nullptr);
+    profiler_.EndFrame();
+}
+
+TEST(CpuTimestampBackendTest, OnlyResolvedQueriesAreReadable) {
+    uint64_t now = 10;
+    CpuTimestampBackend backend(2, 4, [&] { return now; }, 1000);
+    uint64_t out[4] = {};
+
+    backend.WriteTimestamp(1, 0);
+    now = 20;
+    backend.WriteTimestamp(1, 1);
+    EXPECT_FALSE(backend.ReadFrame(1, 2, out)); // 解決前は読めない
+
+    backend.ResolveFrame(1, 2);
+    ASSERT_TRUE(backend.ReadFrame(1, 2, out));
+    EXPECT_EQ(out[0], 10u);
+    EXPECT_EQ(out[1], 20u);
+    EXPECT_FALSE(backend.ReadFrame(1, 3, out)); // 解決した数より多くは読めない
+    EXPECT_FALSE(backend.ReadFrame(0, 1, out)); // 別のスロットは独立
+
+    // 解決後に書き込んでも、次に解決するまで読み出し側は変わらない
+    now = 99;
+    backend.WriteTimestamp(1, 0);
+    ASSERT_TRUE(backend.ReadFrame(1, 1, out));
+    EXPECT_EQ(out[0], 10u);
+}
@@ -0,0 +1,223 @@
+#include "JobSystem.h"
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // 再帰で子ジョブを積む（ジョブの中からの Run と、入れ子の Wait を通す）
+    uint64_t Fib(JobSystem &jobs, uint32_t n) {
+        if (n < 2) return n;
+        if (n < 12) return Fib(jobs, n - 1) + Fib(jobs, n - 2);
+        uint64_t a = 0;
+        uint64_t b = 0;
+        JobCounter counter;
+        jobs.Run(counter, [&] { a = Fib(jobs, n - 1); });
+        b = Fib(jobs, n - 2);
+        jobs.Wait(counter);
+        return a + b;
+    }
+
+    uint64_t SerialFib(uint32_t n) {
+        return n < 2 ? n : SerialFib(n - 1) + SerialFib(n - 2);
+    }
+
+} // namespace
+
+TEST(WorkStealingDequeTest, OwnerIsLifoAndThiefIsFifo) {
+    WorkStealingDeque<int> deque(8);
+    int v = 0;
+    EXPECT_FALSE(deque.Pop(v));
+    EXPECT_FALSE(deque.Steal(v));
+
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(deque.Push(i));
+    EXPECT_FALSE(deque.Push(8)); // 満杯
+    EXPECT_EQ(deque.GetApproximateSize(), 8u);
+
+    ASSERT_TRUE(deque.Pop(v));
+    EXPECT_EQ(v, 7);
+    ASSERT_TRUE(deque.Steal(v));
+    EXPECT_EQ(v, 0);
+    ASSERT_TRUE(deque.Steal(v));
+    EXPECT_EQ(v, 1);
+    EXPECT_EQ(deque.GetApproximateSize(), 5u);
+
+    // 取り出した分だけ空きができ、リングを一周しても順序は崩れない
+    for (int i = 8; i < 11; ++i) EXPECT_TRUE(deque.Push(i));
+    std::vector<int> popped;
+    while (deque.Pop(v)) popped.push_back(v);
+    EXPECT_EQ(popped, (std::vector<int>{10, 9, 8, 6, 5, 4, 3, 2}));
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealersNeitherLoseNorDuplicate) {
+    constexpr int kItems = 200000;
+    constexpr uint32_t kThieves = 3;
+    WorkStealingDeque<int> deque(256);
+    std::vector<std::atomic<uint32_t>> seen(kItems);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (uint32_t i = 0; i < kThieves; ++i) {
+        thieves.emplace_back([&] {
+            int v = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                if (deque.Steal(v)) seen[v].fetch_add(1, std::memory_order_relaxed);
+                else std::this_thread::yield();
+            }
+        });
+    }
+
+    // 所有スレッドは積みながら、ときどき自分でも取り出す（最後の 1 件の取り合いを起こす）
+    int v = 0;
+    for (int i = 0; i < kItems; ++i) {
+        while (!deque.Push(i)) {
+            if (deque.Pop(v)) seen[v].fetch_add(1, std::memory_order_relaxed);
+        }
+        if (i % 3 == 0 && deque.Pop(v)) seen[v].fetch_add(1, std::memory_order_relaxed);
+    }
+    while (deque.Pop(v)) seen[v].fetch_add(1, std::memory_order_relaxed);
+    done.store(true, std::memory_order_release);
+    for (auto &t : thieves) t.join();
+
+    uint32_t wrong = 0;
+    for (int i = 0; i < kItems; ++i) {
+        if (seen[i].load() != 1) ++wrong;
+    }
+    EXPECT_EQ(wrong, 0u);
+}
+
+TEST(JobSystemTest, RunsEveryJobAndWaitReturnsAfterAll) {
+    JobSystem jobs;
+    jobs.Initialize(3);
+    EXPECT_EQ(jobs.GetWorkerCount(), 3u);
+
+    constexpr uint32_t kJobs = 10000;
+    std::vector<std::atomic<uint32_t>> runs(kJobs);
+    JobCounter counter;
+    for (uint32_t i = 0; i < kJobs; ++i) {
+        jobs.Run(counter, [&runs, i] { runs[i].fetch_add(1, std::memory_order_relaxed); });
+    }
+    jobs.Wait(counter);
+    EXPECT_TRUE(counter.IsDone());
+
+    uint32_t wrong = 0;
+    for (uint32_t i = 0; i < kJobs; ++i) {
+        if (runs[i].load() != 1) ++wrong;
+    }
+    EXPECT_EQ(wrong, 0u);
+    jobs.Finalize();
+}
+
+TEST(JobSystemTest, ChildJobsKeepTheParentCounterOpen) {
+    JobSystem jobs;
+    jobs.Initialize(2);
+
+    std::atomic<uint32_t> leaves{0};
+    JobCounter counter;
+    for (int i = 0; i < 8; ++i) {
+        jobs.Run(counter, [&] {
+            // 同じカウンタに子を積む。親のジョブが先に終わっても、子が残っていれば完了しない
+            for (int j = 0; j < 8; ++j) {
+                jobs.Run(counter, [&] { leaves.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    jobs.Wait(counter);
+    EXPECT_EQ(leaves.load(), 64u);
+
+    EXPECT_EQ(Fib(jobs, 24), SerialFib(24)); // ジョブの中で Wait する入れ子
+    jobs.Finalize();
+}
+
+TEST(JobSystemTest, ParallelForCoversEveryIndexOnce) {
+    JobSystem jobs;
+    jobs.Initialize(3);
+
+    for (const size_t count : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{65}, size_t{100000}}) {
+        for (const size_t grain : {size_t{0}, size_t{1}, size_t{64}, size_t{1000}}) {
+            if (grain == 1 && count > 1000) continue; // 1 件ずつは細かすぎるので省く
+            std::vector<std::atomic<uint32_t>> hits(count);
+            std::atomic<uint32_t> badRange{0};
+            jobs.ParallelFor(count, grain, [&](size_t begin, size_t end) {
+                if (begin >= end || end > count) ++badRange;
+                for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1, std::memory_order_relaxed);
+            });
+            uint32_t wrong = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (hits[i].load() != 1) ++wrong;
+            }
+            EXPECT_EQ(wrong, 0u) << "count " << count << ", grain " << grain;
+            EXPECT_EQ(badRange.load(), 0u) << "count " << count << ", grain " << grain;
+        }
+    }
+    jobs.Finalize();
+}
+
+TEST(JobSystemTest, ThreadsWithoutAQueueCanRunAndWait) {
+    JobSystem jobs;
+    jobs.Initialize(2);
+
+    // SimulationThread のように、Initialize していないスレッドからも積んで待てる
+    constexpr uint32_t kJobs = 2000;
+    std::atomic<uint32_t> runs{0};
+    std::atomic<uint32_t> nested{0};
+    std::thread outsider([&] {
+        JobCounter counter;
+        for (uint32_t i = 0; i < kJobs; ++i) {
+            jobs.Run(counter, [&] { runs.fetch_add(1, std::memory_order_relaxed); });
+        }
+        jobs.Wait(counter);
+        jobs.ParallelFor(1000, 10, [&](size_t begin, size_t end) {
+            nested.fetch_add(static_cast<uint32_t>(end - begin), std::memory_order_relaxed);
+        });
+    });
+    outsider.join();
+
+    EXPECT_EQ(runs.load(), kJobs);
+    EXPECT_EQ(nested.load(), 1000u);
+    jobs.Finalize();
+}
+
+TEST(JobSystemTest, ZeroWorkersRunsOnTheCallingThread) {
+    JobSystem jobs;
+    jobs.Initialize(0);
+    EXPECT_EQ(jobs.GetWorkerCount(), 0u);
+
+    const std::thread::id self = std::this_thread::get_id();
+    std::atomic<uint32_t> elsewhere{0};
+    std::atomic<uint32_t> runs{0};
+    JobCounter counter;
+    for (int i = 0; i < 100; ++i) {
+        jobs.Run(counter, [&] {
+            if (std::this_thread::get_id() != self) ++elsewhere;
+            ++runs;
+        });
+    }
+    jobs.Wait(counter); // ワーカーがいなくても Wait が手伝って片付ける
+    EXPECT_EQ(runs.load(), 100u);
+    EXPECT_EQ(elsewhere.load(), 0u);
+
+    size_t covered = 0;
+    jobs.ParallelFor(500, 16, [&](size_t begin, size_t end) { covered += end - begin; });
+    EXPECT_EQ(covered, 500u);
+    EXPECT_EQ(Fib(jobs, 16), SerialFib(16));
+    jobs.Finalize();
+}
+
+TEST(JobSystemTest, FinalizeDrainsOutstandingJobs) {
+    std::atomic<uint32_t> runs{0};
+    JobCounter counter;
+    {
+        JobSystem jobs;
+        jobs.Initialize(1);
+        for (int i = 0; i < 500; ++i) {
+            jobs.Run(counter, [&] { runs.fetch_add(1, std::memory_order_relaxed); });
+        }
+        jobs.Finalize(); // Wait せずに終えても、積んだ分は実行される
+    }
+    EXPECT_EQ(runs.load(), 500u);
+    EXPECT_TRUE(counter.IsDone());
+}
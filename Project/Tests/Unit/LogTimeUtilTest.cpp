@@ -0,0 +1,235 @@
+#include "LogTimeUtil.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <format>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
+
+// LogTimeUtil::Format を strftime（localtime）+ std::format の組み立てと突き合わせる。
+// タイムゾーンは POSIX の TZ 文字列で切り替える（tzdata が無くても規則ごと解釈される）。
+// 時差が 1 時間単位でない地域や 30 分だけずれる夏時間も含め、オフセットの 15 分区間キャッシュの境界を確かめる。
+
+using namespace std::chrono;
+using Precision = LogTimeUtil::Precision;
+
+namespace {
+
+    constexpr const char *kUtc = "UTC0";
+    constexpr const char *kNepal = "NPT-5:45";                               // +5:45 固定
+    constexpr const char *kUsEastern = "EST5EDT,M3.2.0,M11.1.0";              // -5:00 / 夏 -4:00
+    constexpr const char *kNewfoundland = "NST3:30NDT,M3.2.0,M11.1.0";        // -3:30 / 夏 -2:30
+    constexpr const char *kLordHowe = "LHST-10:30LHDT-11,M10.1.0,M4.1.0";     // +10:30 / 夏 +11:00（30 分だけ進む）
+    constexpr const char *kZones[] = {kUtc, kNepal, kUsEastern, kNewfoundland, kLordHowe};
+
+    std::tm ToLocal(std::time_t t) {
+        std::tm tm{};
+        localtime_r(&t, &tm);
+        return tm;
+    }
+
+    // 期待値：秒は strftime、秒未満は std::format で組み立てる
+    std::string Expected(system_clock::time_point tp, Precision precision) {
+        const auto sec = floor<seconds>(tp);
+        const int64_t micro = duration_cast<microseconds>(tp - sec).count();
+        const std::tm tm = ToLocal(static_cast<std::time_t>(sec.time_since_epoch().count()));
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm);
+        std::string s = buf;
+        if (precision == Precision::Milliseconds) s += std::format(".{:03}", micro / 1000);
+        if (precision == Precision::Microseconds) s += std::format(".{:06}", micro);
+        return s;
+    }
+
+    void ExpectAllPrecisions(system_clock::time_point tp) {
+        for (const Precision p : {Precision::Seconds, Precision::Milliseconds, Precision::Microseconds}) {
+            EXPECT_EQ(LogTimeUtil::Format(tp, p), Expected(tp, p))
+                << "us since epoch " << duration_cast<microseconds>(tp.time_since_epoch()).count()
+                << " precision " << static_cast<int>(p);
+        }
+    }
+
+    system_clock::time_point Utc(int y, unsigned m, unsigned d, int hh = 0, int mm = 0, int ss = 0, int64_t micro = 0) {
+        return sys_days{year{y} / month{m} / day{d}} + hours{hh} + minutes{mm} + seconds{ss} + microseconds{micro};
+    }
+
+    long GmtOffset(int64_t unixSeconds) {
+        return ToLocal(static_cast<std::time_t>(unixSeconds)).tm_gmtoff;
+    }
+
+    // [from, to] で UTC オフセットが最初に変わる秒（1 時間刻みで探してから二分探索）
+    std::optional<int64_t> FindTransition(system_clock::time_point from, system_clock::time_point to) {
+        const int64_t begin = floor<seconds>(from).time_since_epoch().count();
+        const int64_t end = floor<seconds>(to).time_since_epoch().count();
+        const long first = GmtOffset(begin);
+        for (int64_t hi = begin + 3600; hi <= end; hi += 3600) {
+            if (GmtOffset(hi) == first) continue;
+            int64_t lo = hi - 3600;
+            while (hi - lo > 1) {
+                const int64_t mid = lo + (hi - lo) / 2;
+                (GmtOffset(mid) == first ? lo : hi) = mid;
+            }
+            return hi;
+        }
+        return std::nullopt;
+    }
+
+    // TZ を切り替え、終わったら元に戻すフィクスチャ
+    class LogTimeUtilTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            if (const char *tz = std::getenv("TZ")) savedTz_ = tz;
+        }
+
+        void TearDown() override {
+            if (savedTz_) {
+                setenv("TZ", savedTz_->c_str(), 1);
+            } else {
+                unsetenv("TZ");
+            }
+            tzset();
+            LogTimeUtil::Detail::cachedOffset.store(0);
+        }
+
+        static void SetTimeZone(const char *tz) {
+            setenv("TZ", tz, 1);
+            tzset();
+            LogTimeUtil::Detail::cachedOffset.store(0); // 前のゾーンで計算した区間を使わない
+        }
+
+    private:
+        std::optional<std::string> savedTz_;
+    };
+
+} // namespace
+
+TEST_F(LogTimeUtilTest, DaysFromCivilMatchesChronoCalendar) {
+    for (int y : {1600, 1899, 1900, 1969, 1970, 2000, 2024, 2100, 2400}) {
+        for (unsigned m = 1; m <= 12; ++m) {
+            for (unsigned d : {1u, 28u}) {
+                const int64_t expected = sys_days{year{y} / month{m} / day{d}}.time_since_epoch().count();
+                EXPECT_EQ(LogTimeUtil::Detail::DaysFromCivil(y, m, d), expected) << y << "-" << m << "-" << d;
+            }
+        }
+    }
+    // 閏日（4 で割り切れても 100 で割り切れる年は平年、400 で割り切れれば閏年）
+    EXPECT_EQ(LogTimeUtil::Detail::DaysFromCivil(2000, 3, 1) - LogTimeUtil::Detail::DaysFromCivil(2000, 2, 28), 2);
+    EXPECT_EQ(LogTimeUtil::Detail::DaysFromCivil(1900, 3, 1) - LogTimeUtil::Detail::DaysFromCivil(1900, 2, 28), 1);
+    EXPECT_EQ(LogTimeUtil::Detail::DaysFromCivil(2024, 3, 1) - LogTimeUtil::Detail::DaysFromCivil(2024, 2, 28), 2);
+}
+
+TEST_F(LogTimeUtilTest, KnownValuesInUtc) {
+    SetTimeZone(kUtc);
+    const auto tp = Utc(2024, 2, 29, 23, 59, 58, 123456);
+    EXPECT_EQ(LogTimeUtil::Format(tp), "23:59:58");
+    EXPECT_EQ(LogTimeUtil::Format(tp, Precision::Milliseconds), "23:59:58.123");
+    EXPECT_EQ(LogTimeUtil::Format(tp, Precision::Microseconds), "23:59:58.123456");
+
+    // エポック直前は前日の 23:59:59 で、秒未満は切り捨てではなく床（.999999）になる
+    const auto beforeEpoch = system_clock::time_point{} - microseconds{1};
+    EXPECT_EQ(LogTimeUtil::Format(beforeEpoch, Precision::Microseconds), "23:59:59.999999");
+    EXPECT_EQ(LogTimeUtil::Format(beforeEpoch, Precision::Milliseconds), "23:59:59.999");
+
+    char buf[LogTimeUtil::kMaxTimeStringLength];
+    EXPECT_EQ(LogTimeUtil::FormatTo(buf, tp, Precision::Microseconds), 15u);
+    EXPECT_STREQ(buf, "23:59:58.123456");
+}
+
+TEST_F(LogTimeUtilTest, BucketBeforeEpochIsNotTheEmptyCache) {
+    // エポック直前の区間（番号 -1）がキャッシュ未計算の 0 と取り違えられると、オフセット 0（UTC）で表示される
+    SetTimeZone(kNepal);
+    const auto beforeEpoch = system_clock::time_point{} - microseconds{1};
+    EXPECT_EQ(LogTimeUtil::Format(beforeEpoch, Precision::Microseconds), "05:44:59.999999");
+    EXPECT_EQ(LogTimeUtil::GetUtcOffsetSeconds(-1), 5 * 3600 + 45 * 60);
+}
+
+TEST_F(LogTimeUtilTest, DateBoundariesMatchStrftime) {
+    for (const char *zone : kZones) {
+        SCOPED_TRACE(zone);
+        SetTimeZone(zone);
+        // 日・月・年の変わり目、閏日、エポックの前後、1901 年より前（32bit time_t の範囲外）
+        const system_clock::time_point boundaries[] = {
+            Utc(1970, 1, 1), Utc(1969, 12, 31, 23, 59, 59, 999999),
+            Utc(2000, 2, 28, 23, 59, 59, 999999), Utc(2000, 2, 29), Utc(2000, 3, 1),
+            Utc(1900, 2, 28, 23, 59, 59, 999999), Utc(1900, 3, 1),
+            Utc(2024, 2, 29, 12), Utc(2100, 2, 28, 23, 59, 59), Utc(2100, 3, 1),
+            Utc(2023, 12, 31, 23, 59, 59, 500000), Utc(2024, 1, 1),
+            Utc(2024, 4, 30, 23, 59, 59), Utc(2024, 5, 1), Utc(1850, 6, 15, 5, 6, 7, 89),
+        };
+        for (const auto &tp : boundaries) {
+            for (const auto delta : {microseconds{-1}, microseconds{0}, microseconds{1}}) {
+                ExpectAllPrecisions(tp + delta);
+            }
+        }
+    }
+}
+
+TEST_F(LogTimeUtilTest, RandomTimesMatchStrftime) {
+    std::mt19937_64 rng(2024);
+    // 1890 年頃〜2100 年頃（エポックの前後を含む）
+    std::uniform_int_distribution<int64_t> dist(-2'500'000'000'000'000, 4'100'000'000'000'000);
+    for (const char *zone : kZones) {
+        SCOPED_TRACE(zone);
+        SetTimeZone(zone);
+        for (int i = 0; i < 2000; ++i) {
+            ExpectAllPrecisions(system_clock::time_point{microseconds{dist(rng)}});
+        }
+    }
+}
+
+TEST_F(LogTimeUtilTest, OffsetBucketBoundariesMatchStrftime) {
+    constexpr int64_t kBucket = LogTimeUtil::Detail::kOffsetBucketSeconds;
+    for (const char *zone : kZones) {
+        SCOPED_TRACE(zone);
+        SetTimeZone(zone);
+        // 区間の境界の直前・直後を時系列順に（直前の区間のキャッシュが残った状態で境界をまたぐ）
+        const auto start = Utc(2024, 7, 1);
+        for (int64_t b = 1; b <= 200; ++b) {
+            const auto boundary = start + seconds{b * kBucket};
+            ExpectAllPrecisions(boundary - microseconds{1});
+            ExpectAllPrecisions(boundary);
+        }
+        // 逆順でも同じ
+        for (int64_t b = 200; b >= 1; --b) {
+            const auto boundary = start + seconds{b * kBucket};
+            ExpectAllPrecisions(boundary);
+            ExpectAllPrecisions(boundary - microseconds{1});
+        }
+    }
+}
+
+TEST_F(LogTimeUtilTest, DaylightSavingTransitionsMatchStrftime) {
+    constexpr int64_t kBucket = LogTimeUtil::Detail::kOffsetBucketSeconds;
+    struct Case {
+        const char *zone;
+        system_clock::time_point from, to;
+    };
+    const Case cases[] = {
+        {kUsEastern, Utc(2024, 3, 1), Utc(2024, 4, 1)},      // 1 時間進む
+        {kUsEastern, Utc(2024, 11, 1), Utc(2024, 12, 1)},    // 1 時間戻る
+        {kNewfoundland, Utc(2024, 3, 1), Utc(2024, 4, 1)},
+        {kLordHowe, Utc(2024, 3, 25), Utc(2024, 4, 15)},     // 30 分戻る
+        {kLordHowe, Utc(2024, 9, 25), Utc(2024, 10, 15)},    // 30 分進む
+    };
+    for (const Case &c : cases) {
+        SCOPED_TRACE(c.zone);
+        SetTimeZone(c.zone);
+        const std::optional<int64_t> transition = FindTransition(c.from, c.to);
+        ASSERT_TRUE(transition.has_value());
+        EXPECT_EQ(*transition % kBucket, 0); // 切り替えは区間の境界で起きる
+
+        const auto t = system_clock::time_point{seconds{*transition}};
+        const microseconds offsets[] = {
+            -seconds{kBucket} - microseconds{1}, -seconds{kBucket}, -seconds{1}, -microseconds{1},
+            microseconds{0}, microseconds{1}, seconds{kBucket} - microseconds{1}, seconds{kBucket}};
+        for (const auto &o : offsets) ExpectAllPrecisions(t + o);
+        for (auto it = std::rbegin(offsets); it != std::rend(offsets); ++it) ExpectAllPrecisions(t + *it);
+
+        // 切り替えの前後で時計がずれる（進む or 戻る）
+        EXPECT_NE(GmtOffset(*transition - 1), GmtOffset(*transition));
+    }
+}
@@ -0,0 +1,84 @@
+#include "MappedLogFile.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // 一時ディレクトリにファイルを作るフィクスチャ
+    class MappedLogFileTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            std::random_device rd;
+            root_ = fs::temp_directory_path() / ("TaroMappedLogFileTest_" + std::to_string(rd()));
+            fs::create_directories(root_);
+            path_ = root_ / "app.log";
+        }
+
+        void TearDown() override {
+            std::error_code ec;
+            fs::remove_all(root_, ec);
+        }
+
+        std::string ReadAll() const {
+            std::ifstream ifs(path_, std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        }
+
+        fs::path root_;
+        fs::path path_;
+    };
+
+} // namespace
+
+TEST_F(MappedLogFileTest, CloseTrimsZeroFilledTail) {
+    MappedLogFile file;
+    ASSERT_TRUE(file.Open(path_, 1));
+    ASSERT_TRUE(file.Append("hello\n", 6));
+    EXPECT_EQ(file.GetSize(), 6u);
+
+    // 書いている間はセグメント単位で伸びている
+    EXPECT_GT(fs::file_size(path_), 6u);
+
+    file.Close();
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_EQ(ReadAll(), "hello\n");
+}
+
+TEST_F(MappedLogFileTest, AppendCrossesSegments) {
+    MappedLogFile file;
+    ASSERT_TRUE(file.Open(path_, 1)); // 割り当て粒度 1 つぶんに切り上がる
+
+    // 1 回の Append がセグメントをまたぐ長さを何度か書く
+    std::string expected;
+    const std::string chunk(3000, 'x');
+    for (int i = 0; i < 10; ++i) {
+        const std::string text = chunk + std::to_string(i) + "\n";
+        ASSERT_TRUE(file.Append(text.data(), text.size()));
+        expected += text;
+    }
+    ASSERT_TRUE(file.Sync());
+    EXPECT_EQ(file.GetSize(), expected.size());
+    file.Close();
+    EXPECT_EQ(ReadAll(), expected);
+}
+
+TEST_F(MappedLogFileTest, TrimTrailingZerosRemovesCrashLeftover) {
+    // 異常終了した状態（書いた分の後ろに 0 埋めが残る）を作る
+    const std::string text = "line 1\nline 2\n";
+    {
+        std::ofstream ofs(path_, std::ios::binary);
+        ofs << text;
+        ofs << std::string(100000, '\0');
+    }
+
+    MappedLogFile::TrimTrailingZeros(path_);
+    EXPECT_EQ(ReadAll(), text);
+
+    // 0 埋めが無ければ何もしない
+    MappedLogFile::TrimTrailingZeros(path_);
+    EXPECT_EQ(ReadAll(), text);
+}
@@ -0,0 +1,233 @@
+#include "FloatCompare.h"
+#include "MatrixUtil.h"
+#include "ScalarMatrixUtil.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// SIMD 版 MatrixUtil（このテストのビルド設定で選ばれたバックエンド）とスカラ版の比較。
+// FMA を使わない限り、加算順を揃えてあるのでビット単位で一致する（ULP 0）。
+
+namespace {
+
+#if defined(TARO_SIMD_FMA)
+    constexpr int64_t kMaxSimdUlp = 4; // FMA は中間の丸めが 1 回減るぶんずれる
+#else
+    constexpr int64_t kMaxSimdUlp = 0;
+#endif
+
+    constexpr int kIterations = 20000;
+
+    Matrix4x4 RandomMatrix(std::mt19937 &rng, float range) {
+        std::uniform_real_distribution<float> dist(-range, range);
+        Matrix4x4 m;
+        for (auto &row : m.m) {
+            for (float &v : row) v = dist(rng);
+        }
+        return m;
+    }
+
+    Vector3 RandomVector(std::mt19937 &rng, float lo, float hi) {
+        std::uniform_real_distribution<float> dist(lo, hi);
+        return Vector3(dist(rng), dist(rng), dist(rng));
+    }
+
+    Matrix4x4 RandomRigid(std::mt19937 &rng) {
+        return MatrixUtil::MakeTRS(RandomVector(rng, -1000.0f, 1000.0f), RandomVector(rng, -6.3f, 6.3f), Vector3(1, 1, 1));
+    }
+
+    // スプライトで使う VP（ビュー = 平行移動、射影 = 正射影）
+    Matrix4x4 SpriteViewProj(std::mt19937 &rng) {
+        std::uniform_real_distribution<float> dist(-500.0f, 500.0f);
+        const Matrix4x4 view = MatrixUtil::MakeTranslationMatrix(dist(rng), dist(rng), 0.0f);
+        return MatrixUtil::Multiply(view, MatrixUtil::MakeOrthographicMatrix(1280.0f, 720.0f, 0.0f, 1.0f));
+    }
+
+    // 行ベクトル (x, y, 0, 1) を右から m で変換した (x, y, w)
+    Vector3 TransformPoint2D(float x, float y, const Matrix4x4 &m) {
+        return Vector3(x * m.m[0][0] + y * m.m[1][0] + m.m[3][0],
+            x * m.m[0][1] + y * m.m[1][1] + m.m[3][1],
+            x * m.m[0][3] + y * m.m[1][3] + m.m[3][3]);
+    }
+
+} // namespace
+
+TEST(MatrixUtilSimd, ReportsBackend) {
+    EXPECT_STREQ(ScalarMatrixUtil::GetBackendName(), "Scalar");
+    std::printf("[ backend  ] %s\n", SimdConfig::GetBackendName());
+}
+
+TEST(MatrixUtilSimd, MultiplyMatchesScalar) {
+    std::mt19937 rng(1);
+    int64_t worst = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        const float range = i % 2 ? 1.0f : 1.0e4f;
+        const Matrix4x4 a = RandomMatrix(rng, range);
+        const Matrix4x4 b = RandomMatrix(rng, range);
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(MatrixUtil::Multiply(a, b), ScalarMatrixUtil::Multiply(a, b)));
+    }
+    EXPECT_LE(worst, kMaxSimdUlp);
+}
+
+TEST(MatrixUtilSimd, MultiplyAliasedOperands) {
+    std::mt19937 rng(2);
+    const Matrix4x4 a = RandomMatrix(rng, 10.0f);
+    EXPECT_LE(FloatCompare::MaxUlpDistance(MatrixUtil::Multiply(a, a), ScalarMatrixUtil::Multiply(a, a)), kMaxSimdUlp);
+}
+
+TEST(MatrixUtilSimd, TransposeIsExact) {
+    std::mt19937 rng(3);
+    for (int i = 0; i < 1000; ++i) {
+        const Matrix4x4 a = RandomMatrix(rng, 100.0f);
+        const Matrix4x4 t = MatrixUtil::Transpose(a);
+        EXPECT_EQ(FloatCompare::MaxUlpDistance(t, ScalarMatrixUtil::Transpose(a)), 0);
+        EXPECT_EQ(FloatCompare::MaxUlpDistance(MatrixUtil::Transpose(t), a), 0);
+    }
+}
+
+TEST(MatrixUtilSimd, InverseRigidMatchesScalar) {
+    std::mt19937 rng(4);
+    int64_t worst = 0;
+    float worstIdentityError = 0.0f;
+    for (int i = 0; i < kIterations; ++i) {
+        const Matrix4x4 m = RandomRigid(rng);
+        const Matrix4x4 inv = MatrixUtil::InverseRigid(m);
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(inv, ScalarMatrixUtil::InverseRigid(m)));
+        worstIdentityError = (std::max)(worstIdentityError,
+            FloatCompare::MaxAbsDifference(MatrixUtil::Multiply(m, inv), MatrixUtil::MakeIdentityMatrix()));
+    }
+    EXPECT_LE(worst, kMaxSimdUlp);
+    EXPECT_LT(worstIdentityError, 1.0e-3f); // 平行移動が最大 1000 なので相対 1e-6 程度
+}
+
+TEST(MatrixUtilSimd, MultiplyAffine2DMatchesScalar) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-2000.0f, 2000.0f);
+    int64_t worst = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        const Matrix3x2 a = MatrixUtil::MakeAffine2DMatrix(dist(rng) * 0.01f, dist(rng) * 0.01f, dist(rng) * 0.003f, dist(rng), dist(rng));
+        const Matrix4x4 b = RandomMatrix(rng, 2.0f);
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(MatrixUtil::MultiplyAffine2D(a, b), ScalarMatrixUtil::MultiplyAffine2D(a, b)));
+    }
+    EXPECT_LE(worst, kMaxSimdUlp);
+}
+
+// 2D アフィンの閉形式（現 Sprite::Update / SpriteBatchBuilder）と、
+// 置き換える前の 4x4 経路（World = Rz * T を作って VP と一般の 4x4 積）の比較
+TEST(MatrixUtilAffine2D, WorldMatchesRotateTranslate4x4) {
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> ang(-6.3f, 6.3f);
+    std::uniform_real_distribution<float> scale(-64.0f, 64.0f);
+    int64_t worst = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        const float rot = ang(rng), tx = pos(rng), ty = pos(rng), sx = scale(rng), sy = scale(rng);
+
+        const Matrix4x4 rt = MatrixUtil::Multiply(MatrixUtil::MakeRotationZMatrix(rot), MatrixUtil::MakeTranslationMatrix(tx, ty, 0.0f));
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(MatrixUtil::ToMatrix4x4(MatrixUtil::MakeAffine2DMatrix(rot, tx, ty)), rt));
+
+        const Matrix4x4 srt = MatrixUtil::Multiply(MatrixUtil::MakeScaleMatrix(sx, sy, 1.0f), rt);
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(MatrixUtil::ToMatrix4x4(MatrixUtil::MakeAffine2DMatrix(sx, sy, rot, tx, ty)), srt));
+    }
+    EXPECT_EQ(worst, 0);
+}
+
+TEST(MatrixUtilAffine2D, WvpMatchesGeneral4x4Product) {
+    // 0 / 1 との積を省いただけで加算順は同じなので、同じバックエンド同士なら一致する
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> ang(-6.3f, 6.3f);
+    int64_t worstScalar = 0;
+    int64_t worstSimd = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        const Matrix3x2 a = MatrixUtil::MakeAffine2DMatrix(ang(rng), pos(rng), pos(rng));
+        const Matrix4x4 world = MatrixUtil::ToMatrix4x4(a);
+        const Matrix4x4 vp = i % 2 ? SpriteViewProj(rng) : RandomMatrix(rng, 2.0f);
+
+        worstScalar = (std::max)(worstScalar, FloatCompare::MaxUlpDistance(
+            ScalarMatrixUtil::MultiplyAffine2D(a, vp), ScalarMatrixUtil::Multiply(world, vp)));
+        worstSimd = (std::max)(worstSimd, FloatCompare::MaxUlpDistance(
+            MatrixUtil::MultiplyAffine2D(a, vp), MatrixUtil::Multiply(world, vp)));
+    }
+    EXPECT_EQ(worstScalar, 0);
+    EXPECT_LE(worstSimd, kMaxSimdUlp);
+}
+
+TEST(MatrixUtilAffine2D, SizedQuadMatchesVertexSizedPath) {
+    // 旧経路: 頂点を (±w/2, ±h/2) に作り、Rz * T の 4x4 World と VP で変換する
+    // 新経路: 頂点は (±0.5, ±0.5) 固定で、サイズを畳み込んだ WVP で変換する（インスタンス描画）
+    // 掛ける順序が違うので丸めは変わるが、クリップ座標の差は画面 1 ピクセルより十分小さい
+    std::mt19937 rng(10);
+    std::uniform_real_distribution<float> pos(0.0f, 1280.0f);
+    std::uniform_real_distribution<float> ang(-3.2f, 3.2f);
+    std::uniform_real_distribution<float> size(1.0f, 512.0f);
+    constexpr float kCorner[4][2] = {{-0.5f, -0.5f}, {-0.5f, 0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}};
+    constexpr float kHalfPixelNdc = 1.0f / 1280.0f;
+
+    float worst = 0.0f;
+    for (int i = 0; i < kIterations; ++i) {
+        const float rot = ang(rng), tx = pos(rng), ty = pos(rng), w = size(rng), h = size(rng);
+        const Matrix4x4 vp = SpriteViewProj(rng);
+
+        const Matrix4x4 oldWvp = MatrixUtil::Multiply(
+            MatrixUtil::Multiply(MatrixUtil::MakeRotationZMatrix(rot), MatrixUtil::MakeTranslationMatrix(tx, ty, 0.0f)), vp);
+        const Matrix4x4 newWvp = MatrixUtil::MultiplyAffine2D(MatrixUtil::MakeAffine2DMatrix(w, h, rot, tx, ty), vp);
+
+        for (const auto &c : kCorner) {
+            const Vector3 before = TransformPoint2D(c[0] * w, c[1] * h, oldWvp);
+            const Vector3 after = TransformPoint2D(c[0], c[1], newWvp);
+            ASSERT_EQ(before.z, after.z);
+            worst = (std::max)(worst, (std::max)(std::fabs(before.x - after.x), std::fabs(before.y - after.y)));
+        }
+    }
+    EXPECT_LT(worst, kHalfPixelNdc * 1.0e-2f);
+}
+
+TEST(MatrixUtilTrs, ClosedFormMatchesComposedProduct) {
+    // 閉形式の MakeTRS は、0 / 1 との積を省いただけなので元の 4x4 積 4 回と一致する
+    std::mt19937 rng(6);
+    int64_t worst = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        const Vector3 t = RandomVector(rng, -1000.0f, 1000.0f);
+        const Vector3 r = RandomVector(rng, -6.3f, 6.3f);
+        const Vector3 s = RandomVector(rng, -4.0f, 4.0f);
+        const Matrix4x4 composed = ScalarMatrixUtil::MakeTRSComposed(t, r, s);
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(MatrixUtil::MakeTRS(t, r, s), composed));
+        worst = (std::max)(worst, FloatCompare::MaxUlpDistance(ScalarMatrixUtil::MakeTRS(t, r, s), composed));
+    }
+    EXPECT_EQ(worst, 0);
+}
+
+TEST(MatrixUtilTrs, AxisAlignedCases) {
+    const Matrix4x4 m = MatrixUtil::MakeTRS(Vector3(1, 2, 3), Vector3(0, 0, 0), Vector3(2, 3, 4));
+    Matrix4x4 expected = MatrixUtil::MakeScaleMatrix(2, 3, 4);
+    expected.m[3][0] = 1; expected.m[3][1] = 2; expected.m[3][2] = 3;
+    EXPECT_EQ(FloatCompare::MaxUlpDistance(m, expected), 0);
+
+    // Z 回転 90 度: +X が +Y へ（行ベクトル右掛け）
+    const Matrix4x4 rz = MatrixUtil::MakeTRS(Vector3(0, 0, 0), Vector3(0, 0, 1.57079632679f), Vector3(1, 1, 1));
+    EXPECT_NEAR(rz.m[0][0], 0.0f, 1e-6f);
+    EXPECT_NEAR(rz.m[0][1], 1.0f, 1e-6f);
+}
+
+TEST(MatrixUtilInverse, GeneralInverseRoundTrips) {
+    std::mt19937 rng(7);
+    // near/far の比が大きいと float では条件数が悪くなるので、ほどほどの範囲で確かめる
+    const Matrix4x4 proj = MatrixUtil::MakePerspectiveFovMatrix(1.0f, 16.0f / 9.0f, 1.0f, 100.0f);
+    for (int i = 0; i < 1000; ++i) {
+        const Matrix4x4 world = MatrixUtil::MakeTRS(RandomVector(rng, -50, 50), RandomVector(rng, -3, 3), RandomVector(rng, 0.5f, 2.0f));
+        const Matrix4x4 m = MatrixUtil::Multiply(world, proj);
+        Matrix4x4 inv;
+        ASSERT_TRUE(MatrixUtil::Inverse(m, inv));
+        EXPECT_LT(FloatCompare::MaxAbsDifference(MatrixUtil::Multiply(m, inv), MatrixUtil::MakeIdentityMatrix()), 1e-3f);
+    }
+
+    Matrix4x4 singular{};
+    Matrix4x4 out;
+    EXPECT_FALSE(MatrixUtil::Inverse(singular, out));
+}
+
+TEST(FloatCompareTest, UlpDistance) {
+    EXPECT_EQ(FloatCompare::UlpDistance(0.0f, -0.0f), 0);
+    EXPECT_EQ(FloatCompare::UlpDistance(1.0f, std::nextafter(1.0f, 2.0f)), 1);
+    EXPECT_EQ(FloatCompare::UlpDistance(-std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::denorm_min()), 2);
+}
@@ -0,0 +1,195 @@
+#include "PipelineStateKey.h"
+#include <gtest/gtest.h>
+
+// 列挙値は D3D12 の値をそのまま使う（テストでは d3d12.h を読まないので数値で書く）
+namespace {
+
+    constexpr uint32_t kBlendOne = 2;          // D3D12_BLEND_ONE
+    constexpr uint32_t kBlendSrcAlpha = 5;     // D3D12_BLEND_SRC_ALPHA
+    constexpr uint32_t kBlendInvSrcAlpha = 6;  // D3D12_BLEND_INV_SRC_ALPHA
+    constexpr uint32_t kBlendOpAdd = 1;        // D3D12_BLEND_OP_ADD
+    constexpr uint32_t kLogicOpCopy = 4;       // D3D12_LOGIC_OP_COPY
+    constexpr uint32_t kWriteAll = 0xF;        // D3D12_COLOR_WRITE_ENABLE_ALL
+    constexpr uint32_t kFormatRgba8 = 28;      // DXGI_FORMAT_R8G8B8A8_UNORM
+    constexpr uint32_t kFormatRgba16F = 10;    // DXGI_FORMAT_R16G16B16A16_FLOAT
+    constexpr uint32_t kFormatD24S8 = 45;      // DXGI_FORMAT_D24_UNORM_S8_UINT
+    constexpr uint32_t kComparisonLess = 2;    // D3D12_COMPARISON_FUNC_LESS
+    constexpr uint32_t kCullBack = 3;          // D3D12_CULL_MODE_BACK
+    constexpr uint32_t kPerInstanceData = 1;   // D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA
+
+    // スプライト用 PSO 相当の基準キー
+    PipelineStateKey MakeBaseKey() {
+        PipelineStateKey k;
+        k.rootSignature = 0x1111;
+        k.vs = 0x2222;
+        k.ps = 0x3333;
+        k.inputLayout = {
+            {"POSITION", 0, 16, 0, 0, 0, 0},
+            {"TEXCOORD", 0, 16, 0, 8, 0, 0},
+        };
+        k.renderTargetBlend[0].writeMask = kWriteAll;
+        k.fillMode = 3;
+        k.cullMode = kCullBack;
+        k.depthClipEnable = 1;
+        k.sampleMask = 0xFFFFFFFFu;
+        k.primitiveTopologyType = 3;
+        k.numRenderTargets = 1;
+        k.rtvFormats[0] = kFormatRgba8;
+        k.dsvFormat = kFormatD24S8;
+        k.Normalize();
+        return k;
+    }
+
+    // mutate した後に正規化すると基準キーと同じになるか
+    void ExpectSameAfterNormalize(const char *what, void (*mutate)(PipelineStateKey &)) {
+        const PipelineStateKey base = MakeBaseKey();
+        PipelineStateKey k = base;
+        mutate(k);
+        k.Normalize();
+        EXPECT_EQ(k, base) << what;
+        EXPECT_EQ(k.Hash(), base.Hash()) << what;
+    }
+
+    // mutate した後に正規化しても基準キーと区別されるか
+    void ExpectDifferentAfterNormalize(const char *what, void (*mutate)(PipelineStateKey &)) {
+        const PipelineStateKey base = MakeBaseKey();
+        PipelineStateKey k = base;
+        mutate(k);
+        k.Normalize();
+        EXPECT_NE(k, base) << what;
+        EXPECT_NE(k.Hash(), base.Hash()) << what;
+    }
+
+} // namespace
+
+TEST(PipelineStateKey, NormalizeIsIdempotent) {
+    PipelineStateKey k = MakeBaseKey();
+    k.renderTargetBlend[3].srcBlend = kBlendOne;
+    k.Normalize();
+    const PipelineStateKey once = k;
+    k.Normalize();
+    EXPECT_EQ(k, once);
+    EXPECT_EQ(k.Hash(), once.Hash());
+}
+
+TEST(PipelineStateKey, DisabledBlendIgnoresFactors) {
+    ExpectSameAfterNormalize("blend factors", [](PipelineStateKey &k) {
+        k.renderTargetBlend[0].srcBlend = kBlendSrcAlpha;
+        k.renderTargetBlend[0].destBlend = kBlendInvSrcAlpha;
+        k.renderTargetBlend[0].blendOp = kBlendOpAdd;
+        k.renderTargetBlend[0].srcBlendAlpha = kBlendOne;
+    });
+    ExpectSameAfterNormalize("logic op without logicOpEnable", [](PipelineStateKey &k) {
+        k.renderTargetBlend[0].logicOp = kLogicOpCopy;
+    });
+
+    // 書き込みマスクとブレンド有効化は結果に影響する
+    ExpectDifferentAfterNormalize("write mask", [](PipelineStateKey &k) { k.renderTargetBlend[0].writeMask = 0x7; });
+    ExpectDifferentAfterNormalize("blend enable", [](PipelineStateKey &k) {
+        k.renderTargetBlend[0].blendEnable = 1;
+        k.renderTargetBlend[0].srcBlend = kBlendSrcAlpha;
+    });
+}
+
+TEST(PipelineStateKey, EnabledBlendKeepsFactors) {
+    auto makeAlpha = [](uint32_t dest) {
+        PipelineStateKey k = MakeBaseKey();
+        k.renderTargetBlend[0].blendEnable = 1;
+        k.renderTargetBlend[0].srcBlend = kBlendSrcAlpha;
+        k.renderTargetBlend[0].destBlend = dest;
+        k.renderTargetBlend[0].blendOp = kBlendOpAdd;
+        k.Normalize();
+        return k;
+    };
+    EXPECT_NE(makeAlpha(kBlendInvSrcAlpha).Hash(), makeAlpha(kBlendOne).Hash());
+}
+
+TEST(PipelineStateKey, UnusedRenderTargetSlotsAreIgnored) {
+    ExpectSameAfterNormalize("format beyond numRenderTargets", [](PipelineStateKey &k) { k.rtvFormats[3] = kFormatRgba16F; });
+    ExpectSameAfterNormalize("blend beyond RT0 without independent blend", [](PipelineStateKey &k) {
+        k.renderTargetBlend[1].blendEnable = 1;
+        k.renderTargetBlend[1].writeMask = kWriteAll;
+    });
+    ExpectDifferentAfterNormalize("format of a used slot", [](PipelineStateKey &k) { k.rtvFormats[0] = kFormatRgba16F; });
+
+    // 個別ブレンドでは使うスロット分だけが効く
+    ExpectDifferentAfterNormalize("independent blend in a used slot", [](PipelineStateKey &k) {
+        k.independentBlendEnable = 1;
+        k.numRenderTargets = 2;
+        k.rtvFormats[1] = kFormatRgba16F;
+        k.renderTargetBlend[1].writeMask = kWriteAll;
+    });
+
+    auto makeIndependent = [](uint32_t unusedWriteMask) {
+        PipelineStateKey k = MakeBaseKey();
+        k.independentBlendEnable = 1;
+        k.numRenderTargets = 2;
+        k.rtvFormats[1] = kFormatRgba16F;
+        k.renderTargetBlend[5].writeMask = unusedWriteMask;
+        k.Normalize();
+        return k;
+    };
+    EXPECT_EQ(makeIndependent(0), makeIndependent(kWriteAll));
+    EXPECT_EQ(makeIndependent(0).Hash(), makeIndependent(kWriteAll).Hash());
+}
+
+TEST(PipelineStateKey, RenderTargetCountIsClamped) {
+    PipelineStateKey k = MakeBaseKey();
+    k.numRenderTargets = 12;
+    k.Normalize();
+    EXPECT_EQ(k.numRenderTargets, PipelineStateKey::kMaxRenderTargets);
+}
+
+TEST(PipelineStateKey, DisabledDepthStencilIgnoresState) {
+    ExpectSameAfterNormalize("depth func / write mask", [](PipelineStateKey &k) {
+        k.depthWriteMask = 1;
+        k.depthFunc = kComparisonLess;
+    });
+    ExpectSameAfterNormalize("stencil ops", [](PipelineStateKey &k) {
+        k.stencilReadMask = 0xFF;
+        k.stencilWriteMask = 0xFF;
+        k.frontFace = {1, 1, 3, 8};
+        k.backFace = {1, 1, 3, 8};
+    });
+    ExpectDifferentAfterNormalize("depth enabled", [](PipelineStateKey &k) {
+        k.depthEnable = 1;
+        k.depthWriteMask = 1;
+        k.depthFunc = kComparisonLess;
+    });
+}
+
+TEST(PipelineStateKey, InputLayoutNormalization) {
+    ExpectSameAfterNormalize("semantic case", [](PipelineStateKey &k) { k.inputLayout[0].semanticName = "Position"; });
+    ExpectSameAfterNormalize("step rate of per-vertex data", [](PipelineStateKey &k) { k.inputLayout[1].instanceDataStepRate = 1; });
+    ExpectDifferentAfterNormalize("step rate of per-instance data", [](PipelineStateKey &k) {
+        k.inputLayout.push_back({"WVP", 0, 2, 1, 0, kPerInstanceData, 1});
+    });
+    ExpectDifferentAfterNormalize("element order", [](PipelineStateKey &k) {
+        std::swap(k.inputLayout[0], k.inputLayout[1]);
+    });
+    // 追記配置（D3D12_APPEND_ALIGNED_ELEMENT）は 0 ではなく全ビット 1 で、明示オフセットとは区別する
+    static_assert(PipelineStateKey::kAppendAlignedElement == 0xFFFFFFFFu);
+    ExpectDifferentAfterNormalize("append-aligned offset", [](PipelineStateKey &k) {
+        k.inputLayout[1].alignedByteOffset = PipelineStateKey::kAppendAlignedElement;
+    });
+}
+
+TEST(PipelineStateKey, SampleCountZeroMeansOne) {
+    ExpectSameAfterNormalize("sample count 0", [](PipelineStateKey &k) { k.sampleCount = 0; });
+    ExpectDifferentAfterNormalize("sample count 4", [](PipelineStateKey &k) { k.sampleCount = 4; });
+}
+
+TEST(PipelineStateKey, NegativeZeroBiasHashesLikeZero) {
+    ExpectSameAfterNormalize("-0 bias", [](PipelineStateKey &k) {
+        k.depthBiasClamp = -0.0f;
+        k.slopeScaledDepthBias = -0.0f;
+    });
+    ExpectDifferentAfterNormalize("slope bias", [](PipelineStateKey &k) { k.slopeScaledDepthBias = 1.0f; });
+}
+
+TEST(PipelineStateKey, ShaderAndRootSignatureHashesAreKeyed) {
+    ExpectDifferentAfterNormalize("vs", [](PipelineStateKey &k) { k.vs ^= 1; });
+    ExpectDifferentAfterNormalize("ps", [](PipelineStateKey &k) { k.ps = 0; });
+    ExpectDifferentAfterNormalize("root signature", [](PipelineStateKey &k) { k.rootSignature = 0x4444; });
+    ExpectDifferentAfterNormalize("cull mode", [](PipelineStateKey &k) { k.cullMode = 1; });
+}
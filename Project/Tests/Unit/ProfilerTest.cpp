@@ -0,0 +1,372 @@
+#include "Profiler.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // トレース JSON の検証用の最小限の JSON パーサ（数値は double、true/false/null も受け付ける）
+    struct JsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+        Type type = Type::Null;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::vector<std::pair<std::string, JsonValue>> object;
+
+        const JsonValue *Find(const std::string &key) const {
+            for (const auto &[k, v] : object) {
+                if (k == key) return &v;
+            }
+            return nullptr;
+        }
+    };
+
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string &text) : text_(text) {}
+
+        // 全体が 1 つの値として読めたら true
+        bool Parse(JsonValue &out) {
+            if (!ParseValue(out)) return false;
+            SkipSpace();
+            return pos_ == text_.size();
+        }
+
+    private:
+        void SkipSpace() {
+            while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+        }
+
+        bool Consume(char c) {
+            SkipSpace();
+            if (pos_ < text_.size() && text_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        bool ConsumeWord(const char *word) {
+            const std::string w(word);
+            if (text_.compare(pos_, w.size(), w) != 0) return false;
+            pos_ += w.size();
+            return true;
+        }
+
+        bool ParseString(std::string &out) {
+            if (!Consume('"')) return false;
+            while (pos_ < text_.size()) {
+                const char c = text_[pos_++];
+                if (c == '"') return true;
+                if (static_cast<unsigned char>(c) < 0x20) return false;
+                if (c == '\\') {
+                    if (pos_ >= text_.size()) return false;
+                    const char e = text_[pos_++];
+                    if (e != '"' && e != '\\' && e != '/') return false; // 書き出し側が使うのはこれだけ
+                    out += e;
+                } else {
+                    out += c;
+                }
+            }
+            return false;
+        }
+
+        bool ParseValue(JsonValue &out) {
+            SkipSpace();
+            if (pos_ >= text_.size()) return false;
+            const char c = text_[pos_];
+            if (c == '{') {
+                out.type = JsonValue::Type::Object;
+                ++pos_;
+                if (Consume('}')) return true;
+                do {
+                    std::string key;
+                    JsonValue value;
+                    if (!ParseString(key) || !Consume(':') || !ParseValue(value)) return false;
+                    out.object.emplace_back(std::move(key), std::move(value));
+                } while (Consume(','));
+                return Consume('}');
+            }
+            if (c == '[') {
+                out.type = JsonValue::Type::Array;
+                ++pos_;
+                if (Consume(']')) return true;
+                do {
+                    JsonValue value;
+                    if (!ParseValue(value)) return false;
+                    out.array.push_back(std::move(value));
+                } while (Consume(','));
+                return Consume(']');
+            }
+            if (c == '"') {
+                out.type = JsonValue::Type::String;
+                return ParseString(out.string);
+            }
+            if (ConsumeWord("true") || ConsumeWord("false")) {
+                out.type = JsonValue::Type::Bool;
+                return true;
+            }
+            if (ConsumeWord("null")) return true;
+
+            // 数値（JSON の文法どおり、先頭の + や . は認めない）
+            const size_t start = pos_;
+            if (text_[pos_] == '-') ++pos_;
+            if (pos_ >= text_.size() || !std::isdigit(static_cast<unsigned char>(text_[pos_]))) return false;
+            while (pos_ < text_.size() && (std::isdigit(static_cast<unsigned char>(text_[pos_])) ||
+                text_[pos_] == '.' || text_[pos_] == 'e' || text_[pos_] == 'E' || text_[pos_] == '-' || text_[pos_] == '+')) {
+                ++pos_;
+            }
+            const std::string number = text_.substr(start, pos_ - start);
+            char *endPtr = nullptr;
+            out.type = JsonValue::Type::Number;
+            out.number = std::strtod(number.c_str(), &endPtr);
+            return endPtr == number.c_str() + number.size();
+        }
+
+        const std::string &text_;
+        size_t pos_ = 0;
+    };
+
+    Profiler::Event MakeEvent(const char *name, uint64_t startNs, uint64_t endNs, uint32_t depth) {
+        Profiler::Event e;
+        e.name = name;
+        e.startNs = startNs;
+        e.endNs = endNs;
+        e.depth = depth;
+        return e;
+    }
+
+    // 最新フレームから、呼び出しスレッドの名前のスレッドを探す
+    const Profiler::ThreadFrame *FindThread(const Profiler::Frame &frame, const std::string &name) {
+        for (const auto &thread : frame.threads) {
+            if (thread.threadName == name) return &thread;
+        }
+        return nullptr;
+    }
+
+    // 単一スレッドで使う前提で、プロファイラを計測できる状態にして前のゾーンを読み捨てる
+    void ResetProfiler(const char *threadName) {
+        Profiler &profiler = Profiler::Get();
+        profiler.SetEnabled(true);
+        profiler.SetPaused(false);
+        profiler.SetThreadName(threadName);
+        profiler.BeginFrame();
+        profiler.EndFrame();
+    }
+
+} // namespace
+
+TEST(ProfilerTest, BuildHierarchyNestsAndSplitsSelfTime) {
+    Profiler::ThreadFrame thread;
+    thread.events = {
+        MakeEvent("Update", 0, 100, 0),
+        MakeEvent("Physics", 10, 30, 1),
+        MakeEvent("Collide", 12, 20, 2),
+        MakeEvent("Render", 60, 90, 1),
+        MakeEvent("Sort", 70, 75, 2),
+    };
+    const std::vector<Profiler::ZoneNode> nodes = Profiler::BuildHierarchy(thread);
+
+    ASSERT_EQ(nodes.size(), 5u);
+    const char *names[] = {"Update", "Physics", "Collide", "Render", "Sort"};
+    const int32_t parents[] = {-1, 0, 1, 0, 3};
+    const uint32_t depths[] = {0, 1, 2, 1, 2};
+    const uint64_t totals[] = {100, 20, 8, 30, 5};
+    const uint64_t selfs[] = {50, 12, 8, 25, 5}; // 子の合計を引いた残り
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        EXPECT_STREQ(nodes[i].name, names[i]) << i;
+        EXPECT_EQ(nodes[i].parent, parents[i]) << i;
+        EXPECT_EQ(nodes[i].depth, depths[i]) << i;
+        EXPECT_EQ(nodes[i].calls, 1u) << i;
+        EXPECT_EQ(nodes[i].totalNs, totals[i]) << i;
+        EXPECT_EQ(nodes[i].selfNs, selfs[i]) << i;
+    }
+}
+
+TEST(ProfilerTest, BuildHierarchyMergesIdenticalPaths) {
+    // 別アドレスの同名ゾーン（翻訳単位が違うリテラル）も同じ経路ならまとめる
+    static const char kPhysicsCopy[] = "Physics";
+    Profiler::ThreadFrame thread;
+    thread.events = {
+        MakeEvent("Update", 0, 100, 0),
+        MakeEvent("Physics", 10, 30, 1),
+        MakeEvent(kPhysicsCopy, 40, 50, 1),
+        MakeEvent("Render", 60, 90, 1),
+        MakeEvent("Physics", 70, 75, 2), // Render の下は別の経路
+        MakeEvent("Update", 200, 250, 0),
+        MakeEvent("Physics", 210, 220, 1),
+    };
+    const std::vector<Profiler::ZoneNode> nodes = Profiler::BuildHierarchy(thread);
+
+    ASSERT_EQ(nodes.size(), 4u);
+    EXPECT_STREQ(nodes[0].name, "Update");
+    EXPECT_EQ(nodes[0].calls, 2u);
+    EXPECT_EQ(nodes[0].totalNs, 150u);
+    EXPECT_EQ(nodes[0].selfNs, 150u - 40u - 30u);
+
+    EXPECT_STREQ(nodes[1].name, "Physics");
+    EXPECT_EQ(nodes[1].parent, 0);
+    EXPECT_EQ(nodes[1].calls, 3u);
+    EXPECT_EQ(nodes[1].totalNs, 40u);
+    EXPECT_EQ(nodes[1].selfNs, 40u);
+
+    EXPECT_STREQ(nodes[2].name, "Render");
+    EXPECT_EQ(nodes[2].parent, 0);
+    EXPECT_EQ(nodes[2].selfNs, 25u);
+
+    EXPECT_STREQ(nodes[3].name, "Physics");
+    EXPECT_EQ(nodes[3].parent, 2);
+    EXPECT_EQ(nodes[3].depth, 2u);
+    EXPECT_EQ(nodes[3].calls, 1u);
+    EXPECT_EQ(nodes[3].totalNs, 5u);
+}
+
+TEST(ProfilerTest, EndFrameCollectsNestedScopes) {
+    ResetProfiler("ProfilerTest");
+    Profiler &profiler = Profiler::Get();
+
+    profiler.BeginFrame();
+    {
+        TARO_PROFILE_SCOPE("Outer");
+        TARO_PROFILE_SCOPE("Inner");
+    }
+    profiler.EndFrame();
+
+    const Profiler::ThreadFrame *thread = FindThread(profiler.GetFrame(0), "ProfilerTest");
+    ASSERT_NE(thread, nullptr);
+    ASSERT_EQ(thread->events.size(), 2u);
+
+    // 終了順（Inner が先）ではなく開始順に並ぶ
+    const Profiler::Event &outer = thread->events[0];
+    const Profiler::Event &inner = thread->events[1];
+    EXPECT_STREQ(outer.name, "Outer");
+    EXPECT_EQ(outer.depth, 0u);
+    EXPECT_STREQ(inner.name, "Inner");
+    EXPECT_EQ(inner.depth, 1u);
+    EXPECT_LE(outer.startNs, inner.startNs);
+    EXPECT_LE(inner.endNs, outer.endNs);
+}
+
+TEST(ProfilerTest, FullRingKeepsOneSlotForTheWriter) {
+    ResetProfiler("ProfilerTest");
+    Profiler &profiler = Profiler::Get();
+
+    // ちょうど容量分を書くと、一番古いゾーンのスロットは次の書き込み先と同じなので捨てる
+    profiler.BeginFrame();
+    for (uint32_t i = 0; i < Profiler::kThreadBufferCapacity; ++i) {
+        TARO_PROFILE_SCOPE("Zone");
+    }
+    profiler.EndFrame();
+
+    const Profiler::Frame &frame = profiler.GetFrame(0);
+    const Profiler::ThreadFrame *thread = FindThread(frame, "ProfilerTest");
+    ASSERT_NE(thread, nullptr);
+    EXPECT_EQ(thread->events.size(), static_cast<size_t>(Profiler::kThreadBufferCapacity - 1));
+    EXPECT_EQ(frame.droppedEvents, 1u);
+
+    // 溢れた分はすべて数える
+    profiler.BeginFrame();
+    for (uint32_t i = 0; i < Profiler::kThreadBufferCapacity + 10; ++i) {
+        TARO_PROFILE_SCOPE("Zone");
+    }
+    profiler.EndFrame();
+    EXPECT_EQ(FindThread(profiler.GetFrame(0), "ProfilerTest")->events.size(),
+        static_cast<size_t>(Profiler::kThreadBufferCapacity - 1));
+    EXPECT_EQ(profiler.GetFrame(0).droppedEvents, 11u);
+}
+
+TEST(ProfilerTest, TraceCaptureWritesChromeTraceJson) {
+    std::random_device rd;
+    const fs::path dir = fs::temp_directory_path() / ("TaroProfilerTest_" + std::to_string(rd()));
+    const fs::path path = dir / "trace.json";
+
+    ResetProfiler("Trace \"Main\""); // エスケープが必要な名前
+    Profiler &profiler = Profiler::Get();
+    ASSERT_TRUE(profiler.BeginTraceCapture(path, 2));
+    EXPECT_FALSE(profiler.BeginTraceCapture(path, 2)); // 記録中は開始できない
+
+    for (int f = 0; f < 2; ++f) {
+        profiler.BeginFrame();
+        {
+            TARO_PROFILE_SCOPE("Outer");
+            TARO_PROFILE_SCOPE("Inner");
+        }
+        profiler.EndFrame();
+    }
+    EXPECT_FALSE(profiler.IsCapturing()); // 指定フレーム数で自動的に書き出す
+
+    std::string text;
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        ASSERT_TRUE(ifs) << path;
+        text.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    JsonValue json;
+    ASSERT_TRUE(JsonParser(text).Parse(json)) << text;
+    ASSERT_EQ(json.type, JsonValue::Type::Object);
+    const JsonValue *events = json.Find("traceEvents");
+    ASSERT_NE(events, nullptr);
+    ASSERT_EQ(events->type, JsonValue::Type::Array);
+
+    // 完了イベント（X）は名前・pid・tid・ts・dur を持つ。スレッド名はメタデータ（M）で 1 回だけ
+    std::vector<const JsonValue *> outers;
+    std::vector<const JsonValue *> inners;
+    int frames = 0;
+    int threadNames = 0;
+    double mainTid = -1.0;
+    for (const JsonValue &e : events->array) {
+        ASSERT_EQ(e.type, JsonValue::Type::Object);
+        const JsonValue *ph = e.Find("ph");
+        const JsonValue *name = e.Find("name");
+        const JsonValue *tid = e.Find("tid");
+        ASSERT_TRUE(ph && name && tid && e.Find("pid"));
+        ASSERT_EQ(tid->type, JsonValue::Type::Number);
+
+        if (ph->string == "M") {
+            EXPECT_EQ(name->string, "thread_name");
+            const JsonValue *args = e.Find("args");
+            ASSERT_NE(args, nullptr);
+            if (args->Find("name") && args->Find("name")->string == "Trace \"Main\"") {
+                ++threadNames;
+                mainTid = tid->number;
+            }
+            continue;
+        }
+        ASSERT_EQ(ph->string, "X");
+        const JsonValue *ts = e.Find("ts");
+        const JsonValue *dur = e.Find("dur");
+        ASSERT_TRUE(ts && dur);
+        EXPECT_EQ(ts->type, JsonValue::Type::Number);
+        EXPECT_GE(dur->number, 0.0);
+        if (name->string.rfind("Frame ", 0) == 0) ++frames;
+        if (name->string == "Outer") outers.push_back(&e);
+        if (name->string == "Inner") inners.push_back(&e);
+    }
+    EXPECT_EQ(frames, 2);
+    EXPECT_EQ(threadNames, 1);
+    ASSERT_EQ(outers.size(), 2u);
+    ASSERT_EQ(inners.size(), 2u);
+
+    // Inner は同じスレッドの Outer の区間に収まる（ts / dur はマイクロ秒・小数 3 桁でナノ秒まで正確）
+    for (size_t i = 0; i < outers.size(); ++i) {
+        const double outerTs = outers[i]->Find("ts")->number;
+        const double outerEnd = outerTs + outers[i]->Find("dur")->number;
+        const double innerTs = inners[i]->Find("ts")->number;
+        const double innerEnd = innerTs + inners[i]->Find("dur")->number;
+        EXPECT_EQ(outers[i]->Find("tid")->number, mainTid);
+        EXPECT_EQ(inners[i]->Find("tid")->number, mainTid);
+        EXPECT_GE(innerTs, outerTs - 1e-3);
+        EXPECT_LE(innerEnd, outerEnd + 1e-3);
+    }
+}
@@ -0,0 +1,157 @@
+#include "RotatingFileLogger.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr const char *kContinuesLine = "===== Log continues in next file =====";
+
+    // 一時ディレクトリに app.log を書くフィクスチャ
+    class RotatingFileLoggerTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            std::random_device rd;
+            root_ = fs::temp_directory_path() / ("TaroRotatingFileLoggerTest_" + std::to_string(rd()));
+            fs::create_directories(root_);
+            path_ = root_ / "app.log";
+        }
+
+        void TearDown() override {
+            std::error_code ec;
+            fs::remove_all(root_, ec);
+        }
+
+        // サイズだけで切り替える設定
+        RotatingFileLogger::Options SizeOptions(uint64_t maxFileBytes, uint32_t retention) const {
+            RotatingFileLogger::Options options;
+            options.maxFileBytes = maxFileBytes;
+            options.retention = retention;
+            options.segmentBytes = 1;
+            return options;
+        }
+
+        static std::string ReadAll(const fs::path &path) {
+            std::ifstream ifs(path, std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        }
+
+        static std::vector<std::string> ReadLines(const fs::path &path) {
+            std::istringstream iss(ReadAll(path));
+            std::vector<std::string> lines;
+            for (std::string line; std::getline(iss, line);) lines.push_back(line);
+            return lines;
+        }
+
+        // "msg N" の行から N を取り出す（それ以外の行は -1）
+        static int MessageNumber(const std::string &line) {
+            const size_t pos = line.find("] msg ");
+            return (pos == std::string::npos) ? -1 : std::stoi(line.substr(pos + 6));
+        }
+
+        fs::path root_;
+        fs::path path_;
+    };
+
+} // namespace
+
+TEST_F(RotatingFileLoggerTest, RotatesBeforeExceedingMaxFileBytes) {
+    constexpr uint64_t kMaxFileBytes = 1024;
+    constexpr int kCount = 150;
+    {
+        RotatingFileLogger logger(path_, SizeOptions(kMaxFileBytes, 100));
+        ASSERT_TRUE(logger.IsOpen());
+        for (int i = 0; i < kCount; ++i) {
+            logger.Log(LogLevel::INFO, "msg " + std::to_string(i));
+        }
+    }
+
+    // 古い順（番号の大きい順）に読むと全メッセージが順に並ぶ
+    std::vector<fs::path> files;
+    for (uint32_t i = 1; fs::exists(root_ / ("app." + std::to_string(i) + ".log")); ++i) {
+        files.insert(files.begin(), root_ / ("app." + std::to_string(i) + ".log"));
+    }
+    ASSERT_GE(files.size(), 3u);
+
+    int next = 0;
+    for (const fs::path &file : files) {
+        // 切り替えた側のファイルは末尾の案内行まで含めて上限に収まる
+        EXPECT_LE(fs::file_size(file), kMaxFileBytes) << file;
+        const std::vector<std::string> lines = ReadLines(file);
+        ASSERT_FALSE(lines.empty());
+        EXPECT_EQ(lines.back(), kContinuesLine) << file;
+        for (const std::string &line : lines) {
+            const int n = MessageNumber(line);
+            if (n >= 0) {
+                EXPECT_EQ(n, next++);
+            }
+        }
+    }
+    for (const std::string &line : ReadLines(path_)) {
+        const int n = MessageNumber(line);
+        if (n >= 0) {
+            EXPECT_EQ(n, next++);
+        }
+    }
+    EXPECT_EQ(next, kCount);
+}
+
+TEST_F(RotatingFileLoggerTest, RetentionDeletesOldestAndShiftsTheRest) {
+    constexpr uint32_t kRetention = 2;
+    RotatingFileLogger logger(path_, SizeOptions(256, kRetention));
+    ASSERT_TRUE(logger.IsOpen());
+
+    // 1 行ごとに切り替わる長さで書く（256 バイトに 2 行は入らない）
+    const std::string padding(100, '.');
+    for (int i = 0; i < 6; ++i) {
+        logger.Log(LogLevel::INFO, "msg " + std::to_string(i) + " " + padding);
+    }
+
+    // app.log に最新、app.1.log に 1 つ前、app.2.log に 2 つ前が残り、それより古いものは消える
+    EXPECT_FALSE(fs::exists(logger.GetFilePath(kRetention + 1)));
+    const int expected[] = {5, 4, 3};
+    for (uint32_t index = 0; index <= kRetention; ++index) {
+        if (index == 0) logger.Flush();
+        int found = -1;
+        for (const std::string &line : ReadLines(logger.GetFilePath(index))) {
+            const int n = MessageNumber(line);
+            if (n >= 0) found = n;
+        }
+        EXPECT_EQ(found, expected[index]) << logger.GetFilePath(index);
+    }
+    EXPECT_EQ(logger.GetFilePath(2), root_ / "app.2.log");
+}
+
+TEST_F(RotatingFileLoggerTest, PreviousSessionIsShiftedAtStartup) {
+    // 前回のセッションが異常終了して 0 埋めが残った app.log と、さらに前の app.1.log
+    {
+        std::ofstream ofs(path_, std::ios::binary);
+        ofs << "previous session\n" << std::string(4096, '\0');
+    }
+    {
+        std::ofstream ofs(root_ / "app.1.log", std::ios::binary);
+        ofs << "older session\n";
+    }
+
+    {
+        RotatingFileLogger logger(path_, SizeOptions(1024 * 1024, 5));
+        ASSERT_TRUE(logger.IsOpen());
+        logger.Log(LogLevel::INFO, "msg 0");
+    }
+
+    // 前回分は 0 埋めを落として app.1.log へ、その前は app.2.log へずれる
+    EXPECT_EQ(ReadAll(root_ / "app.1.log"), "previous session\n");
+    EXPECT_EQ(ReadAll(root_ / "app.2.log"), "older session\n");
+
+    const std::vector<std::string> lines = ReadLines(path_);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0].rfind("===== Log session started at ", 0), 0u);
+    EXPECT_EQ(MessageNumber(lines[1]), 0);
+    EXPECT_EQ(lines[2].rfind("===== Log session ended at ", 0), 0u);
+    EXPECT_EQ(ReadAll(path_).find('\0'), std::string::npos); // 閉じたときに末尾の 0 埋めも切り詰めている
+}
@@ -0,0 +1,42 @@
+// このファイルは TARO_MATH_FORCE_SCALAR 付きでコンパイルする（Tests/CMakeLists.txt）。
+// MatrixUtil / SimdConfig を別名にして取り込み、SIMD 版の inline 関数と定義が衝突しないようにする。
+#define MatrixUtil MatrixUtilScalar
+#define SimdConfig SimdConfigScalar
+#include "MatrixUtil.h"
+#undef MatrixUtil
+#undef SimdConfig
+
+#include "ScalarMatrixUtil.h"
+
+#if !defined(TARO_MATH_FORCE_SCALAR)
+#error ScalarMatrixUtil.cpp must be compiled with TARO_MATH_FORCE_SCALAR
+#endif
+
+namespace ScalarMatrixUtil {
+
+    Matrix4x4 Multiply(const Matrix4x4 &a, const Matrix4x4 &b) { return MatrixUtilScalar::Multiply(a, b); }
+
+    Matrix4x4 Transpose(const Matrix4x4 &a) { return MatrixUtilScalar::Transpose(a); }
+
+    Matrix4x4 InverseRigid(const Matrix4x4 &m) { return MatrixUtilScalar::InverseRigid(m); }
+
+    Matrix4x4 MultiplyAffine2D(const Matrix3x2 &a, const Matrix4x4 &b) { return MatrixUtilScalar::MultiplyAffine2D(a, b); }
+
+    Matrix4x4 MakeTRS(const Vector3 &t, const Vector3 &rXYZRadians, const Vector3 &s) {
+        return MatrixUtilScalar::MakeTRS(t, rXYZRadians, s);
+    }
+
+    Matrix4x4 MakeTRSComposed(const Vector3 &t, const Vector3 &rXYZRadians, const Vector3 &s) {
+        using namespace MatrixUtilScalar;
+        auto S = MakeScaleMatrix(s.x, s.y, s.z);
+        auto Rx = MakeRotationXMatrix(rXYZRadians.x);
+        auto Ry = MakeRotationYMatrix(rXYZRadians.y);
+        auto Rz = MakeRotationZMatrix(rXYZRadians.z);
+        auto R = MatrixUtilScalar::Multiply(MatrixUtilScalar::Multiply(Rx, Ry), Rz);
+        auto T = MakeTranslationMatrix(t.x, t.y, t.z);
+        return MatrixUtilScalar::Multiply(MatrixUtilScalar::Multiply(S, R), T);
+    }
+
+    const char *GetBackendName() { return SimdConfigScalar::GetBackendName(); }
+
+} // namespace ScalarMatrixUtil
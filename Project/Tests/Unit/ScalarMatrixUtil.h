@@ -0,0 +1,29 @@
+#pragma once
+#include "Matrix3x2.h"
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+/// <summary>
+/// TARO_MATH_FORCE_SCALAR でコンパイルした MatrixUtil（SIMD 版と比べる基準）。
+/// </summary>
+/// <remarks>
+/// ScalarMatrixUtil.cpp だけを TARO_MATH_FORCE_SCALAR 付きでビルドし、MatrixUtil を別名の
+/// 名前空間に展開して包んでいる（同名の inline 関数が 2 通りの定義を持たないように）。
+/// </remarks>
+namespace ScalarMatrixUtil {
+
+    Matrix4x4 Multiply(const Matrix4x4 &a, const Matrix4x4 &b);
+    Matrix4x4 Transpose(const Matrix4x4 &a);
+    Matrix4x4 InverseRigid(const Matrix4x4 &m);
+    Matrix4x4 MultiplyAffine2D(const Matrix3x2 &a, const Matrix4x4 &b);
+    Matrix4x4 MakeTRS(const Vector3 &t, const Vector3 &rXYZRadians, const Vector3 &s);
+
+    /// <summary>
+    /// 閉形式にする前の MakeTRS（S, Rx, Ry, Rz, T を作って 4x4 積を 4 回）。
+    /// </summary>
+    Matrix4x4 MakeTRSComposed(const Vector3 &t, const Vector3 &rXYZRadians, const Vector3 &s);
+
+    /// <summary>スカラ版のバックエンド名（"Scalar" になっているかの確認用）。</summary>
+    const char *GetBackendName();
+
+} // namespace ScalarMatrixUtil
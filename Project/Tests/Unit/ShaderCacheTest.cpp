@@ -0,0 +1,224 @@
+#include "ShaderCache.h"
+#include <cstdint>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // 一時ディレクトリにシェーダとキャッシュを置くフィクスチャ
+    class ShaderCacheTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            std::random_device rd;
+            root_ = fs::temp_directory_path() / ("TaroShaderCacheTest_" + std::to_string(rd()));
+            fs::create_directories(root_ / "Shaders");
+            fs::create_directories(root_ / "Include");
+            ASSERT_TRUE(cache_.Initialize(root_ / "Cache"));
+        }
+
+        void TearDown() override {
+            std::error_code ec;
+            fs::remove_all(root_, ec);
+        }
+
+        void WriteFile(const fs::path &relative, const std::string &text) {
+            std::ofstream ofs(root_ / relative, std::ios::binary | std::ios::trunc);
+            ofs << text;
+        }
+
+        ShaderCache::KeyDesc MakeDesc(const std::string &source) const {
+            ShaderCache::KeyDesc desc;
+            desc.source = source;
+            desc.sourcePath = root_ / "Shaders" / "Main.hlsl";
+            desc.entry = L"main";
+            desc.profile = L"vs_6_0";
+            desc.defines = {L"-DUSE_FOG=1"};
+            desc.arguments = {L"-O3", L"-I", (root_ / "Include").wstring()};
+            desc.toolchain = "stub 1.0";
+            return desc;
+        }
+
+        // 呼ばれた回数を数え、ソースの長さから決まるバイト列を返すスタブコンパイラ
+        ShaderCache::CompileFunc MakeStubCompiler(const ShaderCache::KeyDesc &desc) {
+            return [this, size = desc.source.size()](std::vector<uint8_t> &out) {
+                ++compileCount_;
+                out.assign(size % 61 + 4, static_cast<uint8_t>(compileCount_));
+                return true;
+            };
+        }
+
+        fs::path root_;
+        ShaderCache cache_;
+        int compileCount_ = 0;
+    };
+
+} // namespace
+
+TEST_F(ShaderCacheTest, KeyIsStableAndCoversEveryInput) {
+    const ShaderCache::KeyDesc base = MakeDesc("float4 main() : SV_Position { return 0; }");
+    const uint64_t hash = cache_.ComputeKey(base).hash;
+    EXPECT_EQ(cache_.ComputeKey(base).hash, hash);
+
+    auto expectDiffers = [&](const char *what, auto mutate) {
+        ShaderCache::KeyDesc d = base;
+        mutate(d);
+        EXPECT_NE(cache_.ComputeKey(d).hash, hash) << what;
+    };
+    expectDiffers("source", [](auto &d) { d.source += " "; });
+    expectDiffers("entry", [](auto &d) { d.entry = L"VSMain"; });
+    expectDiffers("profile", [](auto &d) { d.profile = L"vs_6_6"; });
+    expectDiffers("define", [](auto &d) { d.defines[0] = L"-DUSE_FOG=0"; });
+    expectDiffers("extra define", [](auto &d) { d.defines.push_back(L"-DSKINNED"); });
+    expectDiffers("argument", [](auto &d) { d.arguments[0] = L"-Od"; });
+    expectDiffers("toolchain", [](auto &d) { d.toolchain = "stub 1.1"; });
+
+    // マクロと引数の境界をずらしただけの組み合わせも別キー
+    expectDiffers("define/argument split", [](auto &d) {
+        d.arguments.insert(d.arguments.begin(), d.defines[0]);
+        d.defines.clear();
+    });
+
+    EXPECT_EQ(cache_.ComputeKey(base).ToHex().size(), 16u);
+}
+
+TEST_F(ShaderCacheTest, TracksIncludesRelativeToSourceAndIncludeDirs) {
+    WriteFile("Shaders/Local.hlsli", "#include \"Shared.hlsli\"\n");
+    WriteFile("Include/Shared.hlsli", "#pragma once\n#include \"Shared.hlsli\"\n"); // 自己インクルードは 1 回だけ数える
+
+    const ShaderCache::KeyDesc desc = MakeDesc(
+        "#include \"Local.hlsli\"\n"
+        "// #include \"Commented.hlsli\"\n"
+        "#include <Missing.hlsli>\n");
+    const ShaderCache::Key key = cache_.ComputeKey(desc);
+
+    ASSERT_EQ(key.dependencies.size(), 2u);
+    EXPECT_EQ(key.dependencies[0].filename(), "Local.hlsli");
+    EXPECT_EQ(key.dependencies[1].filename(), "Shared.hlsli");
+    ASSERT_EQ(key.missingIncludes.size(), 1u);
+    EXPECT_EQ(key.missingIncludes[0], "Missing.hlsli");
+}
+
+TEST_F(ShaderCacheTest, VirtualSourceResolvesNextToVirtualFileName) {
+    // メモリ上のソース（ShaderPermutation など）でも、仮想ファイル名の場所から #include を探す
+    WriteFile("Shaders/Local.hlsli", "float Fog() { return 1; }\n");
+    ShaderCache::KeyDesc desc = MakeDesc("#include \"Local.hlsli\"\n");
+    desc.sourcePath = root_ / "Shaders" / "Virtual_Permutation.hlsl"; // 実在しないファイル名
+
+    const ShaderCache::Key key = cache_.ComputeKey(desc);
+    EXPECT_EQ(key.dependencies.size(), 1u);
+    EXPECT_TRUE(key.missingIncludes.empty());
+
+    // 基準がないと解決できない（この状態でキャッシュすると include の変更に気付けない）
+    desc.sourcePath.clear();
+    EXPECT_EQ(cache_.ComputeKey(desc).missingIncludes.size(), 1u);
+}
+
+TEST_F(ShaderCacheTest, HitsUntilAnIncludeChanges) {
+    WriteFile("Include/Shared.hlsli", "static const float kFog = 1;\n");
+    const ShaderCache::KeyDesc desc = MakeDesc("#include \"Shared.hlsli\"\nfloat4 main() : SV_Position { return kFog; }\n");
+
+    std::vector<uint8_t> first;
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), first));
+    std::vector<uint8_t> second;
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), second));
+    EXPECT_EQ(compileCount_, 1);
+    EXPECT_EQ(first, second);
+
+    // インクルード先の内容だけを変えると別キーになり、再コンパイルされる
+    WriteFile("Include/Shared.hlsli", "static const float kFog = 2;\n");
+    std::vector<uint8_t> third;
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), third));
+    EXPECT_EQ(compileCount_, 2);
+    EXPECT_NE(third, first);
+
+    const ShaderCache::Stats stats = cache_.GetStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.stores, 2u);
+}
+
+TEST_F(ShaderCacheTest, MissingIncludeAppearingInvalidates) {
+    const ShaderCache::KeyDesc desc = MakeDesc("#include \"Late.hlsli\"\n");
+    const uint64_t before = cache_.ComputeKey(desc).hash;
+
+    WriteFile("Include/Late.hlsli", "// now present\n");
+    const ShaderCache::Key after = cache_.ComputeKey(desc);
+    EXPECT_NE(after.hash, before);
+    EXPECT_TRUE(after.missingIncludes.empty());
+}
+
+TEST_F(ShaderCacheTest, TruncatedEntryIsRecompiled) {
+    const ShaderCache::KeyDesc desc = MakeDesc("float4 main() : SV_Position { return 0; }");
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), out));
+
+    const ShaderCache::Key key = cache_.ComputeKey(desc);
+    const fs::path entry = cache_.GetDirectory() / (key.ToHex() + ".dxil");
+    ASSERT_TRUE(fs::exists(entry));
+    fs::resize_file(entry, fs::file_size(entry) - 1);
+
+    EXPECT_FALSE(cache_.Load(key).has_value());
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), out));
+    EXPECT_EQ(compileCount_, 2);
+    EXPECT_TRUE(cache_.Load(key).has_value());
+}
+
+TEST_F(ShaderCacheTest, CorruptSizeFieldIsAMiss) {
+    const ShaderCache::KeyDesc desc = MakeDesc("float4 main() : SV_Position { return 1; }");
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), out));
+
+    const ShaderCache::Key key = cache_.ComputeKey(desc);
+    const fs::path entry = cache_.GetDirectory() / (key.ToHex() + ".dxil");
+    ASSERT_TRUE(fs::exists(entry));
+
+    // ヘッダの size（magic / version / hash の後ろの 8 バイト）を巨大な値に書き換える
+    for (const uint64_t size : {uint64_t{0x7fffffffffffffffull}, uint64_t{out.size() + 1}}) {
+        {
+            std::fstream fsEntry(entry, std::ios::binary | std::ios::in | std::ios::out);
+            fsEntry.seekp(16);
+            fsEntry.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        }
+        EXPECT_FALSE(cache_.Load(key).has_value()) << "size " << size; // bad_alloc ではなくミス
+    }
+
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), out));
+    EXPECT_EQ(compileCount_, 2);
+    EXPECT_TRUE(cache_.Load(key).has_value());
+}
+
+TEST_F(ShaderCacheTest, FailedCompileIsNotStored) {
+    const ShaderCache::KeyDesc desc = MakeDesc("syntax error");
+    std::vector<uint8_t> out;
+    EXPECT_FALSE(cache_.GetOrCompile(desc, [](std::vector<uint8_t> &) { return false; }, out));
+    EXPECT_FALSE(cache_.Load(cache_.ComputeKey(desc)).has_value());
+    EXPECT_EQ(cache_.GetStats().stores, 0u);
+}
+
+TEST_F(ShaderCacheTest, ClearAndPruneRemoveEntries) {
+    for (int i = 0; i < 4; ++i) {
+        const ShaderCache::KeyDesc desc = MakeDesc(std::string(static_cast<size_t>(i + 1), 'x'));
+        std::vector<uint8_t> out;
+        ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), out));
+    }
+
+    auto countEntries = [&] {
+        int n = 0;
+        for (const auto &e : fs::directory_iterator(cache_.GetDirectory())) n += e.path().extension() == ".dxil";
+        return n;
+    };
+    EXPECT_EQ(countEntries(), 4);
+
+    cache_.Prune(0);
+    EXPECT_EQ(countEntries(), 0);
+
+    const ShaderCache::KeyDesc desc = MakeDesc("y");
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(cache_.GetOrCompile(desc, MakeStubCompiler(desc), out));
+    cache_.Clear();
+    EXPECT_EQ(countEntries(), 0);
+}
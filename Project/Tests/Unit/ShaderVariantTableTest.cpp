@@ -0,0 +1,191 @@
+#include "ShaderVariantTable.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    enum class TestFeature : uint32_t { Fog, Skinning, Shadow };
+
+    void AppendU32(std::vector<uint8_t> &out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+    }
+
+    void AppendFourCC(std::vector<uint8_t> &out, const std::string &fourCC) {
+        for (size_t i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(fourCC[i]));
+    }
+
+    // DXIL コンテナ（DXBC ヘッダ + オフセット表 + パート）を組み立てる
+    std::vector<uint8_t> MakeContainer(const std::vector<std::pair<std::string, std::vector<uint8_t>>> &parts,
+        uint8_t digest) {
+        const uint32_t headerSize = 32 + 4 * static_cast<uint32_t>(parts.size());
+        std::vector<uint8_t> body;
+        std::vector<uint32_t> offsets;
+        for (const auto &[name, data] : parts) {
+            offsets.push_back(headerSize + static_cast<uint32_t>(body.size()));
+            AppendFourCC(body, name);
+            AppendU32(body, static_cast<uint32_t>(data.size()));
+            body.insert(body.end(), data.begin(), data.end());
+        }
+
+        std::vector<uint8_t> out;
+        AppendFourCC(out, "DXBC");
+        out.insert(out.end(), 16, digest); // ダイジェスト（本来は全パートから計算される）
+        AppendU32(out, 1);                 // バージョン 1.0
+        AppendU32(out, headerSize + static_cast<uint32_t>(body.size()));
+        AppendU32(out, static_cast<uint32_t>(parts.size()));
+        for (uint32_t offset : offsets) AppendU32(out, offset);
+        out.insert(out.end(), body.begin(), body.end());
+        return out;
+    }
+
+    // -Zi -Qembed_debug でコンパイルした結果に似せたコンテナ（コード以外はマクロごとに変わる）
+    std::vector<uint8_t> MakeDebugContainer(uint8_t code, uint8_t debug) {
+        return MakeContainer({
+            {"SFI0", {0, 0, 0, 0, 0, 0, 0, 0}},
+            {"DXIL", {code, code, code, 1, 2, 3}},
+            {"ILDB", {debug, debug, code}},
+            {"ILDN", {debug, 'n', 'a', 'm', 'e'}},
+            {"HASH", {debug, 1, 2, 3, 4, 5, 6, 7}},
+        }, debug);
+    }
+
+    ShaderVariantTable::Bytecode View(const std::vector<uint8_t> &bytes) {
+        return {bytes.data(), bytes.size()};
+    }
+
+    std::vector<ShaderVariantTable::Feature> MakeFeatures() {
+        std::vector<ShaderVariantTable::Feature> features(3);
+        features[0].define = L"USE_FOG";
+        features[1].define = L"USE_SKINNING";
+        features[2].define = L"USE_SHADOW";
+        return features;
+    }
+
+} // namespace
+
+TEST(ShaderVariantTableTest, FeatureMaskUsesEnumValueAsBitNumber) {
+    static_assert(MakeFeatureMask(TestFeature::Fog) == 1u);
+    static_assert(MakeFeatureMask(TestFeature::Shadow) == 4u);
+    static_assert(MakeFeatureMask(TestFeature::Fog, TestFeature::Skinning, TestFeature::Shadow) == 7u);
+    EXPECT_EQ(MakeFeatureMask(TestFeature::Skinning, TestFeature::Skinning), 2u);
+}
+
+TEST(ShaderVariantTableTest, UnreferencedMacrosAreCanonicalizedAway) {
+    // USE_SKINNING は本文に無い（USE_SKINNING_EX は別の識別子）
+    const std::string source = "#if USE_FOG\n#endif\n#if USE_SHADOW\n#endif\nint USE_SKINNING_EX;\n";
+    ShaderVariantTable table;
+    table.Initialize(source, MakeFeatures());
+
+    EXPECT_EQ(table.GetFeatureCount(), 3u);
+    EXPECT_EQ(table.Canonicalize(0b111), 0b101u);
+    EXPECT_EQ(table.Canonicalize(0b010), 0u);
+    EXPECT_EQ(table.Enumerate(), (std::vector<uint32_t>{0b000, 0b001, 0b100, 0b101}));
+
+    // #include 先で使う機能は本文に無くても区別する
+    std::vector<ShaderVariantTable::Feature> features = MakeFeatures();
+    features[1].alwaysRelevant = true;
+    table.Initialize(source, features);
+    EXPECT_EQ(table.Canonicalize(0b111), 0b111u);
+    EXPECT_EQ(table.Enumerate().size(), 8u);
+}
+
+TEST(ShaderVariantTableTest, MakeDefinesExpandsEveryFeature) {
+    std::vector<ShaderVariantTable::Feature> features = MakeFeatures();
+    features[2].value = L"2";
+    ShaderVariantTable table;
+    table.Initialize("USE_FOG USE_SHADOW", features, {}, {{L"MAX_LIGHTS", L"4"}});
+
+    // 無効な機能も 0 で定義し、共通マクロが先頭に来る。本文に無い機能もマクロは付ける
+    const std::vector<ShaderVariantTable::Define> defines = table.MakeDefines(0b110);
+    ASSERT_EQ(defines.size(), 4u);
+    EXPECT_EQ(defines[0].name, L"MAX_LIGHTS");
+    EXPECT_EQ(defines[0].value, L"4");
+    EXPECT_EQ(defines[1].name, L"USE_FOG");
+    EXPECT_EQ(defines[1].value, L"0");
+    EXPECT_EQ(defines[2].name, L"USE_SKINNING");
+    EXPECT_EQ(defines[2].value, L"1");
+    EXPECT_EQ(defines[3].name, L"USE_SHADOW");
+    EXPECT_EQ(defines[3].value, L"2");
+}
+
+TEST(ShaderVariantTableTest, BuildMapsEveryMaskToItsVariant) {
+    ShaderVariantTable table;
+    table.Initialize("USE_FOG USE_SKINNING", MakeFeatures());
+    const std::vector<uint32_t> masks = table.Enumerate();
+    ASSERT_EQ(masks, (std::vector<uint32_t>{0, 1, 2, 3}));
+
+    // フォグの有無だけが結果を変える（スキニングは同じバイト列になった）
+    const std::vector<uint8_t> plain = {1, 2, 3};
+    const std::vector<uint8_t> fog = {1, 2, 3, 4};
+    const std::vector<ShaderVariantTable::Bytecode> bytecodes = {View(plain), View(fog), View(plain), View(fog)};
+    const std::vector<size_t> representatives = table.Build(masks, bytecodes);
+
+    EXPECT_EQ(representatives, (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(table.GetVariantCount(), 2u);
+    for (uint32_t mask = 0; mask < 8; ++mask) {
+        // USE_SHADOW（ビット 2）は本文に無いので落ちる
+        EXPECT_EQ(table.GetVariantIndex(mask), (mask & 1u) ? 1u : 0u) << "mask " << mask;
+    }
+}
+
+TEST(ShaderVariantTableTest, InvalidAndFailedMasksHaveNoVariant) {
+    ShaderVariantTable table;
+    // フォグとスキニングの同時指定は禁止
+    table.Initialize("USE_FOG USE_SKINNING USE_SHADOW", MakeFeatures(), [](uint32_t mask) { return (mask & 3u) != 3u; });
+    const std::vector<uint32_t> masks = table.Enumerate();
+    EXPECT_EQ(masks, (std::vector<uint32_t>{0, 1, 2, 4, 5, 6}));
+
+    std::vector<std::vector<uint8_t>> blobs;
+    for (uint32_t mask : masks) blobs.push_back({static_cast<uint8_t>(mask)});
+    std::vector<ShaderVariantTable::Bytecode> bytecodes;
+    for (const auto &b : blobs) bytecodes.push_back(View(b));
+    bytecodes[4] = {}; // マスク 5 のコンパイルが失敗した
+
+    EXPECT_EQ(table.Build(masks, bytecodes).size(), 5u);
+    EXPECT_EQ(table.GetVariantIndex(3), ShaderVariantTable::kInvalidVariant);
+    EXPECT_EQ(table.GetVariantIndex(7), ShaderVariantTable::kInvalidVariant);
+    EXPECT_EQ(table.GetVariantIndex(5), ShaderVariantTable::kInvalidVariant);
+    EXPECT_NE(table.GetVariantIndex(6), ShaderVariantTable::kInvalidVariant);
+}
+
+TEST(ShaderVariantTableTest, DedupIgnoresEmbeddedDebugInfoAndHash) {
+    ShaderVariantTable table;
+    table.Initialize("USE_FOG USE_SKINNING", MakeFeatures());
+    const std::vector<uint32_t> masks = table.Enumerate();
+
+    // コードは 2 種類だが、埋め込み PDB・PDB 名・シェーダハッシュ・ダイジェストはマスクごとに違う
+    const std::vector<std::vector<uint8_t>> blobs = {
+        MakeDebugContainer(10, 1), MakeDebugContainer(20, 2), MakeDebugContainer(10, 3), MakeDebugContainer(20, 4)};
+    std::vector<ShaderVariantTable::Bytecode> bytecodes;
+    for (const auto &b : blobs) bytecodes.push_back(View(b));
+
+    EXPECT_EQ(table.Build(masks, bytecodes), (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(table.GetVariantIndex(0), table.GetVariantIndex(2));
+    EXPECT_EQ(table.GetVariantIndex(1), table.GetVariantIndex(3));
+    EXPECT_NE(table.GetVariantIndex(0), table.GetVariantIndex(1));
+}
+
+TEST(ShaderVariantTableTest, StripForCompareKeepsOnlyCodeParts) {
+    const std::vector<uint8_t> container = MakeDebugContainer(7, 9);
+    const std::vector<uint8_t> stripped = ShaderVariantTable::StripForCompare(container.data(), container.size());
+
+    // SFI0 と DXIL のパート（ヘッダ付き）だけが残る
+    std::vector<uint8_t> expected;
+    AppendFourCC(expected, "SFI0");
+    AppendU32(expected, 8);
+    expected.insert(expected.end(), 8, 0);
+    AppendFourCC(expected, "DXIL");
+    AppendU32(expected, 6);
+    expected.insert(expected.end(), {7, 7, 7, 1, 2, 3});
+    EXPECT_EQ(stripped, expected);
+
+    // コンテナでないもの・壊れたコンテナはそのまま比べる
+    const std::vector<uint8_t> raw = {'D', 'X', 'B', 'X', 1, 2, 3};
+    EXPECT_EQ(ShaderVariantTable::StripForCompare(raw.data(), raw.size()), raw);
+    std::vector<uint8_t> broken = container;
+    broken[32] = 0xff; // 最初のパートのオフセットが範囲外
+    EXPECT_EQ(ShaderVariantTable::StripForCompare(broken.data(), broken.size()), broken);
+}
@@ -0,0 +1,118 @@
+#include "RenderSnapshot.h"
+#include "SimulationThread.h"
+#include "SnapshotExchange.h"
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(SimulationThreadTest, RunsKickedFramesInOrderOnItsOwnThread) {
+    std::mutex mutex;
+    std::vector<uint64_t> frames;
+    std::vector<double> seconds;
+    std::thread::id workerId;
+
+    SimulationThread sim;
+    sim.Start([&](const SimulationThread::FrameInput &input) {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames.push_back(input.frameIndex);
+        seconds.push_back(input.frameSeconds);
+        workerId = std::this_thread::get_id();
+    });
+    EXPECT_TRUE(sim.IsRunning());
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        sim.Kick({i, static_cast<double>(i) * 0.5});
+    }
+    sim.WaitIdle();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(frames.size(), 100u);
+    for (uint64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(frames[i], i);
+        EXPECT_DOUBLE_EQ(seconds[i], static_cast<double>(i) * 0.5);
+    }
+    EXPECT_NE(workerId, std::this_thread::get_id());
+}
+
+TEST(SimulationThreadTest, StopFinishesThePendingFrame) {
+    std::atomic<int> runs{0};
+    std::atomic<bool> release{false};
+
+    SimulationThread sim;
+    sim.Start([&](const SimulationThread::FrameInput &) {
+        while (!release.load()) std::this_thread::yield();
+        ++runs;
+    });
+    sim.Kick({0, 0.0}); // 実行中（release 待ち）
+    sim.Kick({1, 0.0}); // 1 つ目が着手されてから積まれ、未着手のまま残る
+
+    std::thread stopper([&] { sim.Stop(); });
+    release.store(true);
+    stopper.join();
+
+    EXPECT_EQ(runs.load(), 2);
+    EXPECT_FALSE(sim.IsRunning());
+    sim.Stop(); // 二重に止めても何もしない
+}
+
+// main.cpp のパイプライン（描画がフレーム N を読む間にシミュレーションが N+1 を進める）を GPU なしで再現する
+TEST(SimulationThreadTest, PipelinedRenderSeesEverySimulatedFrameOnce) {
+    constexpr uint64_t kFrames = 300;
+    SnapshotExchange<RenderSnapshot> snapshots;
+    SimulationThread sim;
+
+    // シミュレーション側だけが触る状態（描画スレッドは見ない）
+    uint64_t simulatedSteps = 0;
+    std::atomic<uint64_t> simRunningFrame{UINT64_MAX};
+
+    sim.Start([&](const SimulationThread::FrameInput &input) {
+        simRunningFrame.store(input.frameIndex);
+        ++simulatedSteps;
+
+        RenderSnapshot *snapshot = snapshots.BeginWrite();
+        if (!snapshot) return; // 終了中
+        snapshot->Clear();
+        snapshot->frameIndex = input.frameIndex;
+        snapshot->interpolationAlpha = static_cast<float>(input.frameIndex % 4) * 0.25f;
+        snapshot->extracted = true;
+        for (uint64_t i = 0; i <= input.frameIndex % 8; ++i) {
+            SpriteBatchBuilder::Entry e{};
+            e.layer = static_cast<int32_t>(input.frameIndex);
+            snapshot->sprites.push_back(e);
+        }
+        snapshots.EndWrite();
+    });
+
+    uint64_t simFrameIndex = 0;
+    sim.Kick({simFrameIndex, 0.0});
+
+    for (uint64_t frame = 0; frame < kFrames; ++frame) {
+        const RenderSnapshot *snapshot = snapshots.BeginRead();
+        if (!snapshot) {
+            ADD_FAILURE() << "no snapshot for frame " << frame;
+            break;
+        }
+        sim.WaitIdle();
+        EXPECT_EQ(snapshot->frameIndex, frame);
+        sim.Kick({++simFrameIndex, 1.0 / 60.0});
+
+        // N+1 の更新と並行して、スナップショット N だけを見て「描画」する
+        EXPECT_TRUE(snapshot->extracted);
+        EXPECT_FLOAT_EQ(snapshot->interpolationAlpha, static_cast<float>(frame % 4) * 0.25f);
+        EXPECT_EQ(snapshot->sprites.size(), frame % 8 + 1);
+        for (const auto &e : snapshot->sprites) {
+            EXPECT_EQ(e.layer, static_cast<int32_t>(frame));
+        }
+        // シミュレーションは描画より 1 フレームまでしか先に進まない
+        const uint64_t running = simRunningFrame.load();
+        EXPECT_TRUE(running == frame || running == frame + 1) << "frame " << frame << ", sim " << running;
+        snapshots.EndRead();
+    }
+
+    snapshots.Stop(); // 書き手が BeginWrite で待っていても抜けられるようにしてから止める
+    sim.Stop();
+    EXPECT_EQ(simulatedSteps, kFrames + 1); // 依頼済みのフレームは止める前に実行される
+}
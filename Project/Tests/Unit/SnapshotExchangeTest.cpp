@@ -0,0 +1,184 @@
+#include "SnapshotExchange.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    struct Payload {
+        uint64_t frame = 0;
+        std::array<uint64_t, 64> values{};
+
+        void Fill(uint64_t f) {
+            frame = f;
+            values.fill(f);
+        }
+
+        bool IsConsistent() const {
+            for (uint64_t v : values) {
+                if (v != frame) return false;
+            }
+            return true;
+        }
+    };
+
+    // 別スレッドの呼び出しが「まだ戻っていない」ことを確かめるための待ち時間
+    constexpr auto kBlockedProbe = std::chrono::milliseconds(30);
+
+} // namespace
+
+TEST(SnapshotExchangeTest, ReadSeesThePublishedSlot) {
+    SnapshotExchange<Payload> exchange;
+    Payload *w = exchange.BeginWrite();
+    ASSERT_NE(w, nullptr);
+    w->Fill(1);
+    exchange.EndWrite();
+    EXPECT_EQ(exchange.GetPublishedCount(), 1u);
+
+    const Payload *r = exchange.BeginRead();
+    ASSERT_EQ(r, w);
+    EXPECT_EQ(r->frame, 1u);
+
+    // 読んでいる間、書き手はもう 1 枚に書く
+    Payload *w2 = exchange.BeginWrite();
+    ASSERT_NE(w2, nullptr);
+    EXPECT_NE(w2, r);
+    w2->Fill(2);
+    exchange.EndWrite();
+    EXPECT_EQ(r->frame, 1u); // 読み取り中のスナップショットは変わらない
+    exchange.EndRead();
+
+    const Payload *r2 = exchange.BeginRead();
+    EXPECT_EQ(r2, w2);
+    EXPECT_EQ(r2->frame, 2u);
+    exchange.EndRead();
+}
+
+TEST(SnapshotExchangeTest, WriterWaitsUntilThePublishedSlotIsRead) {
+    SnapshotExchange<Payload> exchange;
+    exchange.BeginWrite()->Fill(1);
+    exchange.EndWrite();
+
+    std::atomic<bool> acquired{false};
+    std::thread writer([&] {
+        Payload *w = exchange.BeginWrite(); // 1 枚目が未読なので待つ
+        ASSERT_NE(w, nullptr);
+        acquired.store(true);
+        w->Fill(2);
+        exchange.EndWrite();
+    });
+
+    std::this_thread::sleep_for(kBlockedProbe);
+    EXPECT_FALSE(acquired.load()); // フレームを飛ばして上書きしない
+
+    const Payload *r = exchange.BeginRead();
+    EXPECT_EQ(r->frame, 1u);
+    writer.join();
+    EXPECT_TRUE(acquired.load());
+    exchange.EndRead();
+
+    r = exchange.BeginRead();
+    EXPECT_EQ(r->frame, 2u);
+    exchange.EndRead();
+}
+
+TEST(SnapshotExchangeTest, WriterDoesNotReuseTheSlotBeingRead) {
+    SnapshotExchange<Payload> exchange;
+    exchange.BeginWrite()->Fill(1);
+    exchange.EndWrite();
+    const Payload *first = exchange.BeginRead();
+
+    // 読んでいる間にもう 1 枚へ書いて公開する
+    exchange.BeginWrite()->Fill(2);
+    exchange.EndWrite();
+
+    // 2 枚目は未読、1 枚目は読み取り中なので、3 枚目の書き込み先はない
+    std::atomic<Payload *> third{nullptr};
+    std::thread writer([&] {
+        Payload *w = exchange.BeginWrite();
+        ASSERT_NE(w, nullptr);
+        third.store(w);
+        w->Fill(3);
+        exchange.EndWrite();
+    });
+    std::this_thread::sleep_for(kBlockedProbe);
+    EXPECT_EQ(third.load(), nullptr);
+    EXPECT_EQ(first->frame, 1u);
+
+    exchange.EndRead(); // 1 枚目を返しても、2 枚目が未読なのでまだ書けない
+    std::this_thread::sleep_for(kBlockedProbe);
+    EXPECT_EQ(third.load(), nullptr);
+
+    const Payload *second = exchange.BeginRead(); // 2 枚目を読むと、返した 1 枚目に書ける
+    EXPECT_EQ(second->frame, 2u);
+    writer.join();
+    EXPECT_EQ(third.load(), first);
+    EXPECT_EQ(second->frame, 2u); // 読み取り中の 2 枚目は書き換えられていない
+    exchange.EndRead();
+
+    const Payload *r = exchange.BeginRead();
+    EXPECT_EQ(r->frame, 3u);
+    exchange.EndRead();
+}
+
+TEST(SnapshotExchangeTest, StopReleasesWaitersAndKeepsPublishedSnapshot) {
+    SnapshotExchange<Payload> exchange;
+    std::thread reader([&] {
+        EXPECT_EQ(exchange.BeginRead(), nullptr); // 公開前に止められた
+    });
+    std::this_thread::sleep_for(kBlockedProbe);
+    exchange.Stop();
+    reader.join();
+
+    EXPECT_EQ(exchange.BeginWrite(), nullptr);
+
+    // 止める前に公開された分は読める
+    SnapshotExchange<Payload> published;
+    published.BeginWrite()->Fill(7);
+    published.EndWrite();
+    published.Stop();
+    const Payload *r = published.BeginRead();
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->frame, 7u);
+    published.EndRead();
+    EXPECT_EQ(published.BeginRead(), nullptr);
+}
+
+TEST(SnapshotExchangeTest, EveryFrameIsDeliveredOnceAndIntact) {
+    constexpr uint64_t kFrames = 2000;
+    SnapshotExchange<Payload> exchange;
+
+    std::thread writer([&] {
+        for (uint64_t f = 1; f <= kFrames; ++f) {
+            Payload *w = exchange.BeginWrite();
+            ASSERT_NE(w, nullptr);
+            w->Fill(f);
+            exchange.EndWrite();
+        }
+    });
+
+    std::vector<uint64_t> seen;
+    seen.reserve(kFrames);
+    for (uint64_t f = 1; f <= kFrames; ++f) {
+        const Payload *r = exchange.BeginRead();
+        if (!r) {
+            ADD_FAILURE() << "no snapshot for frame " << f;
+            break;
+        }
+        EXPECT_TRUE(r->IsConsistent()) << "frame " << f; // 書き手と同時に触っていない
+        seen.push_back(r->frame);
+        exchange.EndRead();
+    }
+    exchange.Stop(); // 失敗して途中で抜けても書き手を待たせない
+    writer.join();
+
+    ASSERT_EQ(seen.size(), kFrames);
+    for (uint64_t i = 0; i < kFrames; ++i) {
+        EXPECT_EQ(seen[i], i + 1) << "index " << i;
+    }
+    EXPECT_EQ(exchange.GetPublishedCount(), kFrames);
+}
@@ -0,0 +1,246 @@
+#include "MatrixUtil.h"
+#include "SpatialGrid2D.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Rect = SpatialGrid2D::Rect;
+
+    bool Overlaps(const Rect &a, const Rect &b) {
+        return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+    }
+
+    Rect MakeRect(float cx, float cy, float hw, float hh) {
+        return Rect{cx - hw, cy - hh, cx + hw, cy + hh};
+    }
+
+    std::vector<uint32_t> Sorted(std::vector<uint32_t> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    /// <summary>
+    /// グリッドと同じ操作を素朴な配列にも適用し、検索結果を総当たりと比べるフィクスチャ。
+    /// </summary>
+    class SpatialGrid2DTest : public ::testing::Test {
+    protected:
+        static constexpr float kCellSize = 64.0f;
+
+        void SetUp() override { grid_.Initialize(kCellSize); }
+
+        // userData には要素の番号（entries_ の位置）を入れる
+        void Insert(const Rect &bounds) {
+            const uint32_t index = static_cast<uint32_t>(entries_.size());
+            entries_.push_back({grid_.Insert(bounds, index), bounds, true});
+        }
+
+        void ExpectMatchesBruteForce(const Rect &query) const {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < entries_.size(); ++i) {
+                if (entries_[i].alive && Overlaps(entries_[i].bounds, query)) expected.push_back(i);
+            }
+            std::vector<uint32_t> found;
+            const size_t added = grid_.QueryRect(query, found);
+            EXPECT_EQ(added, found.size());
+            EXPECT_EQ(Sorted(found), expected)
+                << "query [" << query.minX << ", " << query.minY << "] - [" << query.maxX << ", " << query.maxY << "]";
+        }
+
+        struct Entry {
+            SpatialGrid2D::ProxyId id;
+            Rect bounds;
+            bool alive;
+        };
+
+        SpatialGrid2D grid_;
+        std::vector<Entry> entries_;
+    };
+
+} // namespace
+
+TEST_F(SpatialGrid2DTest, RectQueriesMatchBruteForceThroughEdits) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> half(0.5f, 40.0f);
+    std::uniform_real_distribution<float> step(-100.0f, 100.0f);
+    std::uniform_int_distribution<int> pick(0, 9);
+
+    for (int i = 0; i < 3000; ++i) {
+        // 1 割はセルより大きい要素（総当たりのリストに入る）
+        const float scale = pick(rng) == 0 ? 6.0f : 1.0f;
+        Insert(MakeRect(pos(rng), pos(rng), half(rng) * scale, half(rng) * scale));
+    }
+    EXPECT_EQ(grid_.GetCount(), entries_.size());
+    EXPECT_GT(grid_.GetLargeCount(), 0u);
+
+    auto randomQuery = [&](float maxHalf) {
+        std::uniform_real_distribution<float> qh(0.0f, maxHalf);
+        return MakeRect(pos(rng), pos(rng), qh(rng), qh(rng));
+    };
+
+    for (int round = 0; round < 20; ++round) {
+        // 移動（同じセル内・セルをまたぐ・大きさが変わって総当たり側と行き来する）と削除・再登録
+        for (Entry &e : entries_) {
+            if (!e.alive) continue;
+            const int action = pick(rng);
+            if (action < 6) {
+                const float dx = action < 3 ? step(rng) * 0.05f : step(rng);
+                const float dy = action < 3 ? step(rng) * 0.05f : step(rng);
+                e.bounds = Rect{e.bounds.minX + dx, e.bounds.minY + dy, e.bounds.maxX + dx, e.bounds.maxY + dy};
+            } else if (action < 8) {
+                const float cx = (e.bounds.minX + e.bounds.maxX) * 0.5f;
+                const float cy = (e.bounds.minY + e.bounds.maxY) * 0.5f;
+                e.bounds = MakeRect(cx, cy, half(rng) * (action == 7 ? 6.0f : 1.0f), half(rng));
+            } else if (action == 8) {
+                grid_.Remove(e.id);
+                e.alive = false;
+                continue;
+            } else {
+                continue;
+            }
+            grid_.Update(e.id, e.bounds);
+        }
+        for (int i = 0; i < 50; ++i) Insert(MakeRect(pos(rng), pos(rng), half(rng), half(rng)));
+
+        for (int q = 0; q < 20; ++q) ExpectMatchesBruteForce(randomQuery(300.0f));
+        ExpectMatchesBruteForce(randomQuery(5000.0f)); // 実在するセルを順に見る経路
+    }
+
+    size_t alive = 0;
+    for (const Entry &e : entries_) alive += e.alive ? 1 : 0;
+    EXPECT_EQ(grid_.GetCount(), alive);
+}
+
+TEST_F(SpatialGrid2DTest, PointQueryFindsEveryRectContainingThePoint) {
+    Insert(MakeRect(10.0f, 10.0f, 5.0f, 5.0f));
+    Insert(MakeRect(14.0f, 10.0f, 5.0f, 5.0f));    // 1 つ目と重なる
+    Insert(MakeRect(63.0f, 63.0f, 2.0f, 2.0f));    // セルの境目をまたぐ
+    Insert(MakeRect(0.0f, 0.0f, 500.0f, 500.0f));  // 総当たり側
+    Insert(MakeRect(-40.0f, -40.0f, 3.0f, 3.0f));  // 負の座標
+
+    std::vector<uint32_t> found;
+    EXPECT_EQ(grid_.QueryPoint(Vector2{12.0f, 10.0f}, found), 3u);
+    EXPECT_EQ(Sorted(found), (std::vector<uint32_t>{0, 1, 3}));
+
+    found.clear();
+    grid_.QueryPoint(Vector2{64.5f, 64.5f}, found); // 隣のセルからはみ出した分も拾う
+    EXPECT_EQ(Sorted(found), (std::vector<uint32_t>{2, 3}));
+
+    found.clear();
+    grid_.QueryPoint(Vector2{-41.0f, -39.0f}, found);
+    EXPECT_EQ(Sorted(found), (std::vector<uint32_t>{3, 4}));
+
+    found.clear();
+    EXPECT_EQ(grid_.QueryPoint(Vector2{1000.0f, 1000.0f}, found), 0u);
+    EXPECT_TRUE(found.empty());
+
+    // 境界上の点は含む（min / max は閉区間）
+    found.clear();
+    grid_.QueryPoint(Vector2{15.0f, 15.0f}, found);
+    EXPECT_EQ(Sorted(found), (std::vector<uint32_t>{0, 1, 3}));
+}
+
+TEST_F(SpatialGrid2DTest, UpdateMovesBetweenCellsAndTheLargeList) {
+    Insert(MakeRect(10.0f, 10.0f, 4.0f, 4.0f));
+    const SpatialGrid2D::ProxyId id = entries_[0].id;
+    EXPECT_EQ(grid_.GetLargeCount(), 0u);
+
+    // 同じセル内で動くだけ
+    grid_.Update(id, MakeRect(20.0f, 12.0f, 4.0f, 4.0f));
+    EXPECT_FLOAT_EQ(grid_.GetBounds(id).minX, 16.0f);
+    std::vector<uint32_t> found;
+    EXPECT_EQ(grid_.QueryPoint(Vector2{20.0f, 12.0f}, found), 1u);
+
+    // 遠くのセルへ
+    grid_.Update(id, MakeRect(1000.0f, -700.0f, 4.0f, 4.0f));
+    found.clear();
+    EXPECT_EQ(grid_.QueryPoint(Vector2{20.0f, 12.0f}, found), 0u);
+    EXPECT_EQ(grid_.QueryPoint(Vector2{1000.0f, -700.0f}, found), 1u);
+
+    // セルより大きくなる → 戻る
+    grid_.Update(id, MakeRect(1000.0f, -700.0f, 100.0f, 4.0f));
+    EXPECT_EQ(grid_.GetLargeCount(), 1u);
+    found.clear();
+    EXPECT_EQ(grid_.QueryPoint(Vector2{1090.0f, -700.0f}, found), 1u);
+    grid_.Update(id, MakeRect(1000.0f, -700.0f, 4.0f, 4.0f));
+    EXPECT_EQ(grid_.GetLargeCount(), 0u);
+    EXPECT_EQ(grid_.GetUserData(id), 0u);
+    EXPECT_EQ(grid_.GetCount(), 1u);
+}
+
+TEST_F(SpatialGrid2DTest, RemovedIdsAreRecycledAndClearEmptiesTheGrid) {
+    Insert(MakeRect(0.0f, 0.0f, 1.0f, 1.0f));
+    Insert(MakeRect(5.0f, 0.0f, 1.0f, 1.0f));
+    Insert(MakeRect(0.0f, 0.0f, 200.0f, 1.0f));
+
+    const SpatialGrid2D::ProxyId removed = entries_[1].id;
+    grid_.Remove(removed);
+    grid_.Remove(entries_[2].id);
+    EXPECT_EQ(grid_.GetCount(), 1u);
+    EXPECT_EQ(grid_.GetLargeCount(), 0u);
+
+    const SpatialGrid2D::ProxyId reused = grid_.Insert(MakeRect(3.0f, 3.0f, 1.0f, 1.0f), 42);
+    EXPECT_TRUE(reused == removed || reused == entries_[2].id);
+    EXPECT_EQ(grid_.GetUserData(reused), 42u);
+
+    std::vector<uint32_t> found;
+    grid_.QueryRect(Rect{-10.0f, -10.0f, 10.0f, 10.0f}, found);
+    EXPECT_EQ(Sorted(found), (std::vector<uint32_t>{0, 42}));
+
+    grid_.Clear();
+    EXPECT_EQ(grid_.GetCount(), 0u);
+    found.clear();
+    EXPECT_EQ(grid_.QueryRect(Rect{-1000.0f, -1000.0f, 1000.0f, 1000.0f}, found), 0u);
+    EXPECT_EQ(grid_.Insert(MakeRect(0.0f, 0.0f, 1.0f, 1.0f), 7), 0u); // 番号は最初から振り直す
+}
+
+TEST(SpatialGrid2DBoundsTest, SpriteBoundsWrapTheRotatedQuad) {
+    const Rect r0 = SpatialGrid2D::MakeSpriteBounds(Vector2{100.0f, 50.0f}, Vector2{40.0f, 20.0f}, 0.0f);
+    EXPECT_FLOAT_EQ(r0.minX, 80.0f);
+    EXPECT_FLOAT_EQ(r0.maxX, 120.0f);
+    EXPECT_FLOAT_EQ(r0.minY, 40.0f);
+    EXPECT_FLOAT_EQ(r0.maxY, 60.0f);
+
+    // 90 度で幅と高さが入れ替わる
+    const Rect r90 = SpatialGrid2D::MakeSpriteBounds(Vector2{0.0f, 0.0f}, Vector2{40.0f, 20.0f}, 1.5707964f);
+    EXPECT_NEAR(r90.maxX, 10.0f, 1e-4f);
+    EXPECT_NEAR(r90.maxY, 20.0f, 1e-4f);
+
+    // 45 度の正方形は対角線の半分まで広がる。負の大きさ（反転）でも同じ
+    const Rect r45 = SpatialGrid2D::MakeSpriteBounds(Vector2{0.0f, 0.0f}, Vector2{-10.0f, 10.0f}, 0.7853982f);
+    EXPECT_NEAR(r45.maxX, 5.0f * std::sqrt(2.0f), 1e-4f);
+    EXPECT_NEAR(r45.minY, -5.0f * std::sqrt(2.0f), 1e-4f);
+}
+
+TEST(SpatialGrid2DBoundsTest, VisibleRectForOrthographicAndPerspectiveCameras) {
+    // 画面中央を (640, 360) に置く正射影なら、画面そのもの
+    const Matrix4x4 ortho = MatrixUtil::Multiply(MatrixUtil::MakeTranslationMatrix(-640.0f, -360.0f, 0.0f),
+        MatrixUtil::MakeOrthographicMatrix(1280.0f, 720.0f, 0.0f, 100.0f));
+    Rect r;
+    ASSERT_TRUE(SpatialGrid2D::ComputeVisibleRect(ortho, 0.0f, r));
+    EXPECT_NEAR(r.minX, 0.0f, 1e-2f);
+    EXPECT_NEAR(r.minY, 0.0f, 1e-2f);
+    EXPECT_NEAR(r.maxX, 1280.0f, 1e-2f);
+    EXPECT_NEAR(r.maxY, 720.0f, 1e-2f);
+
+    // 10 離れた平面を 90 度の視野で見下ろすと、中心から ±10
+    const Vector3 eye(100.0f, 50.0f, -10.0f);
+    const Matrix4x4 view = MatrixUtil::MakeViewMatrix(eye, Vector3(100.0f, 50.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+    const Matrix4x4 proj = MatrixUtil::MakePerspectiveFovMatrix(1.5707964f, 1.0f, 0.1f, 1000.0f);
+    ASSERT_TRUE(SpatialGrid2D::ComputeVisibleRect(MatrixUtil::Multiply(view, proj), 0.0f, r));
+    EXPECT_NEAR(r.minX, 90.0f, 1e-2f);
+    EXPECT_NEAR(r.maxX, 110.0f, 1e-2f);
+    EXPECT_NEAR(r.minY, 40.0f, 1e-2f);
+    EXPECT_NEAR(r.maxY, 60.0f, 1e-2f);
+
+    // 平面に背を向けている・地平線が映るときは範囲を決められない
+    const Matrix4x4 away = MatrixUtil::MakeViewMatrix(eye, Vector3(100.0f, 50.0f, -20.0f), Vector3(0.0f, 1.0f, 0.0f));
+    EXPECT_FALSE(SpatialGrid2D::ComputeVisibleRect(MatrixUtil::Multiply(away, proj), 0.0f, r));
+    const Matrix4x4 side = MatrixUtil::MakeViewMatrix(eye, Vector3(200.0f, 50.0f, -10.0f), Vector3(0.0f, 1.0f, 0.0f));
+    EXPECT_FALSE(SpatialGrid2D::ComputeVisibleRect(MatrixUtil::Multiply(side, proj), 0.0f, r));
+}
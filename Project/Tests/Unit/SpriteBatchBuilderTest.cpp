@@ -0,0 +1,189 @@
+#include "FloatCompare.h"
+#include "JobSystem.h"
+#include "MatrixUtil.h"
+#include "SpriteBatchBuilder.h"
+#include "SpriteBatchCommandSink.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    Matrix4x4 MakeViewProj() {
+        return MatrixUtil::MakeOrthographicMatrix(1280.0f, 720.0f, 0.0f, 1.0f);
+    }
+
+    std::vector<SpriteBatchBuilder::Entry> MakeEntries(size_t count, bool shuffledLayers) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> pos(-640.0f, 640.0f);
+        std::uniform_real_distribution<float> ang(-3.0f, 3.0f);
+        std::uniform_int_distribution<int32_t> layer(-3, 3);
+        std::vector<SpriteBatchBuilder::Entry> entries(count);
+        for (size_t i = 0; i < count; ++i) {
+            SpriteBatchBuilder::Entry &e = entries[i];
+            e.position = {pos(rng), pos(rng)};
+            e.size = {16.0f + static_cast<float>(i % 7), 24.0f};
+            e.rotation = ang(rng);
+            e.color = {static_cast<float>(i), 0.5f, 0.25f, 1.0f};
+            e.uvRect = {0.0f, 0.0f, 0.5f, static_cast<float>(i)};
+            e.layer = shuffledLayers ? layer(rng) : static_cast<int32_t>(i / 100);
+        }
+        return entries;
+    }
+
+    // 1 件ぶんの期待値（TransformBatch を通さない参照実装）
+    SpriteInstance Reference(const SpriteBatchBuilder::Entry &e, const Matrix4x4 &vp) {
+        SpriteInstance inst;
+        inst.wvp = MatrixUtil::MultiplyAffine2D(
+            MatrixUtil::MakeAffine2DMatrix(e.size.x, e.size.y, e.rotation, e.position.x, e.position.y), vp);
+        inst.color = e.color;
+        inst.uvRect = e.uvRect;
+        return inst;
+    }
+
+    // Build の結果が stable_sort(layer) した参照と一致するか
+    void ExpectMatchesReference(const std::vector<SpriteBatchBuilder::Entry> &entries,
+        const std::vector<SpriteInstance> &out, const Matrix4x4 &vp) {
+        std::vector<size_t> order(entries.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return entries[a].layer < entries[b].layer; });
+
+        for (size_t i = 0; i < order.size(); ++i) {
+            const SpriteInstance expected = Reference(entries[order[i]], vp);
+            ASSERT_EQ(FloatCompare::MaxUlpDistance(expected.wvp, out[i].wvp), 0) << "index " << i;
+            ASSERT_EQ(expected.color.x, out[i].color.x) << "index " << i;
+            ASSERT_EQ(expected.uvRect.w, out[i].uvRect.w) << "index " << i;
+        }
+    }
+
+    // 呼ばれたコマンドを文字列で記録するだけのコマンドリスト代わり
+    class RecordingSink : public ISpriteBatchCommandSink {
+    public:
+        explicit RecordingSink(size_t capacity) : storage_(capacity) {}
+
+        InstanceBuffer AllocateInstances(uint32_t count) override {
+            commands.push_back("Allocate " + std::to_string(count));
+            InstanceBuffer buffer;
+            if (count <= storage_.size()) {
+                buffer.cpu = storage_.data();
+                buffer.gpuAddress = kGpuBase;
+            }
+            return buffer;
+        }
+
+        void SetInstanceBuffer(uint64_t gpuAddress, uint32_t strideInBytes, uint32_t sizeInBytes) override {
+            commands.push_back("SetInstanceBuffer " + std::to_string(gpuAddress - kGpuBase) + " " +
+                std::to_string(strideInBytes) + " " + std::to_string(sizeInBytes));
+        }
+
+        void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount) override {
+            commands.push_back("Draw " + std::to_string(indexCountPerInstance) + " " + std::to_string(instanceCount));
+        }
+
+        const std::vector<SpriteInstance> &GetInstances() const { return storage_; }
+
+        std::vector<std::string> commands;
+
+    private:
+        static constexpr uint64_t kGpuBase = 0x10000;
+        std::vector<SpriteInstance> storage_;
+    };
+
+} // namespace
+
+TEST(SpriteBatchBuilder, SortedInputKeepsOrder) {
+    const auto entries = MakeEntries(1000, false);
+    SpriteBatchBuilder builder;
+    for (const auto &e : entries) builder.Add(e);
+    ASSERT_EQ(builder.GetCount(), entries.size());
+
+    std::vector<SpriteInstance> out(entries.size());
+    builder.Build(MakeViewProj(), out.data());
+    ExpectMatchesReference(entries, out, MakeViewProj());
+}
+
+TEST(SpriteBatchBuilder, UnsortedLayersAreStableSorted) {
+    const auto entries = MakeEntries(1000, true);
+    SpriteBatchBuilder builder;
+    for (const auto &e : entries) builder.Add(e);
+
+    std::vector<SpriteInstance> out(entries.size());
+    builder.Build(MakeViewProj(), out.data());
+    ExpectMatchesReference(entries, out, MakeViewProj());
+}
+
+TEST(SpriteBatchBuilder, ParallelBuildMatchesSerial) {
+    const size_t count = SpriteBatchBuilder::kParallelGrainSize * 5 + 17;
+    JobSystem jobs;
+    jobs.Initialize(3);
+
+    for (bool shuffled : {false, true}) {
+        const auto entries = MakeEntries(count, shuffled);
+        SpriteBatchBuilder builder;
+        builder.SetJobSystem(&jobs);
+        for (const auto &e : entries) builder.Add(e);
+
+        std::vector<SpriteInstance> out(count);
+        builder.Build(MakeViewProj(), out.data());
+        ExpectMatchesReference(entries, out, MakeViewProj());
+    }
+    jobs.Finalize();
+}
+
+TEST(SpriteBatchBuilder, ClearResets) {
+    SpriteBatchBuilder builder;
+    for (const auto &e : MakeEntries(10, true)) builder.Add(e);
+    builder.Clear();
+    EXPECT_EQ(builder.GetCount(), 0u);
+
+    const auto entries = MakeEntries(10, false);
+    for (const auto &e : entries) builder.Add(e);
+    std::vector<SpriteInstance> out(entries.size());
+    builder.Build(MakeViewProj(), out.data());
+    ExpectMatchesReference(entries, out, MakeViewProj());
+}
+
+TEST(SpriteBatchBuilderFlush, EmptyBatchRecordsNothing) {
+    SpriteBatchBuilder builder;
+    RecordingSink sink(16);
+    EXPECT_EQ(builder.Flush(MakeViewProj(), sink), 0u);
+    EXPECT_TRUE(sink.commands.empty());
+}
+
+TEST(SpriteBatchBuilderFlush, RecordsSingleInstancedDraw) {
+    const auto entries = MakeEntries(300, true);
+    SpriteBatchBuilder builder;
+    for (const auto &e : entries) builder.Add(e);
+
+    RecordingSink sink(entries.size());
+    EXPECT_EQ(builder.Flush(MakeViewProj(), sink), entries.size());
+
+    const std::vector<std::string> expected = {
+        "Allocate 300",
+        "SetInstanceBuffer 0 96 28800",
+        "Draw 6 300",
+    };
+    EXPECT_EQ(sink.commands, expected);
+    ExpectMatchesReference(entries, sink.GetInstances(), MakeViewProj());
+
+    // 発行後は受付がクリアされ、次のフレームは何も描かない
+    EXPECT_EQ(builder.GetCount(), 0u);
+    sink.commands.clear();
+    EXPECT_EQ(builder.Flush(MakeViewProj(), sink), 0u);
+    EXPECT_TRUE(sink.commands.empty());
+}
+
+TEST(SpriteBatchBuilderFlush, AllocationFailureDrawsNothing) {
+    SpriteBatchBuilder builder;
+    for (const auto &e : MakeEntries(20, false)) builder.Add(e);
+
+    RecordingSink sink(10); // 容量不足
+    EXPECT_EQ(builder.Flush(MakeViewProj(), sink), 0u);
+
+    const std::vector<std::string> expected = {"Allocate 20"};
+    EXPECT_EQ(sink.commands, expected);
+    EXPECT_EQ(builder.GetCount(), 0u);
+}
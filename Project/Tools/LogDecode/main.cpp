@@ -0,0 +1,33 @@
+#include "BinaryLogDecoder.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+/// <summary>
+/// BinaryLogger が書き出したバイナリログをテキストに戻すツール。
+/// </summary>
+/// <remarks>
+/// <code>
+/// TaroLogDecode &lt;入力.tlog&gt; [出力.txt]
+/// </code>
+/// 出力を省略した場合は入力の拡張子を .txt に変えたパスへ書き出す。
+/// 末尾が途中で切れたファイルは、読めたところまでを書き出して 1 を返す。
+/// </remarks>
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s <input.tlog> [output.txt]\n", argv[0]);
+        return 2;
+    }
+
+    const std::filesystem::path input = argv[1];
+    std::filesystem::path output = argc == 3 ? std::filesystem::path(argv[2]) : input;
+    if (argc == 2) output.replace_extension(".txt");
+
+    std::string error;
+    if (!BinaryLogDecoder::DecodeFileToText(input, output, &error)) {
+        std::fprintf(stderr, "%s: %s\n", input.string().c_str(), error.c_str());
+        return 1;
+    }
+    std::printf("%s -> %s\n", input.string().c_str(), output.string().c_str());
+    return 0;
+}